@@ -0,0 +1,66 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/buffer/bufferrepresentation.h>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * A BufferRepresentation whose data is not yet in memory. The data is loaded through the
+ * DiskRepresentationLoader the first time a BufferRAM representation is requested, see
+ * BufferDisk2RAMConverter. Used for deferring the loading of large buffers until they are needed.
+ */
+class IVW_CORE_API BufferDisk : public BufferRepresentation,
+                                public DiskRepresentation<BufferRepresentation, BufferDisk> {
+public:
+    BufferDisk(size_t size = 0, const DataFormatBase* format = DataFloat32::get(),
+               BufferUsage usage = BufferUsage::Static, BufferTarget target = BufferTarget::Data);
+    BufferDisk(std::string srcFile, size_t size = 0,
+               const DataFormatBase* format = DataFloat32::get(),
+               BufferUsage usage = BufferUsage::Static, BufferTarget target = BufferTarget::Data);
+    BufferDisk(const BufferDisk& rhs) = default;
+    BufferDisk& operator=(const BufferDisk& that) = default;
+    virtual BufferDisk* clone() const override;
+    virtual ~BufferDisk() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    virtual void setSize(size_t size) override;
+    virtual size_t getSize() const override;
+
+private:
+    size_t size_;
+};
+
+}  // namespace inviwo
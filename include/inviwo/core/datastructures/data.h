@@ -35,6 +35,7 @@
 
 #include <typeindex>
 #include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
 
@@ -105,6 +106,15 @@ public:
     template <typename T>
     const T* getRepresentation() const;
 
+    /**
+     * Get a representation of type T, same as getRepresentation, but shares the ownership of the
+     * representation. The representation is found or updated under the lock of the Data object,
+     * hence the result stays valid and of type T even if other threads request other
+     * representations in the meantime.
+     */
+    template <typename T>
+    std::shared_ptr<const T> getRepresentationShared() const;
+
     /**
      * Get an editable representation. This will invalidate all other representations.
      * They will now have to be updated from this one before use.
@@ -124,6 +134,14 @@ public:
     template <typename T>
     bool hasRepresentation() const;
 
+    /**
+     * Check if a specific representation type exists and is up to date, i.e. it would be
+     * returned by getRepresentation without having to update it from another representation.
+     * @return true if existing and valid, false otherwise.
+     */
+    template <typename T>
+    bool hasValidRepresentation() const;
+
     /**
      * Check if the Data object has any representation.
      * @return true if any representation exist, false otherwise.
@@ -164,13 +182,19 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * A counter that is incremented whenever a representation is made editable, added or removed.
+     * Can be used to detect modifications of the data, e.g. to invalidate cached derived data.
+     */
+    size_t getModificationCount() const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
     Data<Self, Repr>& operator=(const Data<Self, Repr>& rhs);
 
     template <typename T>
-    const T* getValidRepresentation() const;
+    std::shared_ptr<const T> getValidRepresentation() const;
     void copyRepresentationsTo(Data<Self, Repr>* targetData) const;
 
     std::shared_ptr<Repr> addRepresentationInternal(std::shared_ptr<Repr> representation) const;
@@ -179,6 +203,7 @@ protected:
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+    std::atomic<size_t> modificationCount_{0};
 };
 
 template <typename Self, typename Repr>
@@ -197,6 +222,12 @@ Data<Self, Repr>& Data<Self, Repr>::operator=(const Data<Self, Repr>& that) {
 template <typename Self, typename Repr>
 template <typename T>
 const T* Data<Self, Repr>::getRepresentation() const {
+    return getRepresentationShared<T>().get();
+}
+
+template <typename Self, typename Repr>
+template <typename T>
+std::shared_ptr<const T> Data<Self, Repr>::getRepresentationShared() const {
     std::unique_lock<std::mutex> lock(mutex_);
     if (representations_.empty()) {
         lock.unlock();
@@ -211,7 +242,7 @@ const T* Data<Self, Repr>::getRepresentation() const {
     auto it = representations_.find(std::type_index(typeid(T)));
     if (it != representations_.end() && it->second->isValid()) {
         lastValidRepresentation_ = it->second;
-        return dynamic_cast<const T*>(lastValidRepresentation_.get());
+        return std::dynamic_pointer_cast<const T>(lastValidRepresentation_);
     } else {
         return getValidRepresentation<T>();
     }
@@ -219,7 +250,7 @@ const T* Data<Self, Repr>::getRepresentation() const {
 
 template <typename Self, typename Repr>
 template <typename T>
-const T* Data<Self, Repr>::getValidRepresentation() const {
+std::shared_ptr<const T> Data<Self, Repr>::getValidRepresentation() const {
     auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
     if (auto package = factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
                                                            std::type_index(typeid(T)))) {
@@ -236,7 +267,7 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
                 lastValidRepresentation_ = addRepresentationInternal(result);
             }
         }
-        return dynamic_cast<const T*>(lastValidRepresentation_.get());
+        return std::dynamic_pointer_cast<const T>(lastValidRepresentation_);
     } else {
         throw ConverterException("Found no converters", IVW_CONTEXT);
     }
@@ -257,10 +288,19 @@ bool Data<Self, Repr>::hasRepresentation() const {
     return util::has_key(representations_, std::type_index(typeid(T)));
 }
 
+template <typename Self, typename Repr>
+template <typename T>
+bool Data<Self, Repr>::hasValidRepresentation() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = representations_.find(std::type_index(typeid(T)));
+    return it != representations_.end() && it->second->isValid();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
     bool found = false;
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     for (auto& elem : representations_) {
         if (elem.second.get() != repr) {
             elem.second->setValid(false);
@@ -276,6 +316,7 @@ void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     representations_.clear();
 }
 
@@ -301,12 +342,14 @@ std::shared_ptr<Repr> Data<Self, Repr>::addRepresentationInternal(
 template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
     lastValidRepresentation_ = addRepresentationInternal(representation);
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
 
     for (auto& elem : representations_) {
         if (elem.second.get() == representation) {
@@ -329,6 +372,7 @@ void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
 template <typename Self, typename Repr>
 void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
     std::unique_lock<std::mutex> lock(mutex_);
+    ++modificationCount_;
 
     std::unordered_map<std::type_index, std::shared_ptr<Repr>> repr;
     for (auto& elem : representations_) {
@@ -347,6 +391,11 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
     std::swap(repr, representations_);
 }
 
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getModificationCount() const {
+    return modificationCount_.load();
+}
+
 template <typename Self, typename Repr>
 bool Data<Self, Repr>::hasRepresentations() const {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -34,6 +34,10 @@
 #include <inviwo/core/common/inviwo.h>
 
 #include <iterator>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
 
 namespace inviwo {
 enum class HistogramMode { Off, All, P99, P95, P90, Log };
@@ -76,6 +80,7 @@ protected:
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -94,66 +99,332 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
+namespace detail {
 
+/**
+ * Accumulates bin counts and statistics (min, max, sum, sum of squares) for a number of values
+ * of type T, one histogram per component. Partial accumulators over different parts of the data
+ * can be merged, which is used to calculate histograms in parallel.
+ */
+template <typename T>
+class HistogramAccumulator {
+public:
     // a double type with the same extent as T
     using D = typename util::same_extent<T, double>::type;
     // a size_t type with same extent as T
     using I = typename util::same_extent<T, size_t>::type;
 
-    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    static constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+
+    HistogramAccumulator(dvec2 dataRange, size_t bins);
+
+    template <typename FirstIter, typename LastIter>
+    void add(FirstIter begin, LastIter end);
+
+    /**
+     * Add contiguous data. For scalar arithmetic types the values are processed in blocks where
+     * bin indices and statistics are computed in tight loops that the compiler can vectorize.
+     * Large amounts of 8 and 16 bit integers are instead counted per value.
+     */
+    void add(const T* begin, const T* end);
+
+    /**
+     * Add every stride:th value of contiguous data, used to quickly estimate the histograms from a
+     * subsample.
+     */
+    void add(const T* begin, const T* end, size_t stride);
+
+    void merge(const HistogramAccumulator& other);
+
+    HistogramContainer getHistograms() const;
+
+    size_t getBins() const { return bins_; }
+
+private:
+    std::uint32_t binIndex(double val) const;
+    void addScalarBlock(const T* begin, const T* end, std::vector<std::uint32_t>& subCounts);
+    void addValueCounts(const T* begin, const T* end);
+
+    dvec2 dataRange_;
+    size_t bins_;
+    std::array<std::vector<size_t>, extent> counts_;
+    D min_;
+    D max_;
+    D sum_;
+    D sum2_;
+    size_t count_;
+};
+
+template <typename T>
+HistogramAccumulator<T>::HistogramAccumulator(dvec2 dataRange, size_t bins)
+    : dataRange_{dataRange}
+    , bins_{bins}
+    , counts_{}
+    , min_(std::numeric_limits<double>::max())
+    , max_(std::numeric_limits<double>::lowest())
+    , sum_(0)
+    , sum2_(0)
+    , count_(0) {
 
     // check whether number of bins exceeds the data range only if it is an integral type
     if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
-    }
-
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+        bins_ = std::min(bins_, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
+    for (auto& c : counts_) c.resize(bins_, 0);
+}
 
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
+template <typename T>
+template <typename FirstIter, typename LastIter>
+void HistogramAccumulator<T>::add(FirstIter begin, LastIter end) {
+    const D rangeMin(dataRange_.x);
+    const D rangeScaleFactor(static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x));
 
     for (; begin != end; ++begin) {
-
         const auto val = static_cast<D>(*begin);
 
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
+        min_ = glm::min(min_, val);
+        max_ = glm::max(max_, val);
+        sum_ += val;
+        sum2_ += val * val;
+        count_++;
 
         const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
 
         for (size_t i = 0; i < extent; ++i) {
             const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
+            if (v < bins_) {
+                counts_[i][v]++;
             }
         }
     }
+}
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
+template <typename T>
+void HistogramAccumulator<T>::add(const T* begin, const T* end) {
+    if constexpr (extent == 1 && std::is_integral_v<T> && sizeof(T) <= 2) {
+        // For 8 and 16 bit integers it is cheaper to count the occurrences of each value and
+        // derive the bins and statistics from those counts, if there are enough values.
+        constexpr size_t numValues = size_t{1} << (8 * sizeof(T));
+        if (static_cast<size_t>(end - begin) >= numValues) {
+            addValueCounts(begin, end);
+            return;
+        }
+    }
+    if constexpr (extent == 1 && std::is_arithmetic_v<T>) {
+        // Count into four separate 32 bit sub-histograms to avoid stalls when consecutive
+        // values fall into the same bin. The last slot of each collects out of range values.
+        // The sub-histograms are flushed before they can overflow.
+        constexpr size_t flushSize = size_t{1} << 30;
+        std::vector<std::uint32_t> subCounts(4 * (bins_ + 1), 0);
+        while (begin != end) {
+            const auto chunkEnd = begin + std::min(static_cast<size_t>(end - begin), flushSize);
+            constexpr std::ptrdiff_t blockSize = 1024;
+            while (begin != chunkEnd) {
+                const auto blockEnd = begin + std::min(chunkEnd - begin, blockSize);
+                addScalarBlock(begin, blockEnd, subCounts);
+                begin = blockEnd;
+            }
+            auto& counts = counts_[0];
+            const auto stride = bins_ + 1;
+            for (size_t i = 0; i < bins_; ++i) {
+                counts[i] += size_t{subCounts[i]} + subCounts[stride + i] +
+                             subCounts[2 * stride + i] + subCounts[3 * stride + i];
+            }
+            std::fill(subCounts.begin(), subCounts.end(), 0);
+        }
+    } else {
+        add<const T*, const T*>(begin, end);
+    }
+}
 
+template <typename T>
+void HistogramAccumulator<T>::add(const T* begin, const T* end, size_t stride) {
+    if (stride <= 1) {
+        add(begin, end);
+        return;
+    }
+    std::array<T, 1024> buffer;
+    size_t count = 0;
+    const auto size = static_cast<size_t>(end - begin);
+    for (size_t i = 0; i < size; i += stride) {
+        buffer[count++] = begin[i];
+        if (count == buffer.size()) {
+            add(buffer.data(), buffer.data() + count);
+            count = 0;
+        }
+    }
+    add(buffer.data(), buffer.data() + count);
+}
+
+template <typename T>
+void HistogramAccumulator<T>::addValueCounts(const T* begin, const T* end) {
+    constexpr size_t numValues = size_t{1} << (8 * sizeof(T));
+    constexpr size_t flushSize = size_t{1} << 30;
+    const auto offset = static_cast<std::int64_t>(std::numeric_limits<T>::min());
+
+    std::vector<std::uint32_t> valueCounts(numValues, 0);
+    while (begin != end) {
+        const auto chunkEnd = begin + std::min(static_cast<size_t>(end - begin), flushSize);
+        for (; begin != chunkEnd; ++begin) {
+            ++valueCounts[static_cast<size_t>(static_cast<std::int64_t>(*begin) - offset)];
+        }
+
+        auto& counts = counts_[0];
+        for (size_t i = 0; i < numValues; ++i) {
+            const auto count = valueCounts[i];
+            if (count == 0) continue;
+            const auto val = static_cast<double>(static_cast<std::int64_t>(i) + offset);
+            const auto ind = binIndex(val);
+            if (ind < bins_) counts[ind] += count;
+            min_ = std::min(min_, val);
+            max_ = std::max(max_, val);
+            sum_ += count * val;
+            sum2_ += count * val * val;
+            count_ += count;
+        }
+        std::fill(valueCounts.begin(), valueCounts.end(), 0);
+    }
+}
+
+template <typename T>
+std::uint32_t HistogramAccumulator<T>::binIndex(double val) const {
+    const double rangeScaleFactor =
+        static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+    const double pos = (val - dataRange_.x) * rangeScaleFactor;
+    return (pos > -1.0 && pos < static_cast<double>(bins_)) ? static_cast<std::uint32_t>(pos)
+                                                            : static_cast<std::uint32_t>(bins_);
+}
+
+template <typename T>
+void HistogramAccumulator<T>::addScalarBlock(const T* begin, const T* end,
+                                             std::vector<std::uint32_t>& subCounts) {
+    const auto size = static_cast<size_t>(end - begin);
+    if (size == 0) return;
+
+    // Compute all bin indices first, values outside of the data range get the index bins_.
+    std::array<std::uint32_t, 1024> indices;
+    {
+        const double rangeMin = dataRange_.x;
+        const double rangeScaleFactor =
+            static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+        const double bins = static_cast<double>(bins_);
+        const auto outside = static_cast<std::uint32_t>(bins_);
+        for (size_t i = 0; i < size; ++i) {
+            const double pos = (static_cast<double>(begin[i]) - rangeMin) * rangeScaleFactor;
+            indices[i] = (pos > -1.0 && pos < bins) ? static_cast<std::uint32_t>(pos) : outside;
+        }
+    }
+    const auto stride = bins_ + 1;
+    auto* sub0 = subCounts.data();
+    auto* sub1 = sub0 + stride;
+    auto* sub2 = sub1 + stride;
+    auto* sub3 = sub2 + stride;
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        ++sub0[indices[i]];
+        ++sub1[indices[i + 1]];
+        ++sub2[indices[i + 2]];
+        ++sub3[indices[i + 3]];
+    }
+    for (; i < size; ++i) {
+        ++sub0[indices[i]];
+    }
+
+    // Statistics, for small integer types min and max are found in T and the sums can be
+    // accumulated exactly in 64 bit integers over a block.
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= 2) {
+        T min = begin[0];
+        T max = begin[0];
+        std::int64_t sum = 0;
+        std::uint64_t sum2 = 0;
+        for (size_t j = 0; j < size; ++j) {
+            const auto v = begin[j];
+            min = std::min(min, v);
+            max = std::max(max, v);
+            sum += static_cast<std::int64_t>(v);
+            sum2 += static_cast<std::uint64_t>(static_cast<std::int64_t>(v) *
+                                               static_cast<std::int64_t>(v));
+        }
+        min_ = std::min(min_, static_cast<double>(min));
+        max_ = std::max(max_, static_cast<double>(max));
+        sum_ += static_cast<double>(sum);
+        sum2_ += static_cast<double>(sum2);
+    } else {
+        // Use four independent accumulators to break the dependency chains
+        std::array<double, 4> min, max, sum, sum2;
+        min.fill(std::numeric_limits<double>::max());
+        max.fill(std::numeric_limits<double>::lowest());
+        sum.fill(0.0);
+        sum2.fill(0.0);
+        size_t j = 0;
+        for (; j + 4 <= size; j += 4) {
+            for (size_t k = 0; k < 4; ++k) {
+                const auto v = static_cast<double>(begin[j + k]);
+                min[k] = std::min(min[k], v);
+                max[k] = std::max(max[k], v);
+                sum[k] += v;
+                sum2[k] += v * v;
+            }
+        }
+        for (; j < size; ++j) {
+            const auto v = static_cast<double>(begin[j]);
+            min[0] = std::min(min[0], v);
+            max[0] = std::max(max[0], v);
+            sum[0] += v;
+            sum2[0] += v * v;
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            min_ = std::min(min_, min[k]);
+            max_ = std::max(max_, max[k]);
+            sum_ += sum[k];
+            sum2_ += sum2[k];
+        }
+    }
+    count_ += size;
+}
+
+template <typename T>
+void HistogramAccumulator<T>::merge(const HistogramAccumulator& other) {
+    for (size_t i = 0; i < extent; ++i) {
+        std::transform(counts_[i].begin(), counts_[i].end(), other.counts_[i].begin(),
+                       counts_[i].begin(), std::plus<>{});
+    }
+    min_ = glm::min(min_, other.min_);
+    max_ = glm::max(max_, other.max_);
+    sum_ += other.sum_;
+    sum2_ += other.sum2_;
+    count_ += other.count_;
+}
+
+template <typename T>
+HistogramContainer HistogramAccumulator<T>::getHistograms() const {
+    const auto dcount = static_cast<double>(count_);
+    const auto mean = sum_ / dcount;
+    const auto stddev = glm::sqrt((dcount * sum2_ - sum_ * sum_) / (dcount * (dcount - D{1})));
+
+    std::vector<NormalizedHistogram> histograms;
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        std::vector<double> counts(counts_[i].begin(), counts_[i].end());
+        histograms.emplace_back(dataRange_, std::move(counts), util::glmcomp(min_, i),
+                                util::glmcomp(max_, i), util::glmcomp(mean, i),
+                                util::glmcomp(stddev, i));
+    }
+    return HistogramContainer{std::move(histograms)};
+}
+
+}  // namespace detail
+
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+    detail::HistogramAccumulator<T> accumulator(dataRange, bins);
+    if constexpr (std::is_pointer_v<FirstIter> && std::is_pointer_v<LastIter>) {
+        accumulator.add(static_cast<const T*>(begin), static_cast<const T*>(end));
+    } else {
+        accumulator.add(begin, end);
     }
+    *this = accumulator.getHistograms();
 }
 
 }  // namespace inviwo
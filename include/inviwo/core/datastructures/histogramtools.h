@@ -40,6 +40,7 @@
 namespace inviwo {
 
 class HistogramSupplier;
+class LayerRAM;
 
 class IVW_CORE_API HistogramCalculationState {
 public:
@@ -55,15 +56,27 @@ public:
 
     void whenDone(std::function<void(const HistogramContainer&)> callback);
 
+    /**
+     * Register a callback that is called with intermediate histograms while they are being refined,
+     * and finally with the exact histograms. For large data the intermediate histograms are
+     * calculated from subsamples of the data and are available long before the exact ones. If a
+     * result is already available the callback is called directly with the latest one.
+     */
+    void whenUpdated(std::function<void(const HistogramContainer&)> callback);
+
+    bool isDone() const { return done; }
+
     size_t getBins() const { return bins_; }
     dvec2 getDataRange() const { return dataRange_; }
 
 private:
     std::weak_ptr<HistogramContainer> container_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
+    Dispatcher<void(const HistogramContainer&)> updateCallbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
     bool done = false;
+    HistogramContainer intermediate_;
 
     size_t bins_;
     dvec2 dataRange_;
@@ -88,6 +101,8 @@ protected:
         std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const;
 
 private:
+    static void update(std::shared_ptr<HistogramCalculationState> state,
+                       HistogramContainer histograms);
     static void done(std::shared_ptr<HistogramCalculationState> state,
                      HistogramContainer histograms);
 
@@ -95,4 +110,46 @@ private:
     mutable std::shared_ptr<HistogramContainer> histograms_;
 };
 
+namespace util {
+
+/**
+ * Calculate histograms for all the components of the volume. The voxels are split into chunks that
+ * are binned concurrently on the thread pool into partial histograms, which are merged at the end.
+ * This function can also be called from within a pool thread, that thread will then run other
+ * chunks while waiting.
+ * @param volumeRam the volume to calculate histograms for
+ * @param dataRange the range of the histograms
+ * @param bins number of bins
+ * @param jobs number of chunks, if 0 (default) four times the pool size is used
+ */
+IVW_CORE_API HistogramContainer calculateHistograms(const VolumeRAM& volumeRam, dvec2 dataRange,
+                                                    size_t bins, size_t jobs = 0);
+
+/**
+ * Calculate histograms for all the components of the layer.
+ * @see calculateHistograms(const VolumeRAM&, dvec2, size_t, size_t)
+ */
+IVW_CORE_API HistogramContainer calculateHistograms(const LayerRAM& layerRam, dvec2 dataRange,
+                                                    size_t bins, size_t jobs = 0);
+
+/**
+ * Estimate histograms for all the components of the volume from every stride:th voxel. The bin
+ * counts are those of the subsample, which gives the same normalized histograms and percentiles
+ * as the full data up to sampling error.
+ * @see calculateHistograms(const VolumeRAM&, dvec2, size_t, size_t)
+ */
+IVW_CORE_API HistogramContainer calculateHistogramsStrided(const VolumeRAM& volumeRam,
+                                                           dvec2 dataRange, size_t bins,
+                                                           size_t stride);
+
+/**
+ * The strides used for the intermediate results of a progressive histogram calculation of size
+ * values of sizeOf bytes each, in decreasing order. The strides are primes to avoid aliasing with
+ * power of two dimensions. Empty if the data is small enough to calculate the exact histograms
+ * directly.
+ */
+IVW_CORE_API std::vector<size_t> progressiveHistogramStrides(size_t size, size_t sizeOf);
+
+}  // namespace util
+
 }  // namespace inviwo
@@ -46,9 +46,13 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 
+#include <mutex>
+
 namespace inviwo {
 
 class Camera;
+class VolumePyramid;
+class VolumeMinMaxOctree;
 
 /**
  * \ingroup datastructures
@@ -72,8 +76,8 @@ public:
                     InterpolationType interpolation = InterpolationType::Linear,
                     const Wrapping3D& wrapping = wrapping3d::clampAll);
     explicit Volume(std::shared_ptr<VolumeRepresentation>);
-    Volume(const Volume&) = default;
-    Volume& operator=(const Volume& that) = default;
+    Volume(const Volume& rhs);
+    Volume& operator=(const Volume& that);
     virtual Volume* clone() const override;
     virtual ~Volume();
     Document getInfo() const;
@@ -157,12 +161,40 @@ public:
 
     std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
 
+    /**
+     * Get a multiresolution pyramid of the volume. The pyramid is calculated on the first call
+     * and cached until the representations are modified (see getModificationCount()) or the
+     * dimensions change. Call discardPyramid() after modifying the VolumeRAM representation in
+     * place without getEditableRepresentation() or invalidateAllOther(). The cache is guarded
+     * by a mutex, concurrent callers wait for a single calculation and share its result.
+     * @see VolumePyramid
+     */
+    std::shared_ptr<const VolumePyramid> getPyramid() const;
+    void discardPyramid();
+
+    /**
+     * Get a min/max octree over bricks of the volume, for skipping regions that can not contain
+     * a value. The octree is calculated on the first call and cached in the same way as the
+     * pyramid, see getPyramid().
+     * @see VolumeMinMaxOctree
+     */
+    std::shared_ptr<const VolumeMinMaxOctree> getMinMaxOctree() const;
+    void discardMinMaxOctree();
+
 protected:
     size3_t defaultDimensions_;
     const DataFormatBase* defaultDataFormat_;
     SwizzleMask defaultSwizzleMask_;
     InterpolationType defaultInterpolation_;
     Wrapping3D defaultWrapping_;
+
+private:
+    mutable std::shared_ptr<const VolumePyramid> pyramid_;
+    mutable size_t pyramidModification_ = 0;
+    mutable std::mutex pyramidMutex_;
+    mutable std::shared_ptr<const VolumeMinMaxOctree> minMaxOctree_;
+    mutable size_t minMaxOctreeModification_ = 0;
+    mutable std::mutex minMaxOctreeMutex_;
 };
 
 template <typename Kind>
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief A min/max octree over bricks of a volume, used for empty-space skipping.
+ *
+ * The volume is divided into leaf bricks of brickSize^3 cells. A leaf brick covers the voxels
+ * [brick * brickSize, (brick + 1) * brickSize], i.e. neighboring bricks share their border voxels
+ * such that the range of a brick bounds all cells inside of it. Each level above the leaves
+ * combines 2x2x2 nodes of the level below, up to a single root node.
+ *
+ * Values are the data values (not normalized) of the first channel. NaN values are not included
+ * in the ranges, a brick with only NaN values has an empty range (min > max). Use containsNaN()
+ * to find the bricks with NaN values. A leaf that does not contain
+ * a value can be skipped by algorithms like iso-surface extraction:
+ * ```{.cpp}
+ * const auto octree = volume->getMinMaxOctree();
+ * for (const auto& brick : octree->findBricks(iso)) {
+ *     const auto offset = octree->getBrickOffset(brick);
+ *     const auto dims = octree->getBrickDimensions(brick);
+ *     // process the voxels [offset, offset + dims)
+ * }
+ * ```
+ * @see Volume::getMinMaxOctree()
+ */
+class IVW_CORE_API VolumeMinMaxOctree {
+public:
+    static constexpr size_t defaultBrickSize = 16;
+
+    /**
+     * Calculate the ranges of all leaf bricks, in parallel on the thread pool, and of the levels
+     * above.
+     * @param volume the volume to calculate the ranges of
+     * @param brickSize the number of cells along each axis of a leaf brick
+     */
+    explicit VolumeMinMaxOctree(const VolumeRAM& volume, size_t brickSize = defaultBrickSize);
+
+    size3_t getVolumeDimensions() const;
+    size_t getBrickSize() const;
+
+    /**
+     * The number of levels, level 0 are the leaf bricks and the last level is the root.
+     */
+    size_t getNumberOfLevels() const;
+    size3_t getLevelDimensions(size_t level) const;
+
+    size3_t getNumberOfBricks() const;
+    /**
+     * The first voxel of a leaf brick
+     */
+    size3_t getBrickOffset(const size3_t& brick) const;
+    /**
+     * The number of voxels of a leaf brick, including the border voxels shared with the next brick
+     */
+    size3_t getBrickDimensions(const size3_t& brick) const;
+    /**
+     * The leaf brick containing the cell with the lower corner at voxel pos
+     */
+    size3_t getBrick(const size3_t& pos) const;
+
+    /**
+     * The min (x) and max (y) value of a leaf brick
+     */
+    dvec2 getBrickRange(const size3_t& brick) const;
+    /**
+     * The ranges of all leaf bricks, with x varying fastest
+     */
+    const std::vector<dvec2>& getBrickRanges() const;
+    dvec2 getNodeRange(size_t level, const size3_t& node) const;
+    /**
+     * The min and max value of the whole volume
+     */
+    dvec2 getDataRange() const;
+    /**
+     * True if the leaf brick has any NaN value, those are not part of the brick range.
+     */
+    bool containsNaN(const size3_t& brick) const;
+
+    bool mayContain(const size3_t& brick, double value) const;
+    bool mayIntersect(const size3_t& brick, const dvec2& range) const;
+
+    /**
+     * Find all leaf bricks with a range that includes value, sorted with x varying fastest.
+     */
+    std::vector<size3_t> findBricks(double value) const;
+    /**
+     * Find all leaf bricks with a range that intersects the range [range.x, range.y], sorted with x
+     * varying fastest.
+     */
+    std::vector<size3_t> findBricks(const dvec2& range) const;
+
+private:
+    size_t index(size_t level, const size3_t& node) const;
+
+    size3_t dims_;
+    size_t brickSize_;
+    std::vector<size3_t> levelDims_;
+    std::vector<std::vector<dvec2>> levels_;
+    // one flag per leaf brick, not vector<bool> since bricks are written in parallel
+    std::vector<unsigned char> nanBricks_;
+};
+
+}  // namespace inviwo
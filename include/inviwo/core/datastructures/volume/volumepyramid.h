@@ -0,0 +1,90 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief A multiresolution representation of a volume.
+ *
+ * Level 0 is the full resolution volume, each following level has half the dimensions of the
+ * previous one (rounded up), where every voxel is the average of the corresponding 2x2x2 voxels
+ * of the finer level. Integer values are rounded to the nearest integer. The levels are
+ * calculated one after another, each level in parallel on the thread pool.
+ *
+ * Use getLevelForVoxelBudget() or getLevelForFootprint() to select a level, e.g. to work on a
+ * coarse level during interaction and refine afterwards.
+ * @see Volume::getPyramid()
+ */
+class IVW_CORE_API VolumePyramid {
+public:
+    /**
+     * Calculate all levels down to a level where no dimension is larger than minSize.
+     * @param volume the full resolution volume, used as level 0
+     * @param minSize the largest dimension of the coarsest level
+     */
+    explicit VolumePyramid(std::shared_ptr<const VolumeRAM> volume, size_t minSize = 1);
+
+    size_t getNumberOfLevels() const;
+    const std::shared_ptr<const VolumeRAM>& getLevel(size_t level) const;
+    size3_t getDimensions(size_t level) const;
+
+    /**
+     * The finest level that has at most maxVoxels voxels, or the coarsest level if no level is
+     * small enough.
+     */
+    size_t getLevelForVoxelBudget(size_t maxVoxels) const;
+
+    /**
+     * The finest level where one voxel covers at least one pixel, i.e. where the largest
+     * dimension is no larger than the footprint of the volume on the screen. Or the coarsest
+     * level if no level is small enough.
+     * @param pixels the extent of the volume on the screen in pixels
+     */
+    size_t getLevelForFootprint(size_t pixels) const;
+
+    /**
+     * Calculate a level of half the dimensions (rounded up) of volume, by averaging 2x2x2 voxels.
+     */
+    static std::shared_ptr<VolumeRAM> downsample(const VolumeRAM& volume);
+
+private:
+    std::vector<std::shared_ptr<const VolumeRAM>> levels_;
+};
+
+}  // namespace inviwo
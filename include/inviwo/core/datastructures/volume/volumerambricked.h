@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+#include <fstream>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * \brief A volume representation split into bricks of a fixed size that are stored on disk.
+ *
+ * Only a bounded number of bricks are kept in memory in a least recently used cache, evicted
+ * bricks are written to a temporary file if they have been modified. This makes it possible to
+ * process volumes larger than the available memory with a fixed memory budget. Each brick is a
+ * VolumeRAM, bricks at the upper borders are smaller if the dimensions of the volume are not a
+ * multiple of the brick size.
+ *
+ * Example of finding the largest value of a volume brick by brick:
+ * \code{.cpp}
+ * double max = std::numeric_limits<double>::lowest();
+ * bricked.forEachBrick([&](const VolumeRAM& brick, const size3_t& offset) {
+ *     brick.dispatch<void, dispatching::filter::Scalars>([&](auto br) {
+ *         auto data = br->getDataTyped();
+ *         auto size = glm::compMul(br->getDimensions());
+ *         max = std::max(max, static_cast<double>(*std::max_element(data, data + size)));
+ *     });
+ * });
+ * \endcode
+ *
+ * The cache is guarded by a mutex, bricks can be requested from several threads. A brick that
+ * is still referenced from outside is never evicted.
+ */
+class IVW_CORE_API VolumeRAMBricked : public VolumeRepresentation {
+public:
+    static constexpr size_t defaultCacheSize = size_t{512} * 1024 * 1024;
+
+    VolumeRAMBricked(size3_t dimensions = size3_t(128, 128, 128),
+                     const DataFormatBase* format = DataUInt8::get(),
+                     size3_t brickSize = size3_t(64, 64, 64),
+                     size_t cacheSize = defaultCacheSize,
+                     const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                     InterpolationType interpolation = InterpolationType::Linear,
+                     const Wrapping3D& wrapping = wrapping3d::clampAll);
+    VolumeRAMBricked(const VolumeRAMBricked& rhs);
+    VolumeRAMBricked& operator=(const VolumeRAMBricked& that);
+    virtual VolumeRAMBricked* clone() const override;
+    virtual ~VolumeRAMBricked();
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    /**
+     * Removes all data and resets the volume to the new dimensions.
+     */
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    size3_t getBrickSize() const;
+    size3_t getNumberOfBricks() const;
+    /**
+     * The offset of the first voxel of the brick in the volume
+     */
+    size3_t getBrickOffset(const size3_t& brick) const;
+    /**
+     * The dimensions of the brick, smaller than the brick size at the upper borders.
+     */
+    size3_t getBrickDimensions(const size3_t& brick) const;
+
+    /**
+     * The maximum number of bytes of brick data to keep in memory
+     */
+    size_t getCacheSize() const;
+    void setCacheSize(size_t bytes);
+    size_t getNumberOfCachedBytes() const;
+
+    /**
+     * Get a brick, loading it from disk if it is not in the cache. Bricks that have never been
+     * written are zero initialized.
+     */
+    std::shared_ptr<const VolumeRAM> getBrick(const size3_t& brick) const;
+    /**
+     * Get a brick for modification, the brick will be written back to disk when evicted.
+     */
+    std::shared_ptr<VolumeRAM> getEditableBrick(const size3_t& brick);
+
+    /**
+     * Visit all bricks in memory order. Only the visited brick needs to be in memory.
+     * @param callback called with each brick and the offset of its first voxel in the volume
+     */
+    void forEachBrick(
+        const std::function<void(const VolumeRAM& brick, const size3_t& offset)>& callback) const;
+    void forEachBrick(
+        const std::function<void(VolumeRAM& brick, const size3_t& offset)>& callback);
+
+    double getAsDouble(const size3_t& pos) const;
+    dvec4 getAsDVec4(const size3_t& pos) const;
+    void setFromDouble(const size3_t& pos, double val);
+    void setFromDVec4(const size3_t& pos, dvec4 val);
+
+    /**
+     * The number of bytes of all voxels, most of which are not kept in memory
+     */
+    size_t getNumberOfBytes() const;
+
+    /**
+     * Write all modified bricks in the cache to disk. Bricks that are still referenced from
+     * outside stay marked as modified and are written again when evicted.
+     */
+    void flush() const;
+
+private:
+    struct CachedBrick {
+        size_t index;
+        std::shared_ptr<VolumeRAM> data;
+        bool modified;
+    };
+
+    void copyBricks(const VolumeRAMBricked& src);
+    size_t brickIndex(const size3_t& brick) const;
+    std::shared_ptr<VolumeRAM> load(const size3_t& brick, bool modify) const;
+    void evict() const;
+    void write(size_t index, const VolumeRAM& brick) const;
+    void read(size_t index, VolumeRAM& brick) const;
+    void reset();
+
+    size3_t dimensions_;
+    size3_t brickSize_;
+    size3_t numBricks_;
+    size_t cacheSize_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+
+    mutable std::mutex mutex_;
+    // Most recently used first
+    mutable std::list<CachedBrick> cache_;
+    mutable std::unordered_map<size_t, std::list<CachedBrick>::iterator> cacheIndex_;
+    mutable size_t cachedBytes_;
+    // Which bricks have been written to the file
+    mutable std::vector<bool> stored_;
+    mutable std::string file_;
+    mutable std::fstream stream_;
+};
+
+}  // namespace inviwo
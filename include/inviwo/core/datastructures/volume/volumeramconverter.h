@@ -35,6 +35,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumerambricked.h>
 
 namespace inviwo {
 
@@ -47,6 +48,38 @@ public:
                         std::shared_ptr<VolumeRAM> destination) const override;
 };
 
+/**
+ * Creates a VolumeRAMBricked from a VolumeDisk without keeping a VolumeRAM representation around.
+ * If the loader is a VolumeRegionLoader each brick is read from the file on its own, and the whole
+ * volume is never in memory at once. Otherwise the volume is read into a temporary VolumeRAM.
+ */
+class IVW_CORE_API VolumeDisk2RAMBrickedConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeDisk, VolumeRAMBricked> {
+public:
+    virtual std::shared_ptr<VolumeRAMBricked> createFrom(
+        std::shared_ptr<const VolumeDisk> source) const override;
+    virtual void update(std::shared_ptr<const VolumeDisk> source,
+                        std::shared_ptr<VolumeRAMBricked> destination) const override;
+};
+
+class IVW_CORE_API VolumeRAM2RAMBrickedConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeRAM, VolumeRAMBricked> {
+public:
+    virtual std::shared_ptr<VolumeRAMBricked> createFrom(
+        std::shared_ptr<const VolumeRAM> source) const override;
+    virtual void update(std::shared_ptr<const VolumeRAM> source,
+                        std::shared_ptr<VolumeRAMBricked> destination) const override;
+};
+
+class IVW_CORE_API VolumeRAMBricked2RAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeRAMBricked, VolumeRAM> {
+public:
+    virtual std::shared_ptr<VolumeRAM> createFrom(
+        std::shared_ptr<const VolumeRAMBricked> source) const override;
+    virtual void update(std::shared_ptr<const VolumeRAMBricked> source,
+                        std::shared_ptr<VolumeRAM> destination) const override;
+};
+
 }  // namespace inviwo
 
 #endif  // IVW_VOLUMERAMCONVERTER_H
@@ -39,6 +39,15 @@ namespace util {
 
 void IVW_CORE_API readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
                                       bool littleEndian, size_t elementSize, void* dest);
+
+/**
+ * Read a box of a raw volume of dimensions dims stored at offset in file into dest, row by row.
+ * The box starts at regionOffset and has extent voxels, dest has to hold all of them.
+ * @throws DataReaderException if the file can not be opened or is too short
+ */
+void IVW_CORE_API readRegionIntoBuffer(const std::string& file, size_t offset, size3_t dims,
+                                       size3_t regionOffset, size3_t extent, bool littleEndian,
+                                       size_t elementSize, void* dest);
 }  // namespace util
 
 }  // namespace inviwo
@@ -60,6 +60,13 @@ public:
     const std::vector<FileExtension>& getExtensions() const;
     void addExtension(FileExtension ext);
 
+    /**
+     * Whether the reader can be used from a thread in the thread pool. Readers that need user
+     * interaction, like the RawVolumeReader, should return false.
+     * @see Preloadable
+     */
+    virtual bool isThreadSafe() const { return true; }
+
 private:
     std::vector<FileExtension> extensions_;
 };
@@ -36,6 +36,9 @@
 #include <inviwo/core/io/datawriter.h>
 #include <inviwo/core/util/fileextension.h>
 
+#include <utility>
+#include <vector>
+
 namespace inviwo {
 
 template <typename T>
@@ -59,6 +62,10 @@ public:
     template <typename T>
     std::vector<FileExtension> getExtensionsForType();
 
+    /**
+     * Find a writer for the extension string ext, ignoring case. If several writers of type T
+     * use the same extension, the one registered first is returned.
+     */
     template <typename T>
     std::unique_ptr<DataWriterType<T>> getWriterForTypeAndExtension(const std::string& ext);
 
@@ -78,13 +85,16 @@ public:
 
 protected:
     Map map_;
+    // The registered extensions in registration order, used by the lookups by extension string
+    // to get a deterministic writer when several writers use the same extension.
+    std::vector<std::pair<FileExtension, DataWriter*>> ordered_;
 };
 
 template <typename T>
 std::vector<FileExtension> DataWriterFactory::getExtensionsForType() {
     std::vector<FileExtension> ext;
 
-    for (auto& writer : map_) {
+    for (auto& writer : ordered_) {
         if (auto r = dynamic_cast<DataWriterType<T>*>(writer.second)) {
             ext.push_back(writer.first);
         }
@@ -96,7 +106,7 @@ template <typename T>
 std::unique_ptr<DataWriterType<T>> DataWriterFactory::getWriterForTypeAndExtension(
     const std::string& ext) {
     auto lkey = toLower(ext);
-    for (auto& elem : map_) {
+    for (auto& elem : ordered_) {
         if (toLower(elem.first.extension_) == lkey) {
             if (auto r = dynamic_cast<DataWriterType<T>*>(elem.second)) {
                 return std::unique_ptr<DataWriterType<T>>(r->clone());
@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/io/bytereaderutil.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/volumeregionloader.h>
 #include <inviwo/core/datastructures/diskrepresentation.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
 
@@ -43,21 +44,38 @@ namespace inviwo {
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ * With useMemoryMapping, data that does not need byte swapping is memory mapped instead of read.
+ * The voxels are then read from disk on demand when accessed, and only modified pages are copied
+ * into memory. The file must then not be truncated while the representation is in use, accessing
+ * a page beyond the end of the file terminates the process. Memory mapping is therefore off by
+ * default, the readers enable it with the memoryMapRawVolumes_ system setting.
+ * Parts of the volume can be read on their own, see VolumeRegionLoader.
  */
 
-class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation>,
+                                        public VolumeRegionLoader {
 public:
-    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian);
+    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                       bool useMemoryMapping = false);
     virtual RawVolumeRAMLoader* clone() const override;
+
+    /**
+     * The memoryMapRawVolumes_ system setting, false if there is no application.
+     */
+    static bool isMemoryMappingEnabled();
+
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
         const VolumeRepresentation& src) const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
+    virtual void readRegion(const VolumeRepresentation& src, const size3_t& offset,
+                            VolumeRAM& dest) const override;
 
 private:
     std::string rawFile_;
     size_t offset_;
     bool littleEndian_;
+    bool useMemoryMapping_;
 };
 
 }  // namespace inviwo
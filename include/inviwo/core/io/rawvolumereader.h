@@ -60,6 +60,11 @@ public:
     virtual std::shared_ptr<Volume> readData(const std::string& filePath,
                                              MetaDataOwner* metadata) override;
 
+    /**
+     * Without parameters set the reader will ask for them using a dialog
+     */
+    virtual bool isThreadSafe() const override { return parametersSet_; }
+
     bool haveReadLittleEndian() const { return littleEndian_; }
     const DataFormatBase* getFormat() const { return format_; }
 
@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Storage format used when writing a Serializer, see Serializer::writeFile. The Deserializer
+ * detects the format automatically.
+ */
+enum class SerializationFormat { Xml, Binary };
+
+namespace binaryformat {
+
+using Blob = std::vector<unsigned char>;
+
+/**
+ * The binary format is a chunked container for the same element tree that is written as xml.
+ * After an eight byte signature and a format version follows a sequence of chunks, each with a
+ * four character tag and a 64 bit payload size:
+ *  - `STRS` a table of all element names and attribute keys,
+ *  - `TREE` the element tree, names and keys are indices into the string table and attribute
+ *    values are stored as length prefixed raw strings, without any escaping,
+ *  - `BLOB` one chunk per blob added with Serializer::serializeBlob, in order,
+ *  - `END ` marks the end of the document.
+ * All integers are little endian, counts and lengths inside chunks are LEB128 encoded. Chunks
+ * with unknown tags are skipped when reading.
+ */
+constexpr std::uint32_t version = 1;
+
+/**
+ * Check whether the stream starts with the binary signature. The stream position is not changed.
+ */
+IVW_CORE_API bool isBinary(std::istream& stream);
+
+/**
+ * Write all nodes of the document, except the xml declaration, together with the blobs to the
+ * stream.
+ * @throws SerializationException if the stream could not be written.
+ */
+IVW_CORE_API void write(std::ostream& stream, const TxDocument& doc,
+                        const std::vector<Blob>& blobs);
+
+/**
+ * Read a document written by binaryformat::write into doc and blobs. An xml declaration is
+ * added to the document so it matches a document parsed from xml. Chunk sizes are checked
+ * against the remaining length of the stream before anything is allocated.
+ * @throws SerializationException if the stream does not contain a valid binary document, or is
+ *      truncated.
+ */
+IVW_CORE_API void read(std::istream& stream, TxDocument& doc, std::vector<Blob>& blobs);
+
+IVW_CORE_API std::string toBase64(const unsigned char* data, size_t size);
+
+/**
+ * @throws SerializationException if str contains characters outside of the base64 alphabet.
+ */
+IVW_CORE_API Blob fromBase64(const std::string& str);
+
+}  // namespace binaryformat
+
+}  // namespace inviwo
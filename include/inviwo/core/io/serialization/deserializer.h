@@ -39,6 +39,7 @@
 
 #include <flags/flags.h>
 
+#include <cstring>
 #include <type_traits>
 #include <list>
 #include <istream>
@@ -60,7 +61,8 @@ public:
     /**
      * \brief Deserializer constructor
      *
-     * @param fileName path to file that is to be deserialized.
+     * @param fileName path to file that is to be deserialized, either xml or the binary format
+     *      written by Serializer::writeBinaryFile.
      * @param allowReference flag to manage references to avoid multiple object creation.
      */
     Deserializer(std::string fileName, bool allowReference = true);
@@ -233,6 +235,19 @@ public:
      * \brief  Deserialize any Serializable object
      */
     void deserialize(const std::string& key, Serializable& sObj);
+
+    /**
+     * \brief Deserialize a blob written by Serializer::serializeBlob, works for both the xml and
+     * the binary format.
+     */
+    void deserializeBlob(const std::string& key, binaryformat::Blob& blob);
+
+    /**
+     * \brief Deserialize a vector of trivially copyable values written by
+     * Serializer::serializeBlob.
+     */
+    template <typename T>
+    void deserializeBlob(const std::string& key, std::vector<T>& data);
     /**
      * \brief  Deserialize pointer data of type T, which is of type
      *         serializable object or primitive data
@@ -745,6 +760,20 @@ void Deserializer::deserialize(const std::string& key, Mat& data) {
     }
 }
 
+template <typename T>
+void Deserializer::deserializeBlob(const std::string& key, std::vector<T>& data) {
+    static_assert(std::is_trivially_copyable<T>::value, "Blob data has to be trivially copyable");
+    binaryformat::Blob blob;
+    deserializeBlob(key, blob);
+    if (blob.size() % sizeof(T) != 0) {
+        throw SerializationException(
+            "Blob size " + toString(blob.size()) + " is not a multiple of the element size",
+            IVW_CONTEXT, key);
+    }
+    data.resize(blob.size() / sizeof(T));
+    if (!blob.empty()) std::memcpy(data.data(), blob.data(), blob.size());
+}
+
 template <unsigned N>
 void Deserializer::deserialize(const std::string& key, std::bitset<N>& bits) {
     std::string value = bits.to_string();
@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/io/serialization/serializeconstants.h>
 #include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/binaryformat.h>
 #include <inviwo/core/util/factory.h>
 #include <map>
 
@@ -102,7 +103,8 @@ public:
      * and de-serializer. Some of them are reference data manager,
      * (ticpp::Node) node switch and factory registration.
      *
-     * @param stream containing all xml data (for reading).
+     * @param stream containing all xml or binary data (for reading), the format is detected
+     * automatically, see binaryformat::isBinary.
      * @param path A path that will be used to decode the location of data during deserialization.
      * @param allowReference disables or enables reference management schemes.
      */
@@ -171,6 +173,7 @@ protected:
     bool allowRef_;
     bool retrieveChild_;
     ReferenceDataContainer refDataContainer_;
+    std::vector<binaryformat::Blob> blobs_;
 };
 
 class IVW_CORE_API NodeSwitch {
@@ -78,6 +78,24 @@ public:
      * @throws SerializationException
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
+    /**
+     * \brief Writes serialized data to stream using the binary format, see binaryformat::write.
+     * Blobs are stored as raw bytes instead of base64 encoded strings.
+     *
+     * @param stream Stream to be written to, should be opened in binary mode.
+     * @throws SerializationException
+     */
+    virtual void writeBinaryFile(std::ostream& stream);
+
+    /**
+     * \brief Writes serialized data using the given format to stream.
+     *
+     * @param stream Stream to be written to.
+     * @param format SerializationFormat::Xml writes formatted xml, SerializationFormat::Binary
+     *      calls writeBinaryFile.
+     * @throws SerializationException
+     */
+    void writeFile(std::ostream& stream, SerializationFormat format);
 
     // std containers
     template <typename T>
@@ -145,6 +163,21 @@ public:
     // serializable classes
     void serialize(const std::string& key, const Serializable& sObj);
 
+    /**
+     * \brief Serialize a block of raw bytes.
+     * In the binary format the bytes are stored unmodified in a separate chunk, in xml they are
+     * stored base64 encoded in the content attribute.
+     * Read back using Deserializer::deserializeBlob.
+     */
+    void serializeBlob(const std::string& key, binaryformat::Blob blob);
+
+    /**
+     * \brief Serialize a vector of trivially copyable values as a blob of raw bytes, see
+     * serializeBlob(const std::string&, binaryformat::Blob).
+     */
+    template <typename T>
+    void serializeBlob(const std::string& key, const std::vector<T>& data);
+
     // pointers to something of the above.
     template <class T>
     void serialize(const std::string& key, const T* const& data);
@@ -155,8 +188,20 @@ public:
 
 protected:
     friend class NodeSwitch;
+
+private:
+    void prepareBlobs(SerializationFormat format);
+
+    std::vector<TxElement> blobNodes_;  // Keeps the nodes alive, blobs are stored in blobs_
 };
 
+template <typename T>
+void Serializer::serializeBlob(const std::string& key, const std::vector<T>& data) {
+    static_assert(std::is_trivially_copyable<T>::value, "Blob data has to be trivially copyable");
+    const auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+    serializeBlob(key, binaryformat::Blob(bytes, bytes + data.size() * sizeof(T)));
+}
+
 template <typename T>
 void Serializer::serialize(const std::string& key, const std::vector<T>& vector,
                            const std::string& itemKey) {
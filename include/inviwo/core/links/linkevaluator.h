@@ -36,6 +36,8 @@
 #include <inviwo/core/links/propertylink.h>
 
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
 
 namespace inviwo {
 
@@ -70,6 +72,18 @@ public:
     void removeLink(const PropertyLink& propertyLink);
     bool isLinking() const;
 
+    /**
+     * Start a batch of link evaluations. While a batch is active evaluateLinksFromProperty only
+     * records the modified property, repeated modifications of the same property are coalesced.
+     * The links of the recorded properties are evaluated when the outermost batch ends, in the
+     * order of their last modification. A recorded property that is itself updated by the links
+     * of a later recorded property is skipped, since its changes would be overwritten anyway.
+     * Batches can be nested. Prefer the RAII helper LinkBatch over calling these directly.
+     */
+    void beginBatch();
+    void endBatch();
+    bool isBatching() const;
+
 private:
     struct Link {
         Link(Property* src, Property* dst, const PropertyConverter* converter)
@@ -79,43 +93,43 @@ private:
         const PropertyConverter* converter_;
     };
 
-    // Cache helpers
-    std::vector<Link>& addToSecondaryCache(Property* property);
-    void secondaryCacheHelper(std::vector<Link>& links, Property* src, Property* dst);
-    std::vector<Link>& getTriggerdLinksForProperty(Property* property);
+    /**
+     * A flat list of ALL the links, direct and indirect, that are triggered by a modification of
+     * a source property, in evaluation order. Members holds all the properties involved, sorted,
+     * and is used to make sure we don't end up in circular links.
+     */
+    struct Plan {
+        std::vector<Link> links;
+        std::vector<Property*> members;
+        bool involves(Property* property) const;
+    };
+
+    // Plan helpers
+    void compile();
+    void compileHelper(std::vector<Link>& links, std::unordered_set<Property*>& members,
+                       Property* src, Property* dst);
+    void compileOutgoing(std::vector<Link>& links, std::unordered_set<Property*>& members,
+                         Property* src);
+    std::shared_ptr<const Plan> getPlan(Property* property);
 
     ProcessorNetwork* network_;
 
     // The primary link cache is a map with all source properties and a vector of properties that
     // they link directly to
     std::unordered_map<Property*, std::vector<Property*>> propertyLinkPrimaryCache_;
-    // The secondary link cache is a map with all source properties and a vector of ALL the
-    // properties that they link to. Directly or indirectly.
-    std::unordered_map<Property*, std::vector<Link>> propertyLinkSecondaryCache_;
+    // The compiled plans of all source properties. Rebuilt from the primary cache on the first
+    // evaluation after the links have changed.
+    std::unordered_map<Property*, std::shared_ptr<const Plan>> plans_;
+    bool plansDirty_ = false;
     // A cache of all links between two processors.
     ProcessorLinkMap processorLinksCache_;
 
-    // Used to make sure we don't end up in circular links
-    std::vector<Property*> visited_;
-    struct VisitedHelper {
-        VisitedHelper(std::vector<Property*>& visited, std::vector<Link>& toVisit)
-            : visited_(visited), toVisit_(toVisit) {
-            for (auto& link : toVisit_) {
-                util::push_back_unique(visited_, link.src_);
-                util::push_back_unique(visited_, link.dst_);
-            }
-        }
-        ~VisitedHelper() {
-            for (auto& link : toVisit_) {
-                util::erase_remove(visited_, link.src_);
-                util::erase_remove(visited_, link.dst_);
-            }
-        }
-
-    private:
-        std::vector<Property*>& visited_;
-        std::vector<Link>& toVisit_;
-    };
+    // The plans currently being evaluated. Held by shared_ptr since links might change while
+    // evaluating.
+    std::vector<std::shared_ptr<const Plan>> active_;
+
+    size_t batchDepth_ = 0;
+    std::vector<Property*> pending_;
 };
 
 }  // namespace inviwo
@@ -69,6 +69,42 @@ inline NetworkLock::~NetworkLock() {
     if (network_) network_->unlock();
 }
 
+/**
+ * A RAII utility that locks the network and defers the evaluation of property links until it goes
+ * out of scope. Repeated modifications of a linked property within the scope, like when setting
+ * the components of a camera one by one, are then only propagated once.
+ * The links are evaluated before the network is unlocked.
+ * @see LinkEvaluator::beginBatch
+ */
+struct IVW_CORE_API LinkBatch {
+    LinkBatch(ProcessorNetwork* network);
+    LinkBatch(Processor* processor);
+    LinkBatch(Property* property);
+    ~LinkBatch();
+
+    LinkBatch(LinkBatch const&) = delete;
+    LinkBatch& operator=(LinkBatch const& that) = delete;
+
+private:
+    NetworkLock lock_;
+    ProcessorNetwork* network_;
+};
+
+inline LinkBatch::LinkBatch(ProcessorNetwork* network) : lock_(network), network_(network) {
+    if (network_) network_->beginLinkBatch();
+}
+
+inline LinkBatch::LinkBatch(Processor* processor)
+    : LinkBatch(processor ? processor->getNetwork() : nullptr) {}
+
+inline LinkBatch::LinkBatch(Property* property)
+    : LinkBatch(property ? (property->getOwner() ? property->getOwner()->getProcessor() : nullptr)
+                         : nullptr) {}
+
+inline LinkBatch::~LinkBatch() {
+    if (network_) network_->endLinkBatch();
+}
+
 }  // namespace inviwo
 
 #endif  // IVW_NETWORKLOCK_H
@@ -43,6 +43,10 @@
 #include <inviwo/core/util/observer.h>
 #include <inviwo/core/util/exception.h>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace inviwo {
 
 class InviwoApplication;
@@ -234,6 +238,13 @@ public:
 
     void evaluateLinksFromProperty(Property*);
 
+    /**
+     * Defer and coalesce the evaluation of property links until the matching endLinkBatch, see
+     * LinkEvaluator::beginBatch. Prefer the RAII helper LinkBatch over calling these directly.
+     */
+    void beginLinkBatch();
+    void endLinkBatch();
+
     bool isEmpty() const;
     bool isInvalidating() const;
     bool isLinking() const;
@@ -286,7 +297,15 @@ private:
     PropertyLinks links_;
 
     LinkEvaluator linkEvaluator_;
+
+    // Processors processed on the thread pool during a parallel evaluation might invalidate
+    // themselves, hence the invalidation callbacks can come from any thread. The evaluate request
+    // of an invalidation that ends outside of the main thread is deferred until the network is
+    // unlocked, which a parallel evaluation does in the main thread once all jobs are done.
+    mutable std::mutex invalidatingMutex_;
     std::vector<Processor*> processorsInvalidating_;
+    std::thread::id mainThread_;
+    std::atomic<bool> deferredEvaluateRequest_{false};
 };
 
 template <class T>
@@ -317,7 +336,12 @@ void ProcessorNetwork::forEachLink(C callback) {
 inline void ProcessorNetwork::lock() { locked_++; }
 inline void ProcessorNetwork::unlock() {
     (locked_ > 0) ? locked_-- : locked_ = 0;
-    if (locked_ == 0) notifyObserversProcessorNetworkUnlocked();
+    if (locked_ == 0) {
+        if (deferredEvaluateRequest_.exchange(false)) {
+            notifyObserversProcessorNetworkEvaluateRequest();
+        }
+        notifyObserversProcessorNetworkUnlocked();
+    }
 }
 inline bool ProcessorNetwork::islocked() const { return (locked_ != 0); }
 
@@ -36,6 +36,11 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/util/topologicalorder.h>
+
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -52,6 +57,18 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * Enable or disable parallel evaluation. In parallel mode processors that do not depend on
+     * each other are processed concurrently. Only processors that opt in with
+     * Processor::isThreadSafe(), have the CPU platform tag and no other platform tags (GL, CL,
+     * PY), and already have data in all their outports are processed on the thread pool, all
+     * other processors are processed in the calling thread. Resource initialization, port
+     * onChange callbacks and observer notifications are always done in the calling thread, in
+     * topological order. Disabled by default.
+     */
+    void setParallelEvaluation(bool enable);
+    bool getParallelEvaluation() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -62,16 +79,53 @@ private:
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
 
     // ProcessorObserver overrides
+    virtual void onProcessorInvalidationBegin(Processor*) override;
+    virtual void onProcessorInvalidationEnd(Processor*) override;
     virtual void onProcessorSinkChanged(Processor*) override;
     virtual void onProcessorActiveConnectionsChanged(Processor*) override;
 
     void requestEvaluate();
     void evaluate();
+    void evaluateParallel();
+
+    /**
+     * Initialize resources and call port onChange callbacks.
+     * @return true if the processor should be processed.
+     */
+    bool prepare(Processor* processor);
+    /**
+     * Set the processor valid, if still ready, and notify observers that it has processed.
+     */
+    void finish(Processor* processor);
+    bool canProcessConcurrently(Processor* processor) const;
+
+    /**
+     * The invalid processors that have a path of active connections to a sink, in topological
+     * order.
+     */
+    std::vector<Processor*> getProcessorsToEvaluate();
+    /**
+     * Returns true if the processor is a sink or has a path of active connections to a sink.
+     * The result is cached until the connections of the processor or its successors change.
+     */
+    bool reachesSink(Processor* processor);
+    void invalidateReachesSink(Processor* processor);
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
-    std::vector<Processor*> processorsSorted_;
+    // the processors in topological order, updated incrementally as the network changes
+    util::TopologicalOrder<Processor*> topology_;
+    // the processors that have been invalidated since they were last evaluated. Processors
+    // processed on the thread pool during a parallel evaluation might invalidate themselves, hence
+    // the invalidation callbacks can come from any thread and dirty_ is guarded by dirtyMutex_.
+    std::unordered_set<Processor*> dirty_;
+    std::mutex dirtyMutex_;
+    std::unordered_map<Processor*, bool> reachesSink_;
+    // processors queued during a serial evaluation, as a min heap on topological position
+    std::vector<Processor*> queue_;
+    bool evaluating_;
+    size_t evaluationPosition_;
     bool evaulationQueued_;
+    bool parallelEvaluation_;
     EvaluationErrorHandler exceptionHandler_;
 };
 
@@ -34,9 +34,11 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/util/dispatcher.h>
 #include <inviwo/core/util/exception.h>
+#include <inviwo/core/io/serialization/binaryformat.h>
 
 #include <flags/flags.h>
 
+#include <chrono>
 #include <iostream>
 
 namespace inviwo {
@@ -89,23 +91,32 @@ public:
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format xml or the binary format, see binaryformat::write. The stream should be opened
+     *      in binary mode for the binary format.
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
      * Save the current workspace to a file
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format xml or the binary format, see binaryformat::write.
      */
     void save(const std::string& path,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
-     * Load a workspace from a stream
+     * Load a workspace from a stream. Both the xml and the binary format are supported, the format
+     * is detected from the first byte of the stream.
+     * The network is deserialized while locked. Afterwards the data of all Preloadable processors
+     * is read concurrently on the thread pool, and the network is evaluated as the data arrives.
+     * Without a thread pool the data is read during the first evaluation instead.
      * \param stream the stream to read from.
      * \param refPath a reference that that can be use by the deserializer to calculate relative
      *      paths. The same refPath should be given when loading. Most often this should be the
@@ -116,13 +127,29 @@ public:
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler());
 
     /**
-     * Load a workspace from a file
+     * Load a workspace from a file, in either xml or binary format.
      * \param path the file to read from.
      * \param exceptionHandler A callback for handling errors.
      */
     void load(const std::string& path,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler());
 
+    struct LoadTime {
+        std::string processor;
+        std::chrono::duration<double> time;
+    };
+
+    /**
+     * The time spent reading data in the background for each Preloadable processor of the last
+     * loaded workspace. Entries are added on the main thread as the jobs finish.
+     */
+    const std::vector<LoadTime>& getLoadTimes() const;
+
+    /**
+     * Is data of the last loaded workspace still being read in the background.
+     */
+    bool isPreloading() const;
+
     /**
      * Callback for clearing the workspace.
      */
@@ -151,12 +178,18 @@ public:
                                              Logger* logger = LogCentral::getPtr()) const;
 
 private:
+    struct PreloadState;
+    void preload(const std::string& refPath);
+
     InviwoApplication* app_;
     std::vector<FactoryBase*> registeredFactories_;
 
     ClearDispatcher clears_;
     SerializationDispatcher serializers_;
     DeserializationDispatcher deserializers_;
+
+    std::shared_ptr<PreloadState> preloadState_;
+    std::vector<LoadTime> loadTimes_;
 };
 
 }  // namespace inviwo
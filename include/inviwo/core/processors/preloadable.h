@@ -0,0 +1,137 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace inviwo {
+
+/**
+ * \ingroup processors
+ * Interface for source processors that read data from disk. When a workspace is loaded the
+ * WorkspaceManager first deserializes the whole network, then collects the jobs of all Preloadable
+ * processors and runs them concurrently on the thread pool. The network is evaluated as the data
+ * arrives, instead of reading one file after the other during the first evaluation.
+ * @see WorkspaceManager::load
+ */
+class IVW_CORE_API Preloadable {
+public:
+    /**
+     * Called on the main thread to hand the read data over to the processor.
+     */
+    using Apply = std::function<void()>;
+    /**
+     * Executed on a thread in the thread pool, should not throw.
+     */
+    using Job = std::function<Apply()>;
+
+    virtual ~Preloadable() = default;
+
+    /**
+     * Called on the main thread after the workspace has been deserialized, while the network is
+     * locked. Return a job that reads the data, or an empty Job if there is nothing to read. The
+     * job may only use state captured by value. The processor should stay not ready until the
+     * returned Apply has been called, see util::PreloadedData.
+     *
+     * The Apply is called for every job that did not throw as long as the processor still exists,
+     * also when the workspace has been loaded again in the meantime. In that case the processor
+     * might already have handed out a newer job, and the Apply of the old one should not touch
+     * its state.
+     */
+    virtual Job preload() = 0;
+};
+
+namespace util {
+
+/**
+ * Keeps data read in the background by a Preloadable processor until the next call to process().
+ * Each job gets its own token, only the Apply of the latest job stores its data, and the data is
+ * only considered pending as long as that job or its Apply exists. Hence a job that is discarded
+ * without being applied does not leave the processor waiting for it.
+ */
+template <typename DataType>
+class PreloadedData {
+public:
+    /**
+     * Create a job that calls read, read should return the data of file as a
+     * std::shared_ptr<DataType>. When the job is applied the data is stored and done is called.
+     * Any earlier job is superseded.
+     */
+    template <typename Read>
+    Preloadable::Job makeJob(const std::string& file, Read read, std::function<void()> done) {
+        auto token = std::make_shared<Token>();
+        pending_ = token;
+        file_ = file;
+        data_.reset();
+        return [this, token, read, done]() -> Preloadable::Apply {
+            std::shared_ptr<DataType> data;
+            try {
+                data = read();
+            } catch (...) {
+                // Errors are reported by the regular read in process() instead
+            }
+            return [this, token, data, done]() {
+                if (pending_.lock() != token) return;  // superseded by a later job
+                pending_.reset();
+                data_ = data;
+                done();
+            };
+        };
+    }
+
+    /**
+     * Returns the preloaded data if it was read from file, otherwise nullptr. The data is only
+     * returned once.
+     */
+    std::shared_ptr<DataType> take(const std::string& file) {
+        auto data = std::move(data_);
+        data_.reset();
+        return file == file_ ? data : nullptr;
+    }
+
+    /**
+     * True while the latest job has neither been applied nor discarded.
+     */
+    bool isPending() const { return !pending_.expired(); }
+
+private:
+    struct Token {};
+    std::weak_ptr<Token> pending_;
+    std::string file_;
+    std::shared_ptr<DataType> data_;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -379,6 +379,14 @@ public:
      */
     virtual bool isConnectionActive(Inport*, Outport*) const { return true; }
 
+    /**
+     * Return true if process() may be called on the thread pool when the network is evaluated in
+     * parallel, see ProcessorNetworkEvaluator::setParallelEvaluation. Only processors that do
+     * nothing but set data in their outports in process() should opt in, i.e. that do not modify
+     * properties, ports, meta data or the network. Defaults to false.
+     */
+    virtual bool isThreadSafe() const { return false; }
+
 protected:
     std::unique_ptr<ProcessorWidget> processorWidget_;
     StateCoordinator<bool> isReady_;
@@ -137,8 +137,9 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     const auto futures =
         forEachParallelAsync<Iterable, Callback>(iterable, std::forward<Callback>(callback), jobs);
 
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
     for (const auto& e : futures) {
-        e.wait();
+        pool.wait(e);
     }
 }
 
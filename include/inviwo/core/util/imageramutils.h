@@ -84,8 +84,9 @@ void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
         }));
     }
 
+    auto &pool = InviwoApplication::getPtr()->getThreadPool();
     for (const auto &e : futures) {
-        e.wait();
+        pool.wait(e);
     }
 }
 
@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <string>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \class MemoryMappedFile
+ * \brief RAII class for a read only, copy-on-write memory mapping of a region of a file.
+ * The pages of the region are read from the file on demand when first accessed and are shared
+ * with other processes mapping the same file. Writing to the mapped memory is allowed, the
+ * written pages are then privately copied and never written back to the file.
+ */
+class IVW_CORE_API MemoryMappedFile {
+public:
+    /**
+     * Map bytes bytes starting at offset of file.
+     * @throw FileException if the file can not be opened, is too small or can not be mapped.
+     */
+    MemoryMappedFile(const std::string& file, size_t offset, size_t bytes);
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& rhs) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& rhs) noexcept;
+
+    ~MemoryMappedFile();
+
+    /**
+     * Pointer to the first byte of the requested region
+     */
+    void* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void unmap();
+
+    void* mapping_ = nullptr;  // start of the page aligned mapping
+    size_t mappingSize_ = 0;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
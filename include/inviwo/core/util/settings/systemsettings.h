@@ -52,6 +52,7 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    BoolProperty parallelEvaluation_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -63,6 +64,8 @@ public:
     TemplateOptionProperty<MessageBreakLevel> breakOnMessage_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
+    BoolProperty binaryWorkspaces_;
+    BoolProperty memoryMapRawVolumes_;
 
     BoolProperty redirectCout_;
     BoolProperty redirectCerr_;
@@ -69,6 +69,11 @@ public:
 
     const SpatialCoordinateTransformer<SpatialDims> &getCoordinateTransformer() const;
 
+    /**
+     * The coordinate space of positions passed to sample(pos) and withinBounds(pos)
+     */
+    Space getSpace() const;
+
 protected:
     virtual Vector<DataDims, T> sampleDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
     virtual bool withinBoundsDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
@@ -180,6 +185,11 @@ const SpatialCoordinateTransformer<SpatialDims>
     return spatialEntity_.getCoordinateTransformer();
 }
 
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+auto SpatialSampler<SpatialDims, DataDims, T>::getSpace() const -> Space {
+    return space_;
+}
+
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
 Matrix<SpatialDims + 1, float> SpatialSampler<SpatialDims, DataDims, T>::getWorldMatrix() const {
     return spatialEntity_.getWorldMatrix();
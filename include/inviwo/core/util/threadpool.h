@@ -62,21 +62,75 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <tuple>
+#include <type_traits>
+#include <chrono>
+#include <cstddef>
 #include <warn/pop>
 
 namespace inviwo {
 
+/**
+ * A work stealing thread pool. Every worker has its own task queue. Tasks enqueued from within a
+ * worker thread are pushed onto that worker's queue, other tasks are distributed over the workers
+ * in a round robin fashion. A worker will pick tasks from the back of its own queue and, when that
+ * is empty, steal tasks from the front of the other workers' queues. Idle workers sleep until new
+ * tasks arrive.
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    /**
+     * A type erased, move only, `void()` callable. Callables small enough to fit into the internal
+     * buffer, like a std::packaged_task or a std::function, are stored inline without any heap
+     * allocation.
+     */
+    class IVW_CORE_API Task {
+    public:
+        static constexpr size_t bufferSize = 6 * sizeof(void*);
+
+        Task() noexcept = default;
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f);
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task(Task&& rhs) noexcept;
+        Task& operator=(Task&& rhs) noexcept;
+        ~Task();
+
+        void operator()();
+        explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+    private:
+        struct VTable {
+            void (*invoke)(void* storage);
+            void (*move)(void* dst, void* src) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename F>
+        static constexpr bool fitsInline =
+            sizeof(F) <= bufferSize && alignof(std::max_align_t) % alignof(F) == 0 &&
+            std::is_nothrow_move_constructible_v<F>;
+
+        template <typename F>
+        static const VTable* inlineVTable();
+        template <typename F>
+        static const VTable* heapVTable();
+
+        alignas(std::max_align_t) std::byte storage_[bufferSize];
+        const VTable* vtable_ = nullptr;
+    };
+
     ThreadPool(size_t threads, std::function<void()> onThreadStart = []() {},
                std::function<void()> onThreadStop = []() {});
     ~ThreadPool();
@@ -93,6 +147,25 @@ public:
      */
     void enqueueRaw(std::function<void()> f);
 
+    /**
+     * Enqueue a task. The task may not throw exceptions.
+     */
+    void enqueueTask(Task task);
+
+    /**
+     * Wait for the future to become ready. When called from one of the worker threads of this
+     * pool the calling worker will run other queued tasks while waiting. Hence it is safe to
+     * enqueue a task and wait for it from within another task, even if all workers are busy.
+     * When called from any other thread this is equivalent to future.wait().
+     */
+    template <typename Future>
+    void wait(const Future& future);
+
+    /**
+     * Returns true if the calling thread is one of the worker threads of this pool.
+     */
+    bool isWorkerThread() const;
+
     size_t trySetSize(size_t size);
     size_t getSize() const;
 
@@ -116,16 +189,31 @@ private:
         ~Worker();
 
         std::atomic<State> state;  //< State of the worker
+        ThreadPool& pool;
+        std::mutex queueMutex;
+        std::deque<Task> queue;  //< The worker's own tasks, guarded by queueMutex
         std::thread thread;
     };
-    // need to keep track of threads so we can join them
+
+    static Worker*& currentWorker();
+    void push(Worker& worker, Task&& task);
+    Task pop(Worker& worker);
+    Task steal(const Worker& thief);
+    Task findTask(Worker& worker);
+    bool runPendingTask();
+    void sleep(Worker& worker);
+    void notify(bool all);
+
+    // need to keep track of threads so we can join them, and find queues to steal from
     std::vector<std::unique_ptr<Worker>> workers;
+    mutable std::shared_mutex workersMutex_;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
+    std::atomic<size_t> queued_{0};    //< Number of tasks in all the queues
+    std::atomic<size_t> sleeping_{0};  //< Number of workers waiting for tasks
+    std::atomic<size_t> next_{0};      //< Round robin counter for tasks from outside the pool
 
-    // synchronization
-    std::mutex queue_mutex;
+    // synchronization for sleeping workers
+    std::mutex sleepMutex_;
     std::condition_variable condition;
 
     // Thread start end exit actions
@@ -133,25 +221,65 @@ private:
     std::function<void()> onThreadStop_;
 };
 
+template <typename F, typename>
+ThreadPool::Task::Task(F&& f) {
+    using Func = std::decay_t<F>;
+    if constexpr (fitsInline<Func>) {
+        new (&storage_) Func(std::forward<F>(f));
+        vtable_ = inlineVTable<Func>();
+    } else {
+        new (&storage_) Func*(new Func(std::forward<F>(f)));
+        vtable_ = heapVTable<Func>();
+    }
+}
+
+template <typename F>
+auto ThreadPool::Task::inlineVTable() -> const VTable* {
+    static constexpr VTable vtable{
+        [](void* storage) { (*static_cast<F*>(storage))(); },
+        [](void* dst, void* src) noexcept {
+            new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* storage) noexcept { static_cast<F*>(storage)->~F(); }};
+    return &vtable;
+}
+
+template <typename F>
+auto ThreadPool::Task::heapVTable() -> const VTable* {
+    static constexpr VTable vtable{
+        [](void* storage) { (**static_cast<F**>(storage))(); },
+        [](void* dst, void* src) noexcept { new (dst) F*(*static_cast<F**>(src)); },
+        [](void* storage) noexcept { delete *static_cast<F**>(storage); }};
+    return &vtable;
+}
+
 // add new work item to the pool
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type> {
     using return_type = typename std::result_of<F(Args...)>::type;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    std::packaged_task<return_type()> task{
+        [func = std::forward<F>(f), params = std::make_tuple(std::forward<Args>(args)...)]() mutable
+        -> return_type { return std::apply(func, params); }};
 
-    std::future<return_type> res = task->get_future();
+    std::future<return_type> res = task.get_future();
+    enqueueTask(Task{std::move(task)});
+    return res;
+}
 
-    if (workers.empty()) {
-        (*task)();  // No worker threads, just run the task.
-    } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
+template <typename Future>
+void ThreadPool::wait(const Future& future) {
+    if (!isWorkerThread()) {
+        future.wait();
+        return;
+    }
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!runPendingTask()) {
+            future.wait_for(std::chrono::microseconds(100));
+        }
     }
-    condition.notify_one();
-    return res;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,272 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Maintains a topological order of the nodes in a directed acyclic graph while nodes and edges
+ * are added and removed. Adding an edge that agrees with the current order is O(1), otherwise only
+ * the nodes between the two end points of the edge that are affected are reordered, following
+ * D. J. Pearce and P. H. J. Kelly, "A dynamic topological sort algorithm for directed acyclic
+ * graphs", Journal of Experimental Algorithmics, 2006.
+ * Multiple edges between the same pair of nodes are allowed and counted.
+ * Node should be a cheap to copy and hashable handle, like a pointer. A default constructed Node
+ * is used internally to mark empty slots and can not be added.
+ */
+template <typename Node>
+class TopologicalOrder {
+public:
+    TopologicalOrder() = default;
+
+    /**
+     * Add a node without any edges, it will be placed last in the order.
+     */
+    void addNode(Node node);
+    /**
+     * Remove a node and all its edges.
+     */
+    void removeNode(Node node);
+    bool contains(Node node) const { return nodes_.find(node) != nodes_.end(); }
+
+    /**
+     * Add an edge, both nodes have to be added before.
+     * @return false if the edge would introduce a cycle, then the edge is not added.
+     */
+    bool addEdge(Node from, Node to);
+    void removeEdge(Node from, Node to);
+
+    /**
+     * The position of the node in the order. Positions are only comparable as long as the order is
+     * not modified.
+     */
+    size_t position(Node node) const { return nodes_.at(node).position; }
+
+    const std::vector<Node>& getSuccessors(Node node) const { return nodes_.at(node).successors; }
+    const std::vector<Node>& getPredecessors(Node node) const {
+        return nodes_.at(node).predecessors;
+    }
+
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+
+    /**
+     * Call the callback for each node in topological order
+     */
+    template <typename Callback>
+    void forEach(Callback&& callback) const;
+
+    /**
+     * All the nodes in topological order
+     */
+    std::vector<Node> getOrder() const;
+
+private:
+    struct Data {
+        size_t position;
+        std::vector<Node> successors;
+        std::vector<Node> predecessors;
+        bool visited = false;
+    };
+
+    bool visitForward(Node node, size_t upper, std::vector<Node>& visited);
+    void visitBackward(Node node, size_t lower, std::vector<Node>& visited);
+    void compact();
+
+    std::unordered_map<Node, Data> nodes_;
+    std::vector<Node> slots_;  // The order, removed nodes leave empty slots.
+};
+
+template <typename Node>
+void TopologicalOrder<Node>::addNode(Node node) {
+    if (contains(node)) return;
+    nodes_[node].position = slots_.size();
+    slots_.push_back(node);
+}
+
+template <typename Node>
+void TopologicalOrder<Node>::removeNode(Node node) {
+    auto it = nodes_.find(node);
+    if (it == nodes_.end()) return;
+
+    for (auto& successor : it->second.successors) {
+        auto& preds = nodes_[successor].predecessors;
+        preds.erase(std::remove(preds.begin(), preds.end(), node), preds.end());
+    }
+    for (auto& predecessor : it->second.predecessors) {
+        auto& succs = nodes_[predecessor].successors;
+        succs.erase(std::remove(succs.begin(), succs.end(), node), succs.end());
+    }
+    slots_[it->second.position] = Node{};
+    nodes_.erase(it);
+
+    if (slots_.size() > 32 && slots_.size() > 2 * nodes_.size()) compact();
+}
+
+template <typename Node>
+bool TopologicalOrder<Node>::addEdge(Node from, Node to) {
+    auto& fromData = nodes_.at(from);
+    auto& toData = nodes_.at(to);
+    if (from == to) return false;
+
+    const auto upper = fromData.position;
+    const auto lower = toData.position;
+    if (lower < upper) {
+        // The edge violates the current order, find the affected region and reorder it
+        std::vector<Node> forward;
+        const bool acyclic = visitForward(to, upper, forward);
+        if (!acyclic) {
+            for (auto& n : forward) nodes_[n].visited = false;
+            return false;
+        }
+        std::vector<Node> backward;
+        visitBackward(from, lower, backward);
+
+        const auto byPosition = [&](const Node& a, const Node& b) {
+            return nodes_[a].position < nodes_[b].position;
+        };
+        std::sort(forward.begin(), forward.end(), byPosition);
+        std::sort(backward.begin(), backward.end(), byPosition);
+
+        std::vector<size_t> positions;
+        positions.reserve(forward.size() + backward.size());
+        for (auto& n : backward) positions.push_back(nodes_[n].position);
+        for (auto& n : forward) positions.push_back(nodes_[n].position);
+        std::sort(positions.begin(), positions.end());
+
+        // All nodes that must come before "from" get the lowest positions
+        auto pos = positions.begin();
+        const auto assign = [&](const std::vector<Node>& nodes) {
+            for (auto& n : nodes) {
+                auto& data = nodes_[n];
+                data.visited = false;
+                data.position = *pos;
+                slots_[*pos] = n;
+                ++pos;
+            }
+        };
+        assign(backward);
+        assign(forward);
+    }
+
+    fromData.successors.push_back(to);
+    toData.predecessors.push_back(from);
+    return true;
+}
+
+template <typename Node>
+void TopologicalOrder<Node>::removeEdge(Node from, Node to) {
+    auto fromIt = nodes_.find(from);
+    auto toIt = nodes_.find(to);
+    if (fromIt == nodes_.end() || toIt == nodes_.end()) return;
+
+    auto& succs = fromIt->second.successors;
+    auto sit = std::find(succs.begin(), succs.end(), to);
+    if (sit == succs.end()) return;
+    succs.erase(sit);
+
+    auto& preds = toIt->second.predecessors;
+    auto pit = std::find(preds.begin(), preds.end(), from);
+    if (pit != preds.end()) preds.erase(pit);
+}
+
+template <typename Node>
+template <typename Callback>
+void TopologicalOrder<Node>::forEach(Callback&& callback) const {
+    for (auto& node : slots_) {
+        if (node != Node{}) callback(node);
+    }
+}
+
+template <typename Node>
+std::vector<Node> TopologicalOrder<Node>::getOrder() const {
+    std::vector<Node> order;
+    order.reserve(nodes_.size());
+    forEach([&](Node node) { order.push_back(node); });
+    return order;
+}
+
+template <typename Node>
+bool TopologicalOrder<Node>::visitForward(Node node, size_t upper, std::vector<Node>& visited) {
+    std::vector<Node> stack{node};
+    nodes_[node].visited = true;
+    visited.push_back(node);
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop_back();
+        for (auto& successor : nodes_[current].successors) {
+            auto& data = nodes_[successor];
+            if (data.position == upper) return false;  // Found a cycle
+            if (!data.visited && data.position < upper) {
+                data.visited = true;
+                visited.push_back(successor);
+                stack.push_back(successor);
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Node>
+void TopologicalOrder<Node>::visitBackward(Node node, size_t lower, std::vector<Node>& visited) {
+    std::vector<Node> stack{node};
+    nodes_[node].visited = true;
+    visited.push_back(node);
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop_back();
+        for (auto& predecessor : nodes_[current].predecessors) {
+            auto& data = nodes_[predecessor];
+            if (!data.visited && data.position > lower) {
+                data.visited = true;
+                visited.push_back(predecessor);
+                stack.push_back(predecessor);
+            }
+        }
+    }
+}
+
+template <typename Node>
+void TopologicalOrder<Node>::compact() {
+    slots_.erase(std::remove(slots_.begin(), slots_.end(), Node{}), slots_.end());
+    for (size_t i = 0; i < slots_.size(); ++i) nodes_[slots_[i]].position = i;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
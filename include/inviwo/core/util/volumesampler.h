@@ -58,6 +58,11 @@ public:
     virtual Vector<DataDims, double> sampleDataSpace(const dvec3 &pos) const override;
     virtual bool withinBoundsDataSpace(const dvec3 &pos) const override;
 
+    /**
+     * The sampled representation, can be used to access the voxels directly in tight loops
+     */
+    const VolumeRAM *getVolumeRAM() const;
+
 protected:
     Vector<DataDims, double> getVoxel(const size3_t &pos) const;
 
@@ -128,6 +133,11 @@ inline Vector<4, double> VolumeDoubleSampler<4>::getVoxel(const size3_t &pos) co
     return ram_->getAsDVec4(p);
 }
 
+template <unsigned int DataDims>
+const VolumeRAM *VolumeDoubleSampler<DataDims>::getVolumeRAM() const {
+    return ram_;
+}
+
 template <unsigned int DataDims>
 bool VolumeDoubleSampler<DataDims>::withinBoundsDataSpace(const dvec3 &pos) const {
     return !(glm::any(glm::lessThan(pos, dvec3(0.0))) ||
@@ -37,6 +37,7 @@
 namespace inviwo {
 
 class VolumeRAM;
+class VolumeRAMBricked;
 class LayerRAM;
 class BufferRAM;
 
@@ -49,6 +50,12 @@ namespace util {
 IVW_MODULE_BASE_API std::pair<dvec4, dvec4> volumeMinMax(
     const VolumeRAM* volume, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
+/**
+ * Min and max of a bricked volume, visiting one brick at a time
+ */
+IVW_MODULE_BASE_API std::pair<dvec4, dvec4> volumeMinMax(
+    const VolumeRAMBricked* volume, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+
 IVW_MODULE_BASE_API std::pair<dvec4, dvec4> layerMinMax(
     const LayerRAM* layer, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
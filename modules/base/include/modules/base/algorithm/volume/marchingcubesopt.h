@@ -48,7 +48,8 @@ namespace util {
  * Extracts an iso surface from a volume using the Marching Cubes algorithm
  *
  * Note: Shares interface with util::marchingcbes and util::marchingtetrahedron
- * This is an optimized version of util::marchingcubes
+ * This is an optimized version of util::marchingcubes. Bricks of cells that can not contain the
+ * iso-value are skipped using the min/max octree of the volume, see Volume::getMinMaxOctree().
  *
  * @param volume the scalar volume
  * @param iso iso-value for the extracted surface
@@ -66,6 +67,38 @@ IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOpt(
     std::shared_ptr<const Volume> volume, double iso, const vec4 &color, bool invert, bool enclose,
     std::function<void(float)> progressCallback = nullptr,
     std::function<bool(const size3_t &)> maskingCallback = nullptr);
+
+/**
+ * Extracts an iso surface from a volume using the Marching Cubes algorithm, multi-threaded version
+ * of util::marchingCubesOpt.
+ *
+ * The volume is split into slabs along z which are extracted concurrently on the thread pool.
+ * As in util::marchingCubesOpt, bricks of cells that can not contain the iso-value are skipped.
+ * Vertices on the planes shared by neighboring slabs are welded in slab order, hence the resulting
+ * mesh is independent of the number of threads and identical in topology to the one of
+ * util::marchingCubesOpt. If no thread pool is available the slabs are extracted sequentially.
+ *
+ * @param volume the scalar volume
+ * @param iso iso-value for the extracted surface
+ * @param color the color of the resulting surface
+ * @param invert flips the normals of the surface normals (useful when values greater than the
+ * iso-value is 'outside' of the surface)
+ * @param enclose whether to create surface where the iso surface intersects the volume boundaries
+ * @param progressCallback if set, will be called will executing with the current progress in the
+ * interval [0,1], a pool::Progress can be passed directly
+ * @param stopCallback if set, will be polled while executing. Returning true aborts the
+ * extraction and nullptr is returned. A pool::Stop can be wrapped as
+ * `[stop]() -> bool { return stop; }`
+ * @param maskingCallback optional callback to test whether current cell should be evaluated or not
+ * (return true to include current cell), will be called concurrently from several threads
+ * @param jobs number of slabs to split the volume into, 0 means four times the thread pool size
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOptParallel(
+    std::shared_ptr<const Volume> volume, double iso, const vec4 &color, bool invert, bool enclose,
+    std::function<void(float)> progressCallback = nullptr,
+    std::function<bool()> stopCallback = nullptr,
+    std::function<bool(const size3_t &)> maskingCallback = nullptr, size_t jobs = 0);
+
 }  // namespace util
 
 namespace marching {
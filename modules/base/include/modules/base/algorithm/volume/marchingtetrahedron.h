@@ -38,8 +38,6 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/exception.h>
 
-#include <modules/base/datastructures/kdtree.h>
-
 namespace inviwo {
 
 class IVW_MODULE_BASE_API MarchingTetrahedron {
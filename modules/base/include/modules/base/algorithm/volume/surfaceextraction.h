@@ -36,7 +36,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 
-#include <modules/base/datastructures/kdtree.h>
+#include <modules/base/datastructures/spatialindex.h>
 
 namespace inviwo {
 /*
@@ -51,16 +51,27 @@ double getValue(const T *src, size3_t pos, size3_t dim, double iso, bool invert)
 
 glm::vec3 interpolate(const glm::vec3 &p0, double v0, const glm::vec3 &p1, double v1);
 
-void evaluateTriangle(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
+/**
+ * Maps vertex positions to vertex indices. Vertices closer than sqrt(epsilon) are welded by
+ * addVertex, which is the cell size of the hash, such that only neighboring cells are searched.
+ * Replaces the K3DTree<size_t, float> used before, with the same insert() and findNearest()
+ * interface, since the vertices are inserted one at a time.
+ */
+class VertexMap : public SpatialHash3D<size_t, float> {
+public:
+    VertexMap() : SpatialHash3D<size_t, float>(std::sqrt(glm::epsilon<float>())) {}
+};
+
+void evaluateTriangle(VertexMap &vertexTree, IndexBufferRAM *indexBuffer,
                       std::vector<vec3> &positions, std::vector<vec3> &normals, const glm::vec3 &p0,
                       double v0, const glm::vec3 &p1, double v1, const glm::vec3 &p2, double v2);
 
-size_t addVertex(K3DTree<size_t, float> &vertexTree, std::vector<vec3> &positions,
-                 std::vector<vec3> &normals, const vec3 pos);
+size_t addVertex(VertexMap &vertexTree, std::vector<vec3> &positions, std::vector<vec3> &normals,
+                 const vec3 pos);
 
-void addTriangle(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
-                 std::vector<vec3> &positions, std::vector<vec3> &normals, const glm::vec3 &a,
-                 const glm::vec3 &b, const glm::vec3 &c);
+void addTriangle(VertexMap &vertexTree, IndexBufferRAM *indexBuffer, std::vector<vec3> &positions,
+                 std::vector<vec3> &normals, const glm::vec3 &a, const glm::vec3 &b,
+                 const glm::vec3 &c);
 
 template <typename T>
 void encloseSurfce(const T *src, const size3_t &dim, IndexBufferRAM *indexBuffer,
@@ -75,7 +86,7 @@ void encloseSurfce(const T *src, const size3_t &dim, IndexBufferRAM *indexBuffer
     std::array<double, 4> values;
 
     {
-        K3DTree<size_t, float> sideVertexTree;
+        VertexMap sideVertexTree;
         // Z axis
         for (auto &k : cubeEdgeIndices(dim.z)) {
             for (size_t j = 0; j < dim.y - 1; ++j) {
@@ -110,7 +121,7 @@ void encloseSurfce(const T *src, const size3_t &dim, IndexBufferRAM *indexBuffer
         }
     }
     {
-        K3DTree<size_t, float> sideVertexTree;
+        VertexMap sideVertexTree;
         // Y axis
         for (size_t k = 0; k < dim.z - 1; ++k) {
             for (auto &j : cubeEdgeIndices(dim.y)) {
@@ -145,7 +156,7 @@ void encloseSurfce(const T *src, const size3_t &dim, IndexBufferRAM *indexBuffer
         }
     }
     {
-        K3DTree<size_t, float> sideVertexTree;
+        VertexMap sideVertexTree;
         // X axis
         for (size_t k = 0; k < dim.z - 1; ++k) {
             for (size_t j = 0; j < dim.y - 1; ++j) {
@@ -37,12 +37,22 @@
 namespace inviwo {
 
 class VolumeRAM;
+class Volume;
 
 namespace util {
 
 IVW_MODULE_BASE_API size_t volumeSignificantVoxels(
     const VolumeRAM* volume, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
+/**
+ * Count the voxels that are not zero. For scalar volumes the min/max octree of the volume is used
+ * to skip bricks that are all zero and to count bricks without any zero directly. Bricks of
+ * floating point volumes are always visited voxel by voxel when special values are ignored.
+ * @see Volume::getMinMaxOctree()
+ */
+IVW_MODULE_BASE_API size_t volumeSignificantVoxels(
+    const Volume& volume, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+
 }  // namespace util
 
 }  // namespace inviwo
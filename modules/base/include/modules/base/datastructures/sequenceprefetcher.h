@@ -0,0 +1,323 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Keeps the steps of a sequence that are about to be shown resident in memory. Whenever the
+ * current step changes, see update(), the next steps in playback direction are loaded on the
+ * thread pool while the current one is being shown. The total size of the resident steps is kept
+ * below a memory budget and steps that fall behind the playback are evicted, oldest first.
+ *
+ * Jobs of steps that leave the window before they have started are cancelled, which releases
+ * everything they captured right away. Steps that can not be evicted yet, see Evict, are retried
+ * on every following update().
+ *
+ * All member functions are meant to be called from the main thread, only the jobs run on the pool.
+ */
+template <typename T>
+class SequencePrefetcher {
+public:
+    /**
+     * Loads one step, runs on the thread pool. Returns the resident data and its size in bytes,
+     * or nullptr if there was nothing to load. Exceptions are swallowed and treated as nullptr,
+     * the caller is expected to load the step itself in that case and report the error.
+     */
+    using Job = std::function<std::pair<std::shared_ptr<T>, size_t>()>;
+    /**
+     * Creates the Job for step index, called from the main thread. Everything the job needs
+     * should be captured by value. An empty Job means that the step can not be prefetched.
+     */
+    using MakeJob = std::function<Job(size_t index)>;
+    /**
+     * Releases the memory of a step that is no longer needed, called from the main thread.
+     * Returns false if the data is still in use and can not be released yet, it will then be
+     * retried during the next update().
+     */
+    using Evict = std::function<bool(T&)>;
+
+    /**
+     * @param makeJob creates the jobs, see MakeJob
+     * @param evict releases loaded steps, see Evict
+     * @param pool the pool to run the jobs on, if nullptr the pool of the InviwoApplication is
+     * used. Without any pool only the current step is loaded, directly in update().
+     */
+    SequencePrefetcher(MakeJob makeJob = nullptr, Evict evict = nullptr,
+                       ThreadPool* pool = nullptr)
+        : makeJob_{std::move(makeJob)}, evict_{std::move(evict)}, pool_{pool} {}
+    SequencePrefetcher(const SequencePrefetcher&) = delete;
+    SequencePrefetcher& operator=(const SequencePrefetcher&) = delete;
+    /**
+     * Cancels all pending jobs and evicts all loaded steps. Results of jobs that are already
+     * running, and steps that can not be evicted yet, are left to their owners.
+     */
+    ~SequencePrefetcher() { clear(); }
+
+    void setMakeJob(MakeJob makeJob) { makeJob_ = std::move(makeJob); }
+    void setEvict(Evict evict) { evict_ = std::move(evict); }
+
+    /**
+     * Set the current step of a sequence with count steps. The playback direction is deduced
+     * from the previously set step, wrapping around at the ends. Loads the current step and up to
+     * stepsAhead following steps in that direction as long as the resident size stays below
+     * memoryBudget bytes. Steps outside of that window are cancelled if they have not started
+     * yet, and evicted once they have been loaded.
+     */
+    void update(size_t index, size_t count, size_t stepsAhead, size_t memoryBudget);
+
+    /**
+     * Returns the data of step index if it has been scheduled by update(), waiting for its job to
+     * finish if needed. Returns nullptr if the step was not scheduled or nothing was loaded.
+     */
+    std::shared_ptr<T> get(size_t index);
+
+    /**
+     * Cancel all pending jobs and evict all steps. Jobs still running are evicted when they
+     * finish during a later update().
+     */
+    void clear();
+
+    /**
+     * The number of bytes of all loaded steps.
+     */
+    size_t getResidentBytes() const;
+
+    /**
+     * The number of steps that have been scheduled by update() and not evicted.
+     */
+    size_t getScheduledSteps() const { return entries_.size(); }
+
+private:
+    using Result = std::pair<std::shared_ptr<T>, size_t>;
+    /**
+     * A job that has not been started yet. Cancelling it destroys the job and with it
+     * everything it captured, without waiting for the pool to get to it.
+     */
+    struct Pending {
+        std::mutex mutex;
+        Job job;
+    };
+    struct Entry {
+        std::shared_future<Result> result;
+        std::shared_ptr<Pending> pending;
+        size_t age;
+    };
+    static bool isReady(const std::shared_future<Result>& result) {
+        return result.wait_for(std::chrono::duration<int>::zero()) == std::future_status::ready;
+    }
+    static Result run(Pending& pending);
+    ThreadPool* getPool() const;
+    void release(Entry& entry);
+    bool evict(const std::shared_future<Result>& result);
+    void evictOrphans();
+
+    MakeJob makeJob_;
+    Evict evict_;
+    ThreadPool* pool_;
+    std::map<size_t, Entry> entries_;
+    std::vector<std::shared_future<Result>> orphans_;  //< Steps to evict when possible
+    size_t age_ = 0;
+    size_t estimate_ = 0;  //< Size of the last loaded step, used for the ones not loaded yet
+    size_t last_ = 0;
+    bool hasLast_ = false;
+    bool backward_ = false;
+};
+
+template <typename T>
+void SequencePrefetcher<T>::update(size_t index, size_t count, size_t stepsAhead,
+                                   size_t memoryBudget) {
+    evictOrphans();
+    if (count == 0 || !makeJob_) {
+        clear();
+        return;
+    }
+
+    if (hasLast_ && index != last_ && last_ < count) {
+        const auto forward = (index + count - last_) % count;
+        backward_ = forward > count / 2;
+    }
+    last_ = index;
+    hasLast_ = true;
+
+    const auto window = std::min(stepsAhead + 1, count);
+    const auto step = [&](size_t i) {
+        return backward_ ? (index + count - i % count) % count : (index + i) % count;
+    };
+    const auto inWindow = [&](size_t key) {
+        const auto dist = backward_ ? (index + count - key) % count : (key + count - index) % count;
+        return key < count && dist < window;
+    };
+
+    // Release everything outside of the window, oldest first.
+    std::vector<typename std::map<size_t, Entry>::iterator> stale;
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (!inWindow(it->first)) stale.push_back(it);
+    }
+    std::sort(stale.begin(), stale.end(),
+              [](const auto& a, const auto& b) { return a->second.age < b->second.age; });
+    for (auto& it : stale) {
+        release(it->second);
+        entries_.erase(it);
+    }
+
+    size_t used = 0;
+    for (auto& item : entries_) {
+        if (isReady(item.second.result)) {
+            const auto& result = item.second.result.get();
+            if (result.first) estimate_ = result.second;
+            used += result.second;
+        } else {
+            used += estimate_;
+        }
+    }
+
+    auto pool = getPool();
+    for (size_t i = 0; i < window; ++i) {
+        const auto key = step(i);
+        if (entries_.find(key) != entries_.end()) continue;
+        // The current step is always loaded, the following ones only if they fit the budget.
+        // Until the size of a step is known only the current one is loaded.
+        if (i > 0 && (!pool || estimate_ == 0 || used + estimate_ > memoryBudget)) break;
+
+        auto job = makeJob_(key);
+        if (!job) continue;
+        auto pending = std::make_shared<Pending>();
+        pending->job = std::move(job);
+
+        std::shared_future<Result> result;
+        if (pool) {
+            result = pool->enqueue([pending]() { return run(*pending); }).share();
+        } else {
+            std::promise<Result> promise;
+            promise.set_value(run(*pending));
+            result = promise.get_future().share();
+        }
+        entries_.emplace(key, Entry{std::move(result), std::move(pending), age_++});
+        used += estimate_;
+    }
+}
+
+template <typename T>
+std::shared_ptr<T> SequencePrefetcher<T>::get(size_t index) {
+    auto it = entries_.find(index);
+    if (it == entries_.end()) return nullptr;
+    if (auto pool = getPool()) pool->wait(it->second.result);
+    const auto& result = it->second.result.get();
+    if (result.first) estimate_ = result.second;
+    return result.first;
+}
+
+template <typename T>
+void SequencePrefetcher<T>::clear() {
+    evictOrphans();
+    for (auto& item : entries_) release(item.second);
+    entries_.clear();
+    hasLast_ = false;
+    backward_ = false;
+}
+
+template <typename T>
+size_t SequencePrefetcher<T>::getResidentBytes() const {
+    size_t bytes = 0;
+    for (auto& item : entries_) {
+        if (isReady(item.second.result)) bytes += item.second.result.get().second;
+    }
+    return bytes;
+}
+
+template <typename T>
+auto SequencePrefetcher<T>::run(Pending& pending) -> Result {
+    Job job;
+    {
+        std::scoped_lock lock{pending.mutex};
+        std::swap(job, pending.job);
+    }
+    if (!job) return {nullptr, 0};  // cancelled
+    try {
+        return job();
+    } catch (...) {
+        return {nullptr, 0};
+    }
+}
+
+template <typename T>
+ThreadPool* SequencePrefetcher<T>::getPool() const {
+    if (pool_) return pool_;
+    if (InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0) {
+        return &InviwoApplication::getPtr()->getThreadPool();
+    }
+    return nullptr;
+}
+
+template <typename T>
+void SequencePrefetcher<T>::release(Entry& entry) {
+    if (!isReady(entry.result)) {
+        Job cancelled;
+        {
+            std::scoped_lock lock{entry.pending->mutex};
+            std::swap(cancelled, entry.pending->job);
+        }
+        // A job that already started might still load something, evict that once done.
+        orphans_.push_back(entry.result);
+    } else if (!evict(entry.result)) {
+        orphans_.push_back(entry.result);
+    }
+}
+
+template <typename T>
+bool SequencePrefetcher<T>::evict(const std::shared_future<Result>& result) {
+    const auto& data = result.get().first;
+    if (data && evict_) return evict_(*data);
+    return true;
+}
+
+template <typename T>
+void SequencePrefetcher<T>::evictOrphans() {
+    auto it = std::remove_if(orphans_.begin(), orphans_.end(),
+                             [&](const auto& result) { return isReady(result) && evict(result); });
+    orphans_.erase(it, orphans_.end());
+}
+
+}  // namespace inviwo
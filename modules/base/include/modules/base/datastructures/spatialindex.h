@@ -0,0 +1,548 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glm.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * A point with some data in a FlatKDTree or a SpatialHash. Has the same accessors as KDNode.
+ */
+template <unsigned char N, typename T = char, typename P = double>
+class SpatialPoint {
+public:
+    SpatialPoint(const Vector<N, P> &pos, const T &data) : pos_{pos}, data_{data} {}
+
+    T &get() { return data_; }
+    const T &get() const { return data_; }
+    const P *getPosition() const { return glm::value_ptr(pos_); }
+    const Vector<N, P> &getPos() const { return pos_; }
+
+private:
+    Vector<N, P> pos_;
+    T data_;
+};
+
+namespace detail {
+
+template <unsigned char N, typename P>
+P sqDist(const Vector<N, P> &a, const Vector<N, P> &b) {
+    P res{0};
+    for (unsigned char i = 0; i < N; ++i) {
+        const P d = a[i] - b[i];
+        res += d * d;
+    }
+    return res;
+}
+
+/**
+ * Call func(begin, end) for jobs consecutive parts of [0, size) on the thread pool, or directly if
+ * there is no pool. If jobs is 0, four jobs per pool thread are used.
+ */
+template <typename Func>
+void forEachRange(size_t size, size_t jobs, Func &&func) {
+    const bool usePool =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    if (jobs == 0) jobs = usePool ? 4 * InviwoApplication::getPtr()->getPoolSize() : 1;
+    jobs = std::max(size_t{1}, std::min(jobs, size));
+
+    if (!usePool || jobs == 1) {
+        func(size_t{0}, size);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        const size_t begin = size * job / jobs;
+        const size_t end = size * (job + 1) / jobs;
+        futures.push_back(dispatchPool([&func, begin, end]() { func(begin, end); }));
+    }
+    auto &pool = InviwoApplication::getPtr()->getThreadPool();
+    for (auto &future : futures) {
+        pool.wait(future);
+        future.get();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * \brief A static KD-tree stored in one contiguous array
+ *
+ * The tree is built in bulk from a set of points. The points are ordered such that the median of
+ * each range is the root of the subtree of that range, with the points less than the median along
+ * the split dimension before it and the rest after it. Hence there are no child pointers, and each
+ * node only stores its split dimension, which is the dimension of largest extent of its range.
+ *
+ * The queries have the same names as the ones of KDTreeGlm, but return const pointers to
+ * SpatialPoint. Results of findNNearest are sorted from nearest to farthest. The batched queries
+ * process the query points concurrently on the thread pool.
+ *
+ * @see SpatialHash for incremental insertion
+ */
+template <unsigned char N, typename T = char, typename P = double>
+class FlatKDTree {
+public:
+    using Node = SpatialPoint<N, T, P>;
+    using Vec = Vector<N, P>;
+
+    FlatKDTree() = default;
+    /**
+     * Build a tree of the points, subtrees are built concurrently on the thread pool
+     * @param points to build the tree from
+     * @param jobs number of subtrees to build concurrently, 0 means four per pool thread
+     */
+    explicit FlatKDTree(std::vector<Node> points, size_t jobs = 0);
+    FlatKDTree(const std::vector<Vec> &positions, const std::vector<T> &data, size_t jobs = 0);
+
+    bool empty() const { return nodes_.empty(); }
+    size_t size() const { return nodes_.size(); }
+    size_t depth() const;
+
+    /**
+     * The points in tree order
+     */
+    const std::vector<Node> &getNodes() const { return nodes_; }
+
+    const Node *findNearest(const Vec &pos) const;
+    std::vector<const Node *> findNNearest(const Vec &pos, int amount) const;
+    std::vector<const Node *> findCloseTo(const Vec &pos, P distance) const;
+
+    std::vector<const Node *> findNearest(const std::vector<Vec> &pos, size_t jobs = 0) const;
+    std::vector<std::vector<const Node *>> findNNearest(const std::vector<Vec> &pos, int amount,
+                                                        size_t jobs = 0) const;
+    std::vector<std::vector<const Node *>> findCloseTo(const std::vector<Vec> &pos, P distance,
+                                                       size_t jobs = 0) const;
+
+private:
+    using Candidate = std::pair<P, size_t>;
+
+    static size_t mid(size_t begin, size_t end) { return begin + (end - begin) / 2; }
+    void build(size_t begin, size_t end, size_t levels,
+               std::vector<std::pair<size_t, size_t>> *deferred);
+
+    void nearest(size_t begin, size_t end, const Vec &pos, Candidate &best) const;
+    void nNearest(size_t begin, size_t end, const Vec &pos, size_t amount,
+                  std::priority_queue<Candidate> &best) const;
+    void closeTo(size_t begin, size_t end, const Vec &pos, P sqDistance,
+                 std::vector<const Node *> &res) const;
+
+    std::vector<Node> nodes_;
+    std::vector<unsigned char> splitDims_;
+};
+
+/**
+ * \brief A hash grid of points for incremental insertion and queries within a short distance
+ *
+ * Points are bucketed in cubic cells of the given size. The cells are kept in an open addressing
+ * hash table and the points in a deque, where each point links to the next one of its cell, hence
+ * inserting does not allocate per point, and pointers to inserted points stay valid.
+ *
+ * The queries have the same names as the ones of KDTreeGlm, but findNearest only considers the
+ * cells next to the cell of the query point. It therefore always finds the nearest point if it is
+ * at most one cell size away, and returns nullptr if there is no point in those cells. This makes
+ * it a drop in replacement for KDTreeGlm when used to weld vertices closer than the cell size.
+ */
+template <unsigned char N, typename T = char, typename P = double>
+class SpatialHash {
+public:
+    using Node = SpatialPoint<N, T, P>;
+    using Vec = Vector<N, P>;
+
+    explicit SpatialHash(P cellSize);
+
+    bool empty() const { return nodes_.empty(); }
+    size_t size() const { return nodes_.size(); }
+    P getCellSize() const { return cellSize_; }
+    void clear();
+
+    Node *insert(const Vec &pos, const T &data);
+
+    Node *findNearest(const Vec &pos);
+    const Node *findNearest(const Vec &pos) const;
+    std::vector<const Node *> findCloseTo(const Vec &pos, P distance) const;
+
+private:
+    using Cell = Vector<N, std::int64_t>;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Entry {
+        Node node;
+        size_t next;
+    };
+    struct Slot {
+        Cell cell;
+        size_t head = npos;
+    };
+
+    Cell cellOf(const Vec &pos) const;
+    size_t slotOf(const Cell &cell) const;
+    void rehash(size_t slots);
+    template <typename Func>
+    void forEachInCells(const Cell &lower, const Cell &upper, Func &&func) const;
+
+    P cellSize_;
+    std::deque<Entry> nodes_;
+    std::vector<Slot> slots_;
+    size_t usedSlots_ = 0;
+};
+
+template <typename T = char, typename P = double>
+using FlatK2DTree = FlatKDTree<2, T, P>;
+template <typename T = char, typename P = double>
+using FlatK3DTree = FlatKDTree<3, T, P>;
+
+template <typename T = char, typename P = double>
+using SpatialHash2D = SpatialHash<2, T, P>;
+template <typename T = char, typename P = double>
+using SpatialHash3D = SpatialHash<3, T, P>;
+
+template <unsigned char N, typename T, typename P>
+FlatKDTree<N, T, P>::FlatKDTree(std::vector<Node> points, size_t jobs)
+    : nodes_{std::move(points)}, splitDims_(nodes_.size(), 0) {
+
+    const bool usePool =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    if (jobs == 0) jobs = usePool ? 4 * InviwoApplication::getPtr()->getPoolSize() : 1;
+
+    // Build the top levels serially until there are at least as many subtrees as jobs, then build
+    // the subtrees concurrently
+    size_t levels = 0;
+    while ((size_t{1} << levels) < jobs && levels < 32) ++levels;
+    std::vector<std::pair<size_t, size_t>> subtrees;
+    build(0, nodes_.size(), levels, &subtrees);
+    detail::forEachRange(subtrees.size(), subtrees.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            build(subtrees[i].first, subtrees[i].second, 0, nullptr);
+        }
+    });
+}
+
+template <unsigned char N, typename T, typename P>
+FlatKDTree<N, T, P>::FlatKDTree(const std::vector<Vec> &positions, const std::vector<T> &data,
+                                size_t jobs)
+    : FlatKDTree(
+          [&]() {
+              std::vector<Node> points;
+              points.reserve(positions.size());
+              for (size_t i = 0; i < positions.size(); ++i) {
+                  points.emplace_back(positions[i], i < data.size() ? data[i] : T{});
+              }
+              return points;
+          }(),
+          jobs) {}
+
+template <unsigned char N, typename T, typename P>
+void FlatKDTree<N, T, P>::build(size_t begin, size_t end, size_t levels,
+                                std::vector<std::pair<size_t, size_t>> *deferred) {
+    if (end - begin < 2) return;
+    if (deferred && levels == 0) {
+        deferred->emplace_back(begin, end);
+        return;
+    }
+
+    Vec lower{std::numeric_limits<P>::max()};
+    Vec upper{std::numeric_limits<P>::lowest()};
+    for (size_t i = begin; i < end; ++i) {
+        lower = glm::min(lower, nodes_[i].getPos());
+        upper = glm::max(upper, nodes_[i].getPos());
+    }
+    unsigned char dim = 0;
+    for (unsigned char i = 1; i < N; ++i) {
+        if (upper[i] - lower[i] > upper[dim] - lower[dim]) dim = i;
+    }
+
+    const size_t m = mid(begin, end);
+    std::nth_element(
+        nodes_.begin() + begin, nodes_.begin() + m, nodes_.begin() + end,
+        [dim](const Node &a, const Node &b) { return a.getPos()[dim] < b.getPos()[dim]; });
+    splitDims_[m] = dim;
+
+    const size_t next = levels > 0 ? levels - 1 : 0;
+    build(begin, m, next, deferred);
+    build(m + 1, end, next, deferred);
+}
+
+template <unsigned char N, typename T, typename P>
+size_t FlatKDTree<N, T, P>::depth() const {
+    size_t depth = 0;
+    for (size_t size = nodes_.size(); size > 0; size /= 2) ++depth;
+    return depth;
+}
+
+template <unsigned char N, typename T, typename P>
+void FlatKDTree<N, T, P>::nearest(size_t begin, size_t end, const Vec &pos,
+                                  Candidate &best) const {
+    if (begin >= end) return;
+    const size_t m = mid(begin, end);
+    const auto &node = nodes_[m];
+    const P dist = detail::sqDist<N, P>(node.getPos(), pos);
+    if (dist < best.first) best = {dist, m};
+
+    const auto dim = splitDims_[m];
+    const P diff = pos[dim] - node.getPos()[dim];
+    if (diff < 0) {
+        nearest(begin, m, pos, best);
+        if (diff * diff < best.first) nearest(m + 1, end, pos, best);
+    } else {
+        nearest(m + 1, end, pos, best);
+        if (diff * diff < best.first) nearest(begin, m, pos, best);
+    }
+}
+
+template <unsigned char N, typename T, typename P>
+void FlatKDTree<N, T, P>::nNearest(size_t begin, size_t end, const Vec &pos, size_t amount,
+                                   std::priority_queue<Candidate> &best) const {
+    if (begin >= end) return;
+    const size_t m = mid(begin, end);
+    const auto &node = nodes_[m];
+    const P dist = detail::sqDist<N, P>(node.getPos(), pos);
+    if (best.size() < amount) {
+        best.emplace(dist, m);
+    } else if (dist < best.top().first) {
+        best.pop();
+        best.emplace(dist, m);
+    }
+
+    const auto dim = splitDims_[m];
+    const P diff = pos[dim] - node.getPos()[dim];
+    const auto visitFar = [&]() { return best.size() < amount || diff * diff < best.top().first; };
+    if (diff < 0) {
+        nNearest(begin, m, pos, amount, best);
+        if (visitFar()) nNearest(m + 1, end, pos, amount, best);
+    } else {
+        nNearest(m + 1, end, pos, amount, best);
+        if (visitFar()) nNearest(begin, m, pos, amount, best);
+    }
+}
+
+template <unsigned char N, typename T, typename P>
+void FlatKDTree<N, T, P>::closeTo(size_t begin, size_t end, const Vec &pos, P sqDistance,
+                                  std::vector<const Node *> &res) const {
+    if (begin >= end) return;
+    const size_t m = mid(begin, end);
+    const auto &node = nodes_[m];
+    if (detail::sqDist<N, P>(node.getPos(), pos) < sqDistance) res.push_back(&node);
+
+    const auto dim = splitDims_[m];
+    const P diff = pos[dim] - node.getPos()[dim];
+    if (diff < 0 || diff * diff <= sqDistance) closeTo(begin, m, pos, sqDistance, res);
+    if (diff >= 0 || diff * diff <= sqDistance) closeTo(m + 1, end, pos, sqDistance, res);
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findNearest(const Vec &pos) const -> const Node * {
+    Candidate best{std::numeric_limits<P>::max(), nodes_.size()};
+    nearest(0, nodes_.size(), pos, best);
+    return best.second < nodes_.size() ? &nodes_[best.second] : nullptr;
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findNNearest(const Vec &pos, int amount) const
+    -> std::vector<const Node *> {
+    std::vector<const Node *> res;
+    if (amount <= 0) return res;
+    std::priority_queue<Candidate> best;
+    nNearest(0, nodes_.size(), pos, static_cast<size_t>(amount), best);
+    res.resize(best.size());
+    for (auto it = res.rbegin(); it != res.rend(); ++it, best.pop()) {
+        *it = &nodes_[best.top().second];
+    }
+    return res;
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findCloseTo(const Vec &pos, P distance) const
+    -> std::vector<const Node *> {
+    std::vector<const Node *> res;
+    closeTo(0, nodes_.size(), pos, distance * distance, res);
+    return res;
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findNearest(const std::vector<Vec> &pos, size_t jobs) const
+    -> std::vector<const Node *> {
+    std::vector<const Node *> res(pos.size());
+    detail::forEachRange(pos.size(), jobs, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) res[i] = findNearest(pos[i]);
+    });
+    return res;
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findNNearest(const std::vector<Vec> &pos, int amount,
+                                       size_t jobs) const
+    -> std::vector<std::vector<const Node *>> {
+    std::vector<std::vector<const Node *>> res(pos.size());
+    detail::forEachRange(pos.size(), jobs, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) res[i] = findNNearest(pos[i], amount);
+    });
+    return res;
+}
+
+template <unsigned char N, typename T, typename P>
+auto FlatKDTree<N, T, P>::findCloseTo(const std::vector<Vec> &pos, P distance,
+                                      size_t jobs) const
+    -> std::vector<std::vector<const Node *>> {
+    std::vector<std::vector<const Node *>> res(pos.size());
+    detail::forEachRange(pos.size(), jobs, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) res[i] = findCloseTo(pos[i], distance);
+    });
+    return res;
+}
+
+template <unsigned char N, typename T, typename P>
+SpatialHash<N, T, P>::SpatialHash(P cellSize) : cellSize_{cellSize} {
+    if (!(cellSize_ > P{0})) {
+        throw Exception("The cell size of a SpatialHash has to be positive",
+                        IVW_CONTEXT_CUSTOM("SpatialHash"));
+    }
+    rehash(64);
+}
+
+template <unsigned char N, typename T, typename P>
+void SpatialHash<N, T, P>::clear() {
+    nodes_.clear();
+    usedSlots_ = 0;
+    slots_.assign(64, Slot{});
+}
+
+template <unsigned char N, typename T, typename P>
+auto SpatialHash<N, T, P>::cellOf(const Vec &pos) const -> Cell {
+    Cell cell;
+    for (unsigned char i = 0; i < N; ++i) {
+        cell[i] = static_cast<std::int64_t>(std::floor(pos[i] / cellSize_));
+    }
+    return cell;
+}
+
+template <unsigned char N, typename T, typename P>
+size_t SpatialHash<N, T, P>::slotOf(const Cell &cell) const {
+    constexpr std::array<std::uint64_t, 4> primes = {73856093, 19349663, 83492791, 50331653};
+    std::uint64_t hash = 0;
+    for (unsigned char i = 0; i < N; ++i) {
+        hash ^= static_cast<std::uint64_t>(cell[i]) * primes[i % primes.size()];
+    }
+    const size_t mask = slots_.size() - 1;
+    size_t slot = static_cast<size_t>(hash) & mask;
+    while (slots_[slot].head != npos && slots_[slot].cell != cell) slot = (slot + 1) & mask;
+    return slot;
+}
+
+template <unsigned char N, typename T, typename P>
+void SpatialHash<N, T, P>::rehash(size_t slots) {
+    std::vector<Slot> old(slots, Slot{});
+    std::swap(old, slots_);
+    for (const auto &slot : old) {
+        if (slot.head != npos) slots_[slotOf(slot.cell)] = slot;
+    }
+}
+
+template <unsigned char N, typename T, typename P>
+auto SpatialHash<N, T, P>::insert(const Vec &pos, const T &data) -> Node * {
+    if (2 * (usedSlots_ + 1) > slots_.size()) rehash(2 * slots_.size());
+
+    const auto cell = cellOf(pos);
+    auto &slot = slots_[slotOf(cell)];
+    if (slot.head == npos) {
+        slot.cell = cell;
+        ++usedSlots_;
+    }
+    nodes_.push_back(Entry{Node{pos, data}, slot.head});
+    slot.head = nodes_.size() - 1;
+    return &nodes_.back().node;
+}
+
+template <unsigned char N, typename T, typename P>
+template <typename Func>
+void SpatialHash<N, T, P>::forEachInCells(const Cell &lower, const Cell &upper,
+                                          Func &&func) const {
+    Cell cell = lower;
+    for (;;) {
+        for (size_t i = slots_[slotOf(cell)].head; i != npos; i = nodes_[i].next) {
+            func(i);
+        }
+        unsigned char dim = 0;
+        while (dim < N && cell[dim] == upper[dim]) {
+            cell[dim] = lower[dim];
+            ++dim;
+        }
+        if (dim == N) return;
+        ++cell[dim];
+    }
+}
+
+template <unsigned char N, typename T, typename P>
+auto SpatialHash<N, T, P>::findNearest(const Vec &pos) const -> const Node * {
+    const auto cell = cellOf(pos);
+    const Node *nearest = nullptr;
+    P best = std::numeric_limits<P>::max();
+    forEachInCells(cell - Cell{1}, cell + Cell{1}, [&](size_t i) {
+        const P dist = detail::sqDist<N, P>(nodes_[i].node.getPos(), pos);
+        if (dist < best) {
+            best = dist;
+            nearest = &nodes_[i].node;
+        }
+    });
+    return nearest;
+}
+
+template <unsigned char N, typename T, typename P>
+auto SpatialHash<N, T, P>::findNearest(const Vec &pos) -> Node * {
+    return const_cast<Node *>(static_cast<const SpatialHash &>(*this).findNearest(pos));
+}
+
+template <unsigned char N, typename T, typename P>
+auto SpatialHash<N, T, P>::findCloseTo(const Vec &pos, P distance) const
+    -> std::vector<const Node *> {
+    std::vector<const Node *> res;
+    const P sqDistance = distance * distance;
+    forEachInCells(cellOf(pos - Vec{distance}), cellOf(pos + Vec{distance}), [&](size_t i) {
+        if (detail::sqDist<N, P>(nodes_[i].node.getPos(), pos) < sqDistance) {
+            res.push_back(&nodes_[i].node);
+        }
+    });
+    return res;
+}
+
+}  // namespace inviwo
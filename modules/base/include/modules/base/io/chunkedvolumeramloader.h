@@ -0,0 +1,113 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Splits size bytes of data into chunks of chunkSize bytes and compresses each of them with zlib.
+ * The chunks are compressed concurrently on the thread pool.
+ * @param data the bytes to compress
+ * @param size the number of bytes in data
+ * @param chunkSize the uncompressed size of each chunk, the last chunk might be smaller
+ * @param level zlib compression level in [1, 9], higher is slower but smaller
+ * @return the compressed chunks, in order
+ * @throws Exception if zlib fails
+ */
+IVW_MODULE_BASE_API std::vector<std::vector<char>> compressChunks(const void* data, size_t size,
+                                                                  size_t chunkSize, int level);
+
+/**
+ * Decompresses consecutive zlib compressed chunks, as written by compressChunks, into dest.
+ * The chunks are decompressed concurrently on the thread pool.
+ * @param src the compressed chunks stored back to back
+ * @param compressedSizes the compressed size of each chunk in src
+ * @param chunkSize the uncompressed size of each chunk, the last chunk might be smaller
+ * @param dest destination of the uncompressed data, has to hold size bytes
+ * @param size the total uncompressed size of the chunks
+ * @throws Exception if the data is corrupt or does not match size
+ */
+IVW_MODULE_BASE_API void decompressChunks(const char* src,
+                                          const std::vector<size_t>& compressedSizes,
+                                          size_t chunkSize, void* dest, size_t size);
+
+}  // namespace util
+
+/**
+ * \class ChunkedVolumeRAMLoader
+ * \brief A loader of chunked, compressed raw files. Used to create VolumeRAM representations.
+ * The voxel data is stored as consecutive zlib compressed chunks of whole z slices, see
+ * util::compressChunks. The compressed chunks are read from the file in one go and decompressed
+ * in parallel. A range of slices can be read on its own with readSlices, which only touches the
+ * chunks overlapping that range. This class is used by the IvfVolumeReader.
+ */
+class IVW_MODULE_BASE_API ChunkedVolumeRAMLoader
+    : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    /**
+     * @param file the file holding the compressed chunks
+     * @param offset byte offset of the first chunk in file
+     * @param chunkSlices the number of z slices per chunk
+     * @param compressedSizes the compressed size of each chunk
+     * @param littleEndian the endianness of the uncompressed data
+     */
+    ChunkedVolumeRAMLoader(const std::string& file, size_t offset, size_t chunkSlices,
+                           std::vector<size_t> compressedSizes, bool littleEndian);
+    virtual ChunkedVolumeRAMLoader* clone() const override;
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+
+    /**
+     * Reads the z slices [zBegin, zEnd) of the volume described by src into dest, which has to
+     * hold (zEnd - zBegin) slices. Only the chunks overlapping the range are read from the file.
+     */
+    void readSlices(const VolumeRepresentation& src, size_t zBegin, size_t zEnd, void* dest) const;
+
+private:
+    std::string file_;
+    size_t offset_;
+    size_t chunkSlices_;
+    std::vector<size_t> compressedSizes_;
+    bool littleEndian_;
+};
+
+}  // namespace inviwo
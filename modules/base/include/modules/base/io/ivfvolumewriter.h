@@ -39,16 +39,40 @@ namespace inviwo {
 
 /**
  * \ingroup dataio
+ * Writes a volume as an .ivf header next to a file with the voxel data. The voxel data is either
+ * stored raw (.raw) or, with Compression::Zlib, as zlib compressed chunks of z slices (.zraw)
+ * which are compressed in parallel, see util::compressChunks and ChunkedVolumeRAMLoader.
  */
 class IVW_MODULE_BASE_API IvfVolumeWriter : public DataWriterType<Volume> {
 public:
-    IvfVolumeWriter();
+    enum class Compression { None, Zlib };
+
+    explicit IvfVolumeWriter(Compression compression = Compression::None);
     IvfVolumeWriter(const IvfVolumeWriter& rhs);
     IvfVolumeWriter& operator=(const IvfVolumeWriter& that);
     virtual IvfVolumeWriter* clone() const;
     virtual ~IvfVolumeWriter() {}
 
     virtual void writeData(const Volume* data, const std::string filePath) const;
+
+    Compression getCompression() const;
+    /**
+     * zlib compression level in [1, 9], higher is slower but smaller. Defaults to 6.
+     */
+    void setCompressionLevel(int level);
+    int getCompressionLevel() const;
+    /**
+     * Approximate uncompressed size of each compressed chunk in bytes, rounded to whole z slices.
+     * Smaller chunks make reading subsets cheaper and give more parallelism, larger chunks
+     * compress slightly better. Defaults to 1 MB.
+     */
+    void setChunkSize(size_t bytes);
+    size_t getChunkSize() const;
+
+private:
+    Compression compression_;
+    int compressionLevel_ = 6;
+    size_t chunkSize_ = 1024 * 1024;
 };
 
 }  // namespace inviwo
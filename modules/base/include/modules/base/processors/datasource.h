@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/preloadable.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/io/datareaderfactory.h>
@@ -88,9 +89,10 @@ void updateFilenameFilters(const DataReaderFactory& rf, FileProperty& file,
 /**
  * A base class for simple source processors.
  * Two functions to customize the behavior are available, dataLoaded and dataDeserialized.
+ * When loading a workspace the data is read in the background, see Preloadable.
  */
 template <typename DataType, typename PortType>
-class DataSource : public Processor {
+class DataSource : public Processor, public Preloadable {
 public:
     /**
      * Construct a DataSource
@@ -105,6 +107,7 @@ public:
 
     virtual void process() override;
     virtual void deserialize(Deserializer& d) override;
+    virtual Preloadable::Job preload() override;
 
 protected:
     void load(bool deserialized);
@@ -124,6 +127,7 @@ protected:
 
 private:
     bool deserialized_ = false;
+    util::PreloadedData<DataType> preloaded_;
 };
 
 template <typename DataType, typename PortType>
@@ -145,7 +149,7 @@ DataSource<DataType, PortType>::DataSource(InviwoApplication* app, const std::st
     // make sure that we always process even if not connected
     isSink_.setUpdate([]() { return true; });
     isReady_.setUpdate([this]() {
-        return !loadingFailed_ && filesystem::fileExists(file_.get()) &&
+        return !loadingFailed_ && !preloaded_.isPending() && filesystem::fileExists(file_.get()) &&
                !reader_.getSelectedValue().empty();
     });
     file_.onChange([this]() {
@@ -175,7 +179,8 @@ void DataSource<DataType, PortType>::load(bool deserialized) {
     const auto fext = filesystem::getFileExtension(file_.get());
     if (auto reader = rf_->template getReaderForTypeAndExtension<DataType>(sext, fext)) {
         try {
-            auto data = reader->readData(file_.get());
+            auto data = preloaded_.take(file_.get());
+            if (!data) data = reader->readData(file_.get());
             port_.setData(data);
             loadedData_ = data;
             if (deserialized) {
@@ -204,6 +209,27 @@ void DataSource<DataType, PortType>::deserialize(Deserializer& d) {
     deserialized_ = true;
 }
 
+template <typename DataType, typename PortType>
+Preloadable::Job DataSource<DataType, PortType>::preload() {
+    if (!deserialized_ || !file_.isModified() || !filesystem::fileExists(file_.get())) {
+        return nullptr;
+    }
+    const auto sext = reader_.getSelectedValue();
+    const auto fext = filesystem::getFileExtension(file_.get());
+    std::shared_ptr<DataReaderType<DataType>> reader =
+        rf_->template getReaderForTypeAndExtension<DataType>(sext, fext);
+    if (!reader || !reader->isThreadSafe()) return nullptr;
+
+    auto job = preloaded_.makeJob(
+        file_.get(), [reader, file = file_.get()]() { return reader->readData(file); },
+        [this]() {
+            isReady_.update();
+            invalidate(InvalidationLevel::InvalidOutput);
+        });
+    isReady_.update();
+    return job;
+}
+
 }  // namespace inviwo
 
 #endif  // IVW_DATASOURCE_H
@@ -31,8 +31,10 @@
 #define IVW_IMAGESOURCE_H
 
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/processors/datasource.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/preloadable.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/properties/ordinalproperty.h>
@@ -57,7 +59,7 @@ class InviwoApplication;
  *   * __File name__ The name of the file to load
  *   * __Dimensions__ Readonly, the dimensions of the loaded image.
  */
-class IVW_MODULE_BASE_API ImageSource : public Processor {
+class IVW_MODULE_BASE_API ImageSource : public Processor, public Preloadable {
 public:
     ImageSource(InviwoApplication* app, const std::string& file = "");
     virtual ~ImageSource() = default;
@@ -67,6 +69,7 @@ public:
 
     virtual void process() override;
     virtual void deserialize(Deserializer& d) override;
+    virtual Preloadable::Job preload() override;
 
 private:
     DataReaderFactory* rf_;
@@ -76,6 +79,7 @@ private:
     ButtonProperty reload_;
     IntSize2Property imageDimension_;
     bool loadingFailed_ = false;
+    util::PreloadedData<Layer> preloaded_;
 };
 
 }  // namespace inviwo
@@ -38,11 +38,14 @@
 #include <inviwo/core/properties/filepatternproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
+#include <modules/base/datastructures/sequenceprefetcher.h>
+#include <modules/base/properties/prefetchproperty.h>
 
 namespace inviwo {
 
 class FileExtension;
 class InviwoApplication;
+class Layer;
 
 /** \docpage{org.inviwo.ImageSourceSeries, Image Series Source}
  * ![](org.inviwo.ImageSourceSeries.png?classIdentifier=org.inviwo.ImageSourceSeries)
@@ -58,6 +61,7 @@ class InviwoApplication;
  *   * __Image Index__  Index of selected image file
  *   * __Image File Name__  Name of the selected file (read-only)
  *   * __Update File List__ Reload the list of matching images
+ *   * __Prefetch__ Read the following images on the thread pool ahead of time
  *
  */
 class IVW_MODULE_BASE_API ImageSourceSeries : public Processor {
@@ -75,6 +79,7 @@ protected:
     bool isValidImageFile(std::string);
     void updateProperties();
     void updateFileName();
+    std::shared_ptr<Layer> readImage(size_t index);
 
 private:
     ImageOutport outport_;
@@ -83,9 +88,11 @@ private:
     FilePatternProperty imageFilePattern_;
     IntProperty currentImageIndex_;
     StringProperty imageFileName_;
+    PrefetchProperty prefetch_;
 
     std::vector<FileExtension> validExtensions_;
     std::vector<std::string> fileList_;
+    SequencePrefetcher<Layer> prefetcher_;
 };
 
 }  // namespace inviwo
@@ -50,6 +50,7 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The mesh sequence index to extract
+ *   * __Prefetch__ Load the buffers of the following meshes from disk ahead of time
  */
 
 class IVW_MODULE_BASE_API MeshSequenceElementSelectorProcessor
@@ -55,6 +55,7 @@ public:
     virtual ~TrianglesToWireframe() = default;
 
     virtual void process() override;
+    virtual bool isThreadSafe() const override { return true; }
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
@@ -37,6 +37,8 @@
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/datastructures/sequenceprefetcher.h>
+#include <modules/base/properties/prefetchproperty.h>
 #include <modules/base/properties/sequencetimerproperty.h>
 
 namespace inviwo {
@@ -57,12 +59,39 @@ public:
     void process() override;
 
 protected:
+    /**
+     * What a PrefetchJob loaded ahead of time. release frees it again, it should only touch
+     * representations the job created itself and that nobody else is using or has modified since.
+     * Returns false if the element is still in use, release will then be retried later.
+     */
+    struct Prefetched {
+        std::function<bool()> release;
+    };
+    /**
+     * Loads an element on the thread pool and returns what was loaded together with its size in
+     * bytes, or nullptr if there was nothing to load. Will be called concurrently from several
+     * threads. The returned Prefetched should not keep the element alive.
+     */
+    using PrefetchResult = std::pair<std::shared_ptr<Prefetched>, size_t>;
+    using PrefetchJob = std::function<PrefetchResult(std::shared_ptr<T>)>;
+
+    /**
+     * Load the elements following the selected one on the thread pool ahead of time, see
+     * SequencePrefetcher. Adds a PrefetchProperty to configure it, prefetching is off by default.
+     * Meant to be called from the constructor of child classes.
+     */
+    void enablePrefetching(PrefetchJob load);
+
     DataInport<std::vector<std::shared_ptr<T>>> inport_;
     OutportType outport_;
     SequenceTimerProperty timeStep_;
 
     StringProperty name_;
     DoubleProperty timestamp_;
+
+    PrefetchProperty prefetch_;
+    SequencePrefetcher<Prefetched> prefetcher_;
+    bool prefetching_ = false;
 };
 
 template <typename T, typename OutportType>
@@ -74,7 +103,8 @@ VectorElementSelectorProcessor<T, OutportType>::VectorElementSelectorProcessor()
     , name_("name", "Name")
     , timestamp_("timestamp", "Timestamp", 0, std::numeric_limits<double>::lowest(),
                  std::numeric_limits<double>::max(), std::numeric_limits<double>::epsilon(),
-                 InvalidationLevel::Valid, PropertySemantics("Text")) {
+                 InvalidationLevel::Valid, PropertySemantics("Text"))
+    , prefetch_("prefetch", "Prefetch") {
     addPort(inport_);
     addPort(outport_);
 
@@ -127,12 +157,32 @@ VectorElementSelectorProcessor<T, OutportType>::VectorElementSelectorProcessor()
     });
 
     inport_.onChange([this]() {
+        prefetcher_.clear();
         if (inport_.hasData()) {
             timeStep_.updateMax(inport_.getData()->size());
         }
     });
 }
 
+template <typename T, typename OutportType>
+void VectorElementSelectorProcessor<T, OutportType>::enablePrefetching(PrefetchJob load) {
+    prefetching_ = true;
+    addProperty(prefetch_);
+    prefetch_.enabled_.onChange([this]() {
+        if (!prefetch_.isEnabled()) prefetcher_.clear();
+    });
+
+    prefetcher_.setEvict([](Prefetched& prefetched) {
+        return !prefetched.release || prefetched.release();
+    });
+    using Job = typename SequencePrefetcher<Prefetched>::Job;
+    prefetcher_.setMakeJob([this, load = std::move(load)](size_t index) -> Job {
+        auto data = inport_.getData();
+        if (!data || index >= data->size() || !(*data)[index]) return nullptr;
+        return [load, element = (*data)[index]]() { return load(element); };
+    });
+}
+
 template <typename T, typename OutportType>
 void VectorElementSelectorProcessor<T, OutportType>::process() {
     if (!inport_.isReady()) return;
@@ -144,6 +194,13 @@ void VectorElementSelectorProcessor<T, OutportType>::process() {
         }
         size_t index = std::min(data->size() - 1, static_cast<size_t>(timeStep_.index_.get() - 1));
 
+        if (prefetching_ && prefetch_.isEnabled()) {
+            prefetcher_.update(index, data->size(), prefetch_.getStepsAhead(),
+                               prefetch_.getMemoryBudget());
+            // make sure the selected element has been loaded before passing it on
+            prefetcher_.get(index);
+        }
+
         outport_.setData((*data)[index]);
     }
 }
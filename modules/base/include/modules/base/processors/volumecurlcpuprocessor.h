@@ -58,6 +58,7 @@ public:
     virtual ~VolumeCurlCPUProcessor() = default;
 
     virtual void process() override;
+    virtual bool isThreadSafe() const override { return true; }
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
@@ -50,6 +50,7 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Prefetch__ Load the following volumes from disk ahead of time
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
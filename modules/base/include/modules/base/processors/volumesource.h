@@ -34,8 +34,10 @@
 #include <modules/base/properties/basisproperty.h>
 #include <modules/base/properties/volumeinformationproperty.h>
 #include <modules/base/properties/sequencetimerproperty.h>
+#include <modules/base/processors/datasource.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/preloadable.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
@@ -58,7 +60,7 @@ class InviwoApplication;
  * ### Properties
  *   * __File name__ File to load.
  */
-class IVW_MODULE_BASE_API VolumeSource : public Processor {
+class IVW_MODULE_BASE_API VolumeSource : public Processor, public Preloadable {
 public:
     using VolumeSequence = std::vector<std::shared_ptr<Volume>>;
     virtual const ProcessorInfo getProcessorInfo() const override;
@@ -69,6 +71,7 @@ public:
 
     virtual void deserialize(Deserializer& d) override;
     virtual void process() override;
+    virtual Preloadable::Job preload() override;
 
 private:
     void load(bool deserialize = false);
@@ -87,6 +90,7 @@ private:
 
     bool deserialized_ = false;
     bool loadingFailed_ = false;
+    util::PreloadedData<VolumeSequence> preloaded_;
 };
 
 }  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <modules/base/algorithm/dataminmax.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumerambricked.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
@@ -44,6 +45,18 @@ std::pair<dvec4, dvec4> util::volumeMinMax(const VolumeRAM* volume, IgnoreSpecia
     });
 }
 
+std::pair<dvec4, dvec4> util::volumeMinMax(const VolumeRAMBricked* volume,
+                                           IgnoreSpecialValues ignore) {
+    std::pair<dvec4, dvec4> minMax{dvec4{std::numeric_limits<double>::max()},
+                                   dvec4{std::numeric_limits<double>::lowest()}};
+    volume->forEachBrick([&](const VolumeRAM& brick, const size3_t&) {
+        const auto brickMinMax = util::volumeMinMax(&brick, ignore);
+        minMax.first = glm::min(minMax.first, brickMinMax.first);
+        minMax.second = glm::max(minMax.second, brickMinMax.second);
+    });
+    return minMax;
+}
+
 std::pair<dvec4, dvec4> util::layerMinMax(const LayerRAM* layer, IgnoreSpecialValues ignore) {
     return layer->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto lr) -> std::pair<dvec4, dvec4> {
         const auto dim = lr->getDimensions();
@@ -58,6 +71,10 @@ std::pair<dvec4, dvec4> util::bufferMinMax(const BufferRAM* buffer, IgnoreSpecia
 }
 
 std::pair<dvec4, dvec4> util::volumeMinMax(const Volume* volume, IgnoreSpecialValues ignore) {
+    // Avoid creating a full VolumeRAM for out-of-core volumes
+    if (!volume->hasRepresentation<VolumeRAM>() && volume->hasRepresentation<VolumeRAMBricked>()) {
+        return util::volumeMinMax(volume->getRepresentation<VolumeRAMBricked>(), ignore);
+    }
     return util::volumeMinMax(volume->getRepresentation<VolumeRAM>(), ignore);
 }
 
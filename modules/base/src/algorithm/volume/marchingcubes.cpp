@@ -532,7 +532,7 @@ std::array<std::vector<Triangle>, 256> cases = {
     std::vector<Triangle>{Triangle{0, 1, 3, 0, 0, 4}},
     std::vector<Triangle>{}};
 
-void evaluateCube(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
+void evaluateCube(marching::VertexMap &vertexTree, IndexBufferRAM *indexBuffer,
                   std::vector<vec3> &positions, std::vector<vec3> &normals,
                   const std::array<vec3, 8> &pos, const std::array<double, 8> &values) {
     int index = 0;
@@ -584,7 +584,7 @@ std::shared_ptr<Mesh> marchingcubes(std::shared_ptr<const Volume> volume, double
             throw Exception("Masking callback not set", IVW_CONTEXT_CUSTOM("util::marchingcubes"));
         }
 
-        K3DTree<size_t, float> vertexTree;
+        marching::VertexMap vertexTree;
 
         auto mesh = std::make_shared<BasicMesh>();
         auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
@@ -29,6 +29,8 @@
 
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
 #include <inviwo/core/util/indexmapper.h>
 
 #include <modules/base/datastructures/disjointsets.h>
@@ -37,6 +39,8 @@
 #include <algorithm>
 #include <limits>
 #include <bitset>
+#include <numeric>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -429,137 +433,209 @@ template <typename T, typename IsoTest>
 const std::array<OffsetIndexMasks, 4> Index<T, IsoTest>::oim_ = {
     {{0, 1, {0, 0, 0}}, {3, 2, {0, 1, 0}}, {4, 5, {0, 0, 1}}, {7, 6, {0, 1, 1}}}};
 
-}  // namespace
+const marching::Config &cubeConfig() {
+    static const marching::Config cube{};
+    return cube;
+}
 
-namespace util {
-std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, double iso,
-                                       const vec4 &color, bool invert, bool enclose,
-                                       std::function<void(float)> progressCallback,
-                                       std::function<bool(const size3_t &)> maskingCallback) {
+// Marks bricks of cells whose value range straddles the iso-value
+struct ActiveBricks {
+    size_t size;
+    size3_t count;
+    std::vector<char> active;
 
-    auto indexBuffer = std::make_shared<IndexBuffer>();
-    auto vertexBuffer = std::make_shared<Buffer<vec3>>();
-    auto textureBuffer = std::make_shared<Buffer<vec3>>();
-    auto colorBuffer = std::make_shared<Buffer<vec4>>();
-    auto normalBuffer = std::make_shared<Buffer<vec3>>();
+    bool operator()(size_t x, size_t y, size_t z) const {
+        return active[x / size + count.x * ((y / size) + count.y * (z / size))];
+    }
+    // Whether any brick with cells in [zBegin, zEnd) is active
+    bool any(size_t zBegin, size_t zEnd) const {
+        const auto layer = count.x * count.y;
+        return std::any_of(active.begin() + layer * (zBegin / size),
+                           active.begin() + layer * ((zEnd - 1) / size + 1),
+                           [](char a) { return a; });
+    }
+};
 
-    auto indexRAM = indexBuffer->getEditableRAMRepresentation();
-    auto &indices = indexRAM->getDataContainer();
-    auto &positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
-    auto &textures = textureBuffer->getEditableRAMRepresentation()->getDataContainer();
-    auto &colors = colorBuffer->getEditableRAMRepresentation()->getDataContainer();
-    auto &normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
+template <typename T, typename IsoTest>
+ActiveBricks findActiveBricks(const VolumeMinMaxOctree &octree, const IsoTest &isoTest) {
+    const auto &ranges = octree.getBrickRanges();
+    ActiveBricks bricks{octree.getBrickSize(), octree.getNumberOfBricks(),
+                        std::vector<char>(ranges.size(), 0)};
+    // The iso test is a threshold, all values in a brick agree if the extremes agree
+    std::transform(ranges.begin(), ranges.end(), bricks.active.begin(), [&](const dvec2 &r) {
+        return isoTest(static_cast<T>(r.x)) != isoTest(static_cast<T>(r.y));
+    });
+    return bricks;
+}
 
-    if (progressCallback) progressCallback(0.0f);
+// (edge key, vertex index) of the vertices on the first and last z-plane of a slab
+struct SlabBorders {
+    std::vector<std::pair<size_t, uint32_t>> bottom;
+    std::vector<std::pair<size_t, uint32_t>> top;
+};
 
-    const auto mc = [&](auto ram, auto isoTest, auto mapValue) {
-        using T = util::PrecisionValueType<decltype(ram)>;
-        static const marching::Config cube{};
+/*
+ * Extract the cells with z in [zBegin, zEnd). The sliceCallback is called after each z-slice,
+ * returning false aborts the extraction.
+ */
+template <typename T, typename IsoTest, typename MapValue, typename SliceCallback>
+void extractSlab(const T *src, const size3_t &dim, size_t zBegin, size_t zEnd,
+                 const IsoTest &isoTest, const MapValue &mapValue,
+                 const std::function<bool(const size3_t &)> &maskingCallback,
+                 const ActiveBricks &bricks, std::vector<vec3> &positions,
+                 std::vector<vec3> &normals, std::vector<uint32_t> &indices, SlabBorders *borders,
+                 SliceCallback sliceCallback) {
+    const auto &cube = cubeConfig();
+
+    const size3_t dim1 = dim - size3_t{1, 1, 1};
+    const util::IndexMapper3D im(dim);
+
+    const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+    const auto doffs = [&]() {
+        std::array<dvec3, 8> tmp;
+        std::transform(cube.vertices.begin(), cube.vertices.end(), tmp.begin(),
+                       [dr](auto &v) { return dr * dvec3{v}; });
+        return tmp;
+    }();
+
+    const auto interpolate = [src, im, &mapValue, &doffs, &cube](
+                                 const size3_t &ind, const dvec3 &pos, marching::Config::EdgeId e) {
+        const auto a = cube.edges[e][0];
+        const auto b = cube.edges[e][1];
+        const auto tv0 = src[im(ind + cube.vertices[a])];
+        const auto v0 = mapValue(tv0);
+        const auto tv1 = src[im(ind + cube.vertices[b])];
+        const auto v1 = mapValue(tv1);
+
+        const auto t = v0 / (v0 - v1);
+        const auto r0 = pos + doffs[a];
+        const auto r1 = pos + doffs[b];
+        return r0 + t * (r1 - r0);
+    };
 
-        const T *src = ram->getDataTyped();
-        const size3_t dim{volume->getDimensions()};
-        const size3_t dim1 = dim - size3_t{1, 1, 1};
-        const util::IndexMapper3D im(dim);
-
-        const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
-        const auto doffs = [&]() {
-            std::array<dvec3, 8> tmp;
-            std::transform(cube.vertices.begin(), cube.vertices.end(), tmp.begin(),
-                           [dr](auto &v) { return dr * dvec3{v}; });
-            return tmp;
-        }();
-
-        const auto interpolate = [src, im, &mapValue, &doffs](const size3_t &ind, const dvec3 &pos,
-                                                              marching::Config::EdgeId e) {
-            const auto a = cube.edges[e][0];
-            const auto b = cube.edges[e][1];
-            const auto tv0 = src[im(ind + cube.vertices[a])];
-            const auto v0 = mapValue(tv0);
-            const auto tv1 = src[im(ind + cube.vertices[b])];
-            const auto v1 = mapValue(tv1);
-
-            const auto t = v0 / (v0 - v1);
-            const auto r0 = pos + doffs[a];
-            const auto r1 = pos + doffs[b];
-            return r0 + t * (r1 - r0);
-        };
+    // An edge is identified by its lower corner and its axis
+    const auto edgeKeys = [&]() {
+        std::array<std::pair<size3_t, size_t>, 12> tmp;
+        for (size_t e = 0; e < 12; ++e) {
+            const auto &a = cube.vertices[cube.edges[e][0]];
+            const auto &b = cube.vertices[cube.edges[e][1]];
+            tmp[e] = {glm::min(a, b), a.x != b.x ? 0 : (a.y != b.y ? 1 : 2)};
+        }
+        return tmp;
+    }();
+    const auto edgeKey = [&](const size3_t &ind, size_t e) {
+        return 3 * im(ind + edgeKeys[e].first) + edgeKeys[e].second;
+    };
 
-        VCache vcache(size2_t{dim.x, dim.y});
-        Index<T, decltype(isoTest)> index(src, im, isoTest);
-        size3_t ind;
-        dvec3 pos;
-
-        const float err =
-            static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
-
-        for (ind.z = 0, pos.z = 0.0; ind.z < dim1.z; ++ind.z, pos.z += dr.z) {
-            vcache.incZ();
-            for (ind.y = 0, pos.y = 0.0; ind.y < dim1.y; ++ind.y, pos.y += dr.y) {
-                ind.x = 0;
-                const auto cInd = im(ind);
-                vcache.incY();
-                index.init(cInd);
-                for (pos.x = 0.0; ind.x < dim1.x; ++ind.x, pos.x += dr.x) {
-                    index.update(cInd + ind.x);
-                    if (index == 0 || index == 255) continue;
-                    if (maskingCallback && !maskingCallback(ind)) continue;
-
-                    std::array<size_t, 12> inds;
-                    for (const auto edge : cube.caseEdges[index]) {
-                        const auto c = vcache.find(ind, edge, positions.size());
-                        inds[edge] = c.first;
-                        if (c.second) {
-                            const auto vertex = interpolate(ind, pos, edge);
-                            positions.emplace_back(vertex);
-                            normals.emplace_back(0.0f, 0.0f, 0.0f);
-                        }
+    VCache vcache(size2_t{dim.x, dim.y});
+    Index<T, IsoTest> index(src, im, isoTest);
+    size3_t ind;
+    dvec3 pos;
+
+    const float err =
+        static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
+
+    for (ind.z = zBegin, pos.z = dr.z * zBegin; ind.z < zEnd; ++ind.z, pos.z += dr.z) {
+        vcache.incZ();
+        for (ind.y = 0, pos.y = 0.0; ind.y < dim1.y; ++ind.y, pos.y += dr.y) {
+            ind.x = 0;
+            const auto cInd = im(ind);
+            vcache.incY();
+            index.init(cInd);
+            size_t brickEnd = 0;
+            for (pos.x = 0.0; ind.x < dim1.x; ++ind.x, pos.x += dr.x) {
+                if (ind.x == brickEnd) {
+                    // All cells of inactive bricks are either inside or outside, skip them
+                    const auto brickBegin = ind.x;
+                    while (ind.x < dim1.x && !bricks(ind.x, ind.y, ind.z)) {
+                        ind.x = std::min(ind.x + bricks.size, dim1.x);
                     }
-                    for (const auto &tri : cube.caseTriangles[index]) {
-                        const auto side0 = positions[inds[tri[1]]] - positions[inds[tri[0]]];
-                        const auto side1 = positions[inds[tri[2]]] - positions[inds[tri[0]]];
-                        auto n = glm::cross(side0, side1);
-                        if (glm::length2(n) < err) {
-                            continue;  // triangle is so small area is 0.
-                        }
-                        n = glm::normalize(n);
-                        for (int v = 0; v < 3; ++v) {
-                            indices.push_back(static_cast<uint32_t>(inds[tri[v]]));
-                            normals[inds[tri[v]]] += n;
+                    if (ind.x == dim1.x) break;
+                    brickEnd = std::min(ind.x + bricks.size, dim1.x);
+                    if (ind.x != brickBegin) {
+                        pos.x = dr.x * ind.x;
+                        index.init(cInd + ind.x);
+                    }
+                }
+                index.update(cInd + ind.x);
+                if (index == 0 || index == 255) continue;
+                if (maskingCallback && !maskingCallback(ind)) continue;
+
+                // The vertex cache is relative to the first slice of the slab
+                const size3_t cacheInd{ind.x, ind.y, ind.z - zBegin};
+                std::array<size_t, 12> inds;
+                for (const auto edge : cube.caseEdges[index]) {
+                    const auto c = vcache.find(cacheInd, edge, positions.size());
+                    inds[edge] = c.first;
+                    if (c.second) {
+                        const auto vertex = interpolate(ind, pos, edge);
+                        positions.emplace_back(vertex);
+                        normals.emplace_back(0.0f, 0.0f, 0.0f);
+                        if (borders) {
+                            if (edge < 4 && ind.z == zBegin) {
+                                borders->bottom.emplace_back(edgeKey(ind, edge),
+                                                             static_cast<uint32_t>(c.first));
+                            } else if (edge >= 8 && ind.z + 1 == zEnd) {
+                                borders->top.emplace_back(edgeKey(ind, edge),
+                                                          static_cast<uint32_t>(c.first));
+                            }
                         }
                     }
-                    vcache.incX(cube.caseIncrements[index]);
                 }
-            }
-            if (progressCallback) {
-                progressCallback(static_cast<float>(ind.z + 1) / static_cast<float>(dim.z - 1));
+                for (const auto &tri : cube.caseTriangles[index]) {
+                    const auto side0 = positions[inds[tri[1]]] - positions[inds[tri[0]]];
+                    const auto side1 = positions[inds[tri[2]]] - positions[inds[tri[0]]];
+                    auto n = glm::cross(side0, side1);
+                    if (glm::length2(n) < err) {
+                        continue;  // triangle is so small area is 0.
+                    }
+                    n = glm::normalize(n);
+                    for (int v = 0; v < 3; ++v) {
+                        indices.push_back(static_cast<uint32_t>(inds[tri[v]]));
+                        normals[inds[tri[v]]] += n;
+                    }
+                }
+                vcache.incX(cube.caseIncrements[index]);
             }
         }
+        if (!sliceCallback(ind.z)) return;
+    }
+}
 
-        if (enclose) {
-            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
-                                    dr.z);
-        }
-    };
+template <typename Func>
+void dispatchIsoTest(const Volume &volume, double iso, bool invert, Func &&func) {
     if (invert) {
-        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        volume.getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
             [&](auto ram) {
                 using ValueType = util::PrecisionValueType<decltype(ram)>;
-                mc(ram,
-                   [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val > tiso; },
-                   [iso](auto &&val) { return util::glm_convert<double>(val) - iso; });
+                func(ram,
+                     [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val > tiso; },
+                     [iso](auto &&val) { return util::glm_convert<double>(val) - iso; });
             });
     } else {
-        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+        volume.getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
             [&](auto ram) {
                 using ValueType = util::PrecisionValueType<decltype(ram)>;
-                mc(ram,
-                   [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val < tiso; },
-                   [iso](auto &&val) { return -(util::glm_convert<double>(val) - iso); });
+                func(ram,
+                     [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val < tiso; },
+                     [iso](auto &&val) { return -(util::glm_convert<double>(val) - iso); });
             });
     }
+}
+
+std::shared_ptr<Mesh> createMesh(const Volume &volume, std::shared_ptr<IndexBuffer> indexBuffer,
+                                 std::shared_ptr<Buffer<vec3>> vertexBuffer,
+                                 std::shared_ptr<Buffer<vec3>> normalBuffer, const vec4 &color) {
+    auto &positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto &normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
 
     ivwAssert(positions.size() == normals.size(), "positions and normals must be equal size");
 
+    auto textureBuffer = std::make_shared<Buffer<vec3>>();
+    auto colorBuffer = std::make_shared<Buffer<vec4>>();
+    auto &textures = textureBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto &colors = colorBuffer->getEditableRAMRepresentation()->getDataContainer();
+
     std::transform(normals.begin(), normals.end(), normals.begin(),
                    [](const vec3 &n) { return glm::normalize(n); });
     textures.insert(textures.begin(), positions.begin(), positions.end());
@@ -567,18 +643,192 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
     std::fill_n(std::back_inserter(colors), positions.size(), color);
 
     auto mesh = std::make_shared<Mesh>();
-    mesh->setModelMatrix(volume->getModelMatrix());
-    mesh->setWorldMatrix(volume->getWorldMatrix());
+    mesh->setModelMatrix(volume.getModelMatrix());
+    mesh->setWorldMatrix(volume.getWorldMatrix());
     mesh->addIndices({DrawType::Triangles, ConnectivityType::None}, indexBuffer);
     mesh->addBuffer(BufferType::PositionAttrib, vertexBuffer);
     mesh->addBuffer(BufferType::TexcoordAttrib, textureBuffer);
     mesh->addBuffer(BufferType::ColorAttrib, colorBuffer);
     mesh->addBuffer(BufferType::NormalAttrib, normalBuffer);
+    return mesh;
+}
+
+}  // namespace
+
+namespace util {
+std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, double iso,
+                                       const vec4 &color, bool invert, bool enclose,
+                                       std::function<void(float)> progressCallback,
+                                       std::function<bool(const size3_t &)> maskingCallback) {
+
+    auto indexBuffer = std::make_shared<IndexBuffer>();
+    auto vertexBuffer = std::make_shared<Buffer<vec3>>();
+    auto normalBuffer = std::make_shared<Buffer<vec3>>();
+
+    auto indexRAM = indexBuffer->getEditableRAMRepresentation();
+    auto &indices = indexRAM->getDataContainer();
+    auto &positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto &normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
+
+    if (progressCallback) progressCallback(0.0f);
+
+    const size3_t dim{volume->getDimensions()};
+    dispatchIsoTest(*volume, iso, invert, [&](auto ram, auto isoTest, auto mapValue) {
+        using T = util::PrecisionValueType<decltype(ram)>;
+        const T *src = ram->getDataTyped();
+
+        const auto bricks = findActiveBricks<T>(*volume->getMinMaxOctree(), isoTest);
+        extractSlab(src, dim, 0, dim.z - 1, isoTest, mapValue, maskingCallback, bricks, positions,
+                    normals, indices, nullptr, [&](size_t z) {
+                        if (progressCallback) {
+                            progressCallback(static_cast<float>(z + 1) /
+                                             static_cast<float>(dim.z - 1));
+                        }
+                        return true;
+                    });
+
+        if (enclose) {
+            const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
+                                    dr.z);
+        }
+    });
+
+    auto mesh = createMesh(*volume, indexBuffer, vertexBuffer, normalBuffer, color);
+
+    if (progressCallback) progressCallback(1.0f);
+
+    return mesh;
+}
+
+std::shared_ptr<Mesh> marchingCubesOptParallel(std::shared_ptr<const Volume> volume, double iso,
+                                               const vec4 &color, bool invert, bool enclose,
+                                               std::function<void(float)> progressCallback,
+                                               std::function<bool()> stopCallback,
+                                               std::function<bool(const size3_t &)> maskingCallback,
+                                               size_t jobs) {
+    const auto stopped = [&]() { return stopCallback && stopCallback(); };
+
+    auto indexBuffer = std::make_shared<IndexBuffer>();
+    auto vertexBuffer = std::make_shared<Buffer<vec3>>();
+    auto normalBuffer = std::make_shared<Buffer<vec3>>();
+
+    auto indexRAM = indexBuffer->getEditableRAMRepresentation();
+    auto &indices = indexRAM->getDataContainer();
+    auto &positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto &normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
+
+    if (progressCallback) progressCallback(0.0f);
+
+    const bool usePool =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    if (jobs == 0) {
+        jobs = usePool ? 4 * InviwoApplication::getPtr()->getPoolSize() : 1;
+    }
+
+    const size3_t dim{volume->getDimensions()};
+    const size_t cells = dim.z > 1 ? dim.z - 1 : 0;
+    jobs = std::max(size_t{1}, std::min(jobs, cells));
+
+    struct Slab {
+        std::vector<vec3> positions;
+        std::vector<vec3> normals;
+        std::vector<uint32_t> indices;
+        SlabBorders borders;
+    };
+    std::vector<Slab> slabs(jobs);
+
+    dispatchIsoTest(*volume, iso, invert, [&](auto ram, auto isoTest, auto mapValue) {
+        using T = util::PrecisionValueType<decltype(ram)>;
+        const T *src = ram->getDataTyped();
+        const auto bricks = findActiveBricks<T>(*volume->getMinMaxOctree(), isoTest);
+
+        const auto extract = [&](size_t job) {
+            const auto zBegin = job * cells / jobs;
+            const auto zEnd = (job + 1) * cells / jobs;
+            if (zBegin == zEnd || stopped() || !bricks.any(zBegin, zEnd)) return;
+
+            auto &slab = slabs[job];
+            extractSlab(src, dim, zBegin, zEnd, isoTest, mapValue, maskingCallback, bricks,
+                        slab.positions, slab.normals, slab.indices, &slab.borders,
+                        [&](size_t) { return !stopped(); });
+        };
+
+        if (usePool) {
+            std::vector<std::future<void>> futures;
+            for (size_t job = 0; job < jobs; ++job) {
+                futures.push_back(dispatchPool([&extract, job]() { extract(job); }));
+            }
+            auto &pool = InviwoApplication::getPtr()->getThreadPool();
+            for (size_t job = 0; job < jobs; ++job) {
+                pool.wait(futures[job]);
+                futures[job].get();
+                if (progressCallback) progressCallback(0.9f * (job + 1) / jobs);
+            }
+        } else {
+            for (size_t job = 0; job < jobs; ++job) {
+                extract(job);
+                if (progressCallback) progressCallback(0.9f * (job + 1) / jobs);
+            }
+        }
+        if (stopped()) return;
+
+        // Merge the slabs in order. Vertices on the first plane of a slab were also created by
+        // the previous slab on its last plane, map those to the already merged vertex.
+        const auto nPositions = std::accumulate(
+            slabs.begin(), slabs.end(), size_t{0},
+            [](size_t sum, const Slab &slab) { return sum + slab.positions.size(); });
+        const auto nIndices = std::accumulate(
+            slabs.begin(), slabs.end(), size_t{0},
+            [](size_t sum, const Slab &slab) { return sum + slab.indices.size(); });
+        positions.reserve(nPositions);
+        normals.reserve(nPositions);
+        indices.reserve(nIndices);
+
+        constexpr auto unmapped = std::numeric_limits<uint32_t>::max();
+        std::unordered_map<size_t, uint32_t> previousTop;
+        std::vector<uint32_t> remap;
+        for (auto &slab : slabs) {
+            remap.assign(slab.positions.size(), unmapped);
+            for (const auto &[key, local] : slab.borders.bottom) {
+                auto it = previousTop.find(key);
+                if (it != previousTop.end()) {
+                    remap[local] = it->second;
+                    normals[it->second] += slab.normals[local];
+                }
+            }
+            for (size_t local = 0; local < slab.positions.size(); ++local) {
+                if (remap[local] != unmapped) continue;
+                remap[local] = static_cast<uint32_t>(positions.size());
+                positions.push_back(slab.positions[local]);
+                normals.push_back(slab.normals[local]);
+            }
+            std::transform(slab.indices.begin(), slab.indices.end(), std::back_inserter(indices),
+                           [&](uint32_t i) { return remap[i]; });
+
+            previousTop.clear();
+            for (const auto &[key, local] : slab.borders.top) {
+                previousTop.emplace(key, remap[local]);
+            }
+            slab = Slab{};
+        }
+
+        if (enclose) {
+            const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
+                                    dr.z);
+        }
+    });
+
+    if (stopped()) return nullptr;
+
+    auto mesh = createMesh(*volume, indexBuffer, vertexBuffer, normalBuffer, color);
 
     if (progressCallback) progressCallback(1.0f);
 
     return mesh;
 }
+
 }  // namespace util
 
 }  // namespace inviwo
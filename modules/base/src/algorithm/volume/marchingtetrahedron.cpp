@@ -29,6 +29,7 @@
 
 #include <modules/base/algorithm/volume/marchingtetrahedron.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
 
 namespace inviwo {
 
@@ -60,7 +61,7 @@ const static std::array<std::array<size_t, 4>, 6> tetras = {
     std::array<size_t, 4>{2, 3, 5, 6}, std::array<size_t, 4>{0, 3, 4, 5},
     std::array<size_t, 4>{7, 4, 3, 5}, std::array<size_t, 4>{7, 6, 5, 3}};
 
-void evaluateTetra(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
+void evaluateTetra(marching::VertexMap &vertexTree, IndexBufferRAM *indexBuffer,
                    std::vector<vec3> &positions, std::vector<vec3> &normals, const glm::vec3 &p0,
                    double v0, const glm::vec3 &p1, double v1, const glm::vec3 &p2, double v2,
                    const glm::vec3 &p3, double v3) {
@@ -168,7 +169,7 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
                             IVW_CONTEXT_CUSTOM("util::marchingtetrahedron"));
         }
 
-        K3DTree<size_t, float> vertexTree;
+        marching::VertexMap vertexTree;
 
         auto mesh = std::make_shared<BasicMesh>();
         auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
@@ -187,6 +188,17 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
         dy = 1.0 / static_cast<double>(std::max(size_t(1), (dim.y - 1)));
         dz = 1.0 / static_cast<double>(std::max(size_t(1), (dim.z - 1)));
 
+        // Cells in bricks where all values are on the same side of the iso-value are skipped
+        const auto octree = volume->getMinMaxOctree();
+        const auto numBricks = octree->getNumberOfBricks();
+        std::vector<char> activeBricks(octree->getBrickRanges().size());
+        std::transform(octree->getBrickRanges().begin(), octree->getBrickRanges().end(),
+                       activeBricks.begin(), [&](const dvec2& r) {
+                           const auto v0 = invert ? r.x - iso : -(r.x - iso);
+                           const auto v1 = invert ? r.y - iso : -(r.y - iso);
+                           return (v0 > 0) != (v1 > 0);
+                       });
+
         const auto volSize = dim.x * dim.y * dim.z;
         indexBuffer->getDataContainer().reserve(volSize * 6);
         positions.reserve(volSize * 6);
@@ -195,6 +207,10 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
         for (size_t k = 0; k < dim.z - 1; k++) {
             for (size_t j = 0; j < dim.y - 1; j++) {
                 for (size_t i = 0; i < dim.x - 1; i++) {
+                    const auto brick = octree->getBrick({i, j, k});
+                    if (!activeBricks[brick.x + numBricks.x * (brick.y + numBricks.y * brick.z)]) {
+                        continue;
+                    }
                     if (!maskingCallback({i, j, k})) continue;
                     double x = dx * i;
                     double y = dy * j;
@@ -40,7 +40,7 @@ glm::vec3 interpolate(const glm::vec3 &p0, double v0, const glm::vec3 &p1, doubl
     return p0 + t * (p1 - p0);
 }
 
-void evaluateTriangle(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
+void evaluateTriangle(VertexMap &vertexTree, IndexBufferRAM *indexBuffer,
                       std::vector<vec3> &positions, std::vector<vec3> &normals, const glm::vec3 &p0,
                       double v0, const glm::vec3 &p1, double v1, const glm::vec3 &p2, double v2) {
     int index = 0;
@@ -82,8 +82,8 @@ void evaluateTriangle(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexB
     }
 }
 
-size_t addVertex(K3DTree<size_t, float> &vertexTree, std::vector<vec3> &positions,
-                 std::vector<vec3> &normals, const vec3 pos) {
+size_t addVertex(VertexMap &vertexTree, std::vector<vec3> &positions, std::vector<vec3> &normals,
+                 const vec3 pos) {
     auto nearest = vertexTree.findNearest(vec3(pos));
     const auto nearestPos = [&]() {
         return vec3{nearest->getPosition()[0], nearest->getPosition()[1],
@@ -97,9 +97,9 @@ size_t addVertex(K3DTree<size_t, float> &vertexTree, std::vector<vec3> &position
     return nearest->get();
 }
 
-void addTriangle(K3DTree<size_t, float> &vertexTree, IndexBufferRAM *indexBuffer,
-                 std::vector<vec3> &positions, std::vector<vec3> &normals, const glm::vec3 &a,
-                 const glm::vec3 &b, const glm::vec3 &c) {
+void addTriangle(VertexMap &vertexTree, IndexBufferRAM *indexBuffer, std::vector<vec3> &positions,
+                 std::vector<vec3> &normals, const glm::vec3 &a, const glm::vec3 &b,
+                 const glm::vec3 &c) {
     size_t i0 = addVertex(vertexTree, positions, normals, a);
     size_t i1 = addVertex(vertexTree, positions, normals, b);
     size_t i2 = addVertex(vertexTree, positions, normals, c);
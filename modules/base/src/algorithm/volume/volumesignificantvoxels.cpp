@@ -29,9 +29,13 @@
 
 #include <modules/base/algorithm/volume/volumesignificantvoxels.h>
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
+#include <inviwo/core/util/indexmapper.h>
 
 #include <algorithm>
+#include <type_traits>
 
 namespace inviwo {
 
@@ -54,4 +58,68 @@ size_t util::volumeSignificantVoxels(const VolumeRAM* volume, IgnoreSpecialValue
     });
 }
 
+size_t util::volumeSignificantVoxels(const Volume& volume, IgnoreSpecialValues ignore) {
+    const auto volumeRAM = volume.getRepresentation<VolumeRAM>();
+    if (volumeRAM->getDataFormat()->getComponents() != 1) {
+        return volumeSignificantVoxels(volumeRAM, ignore);
+    }
+    const auto octree = volume.getMinMaxOctree();
+
+    return volumeRAM->dispatch<size_t, dispatching::filter::Scalars>([&](auto vr) -> size_t {
+        using ValueType = util::PrecisionValueType<decltype(vr)>;
+
+        const auto significant = [ignore](const ValueType& v) {
+            if (ignore == IgnoreSpecialValues::Yes && !(v != v + ValueType(1))) return false;
+            return v != ValueType(0);
+        };
+        // The brick ranges do not tell whether a brick contains infinite values next to finite
+        // ones, so whole bricks can only be counted when there are no special values to ignore.
+        const bool countBricks =
+            std::is_integral<ValueType>::value || ignore == IgnoreSpecialValues::No;
+
+        const auto data = vr->getDataTyped();
+        const auto dim = vr->getDimensions();
+        const util::IndexMapper3D im(dim);
+        const auto bricks = octree->getNumberOfBricks();
+
+        size_t count = 0;
+        for (size_t bz = 0; bz < bricks.z; ++bz) {
+            for (size_t by = 0; by < bricks.y; ++by) {
+                for (size_t bx = 0; bx < bricks.x; ++bx) {
+                    const size3_t brick{bx, by, bz};
+                    const auto range = octree->getBrickRange(brick);
+                    // NaN values are not part of the range, but are significant unless ignored
+                    const bool nan = octree->containsNaN(brick);
+                    if (range.x == 0.0 && range.y == 0.0 &&
+                        (!nan || ignore == IgnoreSpecialValues::Yes)) {
+                        continue;
+                    }
+
+                    // Bricks share their border voxels, only count the voxels up to the next
+                    // brick, except for the last brick along each axis.
+                    const auto offset = octree->getBrickOffset(brick);
+                    size3_t size{octree->getBrickSize()};
+                    for (int i = 0; i < 3; ++i) {
+                        if (brick[i] + 1 == bricks[i]) size[i] = dim[i] - offset[i];
+                    }
+
+                    if (countBricks && !nan && (range.x > 0.0 || range.y < 0.0) &&
+                        significant(static_cast<ValueType>(range.x)) &&
+                        significant(static_cast<ValueType>(range.y))) {
+                        count += size.x * size.y * size.z;
+                        continue;
+                    }
+                    for (size_t z = offset.z; z < offset.z + size.z; ++z) {
+                        for (size_t y = offset.y; y < offset.y + size.y; ++y) {
+                            const auto row = data + im(offset.x, y, z);
+                            count += std::count_if(row, row + size.x, significant);
+                        }
+                    }
+                }
+            }
+        }
+        return count;
+    });
+}
+
 }  // namespace inviwo
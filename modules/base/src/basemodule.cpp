@@ -102,6 +102,7 @@
 #include <modules/base/properties/bufferinformationproperty.h>
 #include <modules/base/properties/volumeinformationproperty.h>
 #include <modules/base/properties/sequencetimerproperty.h>
+#include <modules/base/properties/prefetchproperty.h>
 #include <modules/base/properties/stipplingproperty.h>
 
 // Io
@@ -208,6 +209,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<InputSelector<ImageMultiInport, ImageOutport>>();
 
     registerProperty<SequenceTimerProperty>();
+    registerProperty<PrefetchProperty>();
     registerProperty<BasisProperty>();
     registerProperty<ImageInformationProperty>();
     registerProperty<LayerInformationProperty>();
@@ -233,6 +235,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     // Register Data writers
     registerDataWriter(std::make_unique<DatVolumeWriter>());
     registerDataWriter(std::make_unique<IvfVolumeWriter>());
+    registerDataWriter(std::make_unique<IvfVolumeWriter>(IvfVolumeWriter::Compression::Zlib));
     registerDataWriter(std::make_unique<StlWriter>());
     registerDataWriter(std::make_unique<BinarySTLWriter>());
     registerDataWriter(std::make_unique<WaveFrontWriter>());
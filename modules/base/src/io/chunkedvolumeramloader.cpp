@@ -0,0 +1,219 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/chunkedvolumeramloader.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+
+#include <zlib.h>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Calls func(i) for all i in [0, count) on the thread pool, or directly if there is no pool.
+ * Rethrows the first exception thrown by func.
+ */
+template <typename Func>
+void forEachChunk(size_t count, Func&& func) {
+    const bool usePool =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    if (!usePool || count < 2) {
+        for (size_t i = 0; i < count; ++i) func(i);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        futures.push_back(dispatchPool([&func, i]() { func(i); }));
+    }
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    for (auto& future : futures) pool.wait(future);
+    for (auto& future : futures) future.get();
+}
+
+}  // namespace
+
+std::vector<std::vector<char>> util::compressChunks(const void* data, size_t size,
+                                                    size_t chunkSize, int level) {
+    if (chunkSize == 0) {
+        throw Exception("Chunk size must be positive", IVW_CONTEXT_CUSTOM("util::compressChunks"));
+    }
+    const auto src = static_cast<const Bytef*>(data);
+    std::vector<std::vector<char>> chunks((size + chunkSize - 1) / chunkSize);
+
+    forEachChunk(chunks.size(), [&](size_t i) {
+        const auto begin = i * chunkSize;
+        const auto bytes = static_cast<uLong>(std::min(chunkSize, size - begin));
+        auto compressedSize = compressBound(bytes);
+        chunks[i].resize(compressedSize);
+        if (compress2(reinterpret_cast<Bytef*>(chunks[i].data()), &compressedSize, src + begin,
+                      bytes, level) != Z_OK) {
+            throw Exception("zlib failed to compress chunk " + std::to_string(i),
+                            IVW_CONTEXT_CUSTOM("util::compressChunks"));
+        }
+        chunks[i].resize(compressedSize);
+    });
+    return chunks;
+}
+
+void util::decompressChunks(const char* src, const std::vector<size_t>& compressedSizes,
+                            size_t chunkSize, void* dest, size_t size) {
+    if (compressedSizes.size() != (size + chunkSize - 1) / std::max(chunkSize, size_t{1})) {
+        throw Exception("Number of chunks does not match the data size",
+                        IVW_CONTEXT_CUSTOM("util::decompressChunks"));
+    }
+    if (compressedSizes.empty()) return;
+
+    std::vector<size_t> offsets(compressedSizes.size(), 0);
+    std::partial_sum(compressedSizes.begin(), compressedSizes.end() - 1, offsets.begin() + 1);
+
+    const auto dst = static_cast<Bytef*>(dest);
+    forEachChunk(compressedSizes.size(), [&](size_t i) {
+        const auto begin = i * chunkSize;
+        const auto bytes = static_cast<uLongf>(std::min(chunkSize, size - begin));
+        auto uncompressedSize = bytes;
+        if (uncompress(dst + begin, &uncompressedSize,
+                       reinterpret_cast<const Bytef*>(src + offsets[i]),
+                       static_cast<uLong>(compressedSizes[i])) != Z_OK ||
+            uncompressedSize != bytes) {
+            throw Exception("Corrupt compressed data in chunk " + std::to_string(i),
+                            IVW_CONTEXT_CUSTOM("util::decompressChunks"));
+        }
+    });
+}
+
+ChunkedVolumeRAMLoader::ChunkedVolumeRAMLoader(const std::string& file, size_t offset,
+                                               size_t chunkSlices,
+                                               std::vector<size_t> compressedSizes,
+                                               bool littleEndian)
+    : file_(file)
+    , offset_(offset)
+    , chunkSlices_(std::max(chunkSlices, size_t{1}))
+    , compressedSizes_(std::move(compressedSizes))
+    , littleEndian_(littleEndian) {}
+
+ChunkedVolumeRAMLoader* ChunkedVolumeRAMLoader::clone() const {
+    return new ChunkedVolumeRAMLoader(*this);
+}
+
+std::shared_ptr<VolumeRepresentation> ChunkedVolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+
+    const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+    auto data = std::make_unique<char[]>(size);
+    readSlices(src, 0, src.getDimensions().z, data.get());
+
+    auto volumeRAM =
+        createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(), src.getSwizzleMask(),
+                        src.getInterpolation(), src.getWrapping());
+    data.release();
+
+    return volumeRAM;
+}
+
+void ChunkedVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                                  const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+
+    if (src.getDimensions() != volumeDst->getDimensions()) {
+        volumeDst->setDimensions(src.getDimensions());
+    }
+
+    readSlices(src, 0, src.getDimensions().z, volumeDst->getData());
+
+    volumeDst->setSwizzleMask(src.getSwizzleMask());
+    volumeDst->setInterpolation(src.getInterpolation());
+    volumeDst->setWrapping(src.getWrapping());
+}
+
+void ChunkedVolumeRAMLoader::readSlices(const VolumeRepresentation& src, size_t zBegin,
+                                        size_t zEnd, void* dest) const {
+    const auto dims = src.getDimensions();
+    if (zBegin > zEnd || zEnd > dims.z) {
+        throw DataReaderException("Slice range outside of the volume", IVW_CONTEXT);
+    }
+    if (zBegin == zEnd) return;
+
+    const auto elementSize = src.getDataFormat()->getSize();
+    const auto sliceBytes = dims.x * dims.y * elementSize;
+    const auto chunkBytes = sliceBytes * chunkSlices_;
+    const auto firstChunk = zBegin / chunkSlices_;
+    const auto lastChunk = (zEnd - 1) / chunkSlices_ + 1;
+    if (compressedSizes_.size() != (dims.z + chunkSlices_ - 1) / chunkSlices_) {
+        throw DataReaderException("Chunks of " + file_ + " do not match the volume dimensions",
+                                  IVW_CONTEXT);
+    }
+
+    const std::vector<size_t> sizes(compressedSizes_.begin() + firstChunk,
+                                    compressedSizes_.begin() + lastChunk);
+    const auto skipped = std::accumulate(compressedSizes_.begin(),
+                                         compressedSizes_.begin() + firstChunk, size_t{0});
+    const auto compressedBytes = std::accumulate(sizes.begin(), sizes.end(), size_t{0});
+
+    // Read all needed chunks at once, fewer but larger reads are faster on network file systems
+    std::vector<char> compressed(compressedBytes);
+    util::readBytesIntoBuffer(file_, offset_ + skipped, compressedBytes, true, 1,
+                              compressed.data());
+
+    const auto begin = firstChunk * chunkBytes;
+    const auto end = std::min(dims.z * sliceBytes, lastChunk * chunkBytes);
+    const auto dst = static_cast<char*>(dest);
+    const auto bytes = (zEnd - zBegin) * sliceBytes;
+    try {
+        if (begin == zBegin * sliceBytes && end == zEnd * sliceBytes) {
+            util::decompressChunks(compressed.data(), sizes, chunkBytes, dst, bytes);
+        } else {
+            // The range does not start or end on a chunk boundary, decompress to a temporary
+            std::vector<char> chunks(end - begin);
+            util::decompressChunks(compressed.data(), sizes, chunkBytes, chunks.data(),
+                                   chunks.size());
+            const auto first = chunks.begin() + (zBegin * sliceBytes - begin);
+            std::copy(first, first + bytes, dst);
+        }
+    } catch (const Exception& e) {
+        throw DataReaderException("Error reading " + file_ + ": " + e.getMessage(), IVW_CONTEXT);
+    }
+
+    if (!littleEndian_ && elementSize > 1) {
+        for (size_t i = 0; i < bytes; i += elementSize) {
+            std::reverse(dst + i, dst + i + elementSize);
+        }
+    }
+}
+
+}  // namespace inviwo
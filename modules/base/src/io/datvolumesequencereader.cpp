@@ -342,8 +342,9 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
                                                          state.wrapping);
             const auto filePos = t * bytes + state.byteOffset;
 
-            auto loader = std::make_unique<RawVolumeRAMLoader>(fileDirectory + "/" + state.rawFile,
-                                                               filePos, state.littleEndian);
+            auto loader = std::make_unique<RawVolumeRAMLoader>(
+                fileDirectory + "/" + state.rawFile, filePos, state.littleEndian,
+                RawVolumeRAMLoader::isMemoryMappingEnabled());
             diskRepr->setLoader(loader.release());
             volumes->back()->addRepresentation(diskRepr);
             // Compute data range if not specified
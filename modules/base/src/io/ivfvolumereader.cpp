@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/io/rawvolumeramloader.h>
+#include <modules/base/io/chunkedvolumeramloader.h>
 
 namespace inviwo {
 
@@ -75,6 +76,20 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.deserialize("Interpolation", interpolation);
     d.deserialize("Wrapping", wrapping);
 
+    std::string compression;
+    size_t chunkSlices = 0;
+    std::vector<size_t> chunkSizes;
+    d.deserialize("Compression", compression);
+    if (!compression.empty()) {
+        if (compression != "zlib") {
+            throw DataReaderException("Unsupported compression \"" + compression + "\" in " +
+                                          filePath,
+                                      IVW_CONTEXT);
+        }
+        d.deserialize("ChunkSlices", chunkSlices);
+        d.deserialize("ChunkSizes", chunkSizes, "Chunk");
+    }
+
     auto volume =
         std::make_shared<Volume>(dimensions, format, swizzleMask, interpolation, wrapping);
     mat4 basisAndOffset = volume->getModelMatrix();
@@ -93,8 +108,15 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
                                            wrapping);
 
-    auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
-    vd->setLoader(loader.release());
+    if (compression.empty()) {
+        auto loader = std::make_unique<RawVolumeRAMLoader>(
+            rawFile, byteOffset, littleEndian, RawVolumeRAMLoader::isMemoryMappingEnabled());
+        vd->setLoader(loader.release());
+    } else {
+        auto loader = std::make_unique<ChunkedVolumeRAMLoader>(
+            rawFile, byteOffset, chunkSlices, std::move(chunkSizes), littleEndian);
+        vd->setLoader(loader.release());
+    }
 
     volume->addRepresentation(vd);
     return volume;
@@ -31,17 +31,34 @@
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/io/datawriterexception.h>
+#include <modules/base/io/chunkedvolumeramloader.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
-IvfVolumeWriter::IvfVolumeWriter() : DataWriterType<Volume>() {
-    addExtension(FileExtension("ivf", "Inviwo ivf file format"));
+IvfVolumeWriter::IvfVolumeWriter(Compression compression)
+    : DataWriterType<Volume>(), compression_{compression} {
+    if (compression_ == Compression::Zlib) {
+        addExtension(FileExtension("ivf", "Inviwo ivf file format (zlib compressed)"));
+    } else {
+        addExtension(FileExtension("ivf", "Inviwo ivf file format"));
+    }
 }
 
-IvfVolumeWriter::IvfVolumeWriter(const IvfVolumeWriter& rhs) : DataWriterType<Volume>(rhs) {}
+IvfVolumeWriter::IvfVolumeWriter(const IvfVolumeWriter& rhs)
+    : DataWriterType<Volume>(rhs)
+    , compression_{rhs.compression_}
+    , compressionLevel_{rhs.compressionLevel_}
+    , chunkSize_{rhs.chunkSize_} {}
 
 IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) {
-    if (this != &that) DataWriterType<Volume>::operator=(that);
+    if (this != &that) {
+        DataWriterType<Volume>::operator=(that);
+        compression_ = that.compression_;
+        compressionLevel_ = that.compressionLevel_;
+        chunkSize_ = that.chunkSize_;
+    }
 
     return *this;
 }
@@ -49,7 +66,8 @@ IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) {
 IvfVolumeWriter* IvfVolumeWriter::clone() const { return new IvfVolumeWriter(*this); }
 
 void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath) const {
-    std::string rawPath = filesystem::replaceFileExtension(filePath, "raw");
+    const bool compress = compression_ == Compression::Zlib;
+    std::string rawPath = filesystem::replaceFileExtension(filePath, compress ? "zraw" : "raw");
 
     if (filesystem::fileExists(filePath) && !overwrite_)
         throw DataWriterException("Error: Output file: " + filePath + " already exists",
@@ -61,8 +79,27 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
 
     const std::string fileName = filesystem::getFileNameWithoutExtension(filePath);
     const VolumeRAM* vr = volume->getRepresentation<VolumeRAM>();
+    const auto dims = vr->getDimensions();
+    const auto sliceBytes = dims.x * dims.y * vr->getDataFormat()->getSize();
+    const auto bytes = sliceBytes * dims.z;
+
+    // Compress before writing anything, so that a failure does not leave a broken file behind
+    size_t chunkSlices = 0;
+    std::vector<std::vector<char>> chunks;
+    if (compress) {
+        chunkSlices = std::max(size_t{1}, chunkSize_ / std::max(sliceBytes, size_t{1}));
+        try {
+            chunks = util::compressChunks(vr->getData(), bytes, chunkSlices * sliceBytes,
+                                          compressionLevel_);
+        } catch (const Exception& e) {
+            throw DataWriterException("Error: Could not compress " + filePath + ": " +
+                                          e.getMessage(),
+                                      IVW_CONTEXT);
+        }
+    }
+
     Serializer s(filePath);
-    s.serialize("RawFile", fileName + ".raw");
+    s.serialize("RawFile", fileName + (compress ? ".zraw" : ".raw"));
     s.serialize("Format", vr->getDataFormatString());
     s.serialize("ByteOffset", 0u);
     s.serialize("BasisAndOffset", volume->getModelMatrix());
@@ -76,15 +113,38 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
     s.serialize("Interpolation", vr->getInterpolation());
     s.serialize("Wrapping", vr->getWrapping());
 
+    if (compress) {
+        std::vector<size_t> chunkSizes;
+        for (const auto& chunk : chunks) chunkSizes.push_back(chunk.size());
+        s.serialize("Compression", std::string("zlib"));
+        s.serialize("ChunkSlices", chunkSlices);
+        s.serialize("ChunkSizes", chunkSizes, "Chunk");
+    }
+
     volume->getMetaDataMap()->serialize(s);
     s.writeFile();
 
     if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
-        fout.write(static_cast<const char*>(vr->getData()),
-                   glm::compMul(vr->getDimensions()) * vr->getDataFormat()->getSize());
+        if (compress) {
+            for (const auto& chunk : chunks) fout.write(chunk.data(), chunk.size());
+        } else {
+            fout.write(static_cast<const char*>(vr->getData()), bytes);
+        }
     } else {
         throw DataWriterException("Error: Could not write to raw file: " + rawPath, IVW_CONTEXT);
     }
 }
 
+IvfVolumeWriter::Compression IvfVolumeWriter::getCompression() const { return compression_; }
+
+void IvfVolumeWriter::setCompressionLevel(int level) {
+    compressionLevel_ = std::clamp(level, 1, 9);
+}
+
+int IvfVolumeWriter::getCompressionLevel() const { return compressionLevel_; }
+
+void IvfVolumeWriter::setChunkSize(size_t bytes) { chunkSize_ = bytes; }
+
+size_t IvfVolumeWriter::getChunkSize() const { return chunkSize_; }
+
 }  // namespace inviwo
@@ -69,7 +69,7 @@ ImageSource::ImageSource(InviwoApplication* app, const std::string& file)
     // make sure that we always process even if not connected
     isSink_.setUpdate([]() { return true; });
     isReady_.setUpdate([this]() {
-        return !loadingFailed_ && filesystem::fileExists(file_.get()) &&
+        return !loadingFailed_ && !preloaded_.isPending() && filesystem::fileExists(file_.get()) &&
                !reader_.getSelectedValue().empty();
     });
     file_.onChange([this]() {
@@ -90,7 +90,8 @@ void ImageSource::process() {
     const auto fext = filesystem::getFileExtension(file_.get());
     if (auto reader = rf_->getReaderForTypeAndExtension<Layer>(sext, fext)) {
         try {
-            auto outLayer = reader->readData(file_.get());
+            auto outLayer = preloaded_.take(file_.get());
+            if (!outLayer) outLayer = reader->readData(file_.get());
             outport_.setData(std::make_shared<Image>(outLayer));
             imageDimension_.set(outLayer->getDimensions());
         } catch (DataReaderException const& e) {
@@ -113,4 +114,23 @@ void ImageSource::deserialize(Deserializer& d) {
     util::updateFilenameFilters<Layer>(*rf_, file_, reader_);
 }
 
+Preloadable::Job ImageSource::preload() {
+    if (!file_.isModified() || !filesystem::fileExists(file_.get())) return nullptr;
+
+    const auto sext = reader_.getSelectedValue();
+    const auto fext = filesystem::getFileExtension(file_.get());
+    std::shared_ptr<DataReaderType<Layer>> reader =
+        rf_->getReaderForTypeAndExtension<Layer>(sext, fext);
+    if (!reader || !reader->isThreadSafe()) return nullptr;
+
+    auto job = preloaded_.makeJob(
+        file_.get(), [reader, file = file_.get()]() { return reader->readData(file); },
+        [this]() {
+            isReady_.update();
+            invalidate(InvalidationLevel::InvalidOutput);
+        });
+    isReady_.update();
+    return job;
+}
+
 }  // namespace inviwo
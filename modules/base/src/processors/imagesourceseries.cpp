@@ -30,6 +30,7 @@
 #include <modules/base/processors/imagesourceseries.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/image/layerdisk.h>
+#include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/io/datareaderfactory.h>
 #include <inviwo/core/util/filesystem.h>
@@ -53,7 +54,8 @@ ImageSourceSeries::ImageSourceSeries(InviwoApplication* app)
     , imageFilePattern_("imageFilePattern", "File Pattern",
                         filesystem::getPath(PathType::Images, "/*"), "")
     , currentImageIndex_("currentImageIndex", "Image Index", 1, 1, 1, 1)
-    , imageFileName_("imageFileName", "Image File Name") {
+    , imageFileName_("imageFileName", "Image File Name")
+    , prefetch_("prefetch", "Prefetch") {
 
     isSink_.setUpdate([]() { return true; });
     isReady_.setUpdate([this]() { return !fileList_.empty(); });
@@ -63,6 +65,7 @@ ImageSourceSeries::ImageSourceSeries(InviwoApplication* app)
     addProperty(findFilesButton_);
     addProperty(currentImageIndex_);
     addProperty(imageFileName_);
+    addProperty(prefetch_);
 
     validExtensions_ = app->getDataReaderFactory()->getExtensionsForType<Layer>();
     imageFilePattern_.addNameFilters(validExtensions_);
@@ -77,6 +80,26 @@ ImageSourceSeries::ImageSourceSeries(InviwoApplication* app)
     });
 
     imageFileName_.setReadOnly(true);
+
+    prefetch_.enabled_.onChange([this]() {
+        if (!prefetch_.isEnabled()) prefetcher_.clear();
+    });
+    prefetcher_.setMakeJob([this, app](size_t index) -> SequencePrefetcher<Layer>::Job {
+        if (index >= fileList_.size()) return nullptr;
+        const auto file = fileList_[index];
+        auto reader = app->getDataReaderFactory()->getReaderForTypeAndExtension<Layer>(
+            imageFilePattern_.getSelectedExtension(), filesystem::getFileExtension(file));
+        if (!reader) return nullptr;
+
+        return [file, reader = std::shared_ptr<DataReaderType<Layer>>(std::move(reader))]()
+                   -> std::pair<std::shared_ptr<Layer>, size_t> {
+            auto layer = reader->readData(file);
+            // make sure the file is actually read and not deferred to a LayerDisk
+            layer->getRepresentation<LayerRAM>();
+            const auto dims = layer->getDimensions();
+            return {layer, dims.x * dims.y * layer->getDataFormat()->getSize()};
+        };
+    });
 }
 
 void ImageSourceSeries::process() {
@@ -85,6 +108,7 @@ void ImageSourceSeries::process() {
     if (imageFilePattern_.isModified()) {
         // check all matching files whether they have a supported file extension,
         // i.e. a data reader exists
+        prefetcher_.clear();
         fileList_ = imageFilePattern_.getFileList();
         const auto numElems = fileList_.size();
         util::erase_remove_if(fileList_,
@@ -107,6 +131,18 @@ void ImageSourceSeries::process() {
         return;
     }
 
+    std::shared_ptr<Layer> layer;
+    if (prefetch_.isEnabled()) {
+        prefetcher_.update(index, fileList_.size(), prefetch_.getStepsAhead(),
+                           prefetch_.getMemoryBudget());
+        layer = prefetcher_.get(index);
+    }
+    // fall back to reading the image here, which also reports any errors of the prefetching
+    if (!layer) layer = readImage(index);
+    if (layer) outport_.setData(std::make_shared<Image>(layer));
+}
+
+std::shared_ptr<Layer> ImageSourceSeries::readImage(size_t index) {
     const auto currentFileName = fileList_[index];
     const auto fext = filesystem::getFileExtension(currentFileName);
     const auto sext = imageFilePattern_.getSelectedExtension();
@@ -118,14 +154,15 @@ void ImageSourceSeries::process() {
     ivwAssert(reader != nullptr, "Could not find reader for \"" << currentFileName << "\"");
 
     try {
-        auto layer = reader->readData(currentFileName);
-        outport_.setData(std::make_shared<Image>(layer));
+        return reader->readData(currentFileName);
     } catch (DataReaderException const& e) {
         LogError(e.getMessage());
+        return nullptr;
     }
 }
 
 void ImageSourceSeries::onFindFiles() {
+    prefetcher_.clear();
     // this processor will only be ready if at least one matching file exists
     fileList_ = imageFilePattern_.getFileList();
     if (fileList_.empty() && !imageFilePattern_.getFilePattern().empty()) {
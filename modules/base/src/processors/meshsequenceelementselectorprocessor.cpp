@@ -28,9 +28,29 @@
  *********************************************************************************/
 
 #include <modules/base/processors/meshsequenceelementselectorprocessor.h>
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
+namespace {
+
+template <typename F>
+void forEachBuffer(const Mesh& mesh, F func) {
+    for (const auto& buffer : mesh.getBuffers()) func(buffer.second);
+    for (const auto& buffer : mesh.getIndexBuffers()) func(buffer.second);
+}
+
+struct LoadedBuffer {
+    std::weak_ptr<BufferBase> buffer;
+    const BufferRepresentation* ram;
+    size_t modified;
+};
+
+}  // namespace
+
 const ProcessorInfo MeshSequenceElementSelectorProcessor::processorInfo_{
     "org.inviwo.MeshTimeStepSelector",  // Class identifier
     "Mesh Sequence Element Selector",   // Display name
@@ -45,6 +65,46 @@ MeshSequenceElementSelectorProcessor::MeshSequenceElementSelectorProcessor()
     : VectorElementSelectorProcessor<Mesh, MeshOutport>() {
     timeStep_.index_.autoLinkToProperty<MeshSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    // Only buffers that can be read from disk again are loaded ahead, and only the RAM
+    // representations created here are released again, unless the buffer has been modified since.
+    enablePrefetching([](std::shared_ptr<Mesh> mesh) -> PrefetchResult {
+        std::vector<LoadedBuffer> loaded;
+        size_t bytes = 0;
+        forEachBuffer(*mesh, [&](const std::shared_ptr<BufferBase>& buffer) {
+            if (!buffer->hasValidRepresentation<BufferDisk>() ||
+                buffer->hasRepresentation<BufferRAM>()) {
+                return;
+            }
+            const auto modified = buffer->getModificationCount();
+            const auto ram = buffer->getRepresentation<BufferRAM>();
+            if (buffer->getModificationCount() != modified) return;
+            loaded.push_back({buffer, ram, modified});
+            bytes += buffer->getSizeInBytes();
+        });
+        if (loaded.empty()) return {nullptr, 0};
+
+        auto release = [weak = std::weak_ptr<Mesh>(mesh), loaded = std::move(loaded)]() mutable {
+            auto current = weak.lock();
+            if (!current) return true;
+            // Still in use by someone besides the sequence, try again later
+            if (current.use_count() > 2) return false;
+            auto it = std::remove_if(loaded.begin(), loaded.end(), [](const LoadedBuffer& item) {
+                auto buffer = item.buffer.lock();
+                if (!buffer || buffer->getModificationCount() != item.modified ||
+                    !buffer->hasValidRepresentation<BufferDisk>()) {
+                    return true;
+                }
+                // Shared with other meshes that are in use
+                if (buffer.use_count() > 2) return false;
+                buffer->removeRepresentation(item.ram);
+                return true;
+            });
+            loaded.erase(it, loaded.end());
+            return loaded.empty();
+        };
+        return {std::make_shared<Prefetched>(Prefetched{std::move(release)}), bytes};
+    });
 }
 
 }  // namespace inviwo
@@ -102,14 +102,17 @@ void SurfaceExtraction::process() {
     const auto computeSurface = [this](vec4 color, std::shared_ptr<const Volume> vol) {
         return [vol, color, method = method_.get(), iso = isoValue_.get(),
                 invert = invertIso_.get(),
-                enclose = encloseSurface_.get()](pool::Progress progress) -> std::shared_ptr<Mesh> {
+                enclose = encloseSurface_.get()](pool::Stop stop,
+                                                 pool::Progress progress) -> std::shared_ptr<Mesh> {
             RenderContext::getPtr()->activateLocalRenderContext();
 
             switch (method) {
                 case Method::MarchingCubes:
                     return util::marchingcubes(vol, iso, color, invert, enclose, progress);
                 case Method::MarchingCubesOpt:
-                    return util::marchingCubesOpt(vol, iso, color, invert, enclose, progress);
+                    return util::marchingCubesOptParallel(vol, iso, color, invert, enclose,
+                                                          progress,
+                                                          [stop]() -> bool { return stop; });
                 case Method::MarchingTetrahedron:
                 default:
                     return util::marchingtetrahedron(vol, iso, color, invert, enclose, progress);
@@ -118,7 +121,7 @@ void SurfaceExtraction::process() {
     };
 
     const auto changeColor = [](vec4 color, std::shared_ptr<const Mesh> oldmesh) {
-        return [oldmesh, color](pool::Progress) -> std::shared_ptr<Mesh> {
+        return [oldmesh, color](pool::Stop, pool::Progress) -> std::shared_ptr<Mesh> {
             RenderContext::getPtr()->activateLocalRenderContext();
 
             auto mesh = std::make_shared<Mesh>(oldmesh->getDefaultMeshInfo());
@@ -165,7 +168,7 @@ void SurfaceExtraction::process() {
             newResults();
         });
     } else {  // Only update the modified ones
-        std::vector<std::function<std::shared_ptr<Mesh>(pool::Progress progress)>> jobs;
+        std::vector<std::function<std::shared_ptr<Mesh>(pool::Stop, pool::Progress)>> jobs;
         std::vector<size_t> inds;
         for (auto [i, item] : util::enumerate(volume_.changedAndData())) {
             const auto portChanged = item.first;
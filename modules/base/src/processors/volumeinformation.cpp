@@ -138,7 +138,7 @@ void VolumeInformation::process() {
 
     if (perVoxelProperties_.isChecked()) {
 
-        auto sigVoxels = util::volumeSignificantVoxels(volumeRAM, IgnoreSpecialValues::Yes);
+        auto sigVoxels = util::volumeSignificantVoxels(*volume, IgnoreSpecialValues::Yes);
         significantVoxels_.set(sigVoxels);
         significantVoxelsRatio_.set(static_cast<double>(sigVoxels) /
                                     static_cast<double>(numVoxels));
@@ -28,6 +28,8 @@
  *********************************************************************************/
 
 #include <modules/base/processors/volumesequenceelementselectorprocessor.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
 
 namespace inviwo {
 
@@ -45,6 +47,32 @@ VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
     : VectorElementSelectorProcessor<Volume>() {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    // Only volumes that can be read from disk again are loaded ahead, and only the RAM
+    // representation created here is released again, unless the volume has been modified since.
+    enablePrefetching([](std::shared_ptr<Volume> volume) -> PrefetchResult {
+        if (!volume->hasValidRepresentation<VolumeDisk>() ||
+            volume->hasRepresentation<VolumeRAM>()) {
+            return {nullptr, 0};
+        }
+        const auto modified = volume->getModificationCount();
+        const auto ram = volume->getRepresentation<VolumeRAM>();
+        if (volume->getModificationCount() != modified) return {nullptr, 0};
+
+        auto release = [weak = std::weak_ptr<Volume>(volume), ram, modified]() {
+            auto loaded = weak.lock();
+            if (!loaded || loaded->getModificationCount() != modified ||
+                !loaded->hasValidRepresentation<VolumeDisk>()) {
+                return true;
+            }
+            // Still in use by someone besides the sequence, try again later
+            if (loaded.use_count() > 2) return false;
+            loaded->removeRepresentation(ram);
+            return true;
+        };
+        return {std::make_shared<Prefetched>(Prefetched{std::move(release)}),
+                glm::compMul(ram->getDimensions()) * ram->getDataFormat()->getSize()};
+    });
 }
 
 }  // namespace inviwo
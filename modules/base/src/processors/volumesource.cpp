@@ -78,7 +78,7 @@ VolumeSource::VolumeSource(InviwoApplication* app, const std::string& file)
     // make sure that we always process even if not connected
     isSink_.setUpdate([]() { return true; });
     isReady_.setUpdate([this]() {
-        return !loadingFailed_ && filesystem::fileExists(file_.get()) &&
+        return !loadingFailed_ && !preloaded_.isPending() && filesystem::fileExists(file_.get()) &&
                !reader_.getSelectedValue().empty();
     });
     file_.onChange([this]() {
@@ -106,6 +106,9 @@ void VolumeSource::load(bool deserialize) {
     bool checkResource = deserialized_ || !reload_.isModified();
     if (checkResource && rm->hasResource<VolumeSequence>(file_.get())) {
         volumes_ = rm->getResource<VolumeSequence>(file_.get());
+    } else if (auto volumes = preloaded_.take(file_.get())) {
+        std::swap(volumes, volumes_);
+        rm->addResource(file_.get(), volumes_, reload_.isModified());
     } else {
         try {
             if (auto volVecReader = rf->getReaderForTypeAndExtension<VolumeSequence>(sext, fext)) {
@@ -174,4 +177,39 @@ void VolumeSource::deserialize(Deserializer& d) {
     deserialized_ = true;
 }
 
+Preloadable::Job VolumeSource::preload() {
+    if (!deserialized_ || !file_.isModified() || !filesystem::fileExists(file_.get())) {
+        return nullptr;
+    }
+    if (app_->getResourceManager()->hasResource<VolumeSequence>(file_.get())) return nullptr;
+
+    auto rf = app_->getDataReaderFactory();
+    const auto sext = reader_.getSelectedValue();
+    const auto fext = filesystem::getFileExtension(file_.get());
+
+    std::function<std::shared_ptr<VolumeSequence>()> read;
+    if (std::shared_ptr<DataReaderType<VolumeSequence>> reader =
+            rf->getReaderForTypeAndExtension<VolumeSequence>(sext, fext)) {
+        if (!reader->isThreadSafe()) return nullptr;
+        read = [reader, file = file_.get()]() { return reader->readData(file); };
+    } else if (std::shared_ptr<DataReaderType<Volume>> reader =
+                   rf->getReaderForTypeAndExtension<Volume>(sext, fext)) {
+        if (!reader->isThreadSafe()) return nullptr;
+        read = [reader, file = file_.get()]() {
+            auto volumes = std::make_shared<VolumeSequence>();
+            volumes->push_back(reader->readData(file));
+            return volumes;
+        };
+    } else {
+        return nullptr;
+    }
+
+    auto job = preloaded_.makeJob(file_.get(), read, [this]() {
+        isReady_.update();
+        invalidate(InvalidationLevel::InvalidOutput);
+    });
+    isReady_.update();
+    return job;
+}
+
 }  // namespace inviwo
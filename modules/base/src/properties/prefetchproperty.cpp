@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/properties/prefetchproperty.h>
+
+namespace inviwo {
+
+const std::string PrefetchProperty::classIdentifier = "org.inviwo.PrefetchProperty";
+std::string PrefetchProperty::getClassIdentifier() const { return classIdentifier; }
+
+PrefetchProperty::PrefetchProperty(std::string identifier, std::string displayName,
+                                   InvalidationLevel invalidationLevel,
+                                   PropertySemantics semantics)
+    : CompositeProperty(identifier, displayName, invalidationLevel, semantics)
+    , enabled_("enabled", "Enabled", false, InvalidationLevel::Valid)
+    , stepsAhead_("stepsAhead", "Steps Ahead", 4, 1, 32, 1, InvalidationLevel::Valid)
+    , memoryBudget_("memoryBudget", "Memory Budget (MB)", 1024, 16, 65536, 16,
+                    InvalidationLevel::Valid) {
+
+    addProperties(enabled_, stepsAhead_, memoryBudget_);
+    stepsAhead_.visibilityDependsOn(enabled_, [](const auto& p) { return p.get(); });
+    memoryBudget_.visibilityDependsOn(enabled_, [](const auto& p) { return p.get(); });
+}
+
+PrefetchProperty::PrefetchProperty(const PrefetchProperty& rhs)
+    : CompositeProperty(rhs)
+    , enabled_(rhs.enabled_)
+    , stepsAhead_(rhs.stepsAhead_)
+    , memoryBudget_(rhs.memoryBudget_) {
+
+    addProperties(enabled_, stepsAhead_, memoryBudget_);
+    stepsAhead_.visibilityDependsOn(enabled_, [](const auto& p) { return p.get(); });
+    memoryBudget_.visibilityDependsOn(enabled_, [](const auto& p) { return p.get(); });
+}
+
+PrefetchProperty* PrefetchProperty::clone() const { return new PrefetchProperty(*this); }
+
+bool PrefetchProperty::isEnabled() const { return enabled_.get(); }
+
+size_t PrefetchProperty::getStepsAhead() const { return stepsAhead_.get(); }
+
+size_t PrefetchProperty::getMemoryBudget() const { return memoryBudget_.get() * 1024 * 1024; }
+
+}  // namespace inviwo
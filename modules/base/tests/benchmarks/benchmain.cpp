@@ -32,6 +32,10 @@
 #endif
 
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -102,6 +106,49 @@ static void RippleNew(benchmark::State& state) {
     state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
 }
 
+static void SphereParallel(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    auto v = std::shared_ptr<Volume>(
+        util::makeSphericalVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh =
+            util::marchingCubesOptParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+static void RippleParallel(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    auto v = std::shared_ptr<Volume>(
+        util::makeRippleVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh =
+            util::marchingCubesOptParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+// Volume size x number of threads in the pool
+static void ParallelArgs(benchmark::internal::Benchmark* b) {
+    for (int size : {512, 640}) {
+        for (int threads : {1, 2, 4, 8, 16}) {
+            b->Args({size, threads});
+        }
+    }
+}
+
 static void MiniOld(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeSingleVoxelVolume(size3_t{static_cast<size_t>(state.range(0))}));
@@ -136,6 +183,9 @@ BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
 BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
+BENCHMARK(SphereParallel)->Apply(ParallelArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(RippleParallel)->Apply(ParallelArgs)->Unit(benchmark::kMillisecond);
+
 // BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
@@ -145,6 +195,18 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(SphereNew)->Arg(5);
 
 int main(int argc, char** argv) {
+    LogCentral::init();
+    auto logger = std::make_shared<ConsoleLogger>();
+    LogCentral::getPtr()->setVerbosity(LogVerbosity::Error);
+    LogCentral::getPtr()->registerLogger(logger);
+    InviwoApplication app(argc, argv, "Inviwo-Benchmarks-Base");
+
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
 
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/chunkedvolumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::uint16_t> testData(size_t size) {
+    std::vector<std::uint16_t> data(size);
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<std::uint16_t>((i * 7919) % 1021);
+    return data;
+}
+
+}  // namespace
+
+TEST(ChunkedVolumeRAMLoader, CompressRoundTrip) {
+    const auto data = testData(10000);
+    const auto bytes = data.size() * sizeof(std::uint16_t);
+    const size_t chunkSize = 3000;
+
+    const auto chunks = util::compressChunks(data.data(), bytes, chunkSize, 6);
+    ASSERT_EQ((bytes + chunkSize - 1) / chunkSize, chunks.size());
+
+    std::vector<char> compressed;
+    std::vector<size_t> sizes;
+    for (const auto& chunk : chunks) {
+        compressed.insert(compressed.end(), chunk.begin(), chunk.end());
+        sizes.push_back(chunk.size());
+    }
+
+    std::vector<std::uint16_t> result(data.size());
+    util::decompressChunks(compressed.data(), sizes, chunkSize, result.data(), bytes);
+    EXPECT_EQ(data, result);
+
+    sizes.pop_back();
+    EXPECT_THROW(
+        util::decompressChunks(compressed.data(), sizes, chunkSize, result.data(), bytes),
+        Exception);
+}
+
+TEST(ChunkedVolumeRAMLoader, ReadSlices) {
+    const size3_t dims{7, 5, 11};
+    const size_t chunkSlices = 3;
+    const auto sliceSize = dims.x * dims.y;
+    const auto data = testData(glm::compMul(dims));
+
+    const auto chunks = util::compressChunks(data.data(), data.size() * sizeof(std::uint16_t),
+                                             chunkSlices * sliceSize * sizeof(std::uint16_t), 6);
+    std::vector<size_t> sizes;
+    util::TempFileHandle file("ivw_", ".zraw");
+    {
+        auto out = filesystem::ofstream(file.getFileName(), std::ios::out | std::ios::binary);
+        for (const auto& chunk : chunks) {
+            out.write(chunk.data(), chunk.size());
+            sizes.push_back(chunk.size());
+        }
+    }
+
+    const VolumeDisk disk(dims, DataUInt16::get());
+    const ChunkedVolumeRAMLoader loader(file.getFileName(), 0, chunkSlices, sizes, true);
+
+    auto volumeRAM = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(disk));
+    ASSERT_EQ(dims, volumeRAM->getDimensions());
+    const auto ptr = static_cast<const std::uint16_t*>(volumeRAM->getData());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), ptr));
+
+    // Ranges that start and end both on and off chunk boundaries
+    for (auto range : {size2_t{0, 3}, size2_t{3, 9}, size2_t{1, 2}, size2_t{4, 11},
+                       size2_t{10, 11}}) {
+        std::vector<std::uint16_t> slices((range.y - range.x) * sliceSize);
+        loader.readSlices(disk, range.x, range.y, slices.data());
+        EXPECT_TRUE(std::equal(slices.begin(), slices.end(), data.begin() + range.x * sliceSize))
+            << "slices " << range.x << " - " << range.y;
+    }
+
+    std::vector<std::uint16_t> slices(sliceSize);
+    EXPECT_THROW(loader.readSlices(disk, 10, 12, slices.data()), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,93 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/ivfvolumewriter.h>
+#include <inviwo/core/io/datawriterfactory.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+IvfVolumeWriter::Compression compressionForIvf(DataWriterFactory& factory) {
+    auto writer = factory.getWriterForTypeAndExtension<Volume>("ivf");
+    EXPECT_TRUE(writer);
+    auto ivfWriter = dynamic_cast<IvfVolumeWriter*>(writer.get());
+    EXPECT_TRUE(ivfWriter);
+    return ivfWriter ? ivfWriter->getCompression() : IvfVolumeWriter::Compression::Zlib;
+}
+
+}  // namespace
+
+TEST(IvfVolumeWriter, PlainWriterPreferredForIvfExtension) {
+    IvfVolumeWriter plain;
+    IvfVolumeWriter compressed(IvfVolumeWriter::Compression::Zlib);
+
+    // Same registration order as in the base module
+    DataWriterFactory factory;
+    factory.registerObject(&plain);
+    factory.registerObject(&compressed);
+
+    EXPECT_EQ(size_t{2}, factory.getExtensionsForType<Volume>().size());
+    EXPECT_EQ(IvfVolumeWriter::Compression::None, compressionForIvf(factory));
+
+    auto writer = factory.create("IVF");
+    ASSERT_TRUE(writer);
+    auto ivfWriter = dynamic_cast<IvfVolumeWriter*>(writer.get());
+    ASSERT_TRUE(ivfWriter);
+    EXPECT_EQ(IvfVolumeWriter::Compression::None, ivfWriter->getCompression());
+
+    factory.unRegisterObject(&plain);
+    EXPECT_EQ(IvfVolumeWriter::Compression::Zlib, compressionForIvf(factory));
+    factory.unRegisterObject(&compressed);
+    EXPECT_FALSE(factory.hasKey("ivf"));
+}
+
+TEST(IvfVolumeWriter, FirstRegisteredWriterPreferredForIvfExtension) {
+    IvfVolumeWriter plain;
+    IvfVolumeWriter compressed(IvfVolumeWriter::Compression::Zlib);
+
+    DataWriterFactory factory;
+    factory.registerObject(&compressed);
+    factory.registerObject(&plain);
+
+    EXPECT_EQ(IvfVolumeWriter::Compression::Zlib, compressionForIvf(factory));
+
+    factory.unRegisterObject(&compressed);
+    factory.unRegisterObject(&plain);
+}
+
+}  // namespace inviwo
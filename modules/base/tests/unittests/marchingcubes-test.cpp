@@ -335,4 +335,32 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+TEST(Marchingcubes, parallel) {
+    auto v = std::shared_ptr<Volume>(util::makeRippleVolume(size3_t{33}));
+
+    auto mesh1 = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+    auto& pos1 = getBufferData<vec3>(*mesh1, 0);
+    auto& ind1 = getBufferIndexData(*mesh1, 0);
+
+    // Welding along the slab borders should reproduce the serial mesh for any number of slabs
+    for (size_t jobs : {1, 2, 5, 32}) {
+        auto mesh2 = util::marchingCubesOptParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false,
+                                                    false, nullptr, nullptr, nullptr, jobs);
+        auto& pos2 = getBufferData<vec3>(*mesh2, 0);
+        auto& ind2 = getBufferIndexData(*mesh2, 0);
+
+        ASSERT_EQ(pos1.size(), pos2.size());
+        EXPECT_EQ(ind1, ind2);
+        for (size_t i = 0; i < pos1.size(); ++i) {
+            EXPECT_NEAR(pos1[i].x, pos2[i].x, 1.0e-6f);
+            EXPECT_NEAR(pos1[i].y, pos2[i].y, 1.0e-6f);
+            EXPECT_NEAR(pos1[i].z, pos2[i].z, 1.0e-6f);
+        }
+    }
+
+    auto stopped = util::marchingCubesOptParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false,
+                                                  nullptr, []() { return true; });
+    EXPECT_EQ(stopped, nullptr);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,221 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/sequenceprefetcher.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t stepSize = 100;
+
+/**
+ * Loads the index of a step as its data. The elements the jobs capture are kept track of to check
+ * that they are released again.
+ */
+struct TestSequence {
+    SequencePrefetcher<size_t>::Job makeJob(size_t index) {
+        auto element = std::make_shared<size_t>(index);
+        elements[index] = element;
+        return [element]() -> std::pair<std::shared_ptr<size_t>, size_t> {
+            return {std::make_shared<size_t>(*element), stepSize};
+        };
+    }
+    bool evict(size_t& index) {
+        if (!canEvict) return false;
+        evicted.push_back(index);
+        return true;
+    }
+    SequencePrefetcher<size_t> prefetcher(ThreadPool* pool) {
+        return SequencePrefetcher<size_t>{[this](size_t index) { return makeJob(index); },
+                                          [this](size_t& index) { return evict(index); }, pool};
+    }
+
+    std::map<size_t, std::weak_ptr<size_t>> elements;
+    std::vector<size_t> evicted;
+    bool canEvict = true;
+};
+
+}  // namespace
+
+TEST(SequencePrefetcher, Window) {
+    ThreadPool pool(2);
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(&pool);
+
+    // The size of the steps is unknown, only the current step is loaded
+    prefetcher.update(0, 10, 3, 1000);
+    EXPECT_EQ(1, prefetcher.getScheduledSteps());
+    ASSERT_TRUE(prefetcher.get(0));
+    EXPECT_EQ(0, *prefetcher.get(0));
+
+    prefetcher.update(0, 10, 3, 1000);
+    EXPECT_EQ(4, prefetcher.getScheduledSteps());
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(prefetcher.get(i));
+        EXPECT_EQ(i, *prefetcher.get(i));
+    }
+    EXPECT_FALSE(prefetcher.get(4));
+    EXPECT_EQ(4 * stepSize, prefetcher.getResidentBytes());
+
+    // Wrap around at the end
+    for (size_t i = 1; i <= 8; ++i) {
+        prefetcher.update(i, 10, 3, 1000);
+        EXPECT_TRUE(prefetcher.get(i));
+    }
+    for (size_t i : {8, 9, 0, 1}) {
+        ASSERT_TRUE(prefetcher.get(i));
+        EXPECT_EQ(i, *prefetcher.get(i));
+    }
+    EXPECT_EQ(4, prefetcher.getScheduledSteps());
+}
+
+TEST(SequencePrefetcher, MemoryBudget) {
+    ThreadPool pool(2);
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(&pool);
+
+    prefetcher.update(0, 10, 8, 2 * stepSize + stepSize / 2);
+    prefetcher.get(0);
+    prefetcher.update(0, 10, 8, 2 * stepSize + stepSize / 2);
+    EXPECT_EQ(2, prefetcher.getScheduledSteps());
+    EXPECT_TRUE(prefetcher.get(1));
+    EXPECT_FALSE(prefetcher.get(2));
+}
+
+TEST(SequencePrefetcher, Backward) {
+    ThreadPool pool(2);
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(&pool);
+
+    prefetcher.update(5, 10, 2, 1000);
+    prefetcher.get(5);
+    prefetcher.update(4, 10, 2, 1000);
+    for (size_t i : {4, 3, 2}) EXPECT_TRUE(prefetcher.get(i));
+    EXPECT_FALSE(prefetcher.get(5));
+    EXPECT_EQ(std::vector<size_t>{5}, seq.evicted);
+}
+
+TEST(SequencePrefetcher, Evict) {
+    ThreadPool pool(2);
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(&pool);
+
+    prefetcher.update(0, 10, 2, 1000);
+    prefetcher.get(0);
+    prefetcher.update(0, 10, 2, 1000);
+    for (size_t i = 0; i < 3; ++i) prefetcher.get(i);
+
+    // Evicted oldest first when moving the window
+    prefetcher.update(2, 10, 2, 1000);
+    EXPECT_EQ((std::vector<size_t>{0, 1}), seq.evicted);
+    for (size_t i = 2; i < 5; ++i) prefetcher.get(i);
+
+    // Steps that can not be evicted yet are retried during the next update
+    seq.canEvict = false;
+    prefetcher.update(4, 10, 2, 1000);
+    EXPECT_EQ((std::vector<size_t>{0, 1}), seq.evicted);
+    seq.canEvict = true;
+    prefetcher.update(4, 10, 2, 1000);
+    EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3}), seq.evicted);
+
+    for (size_t i = 4; i < 7; ++i) prefetcher.get(i);
+    prefetcher.clear();
+    EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3, 4, 5, 6}), seq.evicted);
+    EXPECT_EQ(0, prefetcher.getScheduledSteps());
+    EXPECT_EQ(0, prefetcher.getResidentBytes());
+}
+
+TEST(SequencePrefetcher, ReleaseJobs) {
+    ThreadPool pool(1);
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(&pool);
+
+    prefetcher.update(0, 10, 3, 1000);
+    prefetcher.get(0);
+    // Finished jobs do not hold on to their elements
+    EXPECT_TRUE(seq.elements[0].expired());
+
+    // Keep the only worker busy such that the jobs stay queued
+    std::promise<void> started;
+    std::promise<void> gate;
+    auto blocker = pool.enqueue([&started, wait = gate.get_future()]() {
+        started.set_value();
+        wait.wait();
+    });
+    started.get_future().wait();
+
+    prefetcher.update(1, 10, 3, 1000);
+    for (size_t i = 1; i < 5; ++i) EXPECT_FALSE(seq.elements[i].expired());
+
+    // Moving on cancels the queued jobs which releases their elements right away
+    prefetcher.update(6, 10, 3, 1000);
+    for (size_t i = 1; i < 5; ++i) EXPECT_TRUE(seq.elements[i].expired());
+    for (size_t i = 6; i < 10; ++i) EXPECT_FALSE(seq.elements[i].expired());
+
+    gate.set_value();
+    blocker.wait();
+
+    for (size_t i = 6; i < 10; ++i) {
+        ASSERT_TRUE(prefetcher.get(i));
+        EXPECT_EQ(i, *prefetcher.get(i));
+        EXPECT_TRUE(seq.elements[i].expired());
+    }
+    // The cancelled jobs never loaded anything to evict
+    prefetcher.update(6, 10, 3, 1000);
+    EXPECT_EQ(std::vector<size_t>{0}, seq.evicted);
+
+    prefetcher.clear();
+    EXPECT_EQ((std::vector<size_t>{0, 6, 7, 8, 9}), seq.evicted);
+}
+
+TEST(SequencePrefetcher, NoPool) {
+    TestSequence seq;
+    auto prefetcher = seq.prefetcher(nullptr);
+
+    // Without a pool only the current step is loaded, right away
+    prefetcher.update(0, 10, 3, 1000);
+    prefetcher.update(0, 10, 3, 1000);
+    EXPECT_EQ(1, prefetcher.getScheduledSteps());
+    EXPECT_EQ(stepSize, prefetcher.getResidentBytes());
+    EXPECT_TRUE(seq.elements[0].expired());
+}
+
+}  // namespace inviwo
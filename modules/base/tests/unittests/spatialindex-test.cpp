@@ -0,0 +1,198 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/spatialindex.h>
+
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t size, unsigned int seed) {
+    std::mt19937 rand(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(size);
+    for (auto& p : points) p = vec3(dist(rand), dist(rand), dist(rand));
+    return points;
+}
+
+std::vector<int> iota(size_t size) {
+    std::vector<int> res(size);
+    std::iota(res.begin(), res.end(), 0);
+    return res;
+}
+
+// Indices of the amount nearest points, nearest first
+std::vector<int> bruteForceNearest(const std::vector<vec3>& points, const vec3& pos,
+                                   size_t amount) {
+    auto res = iota(points.size());
+    std::sort(res.begin(), res.end(), [&](int a, int b) {
+        return glm::distance2(points[a], pos) < glm::distance2(points[b], pos);
+    });
+    res.resize(std::min(amount, res.size()));
+    return res;
+}
+
+}  // namespace
+
+TEST(FlatKDTreeTests, empty) {
+    FlatK3DTree<int, float> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(nullptr, tree.findNearest(vec3(0.5f)));
+    EXPECT_TRUE(tree.findNNearest(vec3(0.5f), 10).empty());
+    EXPECT_TRUE(tree.findCloseTo(vec3(0.5f), 1.0f).empty());
+}
+
+TEST(FlatKDTreeTests, findNearest) {
+    const auto points = randomPoints(1000, 0);
+    FlatK3DTree<int, float> tree(points, iota(points.size()));
+    EXPECT_EQ(points.size(), tree.size());
+
+    const auto queries = randomPoints(100, 1);
+    const auto batch = tree.findNearest(queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto expected = bruteForceNearest(points, queries[i], 1).front();
+        ASSERT_NE(nullptr, tree.findNearest(queries[i]));
+        EXPECT_EQ(expected, tree.findNearest(queries[i])->get());
+        EXPECT_EQ(expected, batch[i]->get());
+    }
+}
+
+TEST(FlatKDTreeTests, findNNearest) {
+    const auto points = randomPoints(1000, 2);
+    FlatK3DTree<int, float> tree(points, iota(points.size()));
+
+    const auto queries = randomPoints(20, 3);
+    const auto batch = tree.findNNearest(queries, 10);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto expected = bruteForceNearest(points, queries[i], 10);
+        ASSERT_EQ(expected.size(), batch[i].size());
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(expected[j], batch[i][j]->get());
+        }
+    }
+    EXPECT_EQ(points.size(), tree.findNNearest(vec3(0.5f), 2000).size());
+}
+
+TEST(FlatKDTreeTests, findCloseTo) {
+    const auto points = randomPoints(1000, 4);
+    FlatK3DTree<int, float> tree(points, iota(points.size()));
+
+    const auto queries = randomPoints(20, 5);
+    const auto batch = tree.findCloseTo(queries, 0.2f);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::vector<int> expected;
+        for (int j = 0; j < static_cast<int>(points.size()); ++j) {
+            if (glm::distance2(points[j], queries[i]) < 0.2f * 0.2f) expected.push_back(j);
+        }
+        std::vector<int> found;
+        for (auto node : batch[i]) found.push_back(node->get());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected, found);
+    }
+}
+
+TEST(FlatKDTreeTests, duplicates) {
+    std::vector<vec3> points(100, vec3(0.25f));
+    points.emplace_back(0.75f);
+    FlatK3DTree<int, float> tree(points, iota(points.size()));
+    EXPECT_EQ(100, tree.findCloseTo(vec3(0.25f), 0.1f).size());
+    EXPECT_EQ(100, tree.findNearest(vec3(0.7f))->get());
+}
+
+TEST(FlatKDTreeTests, parallelBuild) {
+    const auto points = randomPoints(5000, 6);
+    // Eight jobs split the top three levels before the subtrees are built separately, which
+    // happens serially if there is no thread pool
+    FlatK3DTree<int, float> serial(points, iota(points.size()), 1);
+    FlatK3DTree<int, float> parallel(points, iota(points.size()), 8);
+    ASSERT_EQ(points.size(), parallel.size());
+    EXPECT_EQ(serial.depth(), parallel.depth());
+
+    const auto queries = randomPoints(200, 7);
+    const auto nearest = parallel.findNearest(queries, 4);
+    const auto close = parallel.findCloseTo(queries, 0.05f, 4);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(serial.findNearest(queries[i])->get(), nearest[i]->get());
+        EXPECT_EQ(serial.findCloseTo(queries[i], 0.05f).size(), close[i].size());
+    }
+}
+
+TEST(SpatialHashTests, weld) {
+    SpatialHash3D<int, float> hash(0.01f);
+    EXPECT_EQ(nullptr, hash.findNearest(vec3(0.5f)));
+
+    hash.insert(vec3(0.5f), 0);
+    hash.insert(vec3(0.505f, 0.5f, 0.5f), 1);
+    hash.insert(vec3(0.8f), 2);
+    EXPECT_EQ(3, hash.size());
+
+    ASSERT_NE(nullptr, hash.findNearest(vec3(0.501f, 0.5f, 0.5f)));
+    EXPECT_EQ(0, hash.findNearest(vec3(0.501f, 0.5f, 0.5f))->get());
+    EXPECT_EQ(1, hash.findNearest(vec3(0.504f, 0.5f, 0.5f))->get());
+    EXPECT_EQ(nullptr, hash.findNearest(vec3(0.2f)));
+}
+
+TEST(SpatialHashTests, findCloseTo) {
+    const auto points = randomPoints(2000, 6);
+    SpatialHash3D<int, float> hash(0.05f);
+    for (size_t i = 0; i < points.size(); ++i) {
+        hash.insert(points[i], static_cast<int>(i));
+    }
+    EXPECT_EQ(points.size(), hash.size());
+
+    for (const auto& query : randomPoints(20, 7)) {
+        std::vector<int> expected;
+        for (int j = 0; j < static_cast<int>(points.size()); ++j) {
+            if (glm::distance2(points[j], query) < 0.12f * 0.12f) expected.push_back(j);
+        }
+        std::vector<int> found;
+        for (auto node : hash.findCloseTo(query, 0.12f)) found.push_back(node->get());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected, found);
+
+        // Within one cell size findNearest is exact
+        const auto nearest = bruteForceNearest(points, query, 1).front();
+        if (glm::distance(points[nearest], query) < hash.getCellSize()) {
+            EXPECT_EQ(nearest, hash.findNearest(query)->get());
+        }
+    }
+}
+
+}  // namespace inviwo
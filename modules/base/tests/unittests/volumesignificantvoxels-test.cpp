@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <modules/base/algorithm/volume/volumesignificantvoxels.h>
+
+#include <limits>
+
+namespace inviwo {
+
+TEST(VolumeSignificantVoxels, SpecialValues) {
+    const size3_t dims{40, 40, 40};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 1.0f);
+    // Zeros in one brick, special values in bricks that otherwise contain no zeros
+    data[0] = 0.0f;
+    data[20 * 40 * 40 + 20 * 40 + 20] = std::numeric_limits<float>::quiet_NaN();
+    data[35 * 40 * 40 + 5 * 40 + 30] = std::numeric_limits<float>::quiet_NaN();
+    data[10 * 40 * 40 + 30 * 40 + 2] = std::numeric_limits<float>::infinity();
+    const size_t total = glm::compMul(dims);
+
+    const Volume volume(ram);
+    EXPECT_EQ(total - 1, util::volumeSignificantVoxels(volume, IgnoreSpecialValues::No));
+    EXPECT_EQ(total - 4, util::volumeSignificantVoxels(volume, IgnoreSpecialValues::Yes));
+    for (auto ignore : {IgnoreSpecialValues::No, IgnoreSpecialValues::Yes}) {
+        EXPECT_EQ(util::volumeSignificantVoxels(ram.get(), ignore),
+                  util::volumeSignificantVoxels(volume, ignore));
+    }
+}
+
+TEST(VolumeSignificantVoxels, NaNInZeroBrick) {
+    const size3_t dims{40, 40, 40};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    // A NaN first in a row of an otherwise zero brick, followed by values that are not zero
+    const size_t row = 3 * 40 * 40 + 3 * 40;
+    data[row] = std::numeric_limits<float>::quiet_NaN();
+    data[row + 1] = data[row + 2] = data[row + 3] = 5.0f;
+    // A brick with only a NaN
+    data[30 * 40 * 40 + 30 * 40 + 30] = std::numeric_limits<float>::quiet_NaN();
+
+    const Volume volume(ram);
+    EXPECT_EQ(5u, util::volumeSignificantVoxels(volume, IgnoreSpecialValues::No));
+    EXPECT_EQ(3u, util::volumeSignificantVoxels(volume, IgnoreSpecialValues::Yes));
+    for (auto ignore : {IgnoreSpecialValues::No, IgnoreSpecialValues::Yes}) {
+        EXPECT_EQ(util::volumeSignificantVoxels(ram.get(), ignore),
+                  util::volumeSignificantVoxels(volume, ignore));
+    }
+}
+
+TEST(VolumeSignificantVoxels, Integer) {
+    const size3_t dims{35, 20, 18};
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = static_cast<unsigned char>(i % 7 == 0 || i > 10000 ? 0 : 255);
+    }
+
+    const Volume volume(ram);
+    for (auto ignore : {IgnoreSpecialValues::No, IgnoreSpecialValues::Yes}) {
+        EXPECT_EQ(util::volumeSignificantVoxels(ram.get(), ignore),
+                  util::volumeSignificantVoxels(volume, ignore));
+    }
+}
+
+}  // namespace inviwo
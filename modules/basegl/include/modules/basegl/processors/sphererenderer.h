@@ -49,6 +49,7 @@
 #include <modules/opengl/shader/shader.h>
 #include <modules/basegl/datastructures/meshshadercache.h>
 #include <modules/brushingandlinking/ports/brushingandlinkingports.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
 
 #include <inviwo/core/util/zip.h>
 #include <unordered_map>
@@ -79,7 +80,7 @@ public:
 
             if (properties.isModified() || brushLinkPort_.isChanged() ||
                 util::contains(inport_.getChangedOutports(), port)) {
-                const auto& selection = brushLinkPort_.getSelectedIndices();
+                const BitSet& selection = brushLinkPort_.getSelected();
 
                 indices.clear();
                 if (auto res = mesh.findBuffer(BufferType::IndexAttrib);
@@ -94,11 +95,11 @@ public:
                     const auto seq = util::make_sequence(
                         uint32_t{0}, static_cast<uint32_t>(indexBuffer.size()), uint32_t{1});
                     std::copy_if(seq.begin(), seq.end(), std::back_inserter(indices),
-                                 [&](uint32_t i) { return selection.count(indexBuffer[i]) > 0; });
+                                 [&](uint32_t i) { return selection.contains(indexBuffer[i]); });
 
                 } else {
-                    std::transform(selection.begin(), selection.end(), std::back_inserter(indices),
-                                   [](size_t i) { return static_cast<uint32_t>(i); });
+                    indices.reserve(selection.cardinality());
+                    selection.forEach([&](uint32_t i) { indices.push_back(i); });
                 }
             }
             if (!indices.empty()) {
@@ -64,20 +64,31 @@ public:
 
     bool isColumnSelected(size_t column) const;
 
+    void setSelected(const BrushingAndLinkingInport* src, const BitSet& indices);
     void setSelected(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
 
+    void setFiltered(const BrushingAndLinkingInport* src, const BitSet& indices);
     void setFiltered(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
 
+    void setSelectedColumn(const BrushingAndLinkingInport* src, const BitSet& columnIndices);
     void setSelectedColumn(const BrushingAndLinkingInport* src,
                            const std::unordered_set<size_t>& columnIndices);
 
-    const std::unordered_set<size_t>& getSelectedIndices() const;
-    const std::unordered_set<size_t>& getFilteredIndices() const;
-    const std::unordered_set<size_t>& getSelectedColumns() const;
+    const BitSet& getSelected() const;
+    const BitSet& getFiltered() const;
+    const BitSet& getSelectedColumnSet() const;
+
+    /*
+     * Set based access, creates a copy of the indices. Prefer getSelected(), getFiltered() and
+     * getSelectedColumnSet() for large selections.
+     */
+    std::unordered_set<size_t> getSelectedIndices() const;
+    std::unordered_set<size_t> getFilteredIndices() const;
+    std::unordered_set<size_t> getSelectedColumns() const;
 
 private:
-    std::unordered_set<size_t> selected_;
-    std::unordered_set<size_t> selectedColumns_;
+    BitSet selected_;
+    BitSet selectedColumns_;
     IndexList filtered_;  // Use IndexList to be able to remove filtered rows on port disconnection
     std::shared_ptr<std::function<void()>> onFilteringChangeCallback_;
 
@@ -88,7 +99,8 @@ private:
 inline bool BrushingAndLinkingManager::isFiltered(size_t idx) const { return filtered_.has(idx); }
 
 inline bool BrushingAndLinkingManager::isSelected(size_t idx) const {
-    return selected_.find(idx) != selected_.end();
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           selected_.contains(static_cast<std::uint32_t>(idx));
 }
 
 }  // namespace inviwo
@@ -0,0 +1,233 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class BitSet
+ * \brief Compressed set of 32 bit indices with fast union, intersection and iteration.
+ *
+ * The layout follows roaring bitmaps: the indices are partitioned by their upper 16 bits into
+ * containers of up to 2^16 values. Sparse containers store their lower 16 bits as a sorted array,
+ * containers with more than 4096 values use a bitmap of 8 KB instead. Hence a set never uses
+ * much more than 2 bytes per index, or 1 bit per index in dense ranges, and set operations work
+ * on whole containers rather than on single values. Iteration is in increasing order.
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API BitSet {
+public:
+    class const_iterator;
+
+    BitSet() = default;
+    BitSet(std::initializer_list<std::uint32_t> values);
+    /**
+     * Create a set from a range of (unsorted) indices
+     */
+    template <typename InputIt>
+    BitSet(InputIt begin, InputIt end);
+    /**
+     * Adapter for the set based API, all indices have to fit in 32 bits
+     */
+    explicit BitSet(const std::unordered_set<size_t>& indices);
+    /**
+     * Create a set of the positions of all true values in \p mask
+     */
+    explicit BitSet(const std::vector<bool>& mask);
+
+    size_t cardinality() const;
+    size_t size() const { return cardinality(); }
+    bool empty() const { return containers_.empty(); }
+
+    bool contains(std::uint32_t value) const;
+    void add(std::uint32_t value);
+    /**
+     * Add all values in [begin, end)
+     */
+    void addRange(std::uint32_t begin, std::uint32_t end);
+    void remove(std::uint32_t value);
+    void clear();
+
+    BitSet& operator|=(const BitSet& rhs);
+    BitSet& operator&=(const BitSet& rhs);
+    BitSet& operator-=(const BitSet& rhs);
+
+    /**
+     * Call \p func(value) for all values in increasing order, faster than iterating
+     */
+    template <typename F>
+    void forEach(F&& func) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::vector<std::uint32_t> toVector() const;
+    /**
+     * Adapter for the set based API
+     */
+    std::unordered_set<size_t> toUnorderedSet() const;
+    /**
+     * Dense mask of \p size entries, true for all values in the set less than \p size
+     */
+    std::vector<bool> toMask(size_t size) const;
+
+    friend bool operator==(const BitSet& lhs, const BitSet& rhs);
+
+private:
+    static constexpr size_t arrayMax = 4096;
+    static constexpr size_t bitmapWords = 1024;
+
+    static std::uint32_t trailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::uint32_t>(__builtin_ctzll(word));
+#else
+        return static_cast<std::uint32_t>(std::bitset<64>((word & (~word + 1)) - 1).count());
+#endif
+    }
+
+    struct Container {
+        std::uint16_t key = 0;
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> array;   // sorted values if cardinality <= arrayMax
+        std::vector<std::uint64_t> bitmap;  // bitmapWords words otherwise
+
+        bool isBitmap() const { return !bitmap.empty(); }
+        bool contains(std::uint16_t value) const;
+        void toBitmap();
+        /**
+         * Switch between array and bitmap depending on the cardinality
+         */
+        void normalize();
+        template <typename F>
+        void forEach(std::uint32_t high, F&& func) const;
+
+        friend bool operator==(const Container& lhs, const Container& rhs) {
+            return lhs.key == rhs.key && lhs.cardinality == rhs.cardinality &&
+                   lhs.array == rhs.array && lhs.bitmap == rhs.bitmap;
+        }
+    };
+
+    void build(std::vector<std::uint32_t> values);
+    Container* find(std::uint16_t key);
+    const Container* find(std::uint16_t key) const;
+    Container& findOrAdd(std::uint16_t key);
+
+    static Container unite(const Container& lhs, const Container& rhs);
+    static Container intersect(const Container& lhs, const Container& rhs);
+    static Container subtract(const Container& lhs, const Container& rhs);
+
+    std::vector<Container> containers_;  // sorted by key
+};
+
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator|(BitSet lhs, const BitSet& rhs);
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator&(BitSet lhs, const BitSet& rhs);
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator-(BitSet lhs, const BitSet& rhs);
+IVW_MODULE_BRUSHINGANDLINKING_API bool operator!=(const BitSet& lhs, const BitSet& rhs);
+
+/**
+ * Forward iterator over the values of a BitSet in increasing order
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API BitSet::const_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::uint32_t*;
+    using reference = const std::uint32_t&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return value_; }
+    pointer operator->() const { return &value_; }
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+        return lhs.container_ == rhs.container_ && lhs.pos_ == rhs.pos_ &&
+               lhs.word_ == rhs.word_;
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    friend class BitSet;
+    const_iterator(const BitSet* set, size_t container);
+    // Find the next value starting at the current position
+    void seek();
+
+    const BitSet* set_ = nullptr;
+    size_t container_ = 0;
+    size_t pos_ = 0;          // index into the array, or word index of the bitmap
+    std::uint64_t word_ = 0;  // remaining bits of the current bitmap word
+    std::uint32_t value_ = 0;
+};
+
+template <typename InputIt>
+BitSet::BitSet(InputIt begin, InputIt end) {
+    std::vector<std::uint32_t> values;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>) {
+        values.reserve(static_cast<size_t>(std::distance(begin, end)));
+    }
+    for (; begin != end; ++begin) values.push_back(static_cast<std::uint32_t>(*begin));
+    build(std::move(values));
+}
+
+template <typename F>
+void BitSet::Container::forEach(std::uint32_t high, F&& func) const {
+    if (isBitmap()) {
+        for (size_t i = 0; i < bitmapWords; ++i) {
+            for (auto word = bitmap[i]; word != 0; word &= word - 1) {
+                func(high | static_cast<std::uint32_t>(i * 64 + trailingZeros(word)));
+            }
+        }
+    } else {
+        for (auto value : array) func(high | value);
+    }
+}
+
+template <typename F>
+void BitSet::forEach(F&& func) const {
+    for (const auto& container : containers_) {
+        container.forEach(static_cast<std::uint32_t>(container.key) << 16, func);
+    }
+}
+
+}  // namespace inviwo
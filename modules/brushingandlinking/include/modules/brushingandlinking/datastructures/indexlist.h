@@ -33,11 +33,18 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/util/dispatcher.h>
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <limits>
 
 namespace inviwo {
 class BrushingAndLinkingInport;
 class BrushingAndLinkingManager;
 
+/**
+ * \class IndexList
+ * \brief Indices set by several sources, the list holds the union of the indices of all sources.
+ */
 class IVW_MODULE_BRUSHINGANDLINKING_API IndexList {
 public:
     IndexList() = default;
@@ -45,23 +52,26 @@ public:
     size_t getSize() const;
     bool has(size_t idx) const;
 
-    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &incices);
+    void set(const BrushingAndLinkingInport *src, const BitSet &indices);
+    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &indices);
     void remove(const BrushingAndLinkingInport *src);
 
     std::shared_ptr<std::function<void()>> onChange(std::function<void()> V);
 
     void update();
     void clear();
-    const std::unordered_set<size_t> &getIndices() const { return indices_; }
+    const BitSet &getIndices() const { return indices_; }
 
 private:
-    std::unordered_map<const BrushingAndLinkingInport *, std::unordered_set<size_t>>
-        indicesBySource_;
-    std::unordered_set<size_t> indices_;
+    std::unordered_map<const BrushingAndLinkingInport *, BitSet> indicesBySource_;
+    BitSet indices_;
     Dispatcher<void()> onUpdate_;
 };
 
-inline bool IndexList::has(size_t idx) const { return indices_.find(idx) != indices_.end(); }
+inline bool IndexList::has(size_t idx) const {
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           indices_.contains(static_cast<std::uint32_t>(idx));
+}
 
 }  // namespace inviwo
 
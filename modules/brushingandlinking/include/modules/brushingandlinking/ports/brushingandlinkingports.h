@@ -49,10 +49,13 @@ public:
     BrushingAndLinkingInport(std::string identifier);
     virtual ~BrushingAndLinkingInport() = default;
 
+    void sendFilterEvent(const BitSet &indices);
     void sendFilterEvent(const std::unordered_set<size_t> &indices);
 
+    void sendSelectionEvent(const BitSet &indices);
     void sendSelectionEvent(const std::unordered_set<size_t> &indices);
 
+    void sendColumnSelectionEvent(const BitSet &indices);
     void sendColumnSelectionEvent(const std::unordered_set<size_t> &indices);
 
     bool isFiltered(size_t idx) const;
@@ -60,15 +63,23 @@ public:
 
     bool isColumnSelected(size_t idx) const;
 
-    const std::unordered_set<size_t> &getSelectedIndices() const;
-    const std::unordered_set<size_t> &getFilteredIndices() const;
-    const std::unordered_set<size_t> &getSelectedColumns() const;
+    const BitSet &getSelected() const;
+    const BitSet &getFiltered() const;
+    const BitSet &getSelectedColumnSet() const;
+
+    /*
+     * Set based access, creates a copy of the indices. Prefer getSelected(), getFiltered() and
+     * getSelectedColumnSet() for large selections.
+     */
+    std::unordered_set<size_t> getSelectedIndices() const;
+    std::unordered_set<size_t> getFilteredIndices() const;
+    std::unordered_set<size_t> getSelectedColumns() const;
 
     virtual std::string getClassIdentifier() const override;
 
-    std::unordered_set<size_t> filterCache_;
-    std::unordered_set<size_t> selectionCache_;
-    std::unordered_set<size_t> selectionColumnCache_;
+    BitSet filterCache_;
+    BitSet selectionCache_;
+    BitSet selectionColumnCache_;
 };
 
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingOutport
@@ -109,7 +120,8 @@ inline bool BrushingAndLinkingInport::isFiltered(size_t idx) const {
     if (isConnected()) {
         return getData()->isFiltered(idx);
     } else {
-        return filterCache_.find(idx) != filterCache_.end();
+        return idx <= std::numeric_limits<std::uint32_t>::max() &&
+               filterCache_.contains(static_cast<std::uint32_t>(idx));
     }
 }
 
@@ -117,7 +129,8 @@ inline bool BrushingAndLinkingInport::isSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isSelected(idx);
     } else {
-        return selectionCache_.find(idx) != selectionCache_.end();
+        return idx <= std::numeric_limits<std::uint32_t>::max() &&
+               selectionCache_.contains(static_cast<std::uint32_t>(idx));
     }
 }
 
@@ -48,7 +48,7 @@ BrushingAndLinkingManager::BrushingAndLinkingManager(Processor* p,
 
 BrushingAndLinkingManager::~BrushingAndLinkingManager() {}
 
-size_t BrushingAndLinkingManager::getNumberOfSelected() const { return selected_.size(); }
+size_t BrushingAndLinkingManager::getNumberOfSelected() const { return selected_.cardinality(); }
 
 size_t BrushingAndLinkingManager::getNumberOfFiltered() const { return filtered_.getSize(); }
 
@@ -57,36 +57,58 @@ void BrushingAndLinkingManager::remove(const BrushingAndLinkingInport* src) {
 }
 
 bool BrushingAndLinkingManager::isColumnSelected(size_t idx) const {
-    return selectedColumns_.find(idx) != selectedColumns_.end();
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           selectedColumns_.contains(static_cast<std::uint32_t>(idx));
 }
 
 void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport*,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const BitSet& indices) {
     selected_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
-void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
+void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport* src,
                                             const std::unordered_set<size_t>& indices) {
+    setSelected(src, BitSet(indices));
+}
+
+void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
+                                            const BitSet& indices) {
     filtered_.set(src, indices);
 }
 
+void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
+                                            const std::unordered_set<size_t>& indices) {
+    setFiltered(src, BitSet(indices));
+}
+
 void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport*,
-                                                  const std::unordered_set<size_t>& indices) {
+                                                  const BitSet& indices) {
     selectedColumns_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedIndices() const {
-    return selected_;
+void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport* src,
+                                                  const std::unordered_set<size_t>& indices) {
+    setSelectedColumn(src, BitSet(indices));
+}
+
+const BitSet& BrushingAndLinkingManager::getSelected() const { return selected_; }
+
+const BitSet& BrushingAndLinkingManager::getFiltered() const { return filtered_.getIndices(); }
+
+const BitSet& BrushingAndLinkingManager::getSelectedColumnSet() const { return selectedColumns_; }
+
+std::unordered_set<size_t> BrushingAndLinkingManager::getSelectedIndices() const {
+    return selected_.toUnorderedSet();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getFilteredIndices() const {
-    return filtered_.getIndices();
+std::unordered_set<size_t> BrushingAndLinkingManager::getFilteredIndices() const {
+    return filtered_.getIndices().toUnorderedSet();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedColumns() const {
-    return selectedColumns_;
+std::unordered_set<size_t> BrushingAndLinkingManager::getSelectedColumns() const {
+    return selectedColumns_.toUnorderedSet();
 }
 
 }  // namespace inviwo
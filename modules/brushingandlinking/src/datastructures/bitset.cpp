@@ -0,0 +1,435 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace inviwo {
+
+namespace {
+
+std::uint32_t popcount(const std::vector<std::uint64_t>& words) {
+    std::uint32_t count = 0;
+    for (auto word : words) count += static_cast<std::uint32_t>(std::bitset<64>(word).count());
+    return count;
+}
+
+constexpr std::uint16_t high(std::uint32_t value) {
+    return static_cast<std::uint16_t>(value >> 16);
+}
+constexpr std::uint16_t low(std::uint32_t value) {
+    return static_cast<std::uint16_t>(value & 0xffff);
+}
+
+constexpr std::uint64_t bit(std::uint16_t value) { return std::uint64_t{1} << (value & 63); }
+
+}  // namespace
+
+bool BitSet::Container::contains(std::uint16_t value) const {
+    if (isBitmap()) {
+        return (bitmap[value >> 6] & bit(value)) != 0;
+    } else {
+        return std::binary_search(array.begin(), array.end(), value);
+    }
+}
+
+void BitSet::Container::toBitmap() {
+    if (isBitmap()) return;
+    bitmap.assign(bitmapWords, 0);
+    for (auto value : array) bitmap[value >> 6] |= bit(value);
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void BitSet::Container::normalize() {
+    if (isBitmap() && cardinality <= arrayMax) {
+        array.clear();
+        array.reserve(cardinality);
+        forEach(0, [&](std::uint32_t value) { array.push_back(low(value)); });
+        bitmap.clear();
+        bitmap.shrink_to_fit();
+    } else if (!isBitmap() && cardinality > arrayMax) {
+        toBitmap();
+    }
+}
+
+BitSet::BitSet(std::initializer_list<std::uint32_t> values)
+    : BitSet(values.begin(), values.end()) {}
+
+BitSet::BitSet(const std::unordered_set<size_t>& indices)
+    : BitSet(indices.begin(), indices.end()) {}
+
+BitSet::BitSet(const std::vector<bool>& mask) {
+    std::vector<std::uint32_t> values;
+    for (size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i]) values.push_back(static_cast<std::uint32_t>(i));
+    }
+    build(std::move(values));
+}
+
+void BitSet::build(std::vector<std::uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    containers_.clear();
+    for (auto first = values.begin(); first != values.end();) {
+        const auto key = high(*first);
+        const auto last =
+            std::find_if(first, values.end(), [key](auto value) { return high(value) != key; });
+
+        auto& container = containers_.emplace_back();
+        container.key = key;
+        container.cardinality = static_cast<std::uint32_t>(last - first);
+        if (container.cardinality <= arrayMax) {
+            container.array.resize(container.cardinality);
+            std::transform(first, last, container.array.begin(),
+                           [](auto value) { return low(value); });
+        } else {
+            container.bitmap.assign(bitmapWords, 0);
+            std::for_each(first, last, [&](auto value) {
+                container.bitmap[low(value) >> 6] |= bit(low(value));
+            });
+        }
+        first = last;
+    }
+}
+
+auto BitSet::find(std::uint16_t key) -> Container* {
+    return const_cast<Container*>(std::as_const(*this).find(key));
+}
+
+auto BitSet::find(std::uint16_t key) const -> const Container* {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, std::uint16_t k) { return c.key < k; });
+    return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+auto BitSet::findOrAdd(std::uint16_t key) -> Container& {
+    // Values are often added in increasing order
+    if (containers_.empty() || containers_.back().key < key) {
+        auto& container = containers_.emplace_back();
+        container.key = key;
+        return container;
+    }
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, std::uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) {
+        it = containers_.emplace(it);
+        it->key = key;
+    }
+    return *it;
+}
+
+size_t BitSet::cardinality() const {
+    size_t count = 0;
+    for (const auto& container : containers_) count += container.cardinality;
+    return count;
+}
+
+bool BitSet::contains(std::uint32_t value) const {
+    const auto container = find(high(value));
+    return container && container->contains(low(value));
+}
+
+void BitSet::add(std::uint32_t value) {
+    auto& container = findOrAdd(high(value));
+    const auto v = low(value);
+    if (container.isBitmap()) {
+        auto& word = container.bitmap[v >> 6];
+        if ((word & bit(v)) == 0) {
+            word |= bit(v);
+            ++container.cardinality;
+        }
+    } else {
+        auto it = std::lower_bound(container.array.begin(), container.array.end(), v);
+        if (it == container.array.end() || *it != v) {
+            container.array.insert(it, v);
+            ++container.cardinality;
+            container.normalize();
+        }
+    }
+}
+
+void BitSet::addRange(std::uint32_t begin, std::uint32_t end) {
+    if (begin >= end) return;
+    const std::uint32_t last = end - 1;
+    for (std::uint32_t key = high(begin); key <= high(last); ++key) {
+        auto& container = findOrAdd(static_cast<std::uint16_t>(key));
+        container.toBitmap();
+        const std::uint32_t first = key == high(begin) ? low(begin) : 0;
+        const std::uint32_t stop = key == high(last) ? low(last) : 0xffff;
+        for (auto v = first; v <= stop; ++v) {
+            if (v % 64 == 0 && v + 63 <= stop) {
+                container.bitmap[v >> 6] = ~std::uint64_t{0};
+                v += 63;
+            } else {
+                container.bitmap[v >> 6] |= bit(static_cast<std::uint16_t>(v));
+            }
+        }
+        container.cardinality = popcount(container.bitmap);
+        container.normalize();
+    }
+}
+
+void BitSet::remove(std::uint32_t value) {
+    auto container = find(high(value));
+    if (!container) return;
+    const auto v = low(value);
+    if (container->isBitmap()) {
+        auto& word = container->bitmap[v >> 6];
+        if ((word & bit(v)) == 0) return;
+        word &= ~bit(v);
+        --container->cardinality;
+        container->normalize();
+    } else {
+        auto it = std::lower_bound(container->array.begin(), container->array.end(), v);
+        if (it == container->array.end() || *it != v) return;
+        container->array.erase(it);
+        --container->cardinality;
+    }
+    if (container->cardinality == 0) {
+        containers_.erase(containers_.begin() + (container - containers_.data()));
+    }
+}
+
+void BitSet::clear() { containers_.clear(); }
+
+auto BitSet::unite(const Container& lhs, const Container& rhs) -> Container {
+    Container result;
+    result.key = lhs.key;
+    if (!lhs.isBitmap() && !rhs.isBitmap() && lhs.cardinality + rhs.cardinality <= arrayMax) {
+        result.array.reserve(lhs.cardinality + rhs.cardinality);
+        std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bitmap = lhs.bitmap;
+    result.array = lhs.array;
+    result.toBitmap();
+    if (rhs.isBitmap()) {
+        for (size_t i = 0; i < bitmapWords; ++i) result.bitmap[i] |= rhs.bitmap[i];
+    } else {
+        for (auto value : rhs.array) result.bitmap[value >> 6] |= bit(value);
+    }
+    result.cardinality = popcount(result.bitmap);
+    result.normalize();
+    return result;
+}
+
+auto BitSet::intersect(const Container& lhs, const Container& rhs) -> Container {
+    Container result;
+    result.key = lhs.key;
+    if (!lhs.isBitmap() && !rhs.isBitmap()) {
+        std::set_intersection(lhs.array.begin(), lhs.array.end(), rhs.array.begin(),
+                              rhs.array.end(), std::back_inserter(result.array));
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else if (!lhs.isBitmap() || !rhs.isBitmap()) {
+        const auto& array = lhs.isBitmap() ? rhs : lhs;
+        const auto& bitmap = lhs.isBitmap() ? lhs : rhs;
+        std::copy_if(array.array.begin(), array.array.end(), std::back_inserter(result.array),
+                     [&](auto value) { return bitmap.contains(value); });
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else {
+        result.bitmap.resize(bitmapWords);
+        for (size_t i = 0; i < bitmapWords; ++i) {
+            result.bitmap[i] = lhs.bitmap[i] & rhs.bitmap[i];
+        }
+        result.cardinality = popcount(result.bitmap);
+        result.normalize();
+    }
+    return result;
+}
+
+auto BitSet::subtract(const Container& lhs, const Container& rhs) -> Container {
+    Container result;
+    result.key = lhs.key;
+    if (!lhs.isBitmap()) {
+        if (rhs.isBitmap()) {
+            std::copy_if(lhs.array.begin(), lhs.array.end(), std::back_inserter(result.array),
+                         [&](auto value) { return !rhs.contains(value); });
+        } else {
+            std::set_difference(lhs.array.begin(), lhs.array.end(), rhs.array.begin(),
+                                rhs.array.end(), std::back_inserter(result.array));
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    } else {
+        result.bitmap = lhs.bitmap;
+        if (rhs.isBitmap()) {
+            for (size_t i = 0; i < bitmapWords; ++i) result.bitmap[i] &= ~rhs.bitmap[i];
+        } else {
+            for (auto value : rhs.array) result.bitmap[value >> 6] &= ~bit(value);
+        }
+        result.cardinality = popcount(result.bitmap);
+        result.normalize();
+    }
+    return result;
+}
+
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+    std::vector<Container> result;
+    result.reserve(containers_.size() + rhs.containers_.size());
+    auto a = containers_.begin();
+    auto b = rhs.containers_.begin();
+    while (a != containers_.end() && b != rhs.containers_.end()) {
+        if (a->key < b->key) {
+            result.push_back(std::move(*a++));
+        } else if (b->key < a->key) {
+            result.push_back(*b++);
+        } else {
+            result.push_back(unite(*a++, *b++));
+        }
+    }
+    std::move(a, containers_.end(), std::back_inserter(result));
+    std::copy(b, rhs.containers_.end(), std::back_inserter(result));
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+    std::vector<Container> result;
+    auto a = containers_.begin();
+    auto b = rhs.containers_.begin();
+    while (a != containers_.end() && b != rhs.containers_.end()) {
+        if (a->key < b->key) {
+            ++a;
+        } else if (b->key < a->key) {
+            ++b;
+        } else {
+            auto container = intersect(*a++, *b++);
+            if (container.cardinality > 0) result.push_back(std::move(container));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet& BitSet::operator-=(const BitSet& rhs) {
+    std::vector<Container> result;
+    result.reserve(containers_.size());
+    auto b = rhs.containers_.begin();
+    for (auto& container : containers_) {
+        while (b != rhs.containers_.end() && b->key < container.key) ++b;
+        if (b != rhs.containers_.end() && b->key == container.key) {
+            auto difference = subtract(container, *b);
+            if (difference.cardinality > 0) result.push_back(std::move(difference));
+        } else {
+            result.push_back(std::move(container));
+        }
+    }
+    containers_ = std::move(result);
+    return *this;
+}
+
+BitSet operator|(BitSet lhs, const BitSet& rhs) { return lhs |= rhs; }
+BitSet operator&(BitSet lhs, const BitSet& rhs) { return lhs &= rhs; }
+BitSet operator-(BitSet lhs, const BitSet& rhs) { return lhs -= rhs; }
+
+bool operator==(const BitSet& lhs, const BitSet& rhs) {
+    // Containers are always normalized, hence equal sets have equal containers
+    return lhs.containers_ == rhs.containers_;
+}
+bool operator!=(const BitSet& lhs, const BitSet& rhs) { return !(lhs == rhs); }
+
+auto BitSet::begin() const -> const_iterator { return const_iterator(this, 0); }
+auto BitSet::end() const -> const_iterator { return const_iterator(this, containers_.size()); }
+
+std::vector<std::uint32_t> BitSet::toVector() const {
+    std::vector<std::uint32_t> values;
+    values.reserve(cardinality());
+    forEach([&](std::uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+std::unordered_set<size_t> BitSet::toUnorderedSet() const {
+    std::unordered_set<size_t> indices;
+    indices.reserve(cardinality());
+    forEach([&](std::uint32_t value) { indices.insert(value); });
+    return indices;
+}
+
+std::vector<bool> BitSet::toMask(size_t size) const {
+    std::vector<bool> mask(size, false);
+    forEach([&](std::uint32_t value) {
+        if (value < size) mask[value] = true;
+    });
+    return mask;
+}
+
+BitSet::const_iterator::const_iterator(const BitSet* set, size_t container)
+    : set_{set}, container_{container} {
+    if (container_ < set_->containers_.size() && set_->containers_[container_].isBitmap()) {
+        word_ = set_->containers_[container_].bitmap[0];
+    }
+    seek();
+}
+
+void BitSet::const_iterator::seek() {
+    const auto& containers = set_->containers_;
+    while (container_ < containers.size()) {
+        const auto& container = containers[container_];
+        const auto key = static_cast<std::uint32_t>(container.key) << 16;
+        if (container.isBitmap()) {
+            while (word_ == 0 && ++pos_ < bitmapWords) word_ = container.bitmap[pos_];
+            if (word_ != 0) {
+                value_ = key | static_cast<std::uint32_t>(pos_ * 64 + trailingZeros(word_));
+                return;
+            }
+        } else if (pos_ < container.array.size()) {
+            value_ = key | container.array[pos_];
+            return;
+        }
+        ++container_;
+        pos_ = 0;
+        word_ = container_ < containers.size() && containers[container_].isBitmap()
+                    ? containers[container_].bitmap[0]
+                    : 0;
+    }
+}
+
+auto BitSet::const_iterator::operator++() -> const_iterator& {
+    if (set_->containers_[container_].isBitmap()) {
+        word_ &= word_ - 1;
+    } else {
+        ++pos_;
+    }
+    seek();
+    return *this;
+}
+
+auto BitSet::const_iterator::operator++(int) -> const_iterator {
+    auto copy = *this;
+    ++(*this);
+    return copy;
+}
+
+}  // namespace inviwo
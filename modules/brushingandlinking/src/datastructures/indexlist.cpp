@@ -32,14 +32,18 @@
 
 namespace inviwo {
 
-size_t IndexList::getSize() const { return indices_.size(); }
+size_t IndexList::getSize() const { return indices_.cardinality(); }
 
-void IndexList::set(const BrushingAndLinkingInport *src,
-                    const std::unordered_set<size_t> &indices) {
+void IndexList::set(const BrushingAndLinkingInport *src, const BitSet &indices) {
     indicesBySource_[src] = indices;
     update();
 }
 
+void IndexList::set(const BrushingAndLinkingInport *src,
+                    const std::unordered_set<size_t> &indices) {
+    set(src, BitSet(indices));
+}
+
 void IndexList::remove(const BrushingAndLinkingInport *src) {
     indicesBySource_.erase(src);
     update();
@@ -52,15 +56,14 @@ std::shared_ptr<std::function<void()>> IndexList::onChange(std::function<void()>
 void IndexList::update() {
     indices_.clear();
 
-    using T = std::unordered_map<const BrushingAndLinkingInport *,
-                                 std::unordered_set<size_t>>::value_type;
+    using T = std::unordered_map<const BrushingAndLinkingInport *, BitSet>::value_type;
     util::map_erase_remove_if(indicesBySource_, [](const T &p) {
         return !p.first->isConnected() ||
                p.second.empty();  // remove if port is disconnected or if the set is empty
     });
 
-    for (auto p : indicesBySource_) {
-        indices_.insert(p.second.begin(), p.second.end());
+    for (const auto &p : indicesBySource_) {
+        indices_ |= p.second;
     }
     onUpdate_.invoke();
 }
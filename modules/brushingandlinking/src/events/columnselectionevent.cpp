@@ -32,7 +32,7 @@
 namespace inviwo {
 
 ColumnSelectionEvent::ColumnSelectionEvent(const BrushingAndLinkingInport* src,
-                                           const std::unordered_set<size_t>& indices)
+                                           const BitSet& indices)
     : BrushingAndLinkingEvent(src, indices) {}
 
 void ColumnSelectionEvent::print(std::ostream& os) const { printEvent("ColumnSelectionEvent", os); }
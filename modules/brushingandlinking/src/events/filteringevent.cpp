@@ -31,8 +31,7 @@
 
 namespace inviwo {
 
-FilteringEvent::FilteringEvent(const BrushingAndLinkingInport* src,
-                               const std::unordered_set<size_t>& indices)
+FilteringEvent::FilteringEvent(const BrushingAndLinkingInport* src, const BitSet& indices)
     : BrushingAndLinkingEvent(src, indices) {}
 
 void FilteringEvent::print(std::ostream& os) const { printEvent("FilteringEvent", os); }
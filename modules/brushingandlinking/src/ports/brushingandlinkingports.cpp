@@ -41,17 +41,21 @@ BrushingAndLinkingInport::BrushingAndLinkingInport(std::string identifier)
     });
 }
 
-void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
-    if (filterCache_.size() == 0 && indices.size() == 0) return;
+void BrushingAndLinkingInport::sendFilterEvent(const BitSet &indices) {
+    if (filterCache_.empty() && indices.empty()) return;
     filterCache_ = indices;
     FilteringEvent event(this, filterCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
+    sendFilterEvent(BitSet(indices));
+}
+
+void BrushingAndLinkingInport::sendSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedIndices().empty();
+        noRemoteSelections = getData()->getSelected().empty();
     }
     if (selectionCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
@@ -61,10 +65,14 @@ void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+    sendSelectionEvent(BitSet(indices));
+}
+
+void BrushingAndLinkingInport::sendColumnSelectionEvent(const BitSet &indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
-        noRemoteSelections = getData()->getSelectedColumns().empty();
+        noRemoteSelections = getData()->getSelectedColumnSet().empty();
     }
     if (selectionColumnCache_.empty() && indices.empty() && noRemoteSelections) {
         return;
@@ -74,38 +82,55 @@ void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set
     propagateEvent(&event, nullptr);
 }
 
+void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+    sendColumnSelectionEvent(BitSet(indices));
+}
+
 bool BrushingAndLinkingInport::isColumnSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isColumnSelected(idx);
     } else {
-        return selectionColumnCache_.find(idx) != selectionColumnCache_.end();
+        return idx <= std::numeric_limits<std::uint32_t>::max() &&
+               selectionColumnCache_.contains(static_cast<std::uint32_t>(idx));
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedIndices() const {
+const BitSet &BrushingAndLinkingInport::getSelected() const {
     if (isConnected()) {
-        return getData()->getSelectedIndices();
+        return getData()->getSelected();
     } else {
         return selectionCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getFilteredIndices() const {
+const BitSet &BrushingAndLinkingInport::getFiltered() const {
     if (isConnected()) {
-        return getData()->getFilteredIndices();
+        return getData()->getFiltered();
     } else {
         return filterCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedColumns() const {
+const BitSet &BrushingAndLinkingInport::getSelectedColumnSet() const {
     if (isConnected()) {
-        return getData()->getSelectedColumns();
+        return getData()->getSelectedColumnSet();
     } else {
         return selectionColumnCache_;
     }
 }
 
+std::unordered_set<size_t> BrushingAndLinkingInport::getSelectedIndices() const {
+    return getSelected().toUnorderedSet();
+}
+
+std::unordered_set<size_t> BrushingAndLinkingInport::getFilteredIndices() const {
+    return getFiltered().toUnorderedSet();
+}
+
+std::unordered_set<size_t> BrushingAndLinkingInport::getSelectedColumns() const {
+    return getSelectedColumnSet().toUnorderedSet();
+}
+
 std::string BrushingAndLinkingInport::getClassIdentifier() const {
     return PortTraits<BrushingAndLinkingInport>::classIdentifier();
 }
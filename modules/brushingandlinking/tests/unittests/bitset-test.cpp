@@ -0,0 +1,137 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+// Sparse values spread over several containers and a dense range that uses a bitmap container
+std::vector<std::uint32_t> randomValues(std::uint32_t seed, size_t count, std::uint32_t max) {
+    std::mt19937 rand(seed);
+    std::uniform_int_distribution<std::uint32_t> dist(0, max);
+    std::vector<std::uint32_t> values(count);
+    std::generate(values.begin(), values.end(), [&]() { return dist(rand); });
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+}  // namespace
+
+TEST(BitSet, addRemoveContains) {
+    BitSet set;
+    EXPECT_TRUE(set.empty());
+
+    set.add(5);
+    set.add(70000);
+    set.add(5);
+    set.add(3);
+    EXPECT_EQ(3, set.cardinality());
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_TRUE(set.contains(70000));
+    EXPECT_FALSE(set.contains(4));
+    EXPECT_EQ(std::vector<std::uint32_t>({3, 5, 70000}), set.toVector());
+
+    set.remove(70000);
+    set.remove(6);
+    EXPECT_EQ(std::vector<std::uint32_t>({3, 5}), set.toVector());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(BitSet, denseContainers) {
+    BitSet set;
+    set.addRange(100, 20000);
+    EXPECT_EQ(19900, set.cardinality());
+    EXPECT_FALSE(set.contains(99));
+    EXPECT_TRUE(set.contains(100));
+    EXPECT_TRUE(set.contains(19999));
+    EXPECT_FALSE(set.contains(20000));
+
+    // Removing values switches back to an array representation without changing the values
+    for (std::uint32_t i = 4000; i < 20000; ++i) set.remove(i);
+    BitSet expected;
+    expected.addRange(100, 4000);
+    EXPECT_EQ(expected, set);
+}
+
+TEST(BitSet, setOperations) {
+    const auto a = randomValues(1, 20000, 200000);
+    const auto b = randomValues(2, 5000, 100000);
+    const BitSet setA(a.begin(), a.end());
+    const BitSet setB(b.begin(), b.end());
+
+    std::vector<std::uint32_t> expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected, (setA | setB).toVector());
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected, (setA & setB).toVector());
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected, (setA - setB).toVector());
+
+    EXPECT_EQ(setA, setA | BitSet{});
+    EXPECT_TRUE((setA & BitSet{}).empty());
+}
+
+TEST(BitSet, iteration) {
+    BitSet set{7, 1, 65536};
+    set.addRange(200000, 210000);
+
+    const std::vector<std::uint32_t> iterated(set.begin(), set.end());
+    EXPECT_EQ(set.toVector(), iterated);
+    EXPECT_EQ(10003, iterated.size());
+    EXPECT_TRUE(std::is_sorted(iterated.begin(), iterated.end()));
+}
+
+TEST(BitSet, adapters) {
+    const std::unordered_set<size_t> indices{4, 2, 9};
+    const BitSet set(indices);
+    EXPECT_EQ(indices, set.toUnorderedSet());
+
+    const std::vector<bool> mask{false, false, true, false, true, false};
+    EXPECT_EQ(mask, set.toMask(6));
+    EXPECT_EQ(BitSet({2, 4}), BitSet(mask));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,111 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class CategoricalDictionary
+ * \brief Dictionary encoding of strings, maps unique strings to consecutive ids.
+ *
+ * Ids are assigned in order of insertion starting at 0 and never change. The strings are stored
+ * back to back in a single character arena and are found through a hash index, hence lookup and
+ * insertion are O(1) on average. A dictionary can be shared by several CategoricalColumns, the
+ * ids of all of them then refer to the same categories.
+ *
+ * The dictionary is not thread safe, concurrent calls to addOrGet() need external
+ * synchronization.
+ */
+class IVW_MODULE_DATAFRAME_API CategoricalDictionary {
+public:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    CategoricalDictionary() = default;
+    explicit CategoricalDictionary(const std::vector<std::string>& categories);
+
+    /**
+     * Returns the id of \p str, \p str is added to the dictionary if not already present.
+     */
+    std::uint32_t addOrGet(std::string_view str);
+
+    /**
+     * Returns the id of \p str, or CategoricalDictionary::npos if \p str is not present.
+     */
+    std::uint32_t find(std::string_view str) const;
+
+    /**
+     * Returns the string with the given id. The view is invalidated by the next insertion.
+     */
+    std::string_view get(std::uint32_t id) const {
+        return std::string_view(arena_.data() + offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+    std::string_view operator[](std::uint32_t id) const { return get(id); }
+
+    size_t size() const { return hashes_.size(); }
+    bool empty() const { return hashes_.empty(); }
+
+    /**
+     * Reserve space for \p categories strings with a total of \p characters characters.
+     */
+    void reserve(size_t categories, size_t characters = 0);
+
+    /**
+     * Returns a copy of all strings ordered by their ids.
+     */
+    std::vector<std::string> getStrings() const;
+
+    /**
+     * Adds all strings of \p other which are not already present. The hashes of \p other are
+     * reused, i.e. no string is hashed again.
+     * @return mapping from the ids of \p other to the ids of this dictionary
+     */
+    std::vector<std::uint32_t> merge(const CategoricalDictionary& other);
+
+private:
+    std::uint32_t addOrGet(std::string_view str, size_t hash);
+    // slot of \p str in the index, or of the empty slot where it would be inserted
+    size_t findSlot(std::string_view str, size_t hash) const;
+    void rehash(size_t slots);
+
+    std::string arena_;
+    std::vector<size_t> offsets_{0};    // string i is [offsets_[i], offsets_[i + 1]) in arena_
+    std::vector<size_t> hashes_;        // hash of each string, used when rebuilding the index
+    std::vector<std::uint32_t> index_;  // open addressing with linear probing, npos is empty
+};
+
+}  // namespace inviwo
@@ -37,8 +37,12 @@
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/util/exception.h>
 
+#include <inviwo/dataframe/datastructures/categoricaldictionary.h>
 #include <inviwo/dataframe/datastructures/datapoint.h>
 
+#include <iterator>
+#include <string_view>
+
 namespace inviwo {
 
 class DataPointBase;
@@ -175,15 +179,24 @@ protected:
  *    by 0, 0, 1, 2.
  *    The original string values can be accessed using CategoricalColumn::get(index, true)
  *
- * \see TemplateColumn, \see CategoricalColumn::get()
+ * The mapping is stored in a CategoricalDictionary, which can be shared between columns. Copies
+ * of a column get their own copy of the dictionary.
+ *
+ * \see TemplateColumn, \see CategoricalColumn::get(), \see CategoricalDictionary
  */
 class IVW_MODULE_DATAFRAME_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
 public:
     CategoricalColumn(const std::string &header);
-    CategoricalColumn(const CategoricalColumn &rhs) = default;
+    /**
+     * Create a column using \p dictionary for mapping categorical values, a new dictionary is
+     * created if \p dictionary is nullptr.
+     */
+    CategoricalColumn(const std::string &header,
+                      std::shared_ptr<CategoricalDictionary> dictionary);
+    CategoricalColumn(const CategoricalColumn &rhs);
     CategoricalColumn(CategoricalColumn &&rhs) = default;
 
-    CategoricalColumn &operator=(const CategoricalColumn &rhs) = default;
+    CategoricalColumn &operator=(const CategoricalColumn &rhs);
     CategoricalColumn &operator=(CategoricalColumn &&rhs) = default;
 
     virtual CategoricalColumn *clone() const override;
@@ -209,15 +222,42 @@ public:
 
     virtual void add(const std::string &value) override;
 
+    /**
+     * Append the categorical values in [begin, end), the values have to be convertible to
+     * std::string_view.
+     */
+    template <typename InputIt>
+    void addMany(InputIt begin, InputIt end);
+    void addMany(const std::vector<std::string> &values);
+
+    /**
+     * Set the categorical values of the rows starting at \p first to the values in [begin, end),
+     * the values have to be convertible to std::string_view.
+     * @throws RangeException if the rows [first, first + distance(begin, end)) are not all within
+     * the column, in which case neither the column nor the categories are modified.
+     */
+    template <typename InputIt>
+    void setMany(size_t first, InputIt begin, InputIt end);
+    void setMany(size_t first, const std::vector<std::string> &values);
+
+    /**
+     * Returns the internal representation of the categorical value \p str. The value is added
+     * to the set of categorical values if not already present. Used for bulk insertion of
+     * data directly into the buffer, see getTypedBuffer().
+     */
+    std::uint32_t addOrGetCategory(std::string_view str);
+
     /**
      * Returns the unique set of categorical values.
      */
-    const std::vector<std::string> &getCategories() const { return lookUpTable_; }
+    std::vector<std::string> getCategories() const;
+    size_t getNumberOfCategories() const;
 
-private:
-    virtual glm::uint32_t addOrGetID(const std::string &str);
+    std::shared_ptr<CategoricalDictionary> getDictionary();
+    std::shared_ptr<const CategoricalDictionary> getDictionary() const;
 
-    std::vector<std::string> lookUpTable_;
+private:
+    std::shared_ptr<CategoricalDictionary> dictionary_;
 };
 
 template <typename T>
@@ -396,6 +436,27 @@ size_t TemplateColumn<T>::getSize() const {
     return buffer_->getSize();
 }
 
+template <typename InputIt>
+void CategoricalColumn::addMany(InputIt begin, InputIt end) {
+    auto &data = getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    std::transform(begin, end, std::back_inserter(data),
+                   [&](const auto &value) { return dictionary_->addOrGet(value); });
+}
+
+template <typename InputIt>
+void CategoricalColumn::setMany(size_t first, InputIt begin, InputIt end) {
+    auto &data = getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    const auto count = static_cast<size_t>(std::distance(begin, end));
+    if (first > data.size() || count > data.size() - first) {
+        throw RangeException("Rows [" + std::to_string(first) + ", " +
+                                 std::to_string(first + count) + ") out of range for column '" +
+                                 getHeader() + "' of size " + std::to_string(data.size()),
+                             IVW_CONTEXT_CUSTOM("CategoricalColumn::setMany"));
+    }
+    std::transform(begin, end, data.begin() + first,
+                   [&](const auto &value) { return dictionary_->addOrGet(value); });
+}
+
 }  // namespace inviwo
 
 #endif  // IVW_COLUMN_H
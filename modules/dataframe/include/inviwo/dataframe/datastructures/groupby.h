@@ -0,0 +1,111 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Aggregation of DataFrame rows grouped by the values of one or more key columns, e.g.
+ *
+ *     using namespace groupby;
+ *     auto summary = groupBy(dataframe, {Key{"type"}, Key{"x", 10}},
+ *                            {{Aggregate::Count}, {Aggregate::Mean, "y"},
+ *                             {Aggregate::Percentile, "y", 0.9}});
+ *
+ * The rows are split into contiguous ranges which are aggregated concurrently on the thread pool,
+ * each into its own partial hash table. The partial tables are then merged, again concurrently,
+ * with each job merging a disjoint partition of the groups.
+ */
+namespace groupby {
+
+/**
+ * Key column of a group-by. Categorical columns are grouped by category. Numerical columns are
+ * either grouped by their distinct values, or by the bin of the values if \p bins is non-zero.
+ * Bins are of equal width and span \p range, or the range of the column if not given. Values
+ * outside of the range are put in the first and last bin, respectively. Rows with NaN keys do not
+ * belong to any group.
+ */
+struct IVW_MODULE_DATAFRAME_API Key {
+    Key(std::string header, size_t bins = 0, std::optional<dvec2> range = std::nullopt);
+
+    std::string header;
+    size_t bins;
+    std::optional<dvec2> range;
+};
+
+enum class Aggregate { Count, Sum, Mean, Min, Max, Variance, Percentile };
+
+/**
+ * An aggregate of the values of column \p header within each group. Count is the number of rows
+ * in the group and does not need a column. NaN values are ignored by all other aggregates, the
+ * aggregate of a group without any values is NaN, except for Sum which is 0. Variance is the
+ * sample variance. Percentile is computed by linear interpolation between the closest ranks, with
+ * \p percentile in [0, 1].
+ */
+struct IVW_MODULE_DATAFRAME_API Aggregation {
+    Aggregation(Aggregate aggregate, std::string header = "", double percentile = 0.5,
+                std::string outputHeader = "");
+
+    Aggregate aggregate;
+    std::string header;
+    double percentile;
+    /**
+     * Header of the resulting column, if empty a header like "mean(y)" is used, see
+     * defaultHeader()
+     */
+    std::string outputHeader;
+};
+
+IVW_MODULE_DATAFRAME_API std::string defaultHeader(const Aggregation& aggregation);
+
+/**
+ * Group the rows of \p dataframe by \p keys and compute \p aggregations for each group. The
+ * resulting DataFrame has one row per non-empty group, ordered by the key columns, and one column
+ * per key followed by one column per aggregation. Categorical key columns share the
+ * CategoricalDictionary with \p dataframe and are ordered by category name, binned keys hold the
+ * center of each bin, other keys hold the values of the group with the type of the key column.
+ * Count columns are of type uint32, all other aggregates are double.
+ * @throws Exception if there are no keys or if a key or aggregation refers to a missing column
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> groupBy(
+    const DataFrame& dataframe, const std::vector<Key>& keys,
+    const std::vector<Aggregation>& aggregations);
+
+}  // namespace groupby
+
+}  // namespace inviwo
@@ -0,0 +1,179 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * Filtering of DataFrame rows with boolean expressions over the columns.
+ *
+ * Expressions are built either programmatically
+ *
+ *     using namespace query;
+ *     auto expr = (col("x") > 0.5 && col("y").inRange(-1.0, 1.0)) || col("type") == "star";
+ *
+ * or from text, see query::parse(). Evaluating an expression gives a selection Mask which can be
+ * turned into a new DataFrame with query::filter(). The rows are evaluated in batches of a few
+ * thousand rows, each predicate runs as a tight loop over a contiguous range of its column,
+ * independent batches are distributed over the thread pool.
+ */
+namespace query {
+
+namespace detail {
+class Node;
+}
+
+/**
+ * Dense selection mask with one entry per row, 1 for selected rows and 0 otherwise
+ */
+using Mask = std::vector<std::uint8_t>;
+
+enum class Comparison { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+
+/**
+ * An immutable boolean expression over the columns of a DataFrame. Copies share the underlying
+ * expression tree. A default constructed expression selects all rows.
+ */
+class IVW_MODULE_DATAFRAME_API Expr {
+public:
+    Expr();
+    explicit Expr(std::shared_ptr<const detail::Node> node);
+
+    const std::shared_ptr<const detail::Node>& getNode() const { return node_; }
+
+private:
+    std::shared_ptr<const detail::Node> node_;
+};
+
+IVW_MODULE_DATAFRAME_API Expr operator&&(const Expr& lhs, const Expr& rhs);
+IVW_MODULE_DATAFRAME_API Expr operator||(const Expr& lhs, const Expr& rhs);
+IVW_MODULE_DATAFRAME_API Expr operator!(const Expr& expr);
+
+/**
+ * Refers to a column by its header and creates predicates on that column. Numerical predicates
+ * compare the values of the column, for categorical columns that means the internal
+ * representation. String predicates are only valid for categorical columns. Comparisons with NaN
+ * values are false, except for NotEqual.
+ */
+class IVW_MODULE_DATAFRAME_API ColumnRef {
+public:
+    explicit ColumnRef(std::string header);
+
+    Expr compare(Comparison comparison, double value) const;
+    Expr operator<(double value) const;
+    Expr operator<=(double value) const;
+    Expr operator>(double value) const;
+    Expr operator>=(double value) const;
+    Expr operator==(double value) const;
+    Expr operator!=(double value) const;
+
+    /**
+     * Selects rows with values in the closed interval [min, max]
+     */
+    Expr inRange(double min, double max) const;
+
+    Expr operator==(std::string_view category) const;
+    Expr operator!=(std::string_view category) const;
+    /**
+     * Selects rows with any of the given categorical values
+     */
+    Expr isIn(std::vector<std::string> categories) const;
+
+    const std::string& getHeader() const;
+
+private:
+    std::string header_;
+};
+
+IVW_MODULE_DATAFRAME_API ColumnRef col(std::string header);
+
+/**
+ * Parse an expression from text, e.g.
+ *
+ *     x > 0.5 and (type == "star" or type in {"planet", "moon"}) and not `y pos` in [-1, 1]
+ *
+ * Columns are referred to by their header, either directly if the header is an identifier or
+ * quoted with backticks. Supported are the comparisons <, <=, >, >=, ==, != with numbers, == and
+ * != with double quoted strings, `in [min, max]` for closed intervals, `in {"a", "b"}` for sets of
+ * categorical values, the boolean operators and/&&, or/||, not/! and parentheses. An empty
+ * string selects all rows.
+ * @throws Exception if the text is not a valid expression
+ */
+IVW_MODULE_DATAFRAME_API Expr parse(std::string_view text);
+
+/**
+ * Evaluate \p expr for all rows of \p dataframe. Only the columns used in the expression are
+ * accessed.
+ * @throws Exception if the expression refers to a missing column, or compares a column that is
+ * not categorical with strings
+ */
+IVW_MODULE_DATAFRAME_API Mask evaluate(const DataFrame& dataframe, const Expr& expr);
+
+/**
+ * Number of selected rows in \p mask
+ */
+IVW_MODULE_DATAFRAME_API size_t count(const Mask& mask);
+
+/**
+ * Indices of the selected rows in \p mask
+ */
+IVW_MODULE_DATAFRAME_API std::vector<std::uint32_t> selectedIndices(const Mask& mask);
+
+/**
+ * Create a DataFrame with the rows of \p dataframe selected by \p mask. The index column holds
+ * the values of the index column of \p dataframe for the selected rows, i.e. the row ids used for
+ * brushing and linking are kept. Categorical columns share the CategoricalDictionary with
+ * \p dataframe. If all rows are selected, all columns are shared with \p dataframe instead of
+ * being copied.
+ * @throws Exception if the size of \p mask does not match the number of rows
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> filter(
+    std::shared_ptr<const DataFrame> dataframe, const Mask& mask);
+
+/**
+ * Create a DataFrame that shares all columns with \p dataframe and has an additional column
+ * \p header holding \p mask.
+ * @throws Exception if the size of \p mask does not match the number of rows
+ */
+IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> appendMask(
+    std::shared_ptr<const DataFrame> dataframe, const Mask& mask, const std::string& header);
+
+}  // namespace query
+
+}  // namespace inviwo
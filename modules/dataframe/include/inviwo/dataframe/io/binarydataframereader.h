@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <array>
+#include <iosfwd>
+
+namespace inviwo {
+
+namespace binarydataframe {
+
+/**
+ * Layout of a binary DataFrame file (native little endian byte order):
+ *
+ *     magic "IVWDFBIN", uint32 version, uint32 byte order mark (0x01020304)
+ *     uint64 rows, uint64 rows per statistics block, uint64 columns
+ *     for each column:
+ *         string header, string data format, uint8 categorical, uint8 statistics,
+ *         uint64 data offset, uint64 data size in bytes
+ *         if statistics: uint64 blocks, blocks x (double min, double max)
+ *         if categorical: uint64 categories, categories x string
+ *     column data, each column starting at an 8 byte aligned offset
+ *
+ * Strings are stored as uint64 length followed by the characters. The index column of the
+ * DataFrame is not stored.
+ */
+constexpr std::array<char, 8> magic{'I', 'V', 'W', 'D', 'F', 'B', 'I', 'N'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+constexpr size_t alignment = 8;
+
+struct IVW_MODULE_DATAFRAME_API ColumnInfo {
+    std::string header;
+    const DataFormatBase* format = nullptr;
+    bool categorical = false;
+    size_t offset = 0;  //!< Offset of the column data in bytes from the start of the file
+    size_t bytes = 0;
+    /**
+     * Min and max value of each block of rows, empty if no statistics were stored. NaN values are
+     * ignored, a block without any valid values has NaN as min and max.
+     */
+    std::vector<dvec2> blockMinMax;
+    std::vector<std::string> categories;
+};
+
+struct IVW_MODULE_DATAFRAME_API FileInfo {
+    size_t rows = 0;
+    size_t blockSize = 0;  //!< Number of rows per statistics block
+    std::vector<ColumnInfo> columns;
+};
+
+/**
+ * Read the header of a binary DataFrame file, i.e. everything but the column data.
+ * @throws DataReaderException if the stream does not contain a valid header
+ */
+IVW_MODULE_DATAFRAME_API FileInfo readFileInfo(std::istream& stream);
+
+}  // namespace binarydataframe
+
+/**
+ * \class BinaryDataFrameReader
+ * \ingroup dataio
+ * Reads a DataFrame from the binary columnar format written by BinaryDataFrameWriter, see
+ * binarydataframe::FileInfo for the layout. Only the header and the categorical values are read
+ * up front. The data of each column is memory mapped and copied into the column buffer the first
+ * time the buffer is accessed, columns that are never used are never read.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameReader : public DataReaderType<DataFrame> {
+public:
+    BinaryDataFrameReader();
+    BinaryDataFrameReader(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader(BinaryDataFrameReader&&) noexcept = default;
+    BinaryDataFrameReader& operator=(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader& operator=(BinaryDataFrameReader&&) noexcept = default;
+    virtual BinaryDataFrameReader* clone() const override;
+    virtual ~BinaryDataFrameReader() = default;
+
+    /**
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the file is not a valid binary DataFrame file
+     */
+    virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,69 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+namespace inviwo {
+
+/**
+ * \class BinaryDataFrameWriter
+ * \ingroup dataio
+ * Writes a DataFrame into a binary columnar file which can be read lazily by
+ * BinaryDataFrameReader, see binarydataframe::FileInfo for the layout. The index column is not
+ * written. Optionally the min and max value of each block of rows is stored for numeric columns.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameWriter : public DataWriterType<DataFrame> {
+public:
+    BinaryDataFrameWriter();
+    BinaryDataFrameWriter(const BinaryDataFrameWriter&) = default;
+    BinaryDataFrameWriter& operator=(const BinaryDataFrameWriter&) = default;
+    virtual BinaryDataFrameWriter* clone() const override;
+    virtual ~BinaryDataFrameWriter() = default;
+
+    /**
+     * @throws DataWriterException if the file exists and overwrite is not set, the file cannot be
+     * written, or the DataFrame contains columns with non-scalar data formats
+     */
+    virtual void writeData(const DataFrame* data, const std::string filePath) const override;
+
+    /**
+     * Number of rows per statistics block, 0 disables the statistics. Default 65536.
+     */
+    void setBlockSize(size_t rows);
+    size_t getBlockSize() const;
+
+private:
+    size_t blockSize_ = 65536;
+};
+
+}  // namespace inviwo
@@ -58,6 +58,11 @@ public:
  *
  * \brief A reader for comma separated value (CSV) files with customizable delimiters.
  * The default delimiter is ',' and headers are included
+ *
+ * The column types are derived from the first 50 rows. Columns where the majority of values are
+ * numbers become float columns, all others categorical columns. Files are memory mapped and the
+ * data is split into chunks of rows, which are parsed concurrently on the thread pool directly
+ * into the column buffers.
  */
 class IVW_MODULE_DATAFRAME_API CSVReader : public DataReaderType<DataFrame> {
 public:
@@ -51,10 +51,11 @@ namespace inviwo {
 
 /** \docpage{org.inviwo.DataFrameExporter, DataFrame Exporter}
  * ![](org.inviwo.DataFrameExporter.png?classIdentifier=org.inviwo.DataFrameExporter)
- * This processor exports a DataFrame into a CSV or XML file.
+ * This processor exports a DataFrame into a CSV, XML, or binary file. The binary format can be
+ * read back lazily, see BinaryDataFrameReader.
  *
  * ### Inports
- *   * __<Inport>__ source DataFrame which is saved as CSV or XML file
+ *   * __<Inport>__ source DataFrame which is saved as CSV, XML, or binary file
  *
  */
 
@@ -74,6 +75,7 @@ protected:
 private:
     void exportAsCSV(bool separateVectorTypesIntoColumns = true);
     void exportAsXML();
+    void exportAsBinary();
 
     DataInport<DataFrame> dataFrame_;
 
@@ -87,6 +89,7 @@ private:
 
     static FileExtension csvExtension_;
     static FileExtension xmlExtension_;
+    static FileExtension binaryExtension_;
 
     bool export_;
 };
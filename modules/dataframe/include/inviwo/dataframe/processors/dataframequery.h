@@ -0,0 +1,82 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/stringproperty.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.DataFrameQuery, DataFrame Query}
+ * ![](org.inviwo.DataFrameQuery.png?classIdentifier=org.inviwo.DataFrameQuery)
+ * Selects the rows of a DataFrame matching a query, e.g.
+ * `x > 0.5 and (type == "star" or y in [-1, 1])`, see query::parse() for the syntax.
+ *
+ * ### Inports
+ *   * __inport__  source DataFrame
+ *
+ * ### Outports
+ *   * __outport__  DataFrame with the selected rows, or the source DataFrame with an additional
+ *                  selection column
+ *
+ * ### Properties
+ *   * __Query__   expression selecting rows, an empty query selects all rows
+ *   * __Output__  either only the selected rows, or all rows with an additional column holding 1
+ *                 for selected rows and 0 otherwise. The index column of the filtered rows keeps
+ *                 the row ids of the source DataFrame.
+ *   * __Selection Column__  name of the additional selection column
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameQuery : public Processor {
+public:
+    enum class OutputMode { FilterRows, SelectionColumn };
+
+    DataFrameQuery();
+    virtual ~DataFrameQuery() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<DataFrame> inport_;
+    DataOutport<DataFrame> outport_;
+
+    StringProperty query_;
+    TemplateOptionProperty<OutputMode> outputMode_;
+    StringProperty selectionColumn_;
+};
+
+}  // namespace inviwo
@@ -32,12 +32,16 @@
 #include <inviwo/dataframe/processors/csvsource.h>
 #include <inviwo/dataframe/processors/dataframesource.h>
 #include <inviwo/dataframe/processors/dataframeexporter.h>
+#include <inviwo/dataframe/processors/dataframegroupby.h>
+#include <inviwo/dataframe/processors/dataframequery.h>
 #include <inviwo/dataframe/processors/imagetodataframe.h>
 #include <inviwo/dataframe/processors/syntheticdataframe.h>
 #include <inviwo/dataframe/processors/volumetodataframe.h>
 #include <inviwo/dataframe/processors/volumesequencetodataframe.h>
 #include <inviwo/dataframe/properties/colormapproperty.h>
 
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
 #include <inviwo/dataframe/io/csvreader.h>
 #include <inviwo/dataframe/io/jsonreader.h>
 
@@ -54,6 +58,8 @@ DataFrameModule::DataFrameModule(InviwoApplication* app) : InviwoModule(app, "Da
     registerProcessor<CSVSource>();
     registerProcessor<DataFrameSource>();
     registerProcessor<DataFrameExporter>();
+    registerProcessor<DataFrameGroupBy>();
+    registerProcessor<DataFrameQuery>();
     registerProcessor<ImageToDataFrame>();
     registerProcessor<SyntheticDataFrame>();
     registerProcessor<VolumeToDataFrame>();
@@ -67,6 +73,8 @@ DataFrameModule::DataFrameModule(InviwoApplication* app) : InviwoModule(app, "Da
     // Readers and writes
     registerDataReader(std::make_unique<CSVReader>());
     registerDataReader(std::make_unique<JSONDataFrameReader>());
+    registerDataReader(std::make_unique<BinaryDataFrameReader>());
+    registerDataWriter(std::make_unique<BinaryDataFrameWriter>());
 
     // Data converters
     registerPropertyConverter(std::make_unique<OptionToStringConverter<DataFrameColumnProperty>>());
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/categoricaldictionary.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace inviwo {
+
+CategoricalDictionary::CategoricalDictionary(const std::vector<std::string>& categories) {
+    reserve(categories.size(),
+            std::accumulate(categories.begin(), categories.end(), size_t{0},
+                            [](size_t sum, const std::string& str) { return sum + str.size(); }));
+    for (const auto& str : categories) addOrGet(str);
+}
+
+std::uint32_t CategoricalDictionary::addOrGet(std::string_view str) {
+    return addOrGet(str, std::hash<std::string_view>{}(str));
+}
+
+std::uint32_t CategoricalDictionary::find(std::string_view str) const {
+    if (index_.empty()) return npos;
+    return index_[findSlot(str, std::hash<std::string_view>{}(str))];
+}
+
+void CategoricalDictionary::reserve(size_t categories, size_t characters) {
+    arena_.reserve(characters);
+    offsets_.reserve(categories + 1);
+    hashes_.reserve(categories);
+    size_t slots = 16;
+    while (slots < 2 * categories) slots *= 2;
+    if (slots > index_.size()) rehash(slots);
+}
+
+std::vector<std::string> CategoricalDictionary::getStrings() const {
+    std::vector<std::string> strings;
+    strings.reserve(size());
+    for (std::uint32_t id = 0; id < size(); ++id) strings.emplace_back(get(id));
+    return strings;
+}
+
+std::vector<std::uint32_t> CategoricalDictionary::merge(const CategoricalDictionary& other) {
+    std::vector<std::uint32_t> ids(other.size());
+    if (&other == this) {
+        std::iota(ids.begin(), ids.end(), std::uint32_t{0});
+        return ids;
+    }
+    reserve(size() + other.size(), arena_.size() + other.arena_.size());
+    for (std::uint32_t id = 0; id < other.size(); ++id) {
+        ids[id] = addOrGet(other.get(id), other.hashes_[id]);
+    }
+    return ids;
+}
+
+std::uint32_t CategoricalDictionary::addOrGet(std::string_view str, size_t hash) {
+    if (!index_.empty()) {
+        const auto id = index_[findSlot(str, hash)];
+        if (id != npos) return id;
+    }
+    if (size() >= npos) {
+        throw Exception("Too many categories", IVW_CONTEXT);
+    }
+    // keep the load factor below 0.5
+    if (2 * (size() + 1) > index_.size()) rehash(std::max(size_t{16}, 2 * index_.size()));
+
+    const auto id = static_cast<std::uint32_t>(size());
+    arena_.append(str);
+    offsets_.push_back(arena_.size());
+    hashes_.push_back(hash);
+    index_[findSlot(str, hash)] = id;
+    return id;
+}
+
+size_t CategoricalDictionary::findSlot(std::string_view str, size_t hash) const {
+    const size_t mask = index_.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const auto id = index_[slot];
+        if (id == npos || (hashes_[id] == hash && get(id) == str)) return slot;
+    }
+}
+
+void CategoricalDictionary::rehash(size_t slots) {
+    index_.assign(slots, npos);
+    const size_t mask = slots - 1;
+    for (std::uint32_t id = 0; id < size(); ++id) {
+        size_t slot = hashes_[id] & mask;
+        while (index_[slot] != npos) slot = (slot + 1) & mask;
+        index_[slot] = id;
+    }
+}
+
+}  // namespace inviwo
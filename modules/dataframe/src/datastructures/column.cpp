@@ -32,13 +32,30 @@
 namespace inviwo {
 
 CategoricalColumn::CategoricalColumn(const std::string &header)
-    : TemplateColumn<std::uint32_t>(header) {}
+    : CategoricalColumn(header, nullptr) {}
+
+CategoricalColumn::CategoricalColumn(const std::string &header,
+                                     std::shared_ptr<CategoricalDictionary> dictionary)
+    : TemplateColumn<std::uint32_t>(header)
+    , dictionary_(dictionary ? dictionary : std::make_shared<CategoricalDictionary>()) {}
+
+CategoricalColumn::CategoricalColumn(const CategoricalColumn &rhs)
+    : TemplateColumn<std::uint32_t>(rhs)
+    , dictionary_(std::make_shared<CategoricalDictionary>(*rhs.dictionary_)) {}
+
+CategoricalColumn &CategoricalColumn::operator=(const CategoricalColumn &rhs) {
+    if (this != &rhs) {
+        TemplateColumn<std::uint32_t>::operator=(rhs);
+        dictionary_ = std::make_shared<CategoricalDictionary>(*rhs.dictionary_);
+    }
+    return *this;
+}
 
 CategoricalColumn *CategoricalColumn::clone() const { return new CategoricalColumn(*this); }
 
 std::string CategoricalColumn::getAsString(size_t idx) const {
     auto index = getTypedBuffer()->getRAMRepresentation()->getDataContainer()[idx];
-    return lookUpTable_[index];
+    return std::string(dictionary_->get(index));
 }
 
 std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getStringsAsStrings) const {
@@ -50,22 +67,37 @@ std::shared_ptr<DataPointBase> CategoricalColumn::get(size_t idx, bool getString
 }
 
 void CategoricalColumn::set(size_t idx, const std::string &str) {
-    auto id = addOrGetID(str);
+    auto id = dictionary_->addOrGet(str);
     getTypedBuffer()->getEditableRAMRepresentation()->set(idx, id);
 }
 
 void CategoricalColumn::add(const std::string &value) {
-    auto id = addOrGetID(value);
+    auto id = dictionary_->addOrGet(value);
     getTypedBuffer()->getEditableRAMRepresentation()->add(id);
 }
 
-glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
-    auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
-    if (it != lookUpTable_.end()) {
-        return static_cast<glm::uint32_t>(std::distance(lookUpTable_.begin(), it));
-    }
-    lookUpTable_.push_back(str);
-    return static_cast<glm::uint32_t>(lookUpTable_.size() - 1);
+void CategoricalColumn::addMany(const std::vector<std::string> &values) {
+    addMany(values.begin(), values.end());
+}
+
+void CategoricalColumn::setMany(size_t first, const std::vector<std::string> &values) {
+    setMany(first, values.begin(), values.end());
+}
+
+std::uint32_t CategoricalColumn::addOrGetCategory(std::string_view str) {
+    return dictionary_->addOrGet(str);
+}
+
+std::vector<std::string> CategoricalColumn::getCategories() const {
+    return dictionary_->getStrings();
+}
+
+size_t CategoricalColumn::getNumberOfCategories() const { return dictionary_->size(); }
+
+std::shared_ptr<CategoricalDictionary> CategoricalColumn::getDictionary() { return dictionary_; }
+
+std::shared_ptr<const CategoricalDictionary> CategoricalColumn::getDictionary() const {
+    return dictionary_;
 }
 
 }  // namespace inviwo
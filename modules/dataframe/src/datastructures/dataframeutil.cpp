@@ -137,6 +137,12 @@ std::shared_ptr<DataFrame> combineDataFrames(std::vector<std::shared_ptr<DataFra
     std::shared_ptr<DataFrame> newDataFrame =
         std::make_shared<DataFrame>(static_cast<glm::u32>(newSize));
     for (auto col : first) {
+        if (auto catCol = std::dynamic_pointer_cast<const CategoricalColumn>(col)) {
+            auto dictionary = std::make_shared<CategoricalDictionary>(*catCol->getDictionary());
+            columns[col->getHeader()] = newDataFrame->addColumn(
+                std::make_shared<CategoricalColumn>(col->getHeader(), dictionary));
+            continue;
+        }
         col->getBuffer()
             ->getRepresentation<BufferRAM>()
             ->dispatch<void, dispatching::filter::Scalars>([&](auto typedBuf) {
@@ -149,8 +155,27 @@ std::shared_ptr<DataFrame> combineDataFrames(std::vector<std::shared_ptr<DataFra
         for (auto col : *(data.get())) {
             if (skipIndexColumn && toLower(col->getHeader()) == skipcol) continue;
 
-            columns[col->getHeader()]
-                ->getBuffer()
+            auto dstCol = columns[col->getHeader()];
+            auto dstCatCol = std::dynamic_pointer_cast<CategoricalColumn>(dstCol);
+            auto srcCatCol = std::dynamic_pointer_cast<const CategoricalColumn>(col);
+            if (!dstCatCol != !srcCatCol) {
+                throw inviwo::Exception(
+                    "Column " + col->getHeader() +
+                        " is categorical in some data frames but not in others",
+                    IVW_CONTEXT_CUSTOM("dataframeutil::combineDataFrames"));
+            } else if (dstCatCol) {
+                // Map the ids of the source dictionary, only its categories are looked up
+                const auto ids = dstCatCol->getDictionary()->merge(*srcCatCol->getDictionary());
+                const auto& src =
+                    srcCatCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+                auto& dst =
+                    dstCatCol->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+                std::transform(src.begin(), src.end(), std::back_inserter(dst),
+                               [&](std::uint32_t id) { return ids[id]; });
+                continue;
+            }
+
+            dstCol->getBuffer()
                 ->getEditableRepresentation<BufferRAM>()
                 ->dispatch<void>([&](auto typedBuf) {
                     using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
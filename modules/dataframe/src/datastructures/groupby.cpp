@@ -0,0 +1,686 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/groupby.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/exception.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace groupby {
+
+Key::Key(std::string header, size_t bins, std::optional<dvec2> range)
+    : header{std::move(header)}, bins{bins}, range{range} {}
+
+Aggregation::Aggregation(Aggregate aggregate, std::string header, double percentile,
+                         std::string outputHeader)
+    : aggregate{aggregate}
+    , header{std::move(header)}
+    , percentile{percentile}
+    , outputHeader{std::move(outputHeader)} {}
+
+std::string defaultHeader(const Aggregation& aggregation) {
+    switch (aggregation.aggregate) {
+        case Aggregate::Count:
+            return "count";
+        case Aggregate::Sum:
+            return fmt::format("sum({})", aggregation.header);
+        case Aggregate::Mean:
+            return fmt::format("mean({})", aggregation.header);
+        case Aggregate::Min:
+            return fmt::format("min({})", aggregation.header);
+        case Aggregate::Max:
+            return fmt::format("max({})", aggregation.header);
+        case Aggregate::Variance:
+            return fmt::format("variance({})", aggregation.header);
+        case Aggregate::Percentile:
+            return fmt::format("p{:g}({})", aggregation.percentile * 100.0, aggregation.header);
+    }
+    return aggregation.header;
+}
+
+namespace {
+
+constexpr size_t batchSize = 4096;
+constexpr std::uint32_t noGroup = std::numeric_limits<std::uint32_t>::max();
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+size_t numberOfJobs(size_t rows) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    return std::max(size_t{1}, std::min(poolSize, (rows + batchSize - 1) / batchSize));
+}
+
+/**
+ * Call \p func(job) for all jobs in [0, jobs), on the thread pool if there is more than one job
+ */
+template <typename F>
+void forEachJob(size_t jobs, F&& func) {
+    if (jobs < 2) {
+        if (jobs == 1) func(size_t{0});
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        futures.push_back(dispatchPool([&func, job]() { func(job); }));
+    }
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    for (auto& future : futures) {
+        pool.wait(future);
+        future.get();
+    }
+}
+
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+std::shared_ptr<const Column> findColumn(const DataFrame& dataframe, const std::string& header) {
+    auto column = dataframe.getColumn(header);
+    if (!column) {
+        throw Exception(fmt::format("Group-by refers to unknown column '{}'", header),
+                        IVW_CONTEXT_CUSTOM("groupby"));
+    }
+    if (column->getSize() < dataframe.getNumberOfRows()) {
+        throw Exception(fmt::format("Column '{}' has {} rows, expected {}", header,
+                                    column->getSize(), dataframe.getNumberOfRows()),
+                        IVW_CONTEXT_CUSTOM("groupby"));
+    }
+    return column;
+}
+
+/**
+ * Maps the values of a key column to 64 bit codes, rows with equal codes belong to the same group
+ */
+struct KeyColumn {
+    /**
+     * Write the codes of the rows [begin, begin + n) to \p codes and set \p valid to 0 for rows
+     * that do not belong to any group
+     */
+    std::function<void(size_t begin, size_t n, std::uint64_t* codes, std::uint8_t* valid)> encode;
+    /**
+     * Value used for ordering the groups by \p code
+     */
+    std::function<double(std::uint64_t code)> order;
+    /**
+     * Create the output column holding the key values for \p codes
+     */
+    std::function<std::shared_ptr<Column>(const std::vector<std::uint64_t>& codes)> makeColumn;
+};
+
+template <typename T>
+dvec2 valueRange(const T* data, size_t rows) {
+    const auto jobs = numberOfJobs(rows);
+    std::vector<dvec2> ranges(jobs, dvec2{std::numeric_limits<double>::infinity(),
+                                          -std::numeric_limits<double>::infinity()});
+    forEachJob(jobs, [&](size_t job) {
+        auto& range = ranges[job];
+        for (size_t i = job * rows / jobs; i < (job + 1) * rows / jobs; ++i) {
+            const auto value = static_cast<double>(data[i]);
+            // NaN values fail both comparisons
+            if (value < range.x) range.x = value;
+            if (value > range.y) range.y = value;
+        }
+    });
+    return std::accumulate(ranges.begin() + 1, ranges.end(), ranges.front(),
+                           [](const dvec2& a, const dvec2& b) {
+                               return dvec2{std::min(a.x, b.x), std::max(a.y, b.y)};
+                           });
+}
+
+template <typename T>
+KeyColumn binnedKey(const std::string& header, const T* data, size_t bins, dvec2 range) {
+    const double width = range.y > range.x ? (range.y - range.x) / bins : 0.0;
+    const double scale = width > 0.0 ? 1.0 / width : 0.0;
+    const double last = static_cast<double>(bins - 1);
+
+    return {[data, range, scale, last](size_t begin, size_t n, std::uint64_t* codes,
+                                       std::uint8_t* valid) {
+                for (size_t i = 0; i < n; ++i) {
+                    const auto value = static_cast<double>(data[begin + i]);
+                    double bin = std::floor((value - range.x) * scale);
+                    // also maps the NaN of 0 * inf to the first bin
+                    bin = bin >= 0.0 ? std::min(bin, last) : 0.0;
+                    codes[i] = static_cast<std::uint64_t>(bin);
+                    if constexpr (std::is_floating_point_v<T>) {
+                        if (std::isnan(value)) valid[i] = 0;
+                    }
+                }
+            },
+            [](std::uint64_t code) { return static_cast<double>(code); },
+            [header, range, width](const std::vector<std::uint64_t>& codes) {
+                std::vector<double> centers(codes.size());
+                std::transform(codes.begin(), codes.end(), centers.begin(), [&](auto code) {
+                    return range.x + (static_cast<double>(code) + 0.5) * width;
+                });
+                return std::make_shared<TemplateColumn<double>>(header, std::move(centers));
+            }};
+}
+
+template <typename T>
+std::uint64_t encodeValue(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        // Map -0.0 to 0.0 so that they end up in the same group
+        const double d = value == T{0} ? 0.0 : static_cast<double>(value);
+        std::uint64_t code;
+        std::memcpy(&code, &d, sizeof(code));
+        return code;
+    } else {
+        return static_cast<std::uint64_t>(value);
+    }
+}
+
+template <typename T>
+T decodeValue(std::uint64_t code) {
+    if constexpr (std::is_floating_point_v<T>) {
+        double d;
+        std::memcpy(&d, &code, sizeof(d));
+        return static_cast<T>(d);
+    } else {
+        return static_cast<T>(code);
+    }
+}
+
+template <typename T>
+KeyColumn valueKey(const std::string& header, const T* data) {
+    return {[data](size_t begin, size_t n, std::uint64_t* codes, std::uint8_t* valid) {
+                for (size_t i = 0; i < n; ++i) {
+                    const auto value = data[begin + i];
+                    codes[i] = encodeValue(value);
+                    if constexpr (std::is_floating_point_v<T>) {
+                        if (std::isnan(value)) valid[i] = 0;
+                    }
+                }
+            },
+            [](std::uint64_t code) { return static_cast<double>(decodeValue<T>(code)); },
+            [header](const std::vector<std::uint64_t>& codes) {
+                std::vector<T> values(codes.size());
+                std::transform(codes.begin(), codes.end(), values.begin(),
+                               [](auto code) { return decodeValue<T>(code); });
+                return std::make_shared<TemplateColumn<T>>(header, std::move(values));
+            }};
+}
+
+KeyColumn categoricalKey(const CategoricalColumn& column) {
+    const auto data =
+        column.getTypedBuffer()->getRAMRepresentation()->getDataContainer().data();
+    auto dictionary = column.getDictionary();
+
+    // Groups are ordered by category name rather than by id
+    std::vector<std::uint32_t> ids(dictionary->size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::sort(ids.begin(), ids.end(),
+              [&](auto a, auto b) { return dictionary->get(a) < dictionary->get(b); });
+    std::vector<double> rank(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) rank[ids[i]] = static_cast<double>(i);
+
+    return {[data](size_t begin, size_t n, std::uint64_t* codes, std::uint8_t*) {
+                std::copy(data + begin, data + begin + n, codes);
+            },
+            [rank = std::move(rank)](std::uint64_t code) {
+                return code < rank.size() ? rank[code] : static_cast<double>(code);
+            },
+            [header = column.getHeader(), dictionary](const std::vector<std::uint64_t>& codes) {
+                // The dictionary is shared read-only between the DataFrames
+                auto result = std::make_shared<CategoricalColumn>(
+                    header, std::const_pointer_cast<CategoricalDictionary>(dictionary));
+                result->setBuffer(
+                    util::makeBuffer(std::vector<std::uint32_t>(codes.begin(), codes.end())));
+                return result;
+            }};
+}
+
+KeyColumn makeKeyColumn(const DataFrame& dataframe, const Key& key) {
+    const auto column = findColumn(dataframe, key.header);
+    if (auto categorical = dynamic_cast<const CategoricalColumn*>(column.get())) {
+        return categoricalKey(*categorical);
+    }
+    const auto rows = dataframe.getNumberOfRows();
+    const auto ram = column->getBuffer()->getRepresentation<BufferRAM>();
+    return ram->dispatch<KeyColumn, dispatching::filter::Scalars>([&](auto br) -> KeyColumn {
+        using T = util::PrecisionValueType<decltype(br)>;
+        const T* data = br->getDataContainer().data();
+        if (key.bins > 0) {
+            return binnedKey(key.header, data, key.bins,
+                             key.range ? *key.range : valueRange(data, rows));
+        } else {
+            return valueKey(key.header, data);
+        }
+    });
+}
+
+/**
+ * A column referred to by aggregations and the statistics needed for them
+ */
+struct ValueColumn {
+    std::function<void(size_t begin, size_t n, double* values)> read;
+    bool sum = false;
+    bool variance = false;
+    bool minMax = false;
+    size_t samples = npos;
+};
+
+ValueColumn makeValueColumn(const DataFrame& dataframe, const std::string& header) {
+    const auto column = findColumn(dataframe, header);
+    const auto ram = column->getBuffer()->getRepresentation<BufferRAM>();
+    return ram->dispatch<ValueColumn, dispatching::filter::Scalars>([](auto br) -> ValueColumn {
+        const auto data = br->getDataContainer().data();
+        ValueColumn value;
+        value.read = [data](size_t begin, size_t n, double* values) {
+            std::transform(data + begin, data + begin + n, values,
+                           [](auto v) { return static_cast<double>(v); });
+        };
+        return value;
+    });
+}
+
+struct Stats {
+    std::uint64_t count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void merge(const Stats& other) {
+        if (count == 0) {
+            count = other.count;
+            sum = other.sum;
+            mean = other.mean;
+            m2 = other.m2;
+        } else if (other.count > 0) {
+            // Chan et al. parallel variance
+            const auto n = count + other.count;
+            const double delta = other.mean - mean;
+            mean += delta * static_cast<double>(other.count) / static_cast<double>(n);
+            m2 += other.m2 + delta * delta * static_cast<double>(count) *
+                                 static_cast<double>(other.count) / static_cast<double>(n);
+            sum += other.sum;
+            count = n;
+        }
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+/**
+ * Open addressing hash table of groups, with the number of rows, statistics and samples of the
+ * values of each group
+ */
+class GroupTable {
+public:
+    GroupTable(size_t keys, size_t values, size_t samples)
+        : keys_{keys}, values_{values}, samples_{samples} {}
+
+    size_t size() const { return hashes_.size(); }
+
+    /**
+     * Index of the group of \p key, the group is added if not already present
+     */
+    std::uint32_t findOrAdd(const std::uint64_t* key, std::uint64_t hash) {
+        if (2 * (size() + 1) > slots_.size()) grow();
+        const size_t mask = slots_.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const auto group = slots_[slot];
+            if (group == noGroup) {
+                const auto added = static_cast<std::uint32_t>(size());
+                slots_[slot] = added;
+                hashes_.push_back(hash);
+                groupKeys_.insert(groupKeys_.end(), key, key + keys_);
+                rows_.push_back(0);
+                stats_.resize(stats_.size() + values_);
+                groupSamples_.resize(groupSamples_.size() + samples_);
+                return added;
+            } else if (hashes_[group] == hash &&
+                       std::equal(key, key + keys_, groupKeys_.data() + group * keys_)) {
+                return group;
+            }
+        }
+    }
+
+    /**
+     * Add the group \p group of \p other to this table
+     */
+    void merge(const GroupTable& other, size_t group) {
+        const auto into = findOrAdd(other.key(group), other.hash(group));
+        rows_[into] += other.rows_[group];
+        for (size_t i = 0; i < values_; ++i) {
+            stats(into, i).merge(other.stats(group, i));
+        }
+        for (size_t i = 0; i < samples_; ++i) {
+            const auto& src = other.samples(group, i);
+            auto& dst = samples(into, i);
+            dst.insert(dst.end(), src.begin(), src.end());
+        }
+    }
+
+    std::uint64_t hash(size_t group) const { return hashes_[group]; }
+    const std::uint64_t* key(size_t group) const { return groupKeys_.data() + group * keys_; }
+    std::uint64_t& rows(size_t group) { return rows_[group]; }
+    std::uint64_t rows(size_t group) const { return rows_[group]; }
+    Stats& stats(size_t group, size_t value) { return stats_[group * values_ + value]; }
+    const Stats& stats(size_t group, size_t value) const {
+        return stats_[group * values_ + value];
+    }
+    std::vector<double>& samples(size_t group, size_t i) {
+        return groupSamples_[group * samples_ + i];
+    }
+    const std::vector<double>& samples(size_t group, size_t i) const {
+        return groupSamples_[group * samples_ + i];
+    }
+
+private:
+    void grow() {
+        slots_.assign(std::max(size_t{16}, 2 * slots_.size()), noGroup);
+        const size_t mask = slots_.size() - 1;
+        for (size_t group = 0; group < size(); ++group) {
+            size_t slot = hashes_[group] & mask;
+            while (slots_[slot] != noGroup) slot = (slot + 1) & mask;
+            slots_[slot] = static_cast<std::uint32_t>(group);
+        }
+    }
+
+    size_t keys_;
+    size_t values_;
+    size_t samples_;
+    std::vector<std::uint32_t> slots_;
+    std::vector<std::uint64_t> hashes_;
+    std::vector<std::uint64_t> groupKeys_;
+    std::vector<std::uint64_t> rows_;
+    std::vector<Stats> stats_;
+    std::vector<std::vector<double>> groupSamples_;
+};
+
+void aggregateRows(const std::vector<KeyColumn>& keys, const std::vector<ValueColumn>& values,
+                   size_t first, size_t last, GroupTable& table) {
+    const auto nkeys = keys.size();
+    std::vector<std::uint64_t> codes(nkeys * batchSize);
+    std::vector<std::uint8_t> valid(batchSize);
+    std::vector<std::uint32_t> groups(batchSize);
+    std::vector<double> batch(batchSize);
+    std::vector<std::uint64_t> key(nkeys);
+
+    for (size_t begin = first; begin < last; begin += batchSize) {
+        const auto n = std::min(batchSize, last - begin);
+        std::fill_n(valid.begin(), n, std::uint8_t{1});
+        for (size_t k = 0; k < nkeys; ++k) {
+            keys[k].encode(begin, n, codes.data() + k * batchSize, valid.data());
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!valid[i]) {
+                groups[i] = noGroup;
+                continue;
+            }
+            std::uint64_t hash = 0x9e3779b97f4a7c15ull;
+            for (size_t k = 0; k < nkeys; ++k) {
+                key[k] = codes[k * batchSize + i];
+                hash = mix(hash ^ key[k]);
+            }
+            groups[i] = table.findOrAdd(key.data(), hash);
+            ++table.rows(groups[i]);
+        }
+
+        for (size_t v = 0; v < values.size(); ++v) {
+            const auto& value = values[v];
+            value.read(begin, n, batch.data());
+            if (value.variance) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (groups[i] == noGroup || std::isnan(batch[i])) continue;
+                    auto& stats = table.stats(groups[i], v);
+                    ++stats.count;
+                    stats.sum += batch[i];
+                    const double delta = batch[i] - stats.mean;
+                    stats.mean += delta / static_cast<double>(stats.count);
+                    stats.m2 += delta * (batch[i] - stats.mean);
+                }
+            } else if (value.sum) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (groups[i] == noGroup || std::isnan(batch[i])) continue;
+                    auto& stats = table.stats(groups[i], v);
+                    ++stats.count;
+                    stats.sum += batch[i];
+                }
+            }
+            if (value.minMax) {
+                // NaN values fail both comparisons
+                for (size_t i = 0; i < n; ++i) {
+                    if (groups[i] == noGroup) continue;
+                    auto& stats = table.stats(groups[i], v);
+                    if (batch[i] < stats.min) stats.min = batch[i];
+                    if (batch[i] > stats.max) stats.max = batch[i];
+                }
+            }
+            if (value.samples != npos) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (groups[i] == noGroup || std::isnan(batch[i])) continue;
+                    table.samples(groups[i], value.samples).push_back(batch[i]);
+                }
+            }
+        }
+    }
+}
+
+double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) return std::numeric_limits<double>::quiet_NaN();
+    const double pos = std::clamp(p, 0.0, 1.0) * static_cast<double>(samples.size() - 1);
+    const auto lower = static_cast<size_t>(pos);
+    std::nth_element(samples.begin(), samples.begin() + lower, samples.end());
+    const double a = samples[lower];
+    if (lower + 1 == samples.size()) return a;
+    const double b = *std::min_element(samples.begin() + lower + 1, samples.end());
+    return a + (pos - static_cast<double>(lower)) * (b - a);
+}
+
+}  // namespace
+
+std::shared_ptr<DataFrame> groupBy(const DataFrame& dataframe, const std::vector<Key>& keys,
+                                   const std::vector<Aggregation>& aggregations) {
+    if (keys.empty()) {
+        throw Exception("Group-by needs at least one key column", IVW_CONTEXT_CUSTOM("groupby"));
+    }
+    const auto rows = dataframe.getNumberOfRows();
+
+    std::vector<KeyColumn> keyColumns;
+    for (const auto& key : keys) keyColumns.push_back(makeKeyColumn(dataframe, key));
+
+    // Aggregations of the same column share the statistics
+    std::vector<ValueColumn> values;
+    std::unordered_map<std::string, size_t> valueIndex;
+    std::vector<size_t> aggregationValue(aggregations.size(), npos);
+    size_t nsamples = 0;
+    for (size_t a = 0; a < aggregations.size(); ++a) {
+        const auto& aggregation = aggregations[a];
+        if (aggregation.aggregate == Aggregate::Count) continue;
+        auto it = valueIndex.find(aggregation.header);
+        if (it == valueIndex.end()) {
+            it = valueIndex.emplace(aggregation.header, values.size()).first;
+            values.push_back(makeValueColumn(dataframe, aggregation.header));
+        }
+        aggregationValue[a] = it->second;
+        auto& value = values[it->second];
+        switch (aggregation.aggregate) {
+            case Aggregate::Sum:
+            case Aggregate::Mean:
+                value.sum = true;
+                break;
+            case Aggregate::Variance:
+                value.variance = true;
+                break;
+            case Aggregate::Min:
+            case Aggregate::Max:
+                value.minMax = true;
+                break;
+            case Aggregate::Percentile:
+                if (value.samples == npos) value.samples = nsamples++;
+                break;
+            case Aggregate::Count:
+                break;
+        }
+    }
+
+    // Aggregate contiguous ranges of rows into partial tables
+    const auto jobs = numberOfJobs(rows);
+    std::vector<GroupTable> partial(jobs, GroupTable{keys.size(), values.size(), nsamples});
+    forEachJob(jobs, [&](size_t job) {
+        aggregateRows(keyColumns, values, job * rows / jobs, (job + 1) * rows / jobs,
+                      partial[job]);
+    });
+
+    // Merge the partial tables, each job handles the groups of one partition of the hash values
+    std::vector<GroupTable> merged;
+    if (jobs == 1) {
+        merged = std::move(partial);
+    } else {
+        merged.resize(jobs, GroupTable{keys.size(), values.size(), nsamples});
+        forEachJob(jobs, [&](size_t job) {
+            for (const auto& table : partial) {
+                for (size_t group = 0; group < table.size(); ++group) {
+                    if ((table.hash(group) >> 32) % jobs == job) merged[job].merge(table, group);
+                }
+            }
+        });
+        partial.clear();
+    }
+
+    // Order the groups by their keys
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> groups;
+    for (size_t t = 0; t < merged.size(); ++t) {
+        for (size_t group = 0; group < merged[t].size(); ++group) {
+            groups.emplace_back(static_cast<std::uint32_t>(t), static_cast<std::uint32_t>(group));
+        }
+    }
+    const auto nkeys = keys.size();
+    std::vector<double> order(groups.size() * nkeys);
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const auto key = merged[groups[g].first].key(groups[g].second);
+        for (size_t k = 0; k < nkeys; ++k) order[g * nkeys + k] = keyColumns[k].order(key[k]);
+    }
+    std::vector<std::uint32_t> sorted(groups.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(), sorted.end(), [&](auto a, auto b) {
+        return std::lexicographical_compare(order.begin() + a * nkeys,
+                                            order.begin() + (a + 1) * nkeys,
+                                            order.begin() + b * nkeys,
+                                            order.begin() + (b + 1) * nkeys);
+    });
+
+    auto result = std::make_shared<DataFrame>();
+    for (size_t k = 0; k < nkeys; ++k) {
+        std::vector<std::uint64_t> codes(sorted.size());
+        std::transform(sorted.begin(), sorted.end(), codes.begin(), [&](auto g) {
+            return merged[groups[g].first].key(groups[g].second)[k];
+        });
+        result->addColumn(keyColumns[k].makeColumn(codes));
+    }
+
+    std::vector<std::vector<double>> results(aggregations.size());
+    for (auto& r : results) r.resize(sorted.size());
+    const auto outputJobs = numberOfJobs(sorted.size());
+    forEachJob(outputJobs, [&](size_t job) {
+        const auto first = job * sorted.size() / outputJobs;
+        const auto last = (job + 1) * sorted.size() / outputJobs;
+        for (size_t i = first; i < last; ++i) {
+            auto& table = merged[groups[sorted[i]].first];
+            const auto group = groups[sorted[i]].second;
+            for (size_t a = 0; a < aggregations.size(); ++a) {
+                const auto& aggregation = aggregations[a];
+                if (aggregation.aggregate == Aggregate::Count) continue;
+                const auto& value = values[aggregationValue[a]];
+                const auto& stats = table.stats(group, aggregationValue[a]);
+                const auto nan = std::numeric_limits<double>::quiet_NaN();
+                const auto count = static_cast<double>(stats.count);
+                const bool empty = stats.min > stats.max;
+                switch (aggregation.aggregate) {
+                    case Aggregate::Sum:
+                        results[a][i] = stats.sum;
+                        break;
+                    case Aggregate::Mean:
+                        results[a][i] = stats.count > 0 ? stats.sum / count : nan;
+                        break;
+                    case Aggregate::Min:
+                        results[a][i] = empty ? nan : stats.min;
+                        break;
+                    case Aggregate::Max:
+                        results[a][i] = empty ? nan : stats.max;
+                        break;
+                    case Aggregate::Variance:
+                        results[a][i] = stats.count > 1 ? stats.m2 / (count - 1.0) : nan;
+                        break;
+                    case Aggregate::Percentile:
+                        results[a][i] =
+                            percentile(table.samples(group, value.samples), aggregation.percentile);
+                        break;
+                    case Aggregate::Count:
+                        break;
+                }
+            }
+        }
+    });
+
+    for (size_t a = 0; a < aggregations.size(); ++a) {
+        const auto& aggregation = aggregations[a];
+        const auto header = aggregation.outputHeader.empty() ? defaultHeader(aggregation)
+                                                             : aggregation.outputHeader;
+        if (aggregation.aggregate == Aggregate::Count) {
+            std::vector<std::uint32_t> counts(sorted.size());
+            std::transform(sorted.begin(), sorted.end(), counts.begin(), [&](auto g) {
+                return static_cast<std::uint32_t>(
+                    merged[groups[g].first].rows(groups[g].second));
+            });
+            result->addColumn(
+                std::make_shared<TemplateColumn<std::uint32_t>>(header, std::move(counts)));
+        } else {
+            result->addColumn(
+                std::make_shared<TemplateColumn<double>>(header, std::move(results[a])));
+        }
+    }
+    result->updateIndexBuffer();
+    return result;
+}
+
+}  // namespace groupby
+
+}  // namespace inviwo
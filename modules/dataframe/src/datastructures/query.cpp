@@ -0,0 +1,724 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/query.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/exception.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <future>
+
+namespace inviwo {
+
+namespace query {
+
+namespace detail {
+
+/**
+ * Evaluates an expression for a batch of rows
+ */
+class Evaluator {
+public:
+    virtual ~Evaluator() = default;
+    /**
+     * Write the result for the rows [begin, begin + n) to \p out, n is at most batchSize
+     */
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const = 0;
+};
+
+class Node {
+public:
+    virtual ~Node() = default;
+    /**
+     * Bind the expression to the columns of \p dataframe
+     */
+    virtual std::unique_ptr<Evaluator> compile(const DataFrame& dataframe, size_t rows) const = 0;
+};
+
+}  // namespace detail
+
+namespace {
+
+constexpr size_t batchSize = 4096;
+
+using EvaluatorPtr = std::unique_ptr<detail::Evaluator>;
+
+/**
+ * Call \p func(first, last) for consecutive ranges covering [0, n), on the thread pool if
+ * available.
+ */
+template <typename F>
+void forEachRange(size_t n, F&& func) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t jobs = std::min(n, 4 * poolSize);
+    if (jobs < 2) {
+        if (n > 0) func(size_t{0}, n);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        futures.push_back(
+            dispatchPool([&func, first = job * n / jobs, last = (job + 1) * n / jobs]() {
+                func(first, last);
+            }));
+    }
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    for (auto& future : futures) {
+        pool.wait(future);
+        future.get();
+    }
+}
+
+std::shared_ptr<const Column> findColumn(const DataFrame& dataframe, const std::string& header,
+                                         size_t rows) {
+    auto column = dataframe.getColumn(header);
+    if (!column) {
+        throw Exception(fmt::format("Query refers to unknown column '{}'", header),
+                        IVW_CONTEXT_CUSTOM("query"));
+    }
+    if (column->getSize() < rows) {
+        throw Exception(fmt::format("Column '{}' has {} rows, expected {}", header,
+                                    column->getSize(), rows),
+                        IVW_CONTEXT_CUSTOM("query"));
+    }
+    return column;
+}
+
+class ConstantEvaluator : public detail::Evaluator {
+public:
+    explicit ConstantEvaluator(bool value) : value_{value} {}
+    virtual void evaluate(size_t, size_t n, std::uint8_t* out) const override {
+        std::fill_n(out, n, static_cast<std::uint8_t>(value_));
+    }
+
+private:
+    bool value_;
+};
+
+template <typename T, typename Op>
+class CompareEvaluator : public detail::Evaluator {
+public:
+    CompareEvaluator(const T* data, double value) : data_{data}, value_{value} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        const auto data = data_ + begin;
+        const Op op{};
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::uint8_t>(op(static_cast<double>(data[i]), value_));
+        }
+    }
+
+private:
+    const T* data_;
+    double value_;
+};
+
+template <typename T>
+class RangeEvaluator : public detail::Evaluator {
+public:
+    RangeEvaluator(const T* data, double min, double max) : data_{data}, min_{min}, max_{max} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        const auto data = data_ + begin;
+        for (size_t i = 0; i < n; ++i) {
+            const auto value = static_cast<double>(data[i]);
+            out[i] = static_cast<std::uint8_t>((value >= min_) & (value <= max_));
+        }
+    }
+
+private:
+    const T* data_;
+    double min_;
+    double max_;
+};
+
+class CategoryEvaluator : public detail::Evaluator {
+public:
+    CategoryEvaluator(const std::uint32_t* data, std::uint32_t id) : data_{data}, id_{id} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        const auto data = data_ + begin;
+        for (size_t i = 0; i < n; ++i) out[i] = static_cast<std::uint8_t>(data[i] == id_);
+    }
+
+private:
+    const std::uint32_t* data_;
+    std::uint32_t id_;
+};
+
+class CategorySetEvaluator : public detail::Evaluator {
+public:
+    CategorySetEvaluator(const std::uint32_t* data, std::vector<std::uint8_t> selected)
+        : data_{data}, selected_{std::move(selected)} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        const auto data = data_ + begin;
+        const auto size = selected_.size();
+        for (size_t i = 0; i < n; ++i) out[i] = data[i] < size ? selected_[data[i]] : 0;
+    }
+
+private:
+    const std::uint32_t* data_;
+    std::vector<std::uint8_t> selected_;  // indexed by category id
+};
+
+class AndEvaluator : public detail::Evaluator {
+public:
+    AndEvaluator(EvaluatorPtr lhs, EvaluatorPtr rhs) : lhs_{std::move(lhs)}, rhs_{std::move(rhs)} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        lhs_->evaluate(begin, n, out);
+        if (std::none_of(out, out + n, [](auto v) { return v != 0; })) return;
+        std::array<std::uint8_t, batchSize> rhs;
+        rhs_->evaluate(begin, n, rhs.data());
+        for (size_t i = 0; i < n; ++i) out[i] &= rhs[i];
+    }
+
+private:
+    EvaluatorPtr lhs_;
+    EvaluatorPtr rhs_;
+};
+
+class OrEvaluator : public detail::Evaluator {
+public:
+    OrEvaluator(EvaluatorPtr lhs, EvaluatorPtr rhs) : lhs_{std::move(lhs)}, rhs_{std::move(rhs)} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        lhs_->evaluate(begin, n, out);
+        if (std::all_of(out, out + n, [](auto v) { return v != 0; })) return;
+        std::array<std::uint8_t, batchSize> rhs;
+        rhs_->evaluate(begin, n, rhs.data());
+        for (size_t i = 0; i < n; ++i) out[i] |= rhs[i];
+    }
+
+private:
+    EvaluatorPtr lhs_;
+    EvaluatorPtr rhs_;
+};
+
+class NotEvaluator : public detail::Evaluator {
+public:
+    explicit NotEvaluator(EvaluatorPtr expr) : expr_{std::move(expr)} {}
+    virtual void evaluate(size_t begin, size_t n, std::uint8_t* out) const override {
+        expr_->evaluate(begin, n, out);
+        for (size_t i = 0; i < n; ++i) out[i] ^= std::uint8_t{1};
+    }
+
+private:
+    EvaluatorPtr expr_;
+};
+
+class ConstantNode : public detail::Node {
+public:
+    explicit ConstantNode(bool value) : value_{value} {}
+    virtual EvaluatorPtr compile(const DataFrame&, size_t) const override {
+        return std::make_unique<ConstantEvaluator>(value_);
+    }
+
+private:
+    bool value_;
+};
+
+class CompareNode : public detail::Node {
+public:
+    CompareNode(std::string header, Comparison comparison, double value)
+        : header_{std::move(header)}, comparison_{comparison}, value_{value} {}
+
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        const auto ram =
+            findColumn(dataframe, header_, rows)->getBuffer()->getRepresentation<BufferRAM>();
+        return ram->dispatch<EvaluatorPtr, dispatching::filter::Scalars>(
+            [&](auto br) -> EvaluatorPtr {
+                using T = util::PrecisionValueType<decltype(br)>;
+                const T* data = br->getDataContainer().data();
+                switch (comparison_) {
+                    case Comparison::Less:
+                        return std::make_unique<CompareEvaluator<T, std::less<>>>(data, value_);
+                    case Comparison::LessEqual:
+                        return std::make_unique<CompareEvaluator<T, std::less_equal<>>>(data,
+                                                                                       value_);
+                    case Comparison::Greater:
+                        return std::make_unique<CompareEvaluator<T, std::greater<>>>(data, value_);
+                    case Comparison::GreaterEqual:
+                        return std::make_unique<CompareEvaluator<T, std::greater_equal<>>>(
+                            data, value_);
+                    case Comparison::Equal:
+                        return std::make_unique<CompareEvaluator<T, std::equal_to<>>>(data,
+                                                                                     value_);
+                    case Comparison::NotEqual:
+                    default:
+                        return std::make_unique<CompareEvaluator<T, std::not_equal_to<>>>(
+                            data, value_);
+                }
+            });
+    }
+
+private:
+    std::string header_;
+    Comparison comparison_;
+    double value_;
+};
+
+class RangeNode : public detail::Node {
+public:
+    RangeNode(std::string header, double min, double max)
+        : header_{std::move(header)}, min_{min}, max_{max} {}
+
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        const auto ram =
+            findColumn(dataframe, header_, rows)->getBuffer()->getRepresentation<BufferRAM>();
+        return ram->dispatch<EvaluatorPtr, dispatching::filter::Scalars>(
+            [&](auto br) -> EvaluatorPtr {
+                using T = util::PrecisionValueType<decltype(br)>;
+                return std::make_unique<RangeEvaluator<T>>(br->getDataContainer().data(), min_,
+                                                           max_);
+            });
+    }
+
+private:
+    std::string header_;
+    double min_;
+    double max_;
+};
+
+class CategoryNode : public detail::Node {
+public:
+    CategoryNode(std::string header, std::vector<std::string> categories)
+        : header_{std::move(header)}, categories_{std::move(categories)} {}
+
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        const auto column = findColumn(dataframe, header_, rows);
+        const auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(column);
+        if (!categorical) {
+            throw Exception(
+                fmt::format("Column '{}' is not categorical, it can not be compared to strings",
+                            header_),
+                IVW_CONTEXT_CUSTOM("query"));
+        }
+        const auto dictionary = categorical->getDictionary();
+        std::vector<std::uint32_t> ids;
+        for (const auto& category : categories_) {
+            const auto id = dictionary->find(category);
+            if (id != CategoricalDictionary::npos) ids.push_back(id);
+        }
+        const auto data =
+            categorical->getTypedBuffer()->getRAMRepresentation()->getDataContainer().data();
+
+        if (ids.empty()) {
+            return std::make_unique<ConstantEvaluator>(false);
+        } else if (ids.size() == 1) {
+            return std::make_unique<CategoryEvaluator>(data, ids.front());
+        } else {
+            std::vector<std::uint8_t> selected(dictionary->size(), 0);
+            for (auto id : ids) selected[id] = 1;
+            return std::make_unique<CategorySetEvaluator>(data, std::move(selected));
+        }
+    }
+
+private:
+    std::string header_;
+    std::vector<std::string> categories_;
+};
+
+class AndNode : public detail::Node {
+public:
+    AndNode(std::shared_ptr<const Node> lhs, std::shared_ptr<const Node> rhs)
+        : lhs_{std::move(lhs)}, rhs_{std::move(rhs)} {}
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        return std::make_unique<AndEvaluator>(lhs_->compile(dataframe, rows),
+                                              rhs_->compile(dataframe, rows));
+    }
+
+private:
+    std::shared_ptr<const Node> lhs_;
+    std::shared_ptr<const Node> rhs_;
+};
+
+class OrNode : public detail::Node {
+public:
+    OrNode(std::shared_ptr<const Node> lhs, std::shared_ptr<const Node> rhs)
+        : lhs_{std::move(lhs)}, rhs_{std::move(rhs)} {}
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        return std::make_unique<OrEvaluator>(lhs_->compile(dataframe, rows),
+                                             rhs_->compile(dataframe, rows));
+    }
+
+private:
+    std::shared_ptr<const Node> lhs_;
+    std::shared_ptr<const Node> rhs_;
+};
+
+class NotNode : public detail::Node {
+public:
+    explicit NotNode(std::shared_ptr<const Node> expr) : expr_{std::move(expr)} {}
+    virtual EvaluatorPtr compile(const DataFrame& dataframe, size_t rows) const override {
+        return std::make_unique<NotEvaluator>(expr_->compile(dataframe, rows));
+    }
+
+private:
+    std::shared_ptr<const Node> expr_;
+};
+
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_{text} {}
+
+    Expr parse() {
+        skipSpace();
+        if (pos_ == text_.size()) return Expr{};
+        auto expr = parseOr();
+        if (pos_ != text_.size()) error("Unexpected character");
+        return expr;
+    }
+
+private:
+    Expr parseOr() {
+        auto expr = parseAnd();
+        while (accept("||") || acceptKeyword("or")) expr = expr || parseAnd();
+        return expr;
+    }
+
+    Expr parseAnd() {
+        auto expr = parseUnary();
+        while (accept("&&") || acceptKeyword("and")) expr = expr && parseUnary();
+        return expr;
+    }
+
+    Expr parseUnary() {
+        if (acceptKeyword("not")) return !parseUnary();
+        // Do not mistake != for a negation
+        if (peek() == '!' && peek(1) != '=') {
+            ++pos_;
+            skipSpace();
+            return !parseUnary();
+        }
+        if (accept("(")) {
+            auto expr = parseOr();
+            expect(")");
+            return expr;
+        }
+        return parsePredicate();
+    }
+
+    Expr parsePredicate() {
+        const auto column = col(parseColumn());
+        if (acceptKeyword("in")) {
+            if (accept("[")) {
+                const auto min = parseNumber();
+                expect(",");
+                const auto max = parseNumber();
+                expect("]");
+                return column.inRange(min, max);
+            } else if (accept("{")) {
+                std::vector<std::string> categories{parseString()};
+                while (accept(",")) categories.push_back(parseString());
+                expect("}");
+                return column.isIn(std::move(categories));
+            }
+            error("Expected '[' or '{'");
+        }
+
+        static constexpr std::array<std::pair<std::string_view, Comparison>, 6> comparisons{
+            {{"<=", Comparison::LessEqual},
+             {">=", Comparison::GreaterEqual},
+             {"==", Comparison::Equal},
+             {"!=", Comparison::NotEqual},
+             {"<", Comparison::Less},
+             {">", Comparison::Greater}}};
+        for (const auto& [op, comparison] : comparisons) {
+            if (!accept(op)) continue;
+            if (peek() == '"') {
+                if (comparison == Comparison::Equal) return column == parseString();
+                if (comparison == Comparison::NotEqual) return column != parseString();
+                error("Strings can only be compared with == and !=");
+            }
+            return column.compare(comparison, parseNumber());
+        }
+        error("Expected comparison operator or 'in'");
+    }
+
+    std::string parseColumn() {
+        if (peek() == '`') {
+            const auto end = text_.find('`', pos_ + 1);
+            if (end == std::string_view::npos) error("Unterminated column name");
+            std::string header{text_.substr(pos_ + 1, end - pos_ - 1)};
+            pos_ = end + 1;
+            skipSpace();
+            return header;
+        }
+        const auto word = identifier();
+        if (word.empty()) error("Expected column name");
+        if (word == "and" || word == "or" || word == "not" || word == "in") {
+            error(fmt::format("Expected column name, found keyword '{}'", word));
+        }
+        pos_ += word.size();
+        skipSpace();
+        return std::string{word};
+    }
+
+    double parseNumber() {
+        // strtod needs a null terminated string
+        const std::string str{text_.substr(pos_, 64)};
+        char* end = nullptr;
+        const double value = std::strtod(str.c_str(), &end);
+        if (end == str.c_str()) error("Expected number");
+        pos_ += static_cast<size_t>(end - str.c_str());
+        skipSpace();
+        return value;
+    }
+
+    std::string parseString() {
+        if (peek() != '"') error("Expected string");
+        std::string str;
+        for (++pos_; pos_ < text_.size() && text_[pos_] != '"'; ++pos_) {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ++pos_;
+            str.push_back(text_[pos_]);
+        }
+        if (pos_ == text_.size()) error("Unterminated string");
+        ++pos_;
+        skipSpace();
+        return str;
+    }
+
+    std::string_view identifier() const {
+        auto end = pos_;
+        const auto isStart = [](char c) {
+            return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+        };
+        const auto isPart = [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+        };
+        if (end < text_.size() && isStart(text_[end])) {
+            while (end < text_.size() && isPart(text_[end])) ++end;
+        }
+        return text_.substr(pos_, end - pos_);
+    }
+
+    bool accept(std::string_view token) {
+        if (text_.substr(pos_, token.size()) != token) return false;
+        pos_ += token.size();
+        skipSpace();
+        return true;
+    }
+
+    bool acceptKeyword(std::string_view keyword) {
+        if (identifier() != keyword) return false;
+        pos_ += keyword.size();
+        skipSpace();
+        return true;
+    }
+
+    void expect(std::string_view token) {
+        if (!accept(token)) error(fmt::format("Expected '{}'", token));
+    }
+
+    char peek(size_t offset = 0) const {
+        return pos_ + offset < text_.size() ? text_[pos_ + offset] : '\0';
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    [[noreturn]] void error(std::string_view message) const {
+        throw Exception(fmt::format("Invalid query at position {}: {}", pos_, message),
+                        IVW_CONTEXT_CUSTOM("query::parse"));
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+std::shared_ptr<Column> gatherRows(const Column& column,
+                                   const std::vector<std::uint32_t>& indices) {
+    const auto ram = column.getBuffer()->getRepresentation<BufferRAM>();
+    return ram->dispatch<std::shared_ptr<Column>, dispatching::filter::Scalars>(
+        [&](auto br) -> std::shared_ptr<Column> {
+            using T = util::PrecisionValueType<decltype(br)>;
+            const auto& src = br->getDataContainer();
+            std::vector<T> dst(indices.size());
+            std::transform(indices.begin(), indices.end(), dst.begin(),
+                           [&](auto i) { return src[i]; });
+
+            if constexpr (std::is_same_v<T, std::uint32_t>) {
+                if (auto categorical = dynamic_cast<const CategoricalColumn*>(&column)) {
+                    auto result = std::make_shared<CategoricalColumn>(
+                        column.getHeader(),
+                        std::const_pointer_cast<CategoricalDictionary>(
+                            categorical->getDictionary()));
+                    result->setBuffer(util::makeBuffer(std::move(dst)));
+                    return result;
+                }
+            }
+            return std::make_shared<TemplateColumn<T>>(column.getHeader(), std::move(dst));
+        });
+}
+
+void checkMaskSize(const DataFrame& dataframe, const Mask& mask) {
+    if (mask.size() != dataframe.getNumberOfRows()) {
+        throw Exception(fmt::format("Mask size ({}) does not match number of rows ({})",
+                                    mask.size(), dataframe.getNumberOfRows()),
+                        IVW_CONTEXT_CUSTOM("query"));
+    }
+}
+
+// The columns are shared read-only between the DataFrames, neither is modified by the query
+std::shared_ptr<DataFrame> shareColumns(const DataFrame& dataframe) {
+    auto result = std::make_shared<DataFrame>();
+    result->getIndexColumn()->setBuffer(std::const_pointer_cast<Buffer<std::uint32_t>>(
+        dataframe.getIndexColumn()->getTypedBuffer()));
+    for (size_t i = 1; i < dataframe.getNumberOfColumns(); ++i) {
+        result->addColumn(std::const_pointer_cast<Column>(dataframe.getColumn(i)));
+    }
+    return result;
+}
+
+}  // namespace
+
+Expr::Expr() : node_{std::make_shared<ConstantNode>(true)} {}
+
+Expr::Expr(std::shared_ptr<const detail::Node> node) : node_{std::move(node)} {}
+
+Expr operator&&(const Expr& lhs, const Expr& rhs) {
+    return Expr{std::make_shared<AndNode>(lhs.getNode(), rhs.getNode())};
+}
+
+Expr operator||(const Expr& lhs, const Expr& rhs) {
+    return Expr{std::make_shared<OrNode>(lhs.getNode(), rhs.getNode())};
+}
+
+Expr operator!(const Expr& expr) { return Expr{std::make_shared<NotNode>(expr.getNode())}; }
+
+ColumnRef::ColumnRef(std::string header) : header_{std::move(header)} {}
+
+Expr ColumnRef::compare(Comparison comparison, double value) const {
+    return Expr{std::make_shared<CompareNode>(header_, comparison, value)};
+}
+
+Expr ColumnRef::operator<(double value) const { return compare(Comparison::Less, value); }
+
+Expr ColumnRef::operator<=(double value) const { return compare(Comparison::LessEqual, value); }
+
+Expr ColumnRef::operator>(double value) const { return compare(Comparison::Greater, value); }
+
+Expr ColumnRef::operator>=(double value) const {
+    return compare(Comparison::GreaterEqual, value);
+}
+
+Expr ColumnRef::operator==(double value) const { return compare(Comparison::Equal, value); }
+
+Expr ColumnRef::operator!=(double value) const { return compare(Comparison::NotEqual, value); }
+
+Expr ColumnRef::inRange(double min, double max) const {
+    return Expr{std::make_shared<RangeNode>(header_, min, max)};
+}
+
+Expr ColumnRef::operator==(std::string_view category) const {
+    return isIn({std::string{category}});
+}
+
+Expr ColumnRef::operator!=(std::string_view category) const { return !(*this == category); }
+
+Expr ColumnRef::isIn(std::vector<std::string> categories) const {
+    return Expr{std::make_shared<CategoryNode>(header_, std::move(categories))};
+}
+
+const std::string& ColumnRef::getHeader() const { return header_; }
+
+ColumnRef col(std::string header) { return ColumnRef{std::move(header)}; }
+
+Expr parse(std::string_view text) { return Parser{text}.parse(); }
+
+Mask evaluate(const DataFrame& dataframe, const Expr& expr) {
+    const auto rows = dataframe.getNumberOfRows();
+    const auto evaluator = expr.getNode()->compile(dataframe, rows);
+
+    Mask mask(rows);
+    forEachRange((rows + batchSize - 1) / batchSize, [&](size_t first, size_t last) {
+        for (size_t batch = first; batch < last; ++batch) {
+            const auto begin = batch * batchSize;
+            evaluator->evaluate(begin, std::min(batchSize, rows - begin), mask.data() + begin);
+        }
+    });
+    return mask;
+}
+
+size_t count(const Mask& mask) {
+    return static_cast<size_t>(
+        std::count_if(mask.begin(), mask.end(), [](auto v) { return v != 0; }));
+}
+
+std::vector<std::uint32_t> selectedIndices(const Mask& mask) {
+    // Branch free, every index is written and the next slot is taken if the row is selected
+    std::vector<std::uint32_t> indices(count(mask) + 1);
+    size_t n = 0;
+    for (size_t i = 0; i < mask.size(); ++i) {
+        indices[n] = static_cast<std::uint32_t>(i);
+        n += mask[i] != 0;
+    }
+    indices.pop_back();
+    return indices;
+}
+
+std::shared_ptr<DataFrame> filter(std::shared_ptr<const DataFrame> dataframe, const Mask& mask) {
+    checkMaskSize(*dataframe, mask);
+    if (std::all_of(mask.begin(), mask.end(), [](auto v) { return v != 0; })) {
+        return shareColumns(*dataframe);
+    }
+
+    const auto indices = selectedIndices(mask);
+    std::vector<std::shared_ptr<Column>> columns(dataframe->getNumberOfColumns());
+    forEachRange(columns.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            columns[i] = gatherRows(*dataframe->getColumn(i), indices);
+        }
+    });
+
+    auto result = std::make_shared<DataFrame>();
+    result->getIndexColumn()->setBuffer(
+        std::static_pointer_cast<TemplateColumn<std::uint32_t>>(columns[0])->getTypedBuffer());
+    for (size_t i = 1; i < columns.size(); ++i) result->addColumn(columns[i]);
+    return result;
+}
+
+std::shared_ptr<DataFrame> appendMask(std::shared_ptr<const DataFrame> dataframe,
+                                      const Mask& mask, const std::string& header) {
+    checkMaskSize(*dataframe, mask);
+    auto result = shareColumns(*dataframe);
+    result->addColumn(
+        std::make_shared<TemplateColumn<int>>(header, std::vector<int>(mask.begin(), mask.end())));
+    return result;
+}
+
+}  // namespace query
+
+}  // namespace inviwo
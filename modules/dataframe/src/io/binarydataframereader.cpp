@@ -0,0 +1,248 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/memorymappedfile.h>
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <istream>
+#include <string_view>
+
+namespace inviwo {
+
+namespace binarydataframe {
+
+namespace {
+
+class HeaderReader {
+public:
+    HeaderReader(std::istream& stream) : stream_{stream} {
+        const auto start = stream_.tellg();
+        stream_.seekg(0, std::ios::end);
+        size_ = static_cast<size_t>(stream_.tellg() - start);
+        stream_.seekg(start);
+    }
+
+    template <typename T>
+    T readValue() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+    std::string readString() {
+        std::string str(checkCount(readValue<std::uint64_t>(), 1), '\0');
+        read(str.data(), str.size());
+        return str;
+    }
+    // Guard against huge allocations for corrupt files
+    size_t checkCount(std::uint64_t count, size_t elementSize) const {
+        if (count > size_ / elementSize) error();
+        return static_cast<size_t>(count);
+    }
+    size_t size() const { return size_; }
+
+    [[noreturn]] void error(std::string_view msg = "Unexpected end of file") const {
+        throw DataReaderException(fmt::format("Invalid binary DataFrame: {}", msg),
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+
+private:
+    void read(void* dest, size_t bytes) {
+        stream_.read(static_cast<char*>(dest), bytes);
+        if (!stream_) error();
+    }
+
+    std::istream& stream_;
+    size_t size_;
+};
+
+}  // namespace
+
+FileInfo readFileInfo(std::istream& stream) {
+    HeaderReader header{stream};
+
+    auto fileMagic = magic;
+    for (auto& c : fileMagic) c = header.readValue<char>();
+    if (fileMagic != magic) header.error("Missing file signature");
+    if (header.readValue<std::uint32_t>() > version) header.error("Unsupported version");
+    if (header.readValue<std::uint32_t>() != byteOrderMark) header.error("Unsupported byte order");
+
+    FileInfo info;
+    info.rows = static_cast<size_t>(header.readValue<std::uint64_t>());
+    info.blockSize = static_cast<size_t>(header.readValue<std::uint64_t>());
+    info.columns.resize(header.checkCount(header.readValue<std::uint64_t>(), 1));
+    for (auto& col : info.columns) {
+        col.header = header.readString();
+        const auto format = header.readString();
+        try {
+            col.format = DataFormatBase::get(format);
+        } catch (const DataFormatException&) {
+            header.error(fmt::format("Invalid data format '{}'", format));
+        }
+        if (col.format->getId() == DataFormatId::NotSpecialized ||
+            col.format->getComponents() != 1) {
+            header.error(fmt::format("Unsupported data format '{}'", format));
+        }
+        col.categorical = header.readValue<std::uint8_t>() != 0;
+        if (col.categorical && col.format != DataUInt32::get()) {
+            header.error(fmt::format("Categorical column '{}' is not of type uint32", col.header));
+        }
+        const bool statistics = header.readValue<std::uint8_t>() != 0;
+        col.offset = static_cast<size_t>(header.readValue<std::uint64_t>());
+        col.bytes = static_cast<size_t>(header.readValue<std::uint64_t>());
+        if (col.offset % alignment != 0 || col.bytes % col.format->getSize() != 0 ||
+            col.offset > header.size() || col.bytes > header.size() - col.offset) {
+            header.error(fmt::format("Invalid data region of column '{}'", col.header));
+        }
+        if (statistics) {
+            col.blockMinMax.resize(
+                header.checkCount(header.readValue<std::uint64_t>(), sizeof(dvec2)));
+            for (auto& minMax : col.blockMinMax) {
+                minMax.x = header.readValue<double>();
+                minMax.y = header.readValue<double>();
+            }
+        }
+        if (col.categorical) {
+            col.categories.resize(header.checkCount(header.readValue<std::uint64_t>(), 1));
+            for (auto& category : col.categories) category = header.readString();
+        }
+    }
+    return info;
+}
+
+}  // namespace binarydataframe
+
+namespace {
+
+/**
+ * Copies the data of a column from the file into a BufferRAM, the region of the file is memory
+ * mapped if possible.
+ */
+class ColumnLoader : public DiskRepresentationLoader<BufferRepresentation> {
+public:
+    ColumnLoader(const std::string& file, size_t offset) : file_{file}, offset_{offset} {}
+    virtual ColumnLoader* clone() const override { return new ColumnLoader(*this); }
+
+    virtual std::shared_ptr<BufferRepresentation> createRepresentation(
+        const BufferRepresentation& src) const override {
+        auto ram = createBufferRAM(src.getSize(), src.getDataFormat(), src.getBufferUsage(),
+                                   src.getBufferTarget());
+        read(ram->getData(), src.getSize() * src.getSizeOfElement());
+        return ram;
+    }
+
+    virtual void updateRepresentation(std::shared_ptr<BufferRepresentation> dest,
+                                      const BufferRepresentation& src) const override {
+        auto ram = std::static_pointer_cast<BufferRAM>(dest);
+        ram->setSize(src.getSize());
+        read(ram->getData(), src.getSize() * src.getSizeOfElement());
+    }
+
+private:
+    void read(void* dest, size_t bytes) const {
+        if (bytes == 0) return;
+        try {
+            const util::MemoryMappedFile mapping(file_, offset_, bytes);
+            std::memcpy(dest, mapping.data(), bytes);
+            return;
+        } catch (const FileException&) {
+            // Fall back to reading the region through a stream
+        }
+        auto stream = filesystem::ifstream(file_, std::ios::in | std::ios::binary);
+        stream.seekg(offset_);
+        stream.read(static_cast<char*>(dest), bytes);
+        if (!stream) {
+            throw DataReaderException("Could not read column data from \"" + file_ + "\"",
+                                      IVW_CONTEXT);
+        }
+    }
+
+    std::string file_;
+    size_t offset_;
+};
+
+struct ColumnDispatcher {
+    template <typename Result, typename Format>
+    Result operator()(const std::string& file, const binarydataframe::ColumnInfo& info) {
+        using T = typename Format::type;
+        const auto size = info.bytes / sizeof(T);
+
+        auto disk = std::make_shared<BufferDisk>(file, size, info.format);
+        disk->setLoader(new ColumnLoader(file, info.offset));
+        auto buffer = std::make_shared<Buffer<T>>(size);
+        buffer->addRepresentation(disk);
+
+        if constexpr (std::is_same_v<T, std::uint32_t>) {
+            if (info.categorical) {
+                auto col = std::make_shared<CategoricalColumn>(
+                    info.header, std::make_shared<CategoricalDictionary>(info.categories));
+                col->setBuffer(buffer);
+                return col;
+            }
+        }
+        return std::make_shared<TemplateColumn<T>>(info.header, buffer);
+    }
+};
+
+}  // namespace
+
+BinaryDataFrameReader::BinaryDataFrameReader() {
+    addExtension(FileExtension("ivwdf", "Inviwo binary DataFrame"));
+}
+
+BinaryDataFrameReader* BinaryDataFrameReader::clone() const {
+    return new BinaryDataFrameReader(*this);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(const std::string& fileName) {
+    auto file = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("BinaryDataFrameReader: Could not open file \"" + fileName + "\".",
+                            IVW_CONTEXT);
+    }
+    const auto info = binarydataframe::readFileInfo(file);
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    for (const auto& col : info.columns) {
+        dataFrame->addColumn(
+            dispatching::dispatch<std::shared_ptr<Column>, dispatching::filter::Scalars>(
+                col.format->getId(), ColumnDispatcher{}, fileName, col));
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,193 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <fmt/format.h>
+
+#include <limits>
+#include <string_view>
+
+namespace inviwo {
+
+namespace {
+
+class HeaderWriter {
+public:
+    template <typename T>
+    void writeValue(T value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types");
+        data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeString(std::string_view str) {
+        writeValue<std::uint64_t>(str.size());
+        data_.append(str.data(), str.size());
+    }
+    const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+size_t alignOffset(size_t offset) {
+    return (offset + binarydataframe::alignment - 1) / binarydataframe::alignment *
+           binarydataframe::alignment;
+}
+
+std::vector<dvec2> calcBlockMinMax(const BufferRAM* ram, size_t blockSize) {
+    return ram->dispatch<std::vector<dvec2>, dispatching::filter::Scalars>([&](auto br) {
+        const auto& data = br->getDataContainer();
+        std::vector<dvec2> res;
+        res.reserve((data.size() + blockSize - 1) / blockSize);
+        for (size_t begin = 0; begin < data.size(); begin += blockSize) {
+            const auto end = std::min(data.size(), begin + blockSize);
+            dvec2 minMax{std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity()};
+            for (size_t i = begin; i < end; ++i) {
+                // comparisons with NaN are false, hence NaN values are ignored
+                const auto value = static_cast<double>(data[i]);
+                if (value < minMax.x) minMax.x = value;
+                if (value > minMax.y) minMax.y = value;
+            }
+            if (minMax.x > minMax.y) minMax = dvec2{std::numeric_limits<double>::quiet_NaN()};
+            res.push_back(minMax);
+        }
+        return res;
+    });
+}
+
+struct ColumnEntry {
+    std::string header;
+    const BufferRAM* ram;
+    const CategoricalColumn* categorical;
+    std::vector<dvec2> blockMinMax;
+    size_t offset = 0;
+    size_t bytes = 0;
+};
+
+std::string createHeader(const std::vector<ColumnEntry>& columns, size_t rows, size_t blockSize) {
+    HeaderWriter header;
+    for (auto c : binarydataframe::magic) header.writeValue(c);
+    header.writeValue(binarydataframe::version);
+    header.writeValue(binarydataframe::byteOrderMark);
+    header.writeValue<std::uint64_t>(rows);
+    header.writeValue<std::uint64_t>(blockSize);
+    header.writeValue<std::uint64_t>(columns.size());
+    for (const auto& col : columns) {
+        header.writeString(col.header);
+        header.writeString(col.ram->getDataFormat()->getString());
+        header.writeValue<std::uint8_t>(col.categorical ? 1 : 0);
+        header.writeValue<std::uint8_t>(col.blockMinMax.empty() ? 0 : 1);
+        header.writeValue<std::uint64_t>(col.offset);
+        header.writeValue<std::uint64_t>(col.bytes);
+        if (!col.blockMinMax.empty()) {
+            header.writeValue<std::uint64_t>(col.blockMinMax.size());
+            for (const auto& minMax : col.blockMinMax) {
+                header.writeValue(minMax.x);
+                header.writeValue(minMax.y);
+            }
+        }
+        if (col.categorical) {
+            const auto dictionary = col.categorical->getDictionary();
+            header.writeValue<std::uint64_t>(dictionary->size());
+            for (std::uint32_t i = 0; i < dictionary->size(); ++i) {
+                header.writeString(dictionary->get(i));
+            }
+        }
+    }
+    return header.data();
+}
+
+}  // namespace
+
+BinaryDataFrameWriter::BinaryDataFrameWriter() : DataWriterType<DataFrame>() {
+    addExtension(FileExtension("ivwdf", "Inviwo binary DataFrame"));
+}
+
+BinaryDataFrameWriter* BinaryDataFrameWriter::clone() const {
+    return new BinaryDataFrameWriter(*this);
+}
+
+void BinaryDataFrameWriter::setBlockSize(size_t rows) { blockSize_ = rows; }
+
+size_t BinaryDataFrameWriter::getBlockSize() const { return blockSize_; }
+
+void BinaryDataFrameWriter::writeData(const DataFrame* data, const std::string filePath) const {
+    if (filesystem::fileExists(filePath) && !overwrite_) {
+        throw DataWriterException("Error: Output file: " + filePath + " already exists",
+                                  IVW_CONTEXT);
+    }
+
+    std::vector<ColumnEntry> columns;
+    for (const auto& col : *data) {
+        if (col == data->getIndexColumn()) continue;
+
+        const auto ram = col->getBuffer()->getRepresentation<BufferRAM>();
+        const auto format = ram->getDataFormat();
+        if (format->getComponents() != 1) {
+            throw DataWriterException(fmt::format("Column '{}' has unsupported data format '{}'",
+                                                  col->getHeader(), format->getString()),
+                                      IVW_CONTEXT);
+        }
+        auto categorical = dynamic_cast<const CategoricalColumn*>(col.get());
+
+        ColumnEntry entry{col->getHeader(), ram, categorical};
+        entry.bytes = ram->getSize() * format->getSize();
+        if (!categorical && blockSize_ > 0) entry.blockMinMax = calcBlockMinMax(ram, blockSize_);
+        columns.push_back(std::move(entry));
+    }
+
+    // All fields in the header have a fixed size, assigning the offsets does not change its size
+    size_t offset = alignOffset(createHeader(columns, data->getNumberOfRows(), blockSize_).size());
+    for (auto& col : columns) {
+        col.offset = offset;
+        offset = alignOffset(offset + col.bytes);
+    }
+    const auto header = createHeader(columns, data->getNumberOfRows(), blockSize_);
+
+    auto file = filesystem::ofstream(filePath, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        throw DataWriterException("Error: Could not open file: " + filePath, IVW_CONTEXT);
+    }
+    const std::array<char, binarydataframe::alignment> padding{};
+    file.write(header.data(), header.size());
+    file.write(padding.data(), alignOffset(header.size()) - header.size());
+    for (const auto& col : columns) {
+        file.write(static_cast<const char*>(col.ram->getData()), col.bytes);
+        file.write(padding.data(), alignOffset(col.bytes) - col.bytes);
+    }
+    if (!file) {
+        throw DataWriterException("Error: Could not write to file: " + filePath, IVW_CONTEXT);
+    }
+}
+
+}  // namespace inviwo
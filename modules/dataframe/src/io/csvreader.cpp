@@ -31,221 +31,537 @@
 
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/memorymappedfile.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <locale>
+#include <optional>
+#include <streambuf>
+#include <string_view>
+#include <tuple>
 
 namespace inviwo {
 
-CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
-    : DataReaderException("CSVReader: " + message, context) {}
-
-CSVReader::CSVReader() : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true) {
-    addExtension(FileExtension("csv", "Comma Separated Values"));
-}
+namespace {
 
-CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
+constexpr size_t maxColumns = std::numeric_limits<size_t>::max();
+constexpr size_t exampleRowCount = 50;
+// data below this size is not split into several chunks
+constexpr size_t minChunkSize = 1 << 20;
 
-void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
-
-void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader; }
+using Fields = std::vector<std::string_view>;
 
-std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
-    auto file = filesystem::ifstream(fileName);
-
-    if (!file.is_open()) {
-        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
-                            IVW_CONTEXT);
-    }
-    file.seekg(0, std::ios::end);
-    std::streampos len = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    if (len == std::streampos(0)) {
-        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
-    }
-
-    return readData(file);
+std::string_view trim(std::string_view str) {
+    const auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    while (!str.empty() && isSpace(str.front())) str.remove_prefix(1);
+    while (!str.empty() && isSpace(str.back())) str.remove_suffix(1);
+    return str;
 }
 
-std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
-    // Skip BOM if it exists. Added by for example Excel when saving csv files.
-    filesystem::skipByteOrderMark(stream);
-
-    if (stream.bad() || stream.fail()) {
-        throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
-    }
+/**
+ * Splits a range of characters into rows and fields. A row may span several lines if a field
+ * contains quoted line breaks. The fields refer directly to the parsed characters, only fields
+ * containing quoted CR line breaks are normalized and stored in \p storage.
+ */
+class RowParser {
+public:
+    RowParser(const char* begin, const char* end, size_t line,
+              const std::array<bool, 256>& delimiters, std::deque<std::string>& storage)
+        : pos_{begin}, end_{end}, line_{line}, delimiters_{delimiters}, storage_{storage} {}
 
-    // create a string stream from input stream for buffering
-    std::stringstream in;
-    in << stream.rdbuf();
-    if (in.fail()) {
-        throw CSVDataReaderException("No data", IVW_CONTEXT);
+    /**
+     * Extract the next row into \p fields. Empty lines result in no fields. If \p colCount is
+     * given, an empty trailing field in column colCount+1 is ignored and rows with a different
+     * number of fields throw a CSVDataReaderException.
+     * @return false if the end of the data was reached and no row was extracted
+     */
+    bool next(Fields& fields, size_t colCount = maxColumns) {
+        fields.clear();
+        const auto rowLine = line_;
+        auto [value, lineBreak] = extractField();
+        if (eof_ && value.empty()) {
+            // reached end of data
+            return false;
+        }
+        complete_ = lineBreak;
+        if (value.empty() && lineBreak) {
+            // empty line
+            return true;
+        }
+        fields.push_back(value);
+        while (!lineBreak && !eof_) {
+            std::tie(value, lineBreak) = extractField();
+            complete_ = lineBreak;
+            fields.push_back(trim(value));
+        }
+        // ignore last field _if_ it is empty and would be inserted in the colCount+1 column
+        if (fields.back().empty() && (fields.size() - 1 == colCount)) {
+            fields.pop_back();
+        } else if ((fields.size() != colCount) && (colCount != maxColumns)) {
+            throw CSVDataReaderException(
+                "Column counts do not match (line " + std::to_string(rowLine) + ": " +
+                std::to_string(fields.size()) + " fields; DataFrame has " +
+                std::to_string(colCount) + " columns)");
+        }
+        return true;
     }
 
-    // current line
-    size_t lineNumber = 1u;
+    const char* position() const { return pos_; }
+    size_t line() const { return line_; }
+    /**
+     * True if the data consumed so far ends with the line break of a row, i.e. the next
+     * character starts a new row.
+     */
+    bool complete() const { return complete_; }
 
-    // extract exactly one field from the current stream position, the bool return value indicates
+private:
+    // extract exactly one field from the current position, the bool return value indicates
     // whether a line break was detected following the field
-    auto extractField = [&in, &lineNumber, delims = delimiters_]() -> std::pair<std::string, bool> {
-        std::string value;
+    std::pair<std::string_view, bool> extractField() {
+        const char* begin = pos_;
         size_t quoteCount = 0;
         size_t quoteBeginLine = 0;
         char prev = 0;
+        bool normalize = false;
 
-        auto isLineBreak = [](const char ch, std::istream& stream) {
-            if (ch == '\r') {
-                // consume potential LF (\n) following CR (\r)
-                if (stream.peek() == '\n') {
-                    stream.get();
-                }
-                return true;
-            } else {
-                return (ch == '\n');
+        while (pos_ != end_) {
+            const char* current = pos_++;
+            char ch = *current;
+            const bool lineBreak = (ch == '\r') || (ch == '\n');
+            if (ch == '\r' && pos_ != end_ && *pos_ == '\n') {
+                // consume LF (\n) following CR (\r)
+                ++pos_;
             }
-        };
-
-        char ch;
-        while (in.get(ch) && in.good()) {
-            bool linebreak = isLineBreak(ch, in);
-            if (linebreak) {
-                ++lineNumber;  // increase line counter
+            if (lineBreak) {
+                ++line_;
                 // ensure that ch is equal to '\n'
                 ch = '\n';
                 // consume line break, if inside quotes
                 if ((quoteCount & 1) != 0) {
-                    value += ch;
+                    normalize |= *current == '\r';
                     prev = ch;
                     continue;
                 }
             }
             if (ch == '"') {  // found a quote
-                if (quoteCount == 0) quoteBeginLine = lineNumber;
+                if (quoteCount == 0) quoteBeginLine = line_;
                 ++quoteCount;
-            } else if (util::contains(delims, ch) || linebreak) {
+            } else if (delimiters_[static_cast<unsigned char>(ch)] || lineBreak) {
                 // found a delimiter/newline, ensure that it isn't enclosed by quotes,
                 // i.e. a quote count of 0 or an even count of quotes if the previous
                 // character was a quote
                 if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
-                    return {value, linebreak};
+                    return {value(begin, current, normalize), lineBreak};
                 }
             }
+            normalize |= lineBreak && *current == '\r';
             prev = ch;
-            value += ch;
         }
-        if (((quoteCount & 1) != 0) && in.eof()) {
+        eof_ = true;
+        if ((quoteCount & 1) != 0) {
             throw CSVDataReaderException("Unmatched quotes (starting in line " +
                                          std::to_string(quoteBeginLine) + ")");
         }
-        return {value, false};
+        return {value(begin, end_, normalize), false};
+    }
+
+    std::string_view value(const char* begin, const char* end, bool normalize) {
+        if (!normalize) return std::string_view(begin, end - begin);
+
+        auto& str = storage_.emplace_back();
+        for (auto it = begin; it != end; ++it) {
+            if (*it == '\r') {
+                if (std::next(it) != end && *std::next(it) == '\n') ++it;
+                str += '\n';
+            } else {
+                str += *it;
+            }
+        }
+        return str;
+    }
+
+    const char* pos_;
+    const char* end_;
+    size_t line_;
+    bool eof_ = false;
+    bool complete_ = true;
+    const std::array<bool, 256>& delimiters_;
+    std::deque<std::string>& storage_;
+};
+
+/**
+ * Parses floating point values directly from the character data, with the same semantics as
+ * extracting them from a std::istringstream, but without any allocations.
+ */
+class FloatParser {
+public:
+    FloatParser() : stream_{&buffer_} { stream_.imbue(std::locale::classic()); }
+
+    float operator()(std::string_view str) {
+        if (auto value = parseDecimal(str)) return *value;
+
+        buffer_.set(str);
+        stream_.clear();
+        float result;
+        stream_ >> result;
+        return stream_.fail() ? std::numeric_limits<float>::quiet_NaN() : result;
+    }
+
+private:
+    // Fast path for short plain decimal numbers like "-12.375". Both the digits and the power of
+    // ten are exactly representable as float, hence the division is correctly rounded and gives
+    // the same result as the stream.
+    static std::optional<float> parseDecimal(std::string_view str) {
+        constexpr std::array<float, 8> pow10{1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f};
+        str = trim(str);
+        bool negative = false;
+        if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+            negative = str.front() == '-';
+            str.remove_prefix(1);
+        }
+        std::uint32_t mantissa = 0;
+        size_t digits = 0;
+        size_t decimals = 0;
+        bool point = false;
+        for (auto c : str) {
+            if (c >= '0' && c <= '9') {
+                if (++digits >= pow10.size()) return std::nullopt;
+                mantissa = mantissa * 10 + static_cast<std::uint32_t>(c - '0');
+                if (point) ++decimals;
+            } else if (c == '.' && !point) {
+                point = true;
+            } else {
+                return std::nullopt;
+            }
+        }
+        if (digits == 0) return std::nullopt;
+        const auto value = static_cast<float>(mantissa) / pow10[decimals];
+        return negative ? -value : value;
+    }
+
+    struct ViewBuffer : std::streambuf {
+        void set(std::string_view str) {
+            auto data = const_cast<char*>(str.data());
+            setg(data, data, data + str.size());
+        }
     };
+    ViewBuffer buffer_;
+    std::istream stream_;
+};
+
+/**
+ * Categorical values of one column in a chunk. Values are numbered locally in the order of
+ * their first occurrence and mapped to the ids of the CategoricalColumn when merging.
+ */
+struct Categories {
+    CategoricalDictionary dictionary;
+    std::vector<std::uint32_t> ids;
+
+    void add(std::string_view value) { ids.push_back(dictionary.addOrGet(value)); }
+};
+
+/**
+ * The parsed values of a range of rows
+ */
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    size_t lines = 0;        // number of line breaks in the chunk
+    bool complete = false;   // the chunk ends with the line break of its last row
+    bool failed = false;     // parsing threw an exception
+    std::vector<std::vector<float>> numbers;  // one per column, unused for categorical columns
+    std::vector<Categories> categories;       // one per column, unused for numerical columns
+    std::deque<std::string> storage;
+};
+
+void parseChunk(Chunk& chunk, size_t line, size_t colCount, const std::vector<bool>& categorical,
+                const std::array<bool, 256>& delimiters) {
+    chunk.numbers.assign(colCount, {});
+    chunk.categories.assign(colCount, {});
+    chunk.storage.clear();
+
+    RowParser parser(chunk.begin, chunk.end, line, delimiters, chunk.storage);
+    FloatParser parseFloat;
+    Fields fields;
+    while (parser.next(fields, colCount)) {
+        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
+        if (std::all_of(fields.begin(), fields.end(), [](auto f) { return f.empty(); })) {
+            continue;
+        }
+        for (size_t col = 0; col < colCount; ++col) {
+            if (categorical[col]) {
+                chunk.categories[col].add(fields[col]);
+            } else {
+                chunk.numbers[col].push_back(parseFloat(fields[col]));
+            }
+        }
+    }
+    chunk.lines = parser.line() - line;
+    chunk.complete = parser.complete();
+}
+
+/**
+ * Call \p func for all indices in [0, n), on the thread pool if \p usePool is true.
+ */
+template <typename F>
+void forEach(size_t n, bool usePool, F&& func) {
+    if (!usePool || n < 2) {
+        for (size_t i = 0; i < n; ++i) func(i);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < n; ++i) {
+        futures.push_back(dispatchPool([&func, i]() { func(i); }));
+    }
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    for (auto& future : futures) {
+        pool.wait(future);
+        future.get();
+    }
+}
 
-    // extract one row from the current stream position, the bool return value indicates whether
-    // the end-of-file was detected
-    auto extractRow = [&in, extractField,
-                       &lineNumber](size_t maxColCount = std::numeric_limits<size_t>::max())
-        -> std::pair<std::vector<std::string>, bool> {
-        auto val = extractField();
-        if (in.eof() && val.first.empty()) {
-            // reached end of file, no more data
-            return {{}, true};
-        } else if (val.first.empty() && val.second) {
-            // empty line, ignore
-            return {{}, false};
-        }
-        std::vector<std::string> values;
-        values.push_back(val.first);
-        while (!val.second && !in.eof()) {
-            val = extractField();
-            values.push_back(trim(val.first));
-        }
-        // ignore last field _if_ it is empty and would be inserted in the maxColCount+1 column
-        if (values.back().empty() && (values.size() - 1 == maxColCount)) {
-            values.resize(values.size() - 1);
-        } else if ((values.size() != maxColCount) &&
-                   (maxColCount != std::numeric_limits<size_t>::max())) {
-            // mismatch in the number of columns
-            throw CSVDataReaderException("Column counts do not match (line " +
-                                         std::to_string(lineNumber) + ": " +
-                                         std::to_string(values.size()) + " fields; DataFrame has " +
-                                         std::to_string(maxColCount) + " columns)");
-        }
-        return {values, false};
+/**
+ * Split [begin, end) into at most \p jobs chunks. Chunks start at line breaks preceded by an
+ * even number of quotes, which is where rows of well formed data begin. The quotes of each part
+ * are counted in parallel, the part's candidate split positions for an even and an odd number of
+ * preceding quotes are then resolved in order.
+ */
+std::vector<const char*> findChunkBegins(const char* begin, const char* end, size_t jobs,
+                                         bool usePool) {
+    struct Part {
+        size_t quotes = 0;
+        std::array<const char*, 2> split{nullptr, nullptr};
     };
+    if (jobs < 2) return {begin};
+
+    std::vector<Part> parts(jobs);
+    const size_t size = end - begin;
+    forEach(jobs, usePool, [&](size_t job) {
+        const auto first = begin + job * size / jobs;
+        const auto last = begin + (job + 1) * size / jobs;
+        auto& part = parts[job];
+        for (auto it = first; it != last; ++it) {
+            if (*it == '"') {
+                ++part.quotes;
+            } else if (*it == '\n' || *it == '\r') {
+                const auto next = std::next(it);
+                if (*it == '\r' && next != end && *next == '\n') continue;
+                auto& split = part.split[part.quotes & 1];
+                if (!split) split = next;
+            }
+        }
+    });
+
+    std::vector<const char*> chunkBegins{begin};
+    size_t quotes = 0;
+    for (size_t job = 0; job < jobs; ++job) {
+        const auto split = parts[job].split[quotes & 1];
+        if (job > 0 && split && split > chunkBegins.back() && split < end) {
+            chunkBegins.push_back(split);
+        }
+        quotes += parts[job].quotes;
+    }
+    return chunkBegins;
+}
+
+std::shared_ptr<DataFrame> parse(const char* begin, const char* end,
+                                 const std::string& delimiters, bool firstRowHeader) {
+    // Skip BOM if it exists. Added by for example Excel when saving csv files.
+    if (end - begin >= 3 && static_cast<unsigned char>(begin[0]) == 0xef &&
+        static_cast<unsigned char>(begin[1]) == 0xbb &&
+        static_cast<unsigned char>(begin[2]) == 0xbf) {
+        begin += 3;
+    }
+
+    std::array<bool, 256> delims{};
+    for (auto c : delimiters) delims[static_cast<unsigned char>(c)] = true;
+
+    std::deque<std::string> storage;
+    RowParser parser(begin, end, 1, delims, storage);
+    Fields fields;
 
     std::vector<std::string> headers;
-    size_t maxColCount = std::numeric_limits<size_t>::max();
-    if (firstRowHeader_) {
+    size_t colCount = maxColumns;
+    if (firstRowHeader) {
         // read headers
-        auto row = extractRow();
-        if (row.second || row.first.empty()) {
+        if (!parser.next(fields) || fields.empty()) {
             throw CSVDataReaderException("Empty file, column headers not found");
         }
-        headers = row.first;
-        maxColCount = headers.size();
+        headers.assign(fields.begin(), fields.end());
+        colCount = headers.size();
     }
+    const auto dataBegin = parser.position();
+    const auto dataLine = parser.line();
 
+    // use the first rows to figure out the column types
     std::vector<std::vector<std::string>> exampleRows;
     std::vector<size_t> exampleLineNumbers;  // line numbers matching the example rows
-    std::streampos streamPos = in.tellg();
-    for (auto exampleRow = 0u; exampleRow < 50u; ++exampleRow) {
-        size_t currentLine = lineNumber;
-        auto row = extractRow(maxColCount);
-        if (row.second) {
+    for (size_t exampleRow = 0; exampleRow < exampleRowCount; ++exampleRow) {
+        const auto currentLine = parser.line();
+        if (!parser.next(fields, colCount)) {
             // reached end-of-file
-            if (exampleRow == 0) {
-                throw CSVDataReaderException("Empty file, no data");
-            }
-            in.clear();  // clear eof-bit
             break;
-        } else if (!row.first.empty()) {  // ignore empty lines
-            exampleRows.emplace_back(row.first);
-            exampleLineNumbers.emplace_back(currentLine);
+        } else if (!fields.empty()) {  // ignore empty lines
+            exampleRows.emplace_back(fields.begin(), fields.end());
+            exampleLineNumbers.push_back(currentLine);
         }
     }
+    if (exampleRows.empty()) {
+        throw CSVDataReaderException("Empty file, no data");
+    }
 
-    // Rewind to start position
-    in.seekg(streamPos, std::ios::beg);
-    if (!firstRowHeader_) {
+    if (!firstRowHeader) {
         // assign default column headers
         for (size_t i = 0; i < exampleRows.front().size(); ++i) {
             headers.push_back(std::string("Column ") + std::to_string(i + 1));
         }
         // update column count
-        maxColCount = headers.size();
+        colCount = headers.size();
     }
 
     // figure out column types
     // but check for correct column counts first
     for (size_t i = 0; i < exampleRows.size(); ++i) {
-        if (exampleRows[i].size() != maxColCount) {
+        if (exampleRows[i].size() != colCount) {
             throw CSVDataReaderException(
                 "Column counts do not match (line " + std::to_string(exampleLineNumbers[i]) + ": " +
                 std::to_string(exampleRows[i].size()) + " fields; DataFrame has " +
-                std::to_string(maxColCount) + " columns)");
+                std::to_string(colCount) + " columns)");
         }
     }
 
     auto dataFrame = createDataFrame(exampleRows, headers);
 
-    size_t rowIndex = firstRowHeader_ ? 1 : 0;
-    auto row = extractRow(maxColCount);
-    while (!row.second) {
-        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
-        auto emptyIt = std::find_if(std::begin(row.first), std::end(row.first),
-                                    [](const auto& a) { return !a.empty(); });
-        if (emptyIt != row.first.end()) {
-            // May throw DataTypeMismatch, but do not catch it here since it indicates
-            // that the DataFrame is in an invalid state
-            dataFrame->addRow(row.first);
+    std::vector<bool> categorical(colCount);
+    for (size_t col = 0; col < colCount; ++col) {
+        categorical[col] =
+            std::dynamic_pointer_cast<CategoricalColumn>(dataFrame->getColumn(col + 1)) != nullptr;
+    }
+
+    // Parse the data, including the example rows, in chunks
+    const bool usePool =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    const size_t jobs =
+        usePool ? std::clamp<size_t>((end - dataBegin) / minChunkSize, 1,
+                                     4 * InviwoApplication::getPtr()->getPoolSize())
+                : 1;
+    const auto chunkBegins = findChunkBegins(dataBegin, end, jobs, usePool);
+    std::vector<Chunk> chunks(chunkBegins.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].begin = chunkBegins[i];
+        chunks[i].end = i + 1 < chunks.size() ? chunkBegins[i + 1] : end;
+    }
+
+    forEach(chunks.size(), usePool, [&](size_t i) {
+        try {
+            // line numbers are only needed for error messages, which are reported below
+            parseChunk(chunks[i], 0, colCount, categorical, delims);
+        } catch (...) {
+            chunks[i].failed = true;
+        }
+    });
+
+    // All but the last chunk have to end with a complete row. Otherwise the data is malformed, or
+    // quotes were used in a way that made us split inside of a row. Reparse the remaining data
+    // sequentially in that case, which also reports errors with the correct line numbers.
+    size_t line = dataLine;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i].failed || (!chunks[i].complete && i + 1 < chunks.size())) {
+            chunks.resize(i + 1);
+            chunks[i].end = end;
+            parseChunk(chunks[i], line, colCount, categorical, delims);
+            break;
+        }
+        line += chunks[i].lines;
+    }
+
+    for (size_t col = 0; col < colCount; ++col) {
+        auto column = dataFrame->getColumn(col + 1);
+        if (categorical[col]) {
+            auto catCol = std::static_pointer_cast<CategoricalColumn>(column);
+            auto& ids =
+                catCol->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+            for (const auto& chunk : chunks) {
+                const auto& cats = chunk.categories[col];
+                const auto toColumnId = catCol->getDictionary()->merge(cats.dictionary);
+                std::transform(cats.ids.begin(), cats.ids.end(), std::back_inserter(ids),
+                               [&](std::uint32_t id) { return toColumnId[id]; });
+            }
+        } else {
+            auto floatCol = std::static_pointer_cast<TemplateColumn<float>>(column);
+            auto& values =
+                floatCol->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+            for (const auto& chunk : chunks) {
+                values.insert(values.end(), chunk.numbers[col].begin(), chunk.numbers[col].end());
+            }
         }
-        row = extractRow(maxColCount);
-        ++rowIndex;
     }
+
     dataFrame->updateIndexBuffer();
     return dataFrame;
 }
 
+}  // namespace
+
+CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
+    : DataReaderException("CSVReader: " + message, context) {}
+
+CSVReader::CSVReader() : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true) {
+    addExtension(FileExtension("csv", "Comma Separated Values"));
+}
+
+CSVReader* CSVReader::clone() const { return new CSVReader(*this); }
+
+void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
+
+void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader; }
+
+std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
+    auto file = filesystem::ifstream(fileName);
+
+    if (!file.is_open()) {
+        throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
+                            IVW_CONTEXT);
+    }
+    file.seekg(0, std::ios::end);
+    std::streampos len = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    if (len == std::streampos(0)) {
+        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
+    }
+
+    std::unique_ptr<util::MemoryMappedFile> mapping;
+    try {
+        mapping = std::make_unique<util::MemoryMappedFile>(fileName, 0, static_cast<size_t>(len));
+    } catch (const FileException&) {
+        // Fall back to reading the file
+        return readData(file);
+    }
+    const auto data = static_cast<const char*>(mapping->data());
+    return parse(data, data + mapping->size(), delimiters_, firstRowHeader_);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
+    if (stream.bad() || stream.fail()) {
+        throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
+    }
+
+    const std::string data{std::istreambuf_iterator<char>(stream), {}};
+    if (data.empty()) {
+        throw CSVDataReaderException("No data", IVW_CONTEXT);
+    }
+    return parse(data.data(), data.data() + data.size(), delimiters_, firstRowHeader_);
+}
+
 }  // namespace inviwo
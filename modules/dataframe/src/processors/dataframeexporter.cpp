@@ -29,7 +29,9 @@
 
 #include <inviwo/dataframe/processors/dataframeexporter.h>
 #include <inviwo/dataframe/datastructures/dataframeutil.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
 
+#include <inviwo/core/io/datawriterexception.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/ostreamjoiner.h>
 #include <inviwo/core/io/serialization/serializer.h>
@@ -51,6 +53,8 @@ const ProcessorInfo DataFrameExporter::getProcessorInfo() const { return process
 
 FileExtension DataFrameExporter::csvExtension_ = FileExtension("csv", "CSV");
 FileExtension DataFrameExporter::xmlExtension_ = FileExtension("xml", "XML");
+FileExtension DataFrameExporter::binaryExtension_ =
+    FileExtension("ivwdf", "Inviwo binary DataFrame");
 
 DataFrameExporter::DataFrameExporter()
     : Processor()
@@ -68,6 +72,7 @@ DataFrameExporter::DataFrameExporter()
     exportFile_.clearNameFilters();
     exportFile_.addNameFilter(csvExtension_);
     exportFile_.addNameFilter(xmlExtension_);
+    exportFile_.addNameFilter(binaryExtension_);
 
     addPort(dataFrame_);
     addProperty(exportFile_);
@@ -100,6 +105,8 @@ void DataFrameExporter::exportNow() {
     }
     if (exportFile_.getSelectedExtension() == xmlExtension_) {
         exportAsXML();
+    } else if (exportFile_.getSelectedExtension() == binaryExtension_) {
+        exportAsBinary();
     } else if (exportFile_.getSelectedExtension() == csvExtension_) {
         exportAsCSV(separateVectorTypesIntoColumns_);
     } else {
@@ -215,4 +222,16 @@ void DataFrameExporter::exportAsXML() {
     LogInfo("XML file exported to " << exportFile_);
 }
 
+void DataFrameExporter::exportAsBinary() {
+    // The index column is never stored in the binary format, it is recreated when read
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    try {
+        writer.writeData(dataFrame_.getData().get(), exportFile_);
+        LogInfo("Binary file exported to " << exportFile_);
+    } catch (const DataWriterException& e) {
+        LogError(e.getMessage());
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframegroupby.h>
+#include <inviwo/dataframe/datastructures/groupby.h>
+#include <inviwo/core/util/exception.h>
+
+#include <array>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameGroupBy::processorInfo_{
+    "org.inviwo.DataFrameGroupBy",           // Class identifier
+    "DataFrame Group By",                    // Display name
+    "DataFrame Operation",                   // Category
+    CodeState::Experimental,                 // Code state
+    "CPU, DataFrame, Group, Aggregate, Bin"  // Tags
+};
+const ProcessorInfo DataFrameGroupBy::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameGroupBy::DataFrameGroupBy()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , key_("key", "Group By", inport_, false, 1)
+    , bins_("bins", "Bins", 0, 0, 1024)
+    , secondKey_("secondKey", "Then By", inport_, true)
+    , secondBins_("secondBins", "Bins", 0, 0, 1024)
+    , aggregates_("aggregates", "Aggregates")
+    , count_("count", "Count", true)
+    , sum_("sum", "Sum", false)
+    , mean_("mean", "Mean", true)
+    , min_("min", "Min", false)
+    , max_("max", "Max", false)
+    , variance_("variance", "Variance", false)
+    , percentile_("percentile", "Percentile", false)
+    , percentileValue_("percentileValue", "Percentile Value", 0.5, 0.0, 1.0) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(key_, bins_, secondKey_, secondBins_, aggregates_);
+    aggregates_.addProperties(count_, sum_, mean_, min_, max_, variance_, percentile_,
+                              percentileValue_);
+
+    percentileValue_.visibilityDependsOn(percentile_, [](const auto& p) { return p.get(); });
+}
+
+void DataFrameGroupBy::process() {
+    auto dataframe = inport_.getData();
+
+    const auto key = key_.getColumn();
+    if (!key) throw Exception("No key column selected", IVW_CONTEXT);
+
+    std::vector<groupby::Key> keys;
+    keys.emplace_back(key->getHeader(), bins_.get());
+    if (auto column = secondKey_.getColumn(); column && secondKey_.get() != key_.get()) {
+        keys.emplace_back(column->getHeader(), secondBins_.get());
+    }
+
+    std::vector<groupby::Aggregation> aggregations;
+    if (count_) aggregations.emplace_back(groupby::Aggregate::Count);
+    const std::array<std::pair<const BoolProperty*, groupby::Aggregate>, 6> aggregates{
+        {{&sum_, groupby::Aggregate::Sum},
+         {&mean_, groupby::Aggregate::Mean},
+         {&min_, groupby::Aggregate::Min},
+         {&max_, groupby::Aggregate::Max},
+         {&variance_, groupby::Aggregate::Variance},
+         {&percentile_, groupby::Aggregate::Percentile}}};
+    // skip the index column
+    for (size_t i = 1; i < dataframe->getNumberOfColumns(); ++i) {
+        auto column = dataframe->getColumn(i);
+        const auto& header = column->getHeader();
+        if (dynamic_cast<const CategoricalColumn*>(column.get()) ||
+            column->getBuffer()->getDataFormat()->getComponents() != 1 ||
+            std::any_of(keys.begin(), keys.end(), [&](auto& k) { return k.header == header; })) {
+            continue;
+        }
+        for (auto [property, aggregate] : aggregates) {
+            if (property->get()) {
+                aggregations.emplace_back(aggregate, header, percentileValue_.get());
+            }
+        }
+    }
+
+    outport_.setData(groupby::groupBy(*dataframe, keys, aggregations));
+}
+
+}  // namespace inviwo
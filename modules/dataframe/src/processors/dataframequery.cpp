@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframequery.h>
+#include <inviwo/dataframe/datastructures/query.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameQuery::processorInfo_{
+    "org.inviwo.DataFrameQuery",     // Class identifier
+    "DataFrame Query",               // Display name
+    "DataFrame Operation",           // Category
+    CodeState::Experimental,         // Code state
+    "CPU, DataFrame, Query, Filter"  // Tags
+};
+const ProcessorInfo DataFrameQuery::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameQuery::DataFrameQuery()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , query_("query", "Query", "")
+    , outputMode_("outputMode", "Output",
+                  {{"filterRows", "Filter Rows", OutputMode::FilterRows},
+                   {"selectionColumn", "Append Selection Column", OutputMode::SelectionColumn}},
+                  0)
+    , selectionColumn_("selectionColumn", "Selection Column", "selected") {
+
+    addPort(inport_);
+    addPort(outport_);
+    addProperties(query_, outputMode_, selectionColumn_);
+
+    selectionColumn_.visibilityDependsOn(
+        outputMode_, [](const auto& p) { return p.get() == OutputMode::SelectionColumn; });
+}
+
+void DataFrameQuery::process() {
+    auto dataframe = inport_.getData();
+    const auto mask = query::evaluate(*dataframe, query::parse(query_.get()));
+
+    if (outputMode_ == OutputMode::FilterRows) {
+        outport_.setData(query::filter(dataframe, mask));
+    } else {
+        outport_.setData(query::appendMask(dataframe, mask, selectionColumn_.get()));
+    }
+}
+
+}  // namespace inviwo
@@ -147,7 +147,7 @@ void ColormapProperty::setupForColumn(const Column& col, double minVal, double m
         type.set(ColormapType::Categorical);
         colormap.set(colorbrewer::Family::Paired);
         auto maxColors = getMaxNumberOfColorsForFamily(colormap);
-        auto numCategories = catCol->getCategories().size();
+        auto numCategories = catCol->getNumberOfCategories();
         if (maxColors < numCategories) {
             LogWarn("Categories exceed maximum classes in colormap. "
                     << maxColors << " will be used but " << numCategories
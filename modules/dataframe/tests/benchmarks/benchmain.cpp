@@ -0,0 +1,227 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
+
+#include <inviwo/dataframe/io/csvreader.h>
+#include <inviwo/dataframe/datastructures/query.h>
+#include <inviwo/dataframe/datastructures/groupby.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+// Six numerical columns and two categorical ones, one with quoted values
+static std::string makeCSV(size_t rows) {
+    std::mt19937 rand(0);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    const std::array<std::string, 4> names{"alpha", "beta", "gamma", "delta"};
+    const std::array<std::string, 3> notes{"\"low, stable\"", "\"high\"", "\"spiking,\nrecheck\""};
+
+    std::ostringstream ss;
+    ss << "time,x,y,z,temperature,pressure,sensor,note\n";
+    for (size_t row = 0; row < rows; ++row) {
+        ss << row;
+        for (int i = 0; i < 5; ++i) ss << ',' << dist(rand);
+        ss << ',' << names[rand() % names.size()] << ',' << notes[rand() % notes.size()] << '\n';
+    }
+    return ss.str();
+}
+
+static void CSVFile(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto csv = makeCSV(rows);
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(csv.data(), 1, csv.size(), tmpFile);
+    std::fflush(tmpFile);
+
+    CSVReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(tmpFile.getFileName());
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(state.iterations() * csv.size());
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+static void CSVStream(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto csv = makeCSV(rows);
+
+    CSVReader reader;
+    for (auto _ : state) {
+        std::istringstream ss(csv);
+        auto dataframe = reader.readData(ss);
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(state.iterations() * csv.size());
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+// Number of rows x number of threads in the pool
+static void ReaderArgs(benchmark::internal::Benchmark* b) {
+    for (int rows : {100'000, 1'000'000}) {
+        for (int threads : {0, 1, 2, 4, 8, 16}) {
+            b->Args({rows, threads});
+        }
+    }
+}
+
+BENCHMARK(CSVFile)->Apply(ReaderArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSVStream)->Apply(ReaderArgs)->Unit(benchmark::kMillisecond);
+
+// Two numerical columns and one categorical column
+static std::shared_ptr<DataFrame> makeDataFrame(size_t rows) {
+    std::mt19937 rand(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(rows);
+    std::vector<float> y(rows);
+    std::vector<std::uint32_t> type(rows);
+    for (size_t row = 0; row < rows; ++row) {
+        x[row] = dist(rand);
+        y[row] = dist(rand);
+        type[row] = rand() % 4;
+    }
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn(std::make_shared<TemplateColumn<float>>("x", std::move(x)));
+    dataframe->addColumn(std::make_shared<TemplateColumn<float>>("y", std::move(y)));
+    auto categorical = std::make_shared<CategoricalColumn>(
+        "type", std::make_shared<CategoricalDictionary>(
+                    std::vector<std::string>{"alpha", "beta", "gamma", "delta"}));
+    categorical->setBuffer(util::makeBuffer(std::move(type)));
+    dataframe->addColumn(categorical);
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+static void QueryEvaluate(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto dataframe = makeDataFrame(rows);
+    const auto expr = query::parse("x > 0 and y in [-0.5, 0.5] or type == \"beta\"");
+
+    for (auto _ : state) {
+        auto mask = query::evaluate(*dataframe, expr);
+        benchmark::DoNotOptimize(mask);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+static void QueryFilter(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto dataframe = makeDataFrame(rows);
+    const auto expr = query::parse("x > 0 and y in [-0.5, 0.5] or type == \"beta\"");
+
+    for (auto _ : state) {
+        auto filtered = query::filter(dataframe, query::evaluate(*dataframe, expr));
+        benchmark::DoNotOptimize(filtered);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+// Number of rows x number of threads in the pool
+static void QueryArgs(benchmark::internal::Benchmark* b) {
+    for (int rows : {1'000'000, 10'000'000}) {
+        for (int threads : {0, 1, 2, 4, 8, 16}) {
+            b->Args({rows, threads});
+        }
+    }
+}
+
+BENCHMARK(QueryEvaluate)->Apply(QueryArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(QueryFilter)->Apply(QueryArgs)->Unit(benchmark::kMillisecond);
+
+static void GroupBy(benchmark::State& state) {
+    InviwoApplication::getPtr()->resizePool(static_cast<size_t>(state.range(1)));
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto dataframe = makeDataFrame(rows);
+    using namespace groupby;
+    const std::vector<Key> keys{Key{"type"}, Key{"x", 64}};
+    const std::vector<Aggregation> aggregations{{Aggregate::Count},
+                                                {Aggregate::Mean, "y"},
+                                                {Aggregate::Variance, "y"},
+                                                {Aggregate::Min, "y"},
+                                                {Aggregate::Max, "y"},
+                                                {Aggregate::Percentile, "y", 0.9}};
+
+    for (auto _ : state) {
+        auto result = groupBy(*dataframe, keys, aggregations);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.counters["Threads"] = static_cast<double>(state.range(1));
+}
+
+BENCHMARK(GroupBy)->Apply(QueryArgs)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    auto logger = std::make_shared<ConsoleLogger>();
+    LogCentral::getPtr()->setVerbosity(LogVerbosity::Error);
+    LogCentral::getPtr()->registerLogger(logger);
+    InviwoApplication app(argc, argv, "Inviwo-Benchmarks-DataFrame");
+
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
@@ -0,0 +1,161 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createDataFrame() {
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn(std::make_shared<TemplateColumn<float>>(
+        "float", std::vector<float>{1.5f, std::numeric_limits<float>::quiet_NaN(), -2.0f, 4.0f,
+                                    8.0f}));
+    dataframe->addColumn(
+        std::make_shared<TemplateColumn<int>>("int", std::vector<int>{-3, 7, 2, 11, 5}));
+    auto categorical = std::make_shared<CategoricalColumn>("cat");
+    categorical->addMany(std::vector<std::string>{"a", "b", "a", "c", "b"});
+    dataframe->addColumn(categorical);
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+}  // namespace
+
+TEST(BinaryDataFrame, roundTrip) {
+    util::TempFileHandle tmpFile("", ".ivwdf");
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(createDataFrame().get(), tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(4, dataframe->getNumberOfColumns());
+    EXPECT_EQ(5, dataframe->getNumberOfRows());
+    EXPECT_EQ(4, dataframe->getIndexColumn()->get(4));
+
+    auto floatCol = std::dynamic_pointer_cast<TemplateColumn<float>>(dataframe->getColumn(1));
+    ASSERT_TRUE(floatCol);
+    EXPECT_EQ("float", floatCol->getHeader());
+    EXPECT_EQ(1.5f, floatCol->get(0));
+    EXPECT_TRUE(std::isnan(floatCol->get(1)));
+    EXPECT_EQ(8.0f, floatCol->get(4));
+
+    auto intCol = std::dynamic_pointer_cast<TemplateColumn<int>>(dataframe->getColumn(2));
+    ASSERT_TRUE(intCol);
+    EXPECT_EQ(std::vector<int>({-3, 7, 2, 11, 5}),
+              std::vector<int>(intCol->begin(), intCol->end()));
+
+    auto catCol = std::dynamic_pointer_cast<CategoricalColumn>(dataframe->getColumn(3));
+    ASSERT_TRUE(catCol);
+    EXPECT_EQ(3, catCol->getNumberOfCategories());
+    EXPECT_EQ("a", catCol->getAsString(2));
+    EXPECT_EQ("c", catCol->getAsString(3));
+    EXPECT_EQ("b", catCol->getAsString(4));
+}
+
+TEST(BinaryDataFrame, lazyColumns) {
+    util::TempFileHandle tmpFile("", ".ivwdf");
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(createDataFrame().get(), tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+    for (size_t i = 1; i < dataframe->getNumberOfColumns(); ++i) {
+        EXPECT_FALSE(dataframe->getColumn(i)->getBuffer()->hasRepresentation<BufferRAM>());
+        EXPECT_EQ(5, dataframe->getColumn(i)->getSize());
+    }
+
+    // accessing a column only loads that column
+    EXPECT_EQ(11.0, dataframe->getColumn("int")->getAsDouble(3));
+    EXPECT_TRUE(dataframe->getColumn("int")->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(dataframe->getColumn("float")->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(dataframe->getColumn("cat")->getBuffer()->hasRepresentation<BufferRAM>());
+
+    // copies stay lazy
+    DataFrame copy{*dataframe};
+    EXPECT_FALSE(copy.getColumn("float")->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_EQ(-2.0, copy.getColumn("float")->getAsDouble(2));
+}
+
+TEST(BinaryDataFrame, blockStatistics) {
+    util::TempFileHandle tmpFile("", ".ivwdf");
+    BinaryDataFrameWriter writer;
+    writer.setOverwrite(true);
+    writer.setBlockSize(2);
+    writer.writeData(createDataFrame().get(), tmpFile.getFileName());
+
+    auto file = filesystem::ifstream(tmpFile.getFileName(), std::ios::in | std::ios::binary);
+    const auto info = binarydataframe::readFileInfo(file);
+    EXPECT_EQ(5, info.rows);
+    EXPECT_EQ(2, info.blockSize);
+    ASSERT_EQ(3, info.columns.size());
+
+    const auto& floats = info.columns[0];
+    EXPECT_EQ(DataFloat32::get(), floats.format);
+    ASSERT_EQ(3, floats.blockMinMax.size());
+    EXPECT_EQ(dvec2(1.5, 1.5), floats.blockMinMax[0]);
+    EXPECT_EQ(dvec2(-2.0, 4.0), floats.blockMinMax[1]);
+    EXPECT_EQ(dvec2(8.0, 8.0), floats.blockMinMax[2]);
+
+    const auto& ints = info.columns[1];
+    ASSERT_EQ(3, ints.blockMinMax.size());
+    EXPECT_EQ(dvec2(-3.0, 7.0), ints.blockMinMax[0]);
+
+    const auto& categories = info.columns[2];
+    EXPECT_TRUE(categories.categorical);
+    EXPECT_TRUE(categories.blockMinMax.empty());
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), categories.categories);
+    for (const auto& col : info.columns) {
+        EXPECT_EQ(0, col.offset % binarydataframe::alignment);
+        EXPECT_EQ(5 * col.format->getSize(), col.bytes);
+    }
+}
+
+TEST(BinaryDataFrame, invalidFile) {
+    std::istringstream ss("not a binary dataframe");
+    EXPECT_THROW(binarydataframe::readFileInfo(ss), DataReaderException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/categoricaldictionary.h>
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/dataframeutil.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+TEST(CategoricalDictionary, addOrGet) {
+    CategoricalDictionary dict;
+    EXPECT_EQ(0u, dict.addOrGet("red"));
+    EXPECT_EQ(1u, dict.addOrGet("green"));
+    EXPECT_EQ(0u, dict.addOrGet("red"));
+    EXPECT_EQ(2u, dict.addOrGet(""));
+    EXPECT_EQ(3u, dict.size());
+
+    EXPECT_EQ("green", dict.get(1));
+    EXPECT_EQ("", dict[2]);
+    EXPECT_EQ(1u, dict.find("green"));
+    EXPECT_EQ(CategoricalDictionary::npos, dict.find("blue"));
+    EXPECT_EQ((std::vector<std::string>{"red", "green", ""}), dict.getStrings());
+}
+
+TEST(CategoricalDictionary, manyCategories) {
+    CategoricalDictionary dict;
+    const std::uint32_t count = 100000;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        ASSERT_EQ(i, dict.addOrGet("host-" + std::to_string(i)));
+    }
+    ASSERT_EQ(count, dict.size());
+    for (std::uint32_t i = 0; i < count; i += 997) {
+        EXPECT_EQ(i, dict.find("host-" + std::to_string(i)));
+        EXPECT_EQ("host-" + std::to_string(i), dict.get(i));
+    }
+}
+
+TEST(CategoricalDictionary, merge) {
+    CategoricalDictionary a({"x", "y"});
+    CategoricalDictionary b({"z", "y", "w"});
+
+    const auto ids = a.merge(b);
+    EXPECT_EQ((std::vector<std::uint32_t>{2, 1, 3}), ids);
+    EXPECT_EQ((std::vector<std::string>{"x", "y", "z", "w"}), a.getStrings());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 3}), a.merge(a));
+}
+
+TEST(CategoricalColumn, bulk) {
+    CategoricalColumn col("col");
+    col.addMany({"a", "b", "a", "c"});
+    ASSERT_EQ(4, col.getSize());
+    EXPECT_EQ(3, col.getNumberOfCategories());
+    EXPECT_EQ("a", col.getAsString(2));
+
+    const std::vector<std::string> values{"d", "a"};
+    col.setMany(1, values.begin(), values.end());
+    EXPECT_EQ("d", col.getAsString(1));
+    EXPECT_EQ("a", col.getAsString(2));
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "c", "d"}), col.getCategories());
+
+    const std::vector<std::string> tooMany{"e", "f", "g"};
+    EXPECT_THROW(col.setMany(2, tooMany), RangeException);
+    EXPECT_THROW(col.setMany(5, std::vector<std::string>{}), RangeException);
+    EXPECT_NO_THROW(col.setMany(4, std::vector<std::string>{}));
+    EXPECT_EQ(4, col.getNumberOfCategories());
+    EXPECT_EQ("c", col.getAsString(3));
+}
+
+TEST(CategoricalColumn, sharedDictionary) {
+    auto dict = std::make_shared<CategoricalDictionary>();
+    CategoricalColumn col1("col1", dict);
+    CategoricalColumn col2("col2", dict);
+    col1.add("a");
+    col2.add("b");
+    col2.add("a");
+    EXPECT_EQ(2, col1.getNumberOfCategories());
+    EXPECT_EQ(col1[0], col2[1]);
+
+    // copies do not share the dictionary
+    CategoricalColumn copy(col1);
+    copy.add("c");
+    EXPECT_EQ(3, copy.getNumberOfCategories());
+    EXPECT_EQ(2, col1.getNumberOfCategories());
+}
+
+TEST(CategoricalColumn, combineDataFrames) {
+    auto df1 = std::make_shared<DataFrame>();
+    df1->addCategoricalColumn("cat")->addMany({"a", "b", "a"});
+    df1->updateIndexBuffer();
+    auto df2 = std::make_shared<DataFrame>();
+    df2->addCategoricalColumn("cat")->addMany({"c", "a"});
+    df2->updateIndexBuffer();
+
+    auto combined = dataframeutil::combineDataFrames({df1, df2}, true);
+    auto col = std::dynamic_pointer_cast<const CategoricalColumn>(combined->getColumn("cat"));
+    ASSERT_TRUE(col) << "expected a categorical column";
+    ASSERT_EQ(5, col->getSize());
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), col->getCategories());
+    const std::vector<std::string> expected{"a", "b", "a", "c", "a"};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], col->getAsString(i)) << "row " << i;
+    }
+}
+
+}  // namespace inviwo
@@ -35,6 +35,7 @@
 #include <inviwo/core/io/tempfilehandle.h>
 #include <inviwo/dataframe/io/csvreader.h>
 
+#include <cstdio>
 #include <sstream>
 
 namespace inviwo {
@@ -465,4 +466,31 @@ TEST(CSVlinebreaks, mixed) {
     ASSERT_EQ(4, dataframe->getNumberOfRows()) << "row count does not match";
 }
 
+TEST(CSVfile, manyRows) {
+    // test reading a larger file with line breaks inside quotes and mixed line endings
+    std::string data = "Value,Name,Note\r\n";
+    const size_t rows = 10000;
+    for (size_t i = 0; i < rows; ++i) {
+        data += std::to_string(i) + ".5," + (i % 3 == 0 ? "\"a, b\"" : "c") + "," +
+                (i % 7 == 0 ? "\"multiline\n quote\"" : "note") + (i % 2 == 0 ? "\n" : "\r\n");
+    }
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(data.data(), 1, data.size(), tmpFile);
+    std::fflush(tmpFile);
+
+    CSVReader reader;
+    auto dataframe = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(4, dataframe->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(rows, dataframe->getNumberOfRows()) << "row count does not match";
+    EXPECT_EQ("9999.5", dataframe->getColumn(1)->get(rows - 1, true)->toString());
+    EXPECT_EQ("\"a, b\"", dataframe->getColumn(2)->get(0, true)->toString());
+    EXPECT_EQ("c", dataframe->getColumn(2)->get(1, true)->toString());
+    EXPECT_EQ("\"multiline\n quote\"", dataframe->getColumn(3)->get(7, true)->toString());
+    EXPECT_EQ("note", dataframe->getColumn(3)->get(8, true)->toString());
+
+    auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(dataframe->getColumn(2));
+    ASSERT_TRUE(categorical) << "expected a categorical column";
+    EXPECT_EQ((std::vector<std::string>{"\"a, b\"", "c"}), categorical->getCategories());
+}
+
 }  // namespace inviwo
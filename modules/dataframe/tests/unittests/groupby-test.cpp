@@ -0,0 +1,149 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/groupby.h>
+
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createDataFrame() {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn(std::make_shared<TemplateColumn<float>>(
+        "x", std::vector<float>{1.0f, 2.0f, nan, 4.0f, 6.0f, 3.0f}));
+    dataframe->addColumn(
+        std::make_shared<TemplateColumn<int>>("y", std::vector<int>{4, -2, 0, 7, 1, 4}));
+    auto categorical = std::make_shared<CategoricalColumn>("type");
+    categorical->addMany(
+        std::vector<std::string>{"star", "moon", "star", "planet", "moon", "star"});
+    dataframe->addColumn(categorical);
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+template <typename T>
+std::vector<T> values(const DataFrame& dataframe, const std::string& header) {
+    auto column = std::dynamic_pointer_cast<const TemplateColumn<T>>(dataframe.getColumn(header));
+    EXPECT_TRUE(column) << "missing column " << header;
+    if (!column) return {};
+    return column->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+}
+
+}  // namespace
+
+TEST(DataFrameGroupBy, categoricalKey) {
+    using namespace groupby;
+    const auto result = groupBy(
+        *createDataFrame(), {Key{"type"}},
+        {{Aggregate::Count}, {Aggregate::Sum, "x"}, {Aggregate::Mean, "x"}, {Aggregate::Min, "x"},
+         {Aggregate::Max, "x"}, {Aggregate::Variance, "x"}, {Aggregate::Percentile, "x", 0.5}});
+
+    ASSERT_EQ(3, result->getNumberOfRows());
+    auto type = std::dynamic_pointer_cast<const CategoricalColumn>(result->getColumn("type"));
+    ASSERT_TRUE(type);
+    EXPECT_EQ("moon", type->getAsString(0));
+    EXPECT_EQ("planet", type->getAsString(1));
+    EXPECT_EQ("star", type->getAsString(2));
+
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 1, 3}), values<std::uint32_t>(*result, "count"));
+    EXPECT_EQ(std::vector<double>({8.0, 4.0, 4.0}), values<double>(*result, "sum(x)"));
+    EXPECT_EQ(std::vector<double>({4.0, 4.0, 2.0}), values<double>(*result, "mean(x)"));
+    EXPECT_EQ(std::vector<double>({2.0, 4.0, 1.0}), values<double>(*result, "min(x)"));
+    EXPECT_EQ(std::vector<double>({6.0, 4.0, 3.0}), values<double>(*result, "max(x)"));
+    EXPECT_EQ(std::vector<double>({4.0, 4.0, 2.0}), values<double>(*result, "p50(x)"));
+
+    const auto variance = values<double>(*result, "variance(x)");
+    ASSERT_EQ(3, variance.size());
+    EXPECT_DOUBLE_EQ(8.0, variance[0]);
+    EXPECT_TRUE(std::isnan(variance[1]));
+    EXPECT_DOUBLE_EQ(2.0, variance[2]);
+}
+
+TEST(DataFrameGroupBy, valueKey) {
+    using namespace groupby;
+    const auto result = groupBy(
+        *createDataFrame(), {Key{"y"}},
+        {{Aggregate::Count, "", 0.5, "rows"}, {Aggregate::Sum, "x"}, {Aggregate::Mean, "x"}});
+
+    EXPECT_EQ(std::vector<int>({-2, 0, 1, 4, 7}), values<int>(*result, "y"));
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 1, 1, 2, 1}), values<std::uint32_t>(*result, "rows"));
+    EXPECT_EQ(std::vector<double>({2.0, 0.0, 6.0, 4.0, 4.0}), values<double>(*result, "sum(x)"));
+    const auto mean = values<double>(*result, "mean(x)");
+    ASSERT_EQ(5, mean.size());
+    EXPECT_TRUE(std::isnan(mean[1]));
+    EXPECT_DOUBLE_EQ(2.0, mean[3]);
+}
+
+TEST(DataFrameGroupBy, binnedKeys) {
+    using namespace groupby;
+    const auto dataframe = createDataFrame();
+
+    // The range of x is [1, 6], the NaN row does not belong to any bin
+    auto result = groupBy(*dataframe, {Key{"x", 2}}, {{Aggregate::Count}});
+    EXPECT_EQ(std::vector<double>({2.25, 4.75}), values<double>(*result, "x"));
+    EXPECT_EQ(std::vector<std::uint32_t>({3, 2}), values<std::uint32_t>(*result, "count"));
+
+    // Values outside of the range end up in the first and last bin
+    result = groupBy(*dataframe, {Key{"type"}, Key{"y", 2, dvec2{0.0, 4.0}}},
+                     {{Aggregate::Max, "x"}});
+    auto type = std::dynamic_pointer_cast<const CategoricalColumn>(result->getColumn("type"));
+    ASSERT_TRUE(type);
+    ASSERT_EQ(4, result->getNumberOfRows());
+    EXPECT_EQ("moon", type->getAsString(0));
+    EXPECT_EQ("planet", type->getAsString(1));
+    EXPECT_EQ("star", type->getAsString(2));
+    EXPECT_EQ("star", type->getAsString(3));
+    EXPECT_EQ(std::vector<double>({1.0, 3.0, 1.0, 3.0}), values<double>(*result, "y"));
+    const auto max = values<double>(*result, "max(x)");
+    ASSERT_EQ(4, max.size());
+    EXPECT_EQ(6.0, max[0]);
+    EXPECT_EQ(4.0, max[1]);
+    EXPECT_TRUE(std::isnan(max[2]));
+    EXPECT_EQ(3.0, max[3]);
+}
+
+TEST(DataFrameGroupBy, invalidColumns) {
+    using namespace groupby;
+    const auto dataframe = createDataFrame();
+
+    EXPECT_THROW(groupBy(*dataframe, {}, {{Aggregate::Count}}), Exception);
+    EXPECT_THROW(groupBy(*dataframe, {Key{"z"}}, {{Aggregate::Count}}), Exception);
+    EXPECT_THROW(groupBy(*dataframe, {Key{"type"}}, {{Aggregate::Mean, "z"}}), Exception);
+}
+
+}  // namespace inviwo
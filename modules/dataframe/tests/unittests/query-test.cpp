@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/query.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createDataFrame() {
+    auto dataframe = std::make_shared<DataFrame>();
+    dataframe->addColumn(std::make_shared<TemplateColumn<float>>(
+        "x", std::vector<float>{-1.0f, 0.5f, std::numeric_limits<float>::quiet_NaN(), 2.0f, 3.5f}));
+    dataframe->addColumn(
+        std::make_shared<TemplateColumn<int>>("y pos", std::vector<int>{4, -2, 0, 7, 1}));
+    auto categorical = std::make_shared<CategoricalColumn>("type");
+    categorical->addMany(std::vector<std::string>{"star", "moon", "star", "planet", "moon"});
+    dataframe->addColumn(categorical);
+    dataframe->updateIndexBuffer();
+    return dataframe;
+}
+
+}  // namespace
+
+TEST(DataFrameQuery, comparisons) {
+    using namespace query;
+    const auto dataframe = createDataFrame();
+
+    EXPECT_EQ(Mask({0, 1, 0, 1, 1}), evaluate(*dataframe, col("x") > 0));
+    EXPECT_EQ(Mask({1, 1, 0, 0, 0}), evaluate(*dataframe, col("x") <= 0.5));
+    EXPECT_EQ(Mask({0, 0, 0, 1, 0}), evaluate(*dataframe, col("x") == 2));
+    EXPECT_EQ(Mask({1, 1, 1, 0, 1}), evaluate(*dataframe, col("x") != 2));
+    EXPECT_EQ(Mask({0, 1, 1, 0, 1}), evaluate(*dataframe, col("y pos").inRange(-2, 1)));
+    EXPECT_EQ(Mask({1, 0, 1, 0, 0}), evaluate(*dataframe, col("type") == "star"));
+    EXPECT_EQ(Mask({0, 1, 0, 1, 1}), evaluate(*dataframe, col("type") != "star"));
+    EXPECT_EQ(Mask({0, 1, 0, 1, 1}), evaluate(*dataframe, col("type").isIn({"planet", "moon"})));
+    EXPECT_EQ(Mask({0, 0, 0, 0, 0}), evaluate(*dataframe, col("type") == "comet"));
+}
+
+TEST(DataFrameQuery, booleanOperators) {
+    using namespace query;
+    const auto dataframe = createDataFrame();
+
+    EXPECT_EQ(Mask({0, 0, 0, 1, 1}), evaluate(*dataframe, col("x") > 0 && col("y pos") >= 1));
+    EXPECT_EQ(Mask({1, 1, 1, 0, 0}), evaluate(*dataframe, col("x") < 0 || col("y pos") <= 0 ||
+                                                               col("type") == "star"));
+    EXPECT_EQ(Mask({1, 0, 1, 0, 0}), evaluate(*dataframe, !(col("x") > 0)));
+    EXPECT_EQ(5, count(evaluate(*dataframe, Expr{})));
+}
+
+TEST(DataFrameQuery, parse) {
+    using namespace query;
+    const auto dataframe = createDataFrame();
+
+    EXPECT_EQ(Mask({0, 0, 0, 1, 1}), evaluate(*dataframe, parse("x > 0 and `y pos` >= 1")));
+    EXPECT_EQ(Mask({0, 1, 0, 0, 1}),
+              evaluate(*dataframe, parse("type == \"moon\" && !(x in [1, 3])")));
+    EXPECT_EQ(Mask({1, 1, 1, 1, 0}),
+              evaluate(*dataframe, parse("not (x >= 3) or type in {\"star\", \"planet\"}")));
+    EXPECT_EQ(5, count(evaluate(*dataframe, parse(""))));
+
+    EXPECT_THROW(parse("x >"), Exception);
+    EXPECT_THROW(parse("(x < 1"), Exception);
+    EXPECT_THROW(parse("x < \"a\""), Exception);
+    EXPECT_THROW(parse("x < 1 )"), Exception);
+    EXPECT_THROW(evaluate(*dataframe, parse("z < 1")), Exception);
+    EXPECT_THROW(evaluate(*dataframe, parse("x == \"a\"")), Exception);
+}
+
+TEST(DataFrameQuery, filter) {
+    using namespace query;
+    const auto dataframe = createDataFrame();
+
+    const auto mask = evaluate(*dataframe, col("x") > 0);
+    EXPECT_EQ(3, count(mask));
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 3, 4}), selectedIndices(mask));
+
+    const auto filtered = filter(dataframe, mask);
+    ASSERT_EQ(4, filtered->getNumberOfColumns());
+    ASSERT_EQ(3, filtered->getNumberOfRows());
+    EXPECT_EQ(3, filtered->getIndexColumn()->get(1));
+    EXPECT_EQ(3.5, filtered->getColumn("x")->getAsDouble(2));
+    EXPECT_EQ(7.0, filtered->getColumn("y pos")->getAsDouble(1));
+
+    auto type = std::dynamic_pointer_cast<const CategoricalColumn>(filtered->getColumn("type"));
+    ASSERT_TRUE(type);
+    EXPECT_EQ("planet", type->getAsString(1));
+    EXPECT_EQ(std::dynamic_pointer_cast<const CategoricalColumn>(dataframe->getColumn("type"))
+                  ->getDictionary(),
+              type->getDictionary());
+
+    // nothing to remove, the columns are shared
+    const auto all = filter(dataframe, Mask(5, 1));
+    EXPECT_EQ(dataframe->getColumn("x"), all->getColumn("x"));
+    EXPECT_EQ(5, all->getNumberOfRows());
+
+    EXPECT_THROW(filter(dataframe, Mask(3, 1)), Exception);
+}
+
+TEST(DataFrameQuery, appendMask) {
+    using namespace query;
+    const auto dataframe = createDataFrame();
+
+    const auto result = appendMask(dataframe, evaluate(*dataframe, col("x") > 0), "selected");
+    ASSERT_EQ(5, result->getNumberOfColumns());
+    EXPECT_EQ(dataframe->getColumn("type"), result->getColumn("type"));
+    EXPECT_EQ(1.0, result->getColumn("selected")->getAsDouble(1));
+    EXPECT_EQ(0.0, result->getColumn("selected")->getAsDouble(2));
+}
+
+}  // namespace inviwo
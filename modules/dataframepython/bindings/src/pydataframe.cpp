@@ -133,6 +133,8 @@ void exposeDataFrame(pybind11::module& m) {
         .def_property_readonly("categories", &CategoricalColumn::getCategories,
                                py::return_value_policy::copy)
         .def("add", [](CategoricalColumn& c, const std::string& str) { c.add(str); })
+        .def("addMany", [](CategoricalColumn& c,
+                           const std::vector<std::string>& values) { c.addMany(values); })
         .def("set", [](CategoricalColumn& c, size_t idx, const std::uint32_t& v) { c.set(idx, v); })
         .def("set", py::overload_cast<size_t, const std::string&>(&CategoricalColumn::set))
         .def("get",
@@ -143,7 +145,7 @@ void exposeDataFrame(pybind11::module& m) {
              py::arg("i"), py::arg("asString") = true)
         .def("__repr__", [](CategoricalColumn& c) {
             return fmt::format("<CategoricalColumn: '{}', {}, {} categories>", c.getHeader(),
-                               c.getSize(), c.getCategories().size());
+                               c.getSize(), c.getNumberOfCategories());
         });
 
     py::class_<DataFrame, std::shared_ptr<DataFrame>> dataframe(m, "DataFrame");
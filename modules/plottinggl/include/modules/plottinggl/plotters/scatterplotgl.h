@@ -145,6 +145,11 @@ public:
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
     void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    /**
+     * Set the selection state of all data points at once, \p selected has one entry per data
+     * point. Data points beyond the size of \p selected are deselected.
+     */
+    void setSelected(const std::vector<bool>& selected);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -202,6 +202,7 @@ private:
 
     PCPCaptionSettings captionSettings_;
     std::vector<std::string> labels_;
+    std::vector<std::string> categories_;  // labels of a categorical column
     std::shared_ptr<std::function<void()>> labelUpdateCallback_;
     PCPLabelSettings labelSettings_;
 
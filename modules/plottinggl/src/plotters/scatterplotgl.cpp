@@ -541,6 +541,14 @@ void ScatterPlotGL::setSelectedIndices(const std::unordered_set<size_t>& indices
     selectedIndicesGLDirty_ = true;
 }
 
+void ScatterPlotGL::setSelected(const std::vector<bool>& selected) {
+    ensureSelectAndFilterSizes();
+    const auto n = std::min(selected.size(), selected_.size());
+    std::copy(selected.begin(), selected.begin() + n, selected_.begin());
+    std::fill(selected_.begin() + n, selected_.end(), false);
+    selectedIndicesGLDirty_ = true;
+}
+
 auto ScatterPlotGL::addToolTipCallback(std::function<ToolTipFunc> callback)
     -> ToolTipCallbackHandle {
     return tooltipCallback_.add(callback);
@@ -650,11 +650,11 @@ void ParallelCoordinates::linePicked(PickingEvent* p) {
 
         auto id = p->getPickedId();
 
-        auto selection = brushingAndLinking_.getSelectedIndices();
+        auto selection = brushingAndLinking_.getSelected();
         if (brushingAndLinking_.isSelected(indexCol[id])) {
-            selection.erase(indexCol[id]);
+            selection.remove(indexCol[id]);
         } else {
-            selection.insert(indexCol[id]);
+            selection.add(indexCol[id]);
         }
         brushingAndLinking_.sendSelectionEvent(selection);
 
@@ -796,11 +796,11 @@ void ParallelCoordinates::updateBrushing() {
         }
     }
 
-    std::unordered_set<size_t> brushedID;
+    std::vector<std::uint32_t> brushedID;
     for (size_t i = 0; i < nRows; ++i) {
-        if (brushed[i]) brushedID.insert(indexCol[i]);
+        if (brushed[i]) brushedID.push_back(indexCol[i]);
     }
-    brushingAndLinking_.sendFilterEvent(brushedID);
+    brushingAndLinking_.sendFilterEvent(BitSet(brushedID.begin(), brushedID.end()));
 }
 
 std::pair<size2_t, size2_t> ParallelCoordinates::axisPos(size_t columnId) const {
@@ -112,6 +112,7 @@ PCPAxisSettings* PCPAxisSettings::clone() const { return new PCPAxisSettings(*th
 void PCPAxisSettings::updateFromColumn(std::shared_ptr<const Column> col) {
     col_ = col;
     catCol_ = dynamic_cast<const CategoricalColumn*>(col.get());
+    categories_ = catCol_ ? catCol_->getCategories() : std::vector<std::string>{};
 
     col->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
         [&](auto ram) -> void {
@@ -284,7 +285,7 @@ void PCPAxisSettings::updateBrushing() {
 
 dvec2 PCPAxisSettings::getRange() const {
     if (catCol_) {
-        return {0.0, static_cast<double>(catCol_->getCategories().size()) - 1.0};
+        return {0.0, static_cast<double>(catCol_->getNumberOfCategories()) - 1.0};
     } else {
         return dvec2{range.getRangeMin(), range.getRangeMax()};
     }
@@ -326,7 +327,7 @@ AxisSettings::Placement PCPAxisSettings::getPlacement() const { return Placement
 const std::string& PCPAxisSettings::getCaption() const { return col_->getHeader(); }
 const PlotTextSettings& PCPAxisSettings::getCaptionSettings() const { return captionSettings_; }
 const std::vector<std::string>& PCPAxisSettings::getLabels() const {
-    return catCol_ ? catCol_->getCategories() : labels_;
+    return catCol_ ? categories_ : labels_;
 }
 
 const PlotTextSettings& PCPAxisSettings::getLabelSettings() const { return labelSettings_; }
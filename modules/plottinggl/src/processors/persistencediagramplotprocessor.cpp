@@ -112,14 +112,14 @@ void PersistenceDiagramPlotProcessor::process() {
         auto iCol = dataframe->getIndexColumn();
         auto &indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto filteredIndicies = brushingPort_.getFilteredIndices();
+        const auto &filteredIndicies = brushingPort_.getFiltered();
         IndexBuffer indicies;
         auto &vec = indicies.getEditableRAMRepresentation()->getDataContainer();
-        vec.reserve(dfSize - filteredIndicies.size());
+        vec.reserve(dfSize - std::min(dfSize, filteredIndicies.cardinality()));
 
         auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
         std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
-                     [&](const auto &id) { return !brushingPort_.isFiltered(indexCol[id]); });
+                     [&](const auto &id) { return !filteredIndicies.contains(indexCol[id]); });
 
         if (backgroundPort_.hasData()) {
             persistenceDiagramPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(),
@@ -221,14 +221,14 @@ void ScatterPlotMatrixProcessor::process() {
         auto iCol = dataframe->getIndexColumn();
         auto &indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto brushedIndicies = brushing_.getFilteredIndices();
+        const auto &brushedIndicies = brushing_.getFiltered();
         indicies = std::make_unique<IndexBuffer>();
         auto &vec = indicies->getEditableRAMRepresentation()->getDataContainer();
-        vec.reserve(dfSize - brushedIndicies.size());
+        vec.reserve(dfSize - std::min(dfSize, brushedIndicies.cardinality()));
 
         auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
         std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
-                     [&](const auto &id) { return !brushing_.isFiltered(indexCol[id]); });
+                     [&](const auto &id) { return !brushedIndicies.contains(indexCol[id]); });
     }
 
     utilgl::activateAndClearTarget(outport_);
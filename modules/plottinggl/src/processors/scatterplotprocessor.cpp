@@ -78,13 +78,14 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     selectionChangedCallBack_ =
         scatterPlot_.addSelectionChangedCallback([this](const std::vector<bool>& selected) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> selectedIndices;
+                std::vector<std::uint32_t> selectedIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < selected.size(); ++i) {
-                    if (selected[i]) selectedIndices.insert(indexCol[i]);
+                    if (selected[i]) selectedIndices.push_back(indexCol[i]);
                 }
-                brushingPort_.sendSelectionEvent(selectedIndices);
+                brushingPort_.sendSelectionEvent(
+                    BitSet(selectedIndices.begin(), selectedIndices.end()));
             } else {
                 invalidate(InvalidationLevel::InvalidOutput);
             }
@@ -92,13 +93,14 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     filteringChangedCallBack_ =
         scatterPlot_.addFilteringChangedCallback([this](const std::vector<bool>& filtered) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> filteredIndices;
+                std::vector<std::uint32_t> filteredIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < filtered.size(); ++i) {
-                    if (filtered[i]) filteredIndices.insert(indexCol[i]);
+                    if (filtered[i]) filteredIndices.push_back(indexCol[i]);
                 }
-                brushingPort_.sendFilterEvent(filteredIndices);
+                brushingPort_.sendFilterEvent(
+                    BitSet(filteredIndices.begin(), filteredIndices.end()));
             } else {
                 invalidate(InvalidationLevel::InvalidOutput);
             }
@@ -138,23 +140,29 @@ void ScatterPlotProcessor::process() {
     auto dataframe = dataFramePort_.getData();
 
     if (brushingPort_.isConnected()) {
-        if (brushingPort_.isChanged()) {
-            scatterPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
-        }
-
         auto dfSize = dataframe->getNumberOfRows();
 
         auto iCol = dataframe->getIndexColumn();
         auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto brushedIndicies = brushingPort_.getFilteredIndices();
+        if (brushingPort_.isChanged()) {
+            // Dense mask over the rows of the dataframe, the selection refers to row ids
+            const auto& selectedIndices = brushingPort_.getSelected();
+            std::vector<bool> selected(dfSize, false);
+            for (size_t i = 0; i < dfSize; ++i) {
+                selected[i] = selectedIndices.contains(indexCol[i]);
+            }
+            scatterPlot_.setSelected(selected);
+        }
+
+        const auto& brushedIndicies = brushingPort_.getFiltered();
         IndexBuffer indicies;
         auto& vec = indicies.getEditableRAMRepresentation()->getDataContainer();
-        vec.reserve(dfSize - brushedIndicies.size());
+        vec.reserve(dfSize - std::min(dfSize, brushedIndicies.cardinality()));
 
         auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
         std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
-                     [&](const auto& id) { return !brushingPort_.isFiltered(indexCol[id]); });
+                     [&](const auto& id) { return !brushedIndicies.contains(indexCol[id]); });
 
         if (backgroundPort_.hasData()) {
             scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), &indicies,
@@ -258,12 +258,14 @@ void TFEditorView::updateHistogram() {
             } else if (!histCalculation_) {
                 histograms_.clear();
                 histCalculation_ = volume->calculateHistograms(2048);
-                histCalculation_->whenDone([this](const HistogramContainer& histograms) {
+                // Show the intermediate histograms while they are being refined
+                histCalculation_->whenUpdated([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
                     resetCachedContent();
                     update();
-                    histCalculation_.reset();
                 });
+                histCalculation_->whenDone(
+                    [this](const HistogramContainer&) { histCalculation_.reset(); });
             }
         } else {
             histograms_.clear();
@@ -0,0 +1,426 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/interpolation.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+
+#include <array>
+#include <bitset>
+#include <iterator>
+#include <unordered_map>
+
+namespace inviwo {
+
+/**
+ * \class BatchedStreamLineTracer
+ * \brief Traces 3D stream lines for packets of up to Width seed points in lock step
+ *
+ * Gives the same lines as StreamLine3DTracer, but all lines of a packet are advanced together, one
+ * integration stage at a time, such that each stage samples the field in a tight loop over the
+ * lanes of the packet. Lanes are masked out as their lines terminate. If the sampler is a
+ * VolumeDoubleSampler<3> of a floating point volume with three or four components, the voxels are
+ * interpolated directly instead of through the virtual SpatialSampler interface.
+ * Only the fixed step schemes, Euler and RK4, are supported.
+ */
+template <size_t Width>
+class BatchedStreamLineTracer {
+public:
+    static_assert(Width > 0, "A packet needs at least one lane");
+
+    using Sampler = SpatialSampler<3, 3, double>;
+    using Result = StreamLine3DTracer::Result;
+    static constexpr size_t PacketWidth = Width;
+
+    BatchedStreamLineTracer(std::shared_ptr<const Sampler> sampler,
+                            const IntegralLineProperties &properties);
+
+    void addMetaDataSampler(const std::string &name, std::shared_ptr<const Sampler> sampler);
+
+    /**
+     * Trace one line for each seed point in [first, last), at most Width seed points.
+     * The results are in the same order as the seed points.
+     */
+    template <typename Iter>
+    std::vector<Result> tracePacket(Iter first, Iter last) const;
+
+private:
+    struct SamplerField {
+        dvec3 sample(const dvec3 &pos) const { return sampler.sample(pos); }
+        bool withinBounds(const dvec3 &pos) const { return sampler.withinBounds(pos); }
+
+        const Sampler &sampler;
+    };
+
+    template <typename T>
+    struct VolumeField {
+        dvec3 toDataSpace(const dvec3 &pos) const;
+        static bool inside(const dvec3 &pos);
+        dvec3 voxel(const size3_t &pos) const;
+        dvec3 sample(const dvec3 &pos) const;
+        bool withinBounds(const dvec3 &pos) const { return inside(toDataSpace(pos)); }
+
+        const T *data;
+        size3_t dims;
+        const dmat4 &toData;
+        bool transform;
+    };
+
+    struct Packet {
+        size_t size{0};
+        std::bitset<Width> active;
+        std::array<dvec3, Width> seed;
+        std::array<dvec3, Width> pos;
+        std::array<size_t, Width> remaining;
+        std::array<bool, Width> forward;
+        std::array<std::vector<dvec3> *, Width> velocity;
+        std::array<std::vector<std::vector<dvec3> *>, Width> meta;
+        std::vector<Result> results;
+    };
+
+    template <typename Field>
+    void trace(Packet &packet, const Field &field) const;
+
+    void endPhase(Packet &packet, size_t lane, IntegralLine::TerminationReason reason) const;
+    void bind(Packet &packet, size_t lane) const;
+    void addPoint(Packet &packet, size_t lane, const dvec3 &pos, const dvec3 &velocity) const;
+
+    IntegralLineProperties::IntegrationScheme integrationScheme_;
+
+    int steps_;
+    double stepSize_;
+    IntegralLineProperties::Direction dir_;
+    bool normalizeSamples_;
+    size_t stepsBWD_;
+    size_t stepsFWD_;
+
+    std::shared_ptr<const Sampler> sampler_;
+    std::unordered_map<std::string, std::shared_ptr<const Sampler>> metaSamplers_;
+
+    dmat3 invBasis_;
+    dmat4 seedTransformation_;
+
+    const VolumeRAM *ram_;  // Set if the voxels can be sampled directly
+    dmat4 toData_;
+    bool transform_;
+};
+
+template <size_t Width>
+BatchedStreamLineTracer<Width>::BatchedStreamLineTracer(std::shared_ptr<const Sampler> sampler,
+                                                        const IntegralLineProperties &properties)
+    : integrationScheme_(properties.getIntegrationScheme())
+    , steps_(properties.getNumberOfSteps())
+    , stepSize_(properties.getStepSize())
+    , dir_(properties.getStepDirection())
+    , normalizeSamples_(properties.getNormalizeSamples())
+    , sampler_(sampler)
+    , invBasis_(glm::inverse(dmat3(sampler->getModelMatrix())))
+    , seedTransformation_(
+          properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer()))
+    , ram_(nullptr)
+    , toData_(1.0)
+    , transform_(sampler->getSpace() != CoordinateSpace::Data) {
+
+    if (IntegralLineProperties::isAdaptive(integrationScheme_)) {
+        throw Exception("Adaptive integration schemes can not be traced in packets", IVW_CONTEXT);
+    }
+
+    switch (dir_) {
+        case IntegralLineProperties::Direction::FWD:
+            stepsBWD_ = 1;
+            stepsFWD_ = steps_ + 1;
+            break;
+        case IntegralLineProperties::Direction::BWD:
+            stepsBWD_ = steps_ + 1;
+            stepsFWD_ = 1;
+            break;
+        default:
+        case IntegralLineProperties::Direction::BOTH:
+            stepsBWD_ = steps_ / 2 + 1;
+            stepsFWD_ = steps_ - (steps_ / 2) + 1;
+            break;
+    }
+
+    const auto volumeSampler = dynamic_cast<const VolumeDoubleSampler<3> *>(sampler_.get());
+    const auto ram = volumeSampler ? volumeSampler->getVolumeRAM() : nullptr;
+    if (ram && ram->getDataFormat()->getNumericType() == NumericType::Float &&
+        ram->getDataFormat()->getComponents() >= 3) {
+        ram_ = ram;
+        if (transform_) {
+            toData_ = dmat4{sampler->getCoordinateTransformer().getMatrix(sampler->getSpace(),
+                                                                          CoordinateSpace::Data)};
+        }
+    }
+}
+
+template <size_t Width>
+void BatchedStreamLineTracer<Width>::addMetaDataSampler(const std::string &name,
+                                                        std::shared_ptr<const Sampler> sampler) {
+    metaSamplers_[name] = sampler;
+}
+
+template <size_t Width>
+template <typename Iter>
+auto BatchedStreamLineTracer<Width>::tracePacket(Iter first, Iter last) const
+    -> std::vector<Result> {
+    Packet packet;
+    packet.size = static_cast<size_t>(std::distance(first, last));
+    if (packet.size > Width) {
+        throw Exception("Packet of " + toString(packet.size) + " seed points exceeds the width " +
+                            toString(Width),
+                        IVW_CONTEXT);
+    }
+    packet.results.resize(packet.size);
+    for (size_t lane = 0; first != last; ++first, ++lane) {
+        const dvec4 p = seedTransformation_ * dvec4(dvec3(*first), 1.0);
+        packet.seed[lane] = dvec3(p) / p[3];
+    }
+
+    if (ram_) {
+        ram_->dispatch<void, dispatching::filter::Floats>([&](auto vrprecision) {
+            using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+            if constexpr (util::extent<ValueType>::value >= 3) {
+                trace(packet, VolumeField<ValueType>{vrprecision->getDataTyped(),
+                                                     vrprecision->getDimensions(), toData_,
+                                                     transform_});
+            } else {
+                trace(packet, SamplerField{*sampler_});
+            }
+        });
+    } else {
+        trace(packet, SamplerField{*sampler_});
+    }
+    return std::move(packet.results);
+}
+
+template <size_t Width>
+template <typename Field>
+void BatchedStreamLineTracer<Width>::trace(Packet &packet, const Field &field) const {
+    using TR = IntegralLine::TerminationReason;
+    constexpr double epsilon = std::numeric_limits<double>::epsilon();
+
+    for (size_t lane = 0; lane < packet.size; ++lane) {
+        auto &line = packet.results[lane].line;
+        if (dir_ == IntegralLineProperties::Direction::FWD) {
+            line.setBackwardTerminationReason(TR::StartPoint);
+        } else if (dir_ == IntegralLineProperties::Direction::BWD) {
+            line.setForwardTerminationReason(TR::StartPoint);
+        }
+        line.getPositions().reserve(steps_ + 2);
+        line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
+        for (auto &m : metaSamplers_) {
+            line.getMetaData<dvec3>(m.first, true).reserve(steps_ + 2);
+        }
+        bind(packet, lane);
+
+        const auto velocity = field.sample(packet.seed[lane]);
+        if (glm::length(velocity) < epsilon) continue;  // Zero velocity at seed point
+        addPoint(packet, lane, packet.seed[lane], velocity);
+
+        packet.active.set(lane);
+        packet.pos[lane] = packet.seed[lane];
+        packet.forward[lane] = false;
+        packet.remaining[lane] = stepsBWD_;
+        if (stepsBWD_ == 0) endPhase(packet, lane, TR::StartPoint);
+    }
+
+    const auto normalize = [](const dvec3 &v) {
+        const auto l = glm::length(v);
+        if (l == 0) return v;
+        return v / l;
+    };
+    const auto move = [&](const dvec3 &pos, dvec3 v, const double stepSize) {
+        if (normalizeSamples_) v = normalize(v);
+        return pos + invBasis_ * (v * stepSize);
+    };
+
+    std::bitset<Width> stepping;
+    std::array<double, Width> h;
+    std::array<dvec3, Width> k1, k2, k3, k4, next;
+
+    while (packet.active.any()) {
+        stepping.reset();
+        for (size_t lane = 0; lane < packet.size; ++lane) {
+            while (packet.active[lane]) {
+                if (packet.remaining[lane] == 0) {
+                    endPhase(packet, lane, TR::Steps);
+                } else if (!field.withinBounds(packet.pos[lane])) {
+                    endPhase(packet, lane, TR::OutOfBounds);
+                } else {
+                    stepping.set(lane);
+                    h[lane] = stepSize_ * (packet.forward[lane] ? 1.0 : -1.0);
+                    break;
+                }
+            }
+        }
+
+        // Each integration stage is evaluated for all lanes of the packet before the next one
+        for (size_t lane = 0; lane < packet.size; ++lane) {
+            if (stepping[lane]) k1[lane] = field.sample(packet.pos[lane]);
+        }
+        if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::Euler) {
+            for (size_t lane = 0; lane < packet.size; ++lane) {
+                if (stepping[lane]) next[lane] = move(packet.pos[lane], k1[lane], h[lane]);
+            }
+        } else {
+            for (size_t lane = 0; lane < packet.size; ++lane) {
+                if (!stepping[lane]) continue;
+                k2[lane] = field.sample(move(packet.pos[lane], k1[lane], h[lane] / 2));
+            }
+            for (size_t lane = 0; lane < packet.size; ++lane) {
+                if (!stepping[lane]) continue;
+                k3[lane] = field.sample(move(packet.pos[lane], k2[lane], h[lane] / 2));
+            }
+            for (size_t lane = 0; lane < packet.size; ++lane) {
+                if (!stepping[lane]) continue;
+                k4[lane] = field.sample(move(packet.pos[lane], k3[lane], h[lane]));
+            }
+            for (size_t lane = 0; lane < packet.size; ++lane) {
+                if (!stepping[lane]) continue;
+                const auto K = normalizeSamples_
+                                   ? normalize(k1[lane] + k2[lane] + k2[lane] + k3[lane] +
+                                               k3[lane] + k4[lane])
+                                   : (k1[lane] + k2[lane] + k2[lane] + k3[lane] + k3[lane] +
+                                      k4[lane]) *
+                                         (1.0 / 6.0);
+                next[lane] = move(packet.pos[lane], K, h[lane]);
+            }
+        }
+
+        for (size_t lane = 0; lane < packet.size; ++lane) {
+            if (!stepping[lane]) continue;
+            packet.pos[lane] = next[lane];
+            --packet.remaining[lane];
+            if (glm::length(k1[lane]) < epsilon) {
+                endPhase(packet, lane, TR::ZeroVelocity);
+            } else {
+                addPoint(packet, lane, next[lane], k1[lane]);
+            }
+        }
+    }
+}
+
+template <size_t Width>
+void BatchedStreamLineTracer<Width>::endPhase(Packet &packet, size_t lane,
+                                              IntegralLine::TerminationReason reason) const {
+    auto &res = packet.results[lane];
+    if (packet.forward[lane]) {
+        res.line.setForwardTerminationReason(reason);
+        packet.active.reset(lane);
+        return;
+    }
+
+    res.line.setBackwardTerminationReason(reason);
+    if (res.line.getPositions().size() > 1) {
+        res.line.reverse();
+        res.seedIndex = res.line.getPositions().size() - 1;
+        bind(packet, lane);
+    }
+
+    packet.forward[lane] = true;
+    packet.pos[lane] = packet.seed[lane];
+    packet.remaining[lane] = stepsFWD_;
+    if (stepsFWD_ == 0) endPhase(packet, lane, IntegralLine::TerminationReason::StartPoint);
+}
+
+template <size_t Width>
+void BatchedStreamLineTracer<Width>::bind(Packet &packet, size_t lane) const {
+    auto &line = packet.results[lane].line;
+    packet.velocity[lane] = &line.getMetaData<dvec3>("velocity");
+    packet.meta[lane].clear();
+    for (auto &m : metaSamplers_) {
+        packet.meta[lane].push_back(&line.getMetaData<dvec3>(m.first));
+    }
+}
+
+template <size_t Width>
+void BatchedStreamLineTracer<Width>::addPoint(Packet &packet, size_t lane, const dvec3 &pos,
+                                              const dvec3 &velocity) const {
+    packet.results[lane].line.getPositions().emplace_back(pos);
+    packet.velocity[lane]->emplace_back(velocity);
+    auto meta = packet.meta[lane].begin();
+    for (auto &m : metaSamplers_) {
+        (*meta++)->emplace_back(util::glm_convert<dvec3>(m.second->sample(pos)));
+    }
+}
+
+template <size_t Width>
+template <typename T>
+dvec3 BatchedStreamLineTracer<Width>::VolumeField<T>::toDataSpace(const dvec3 &pos) const {
+    if (!transform) return pos;
+    const auto p = toData * dvec4(pos, 1.0);
+    return dvec3(p) / p[3];
+}
+
+template <size_t Width>
+template <typename T>
+bool BatchedStreamLineTracer<Width>::VolumeField<T>::inside(const dvec3 &pos) {
+    return !(glm::any(glm::lessThan(pos, dvec3(0.0))) ||
+             glm::any(glm::greaterThan(pos, dvec3(1.0))));
+}
+
+template <size_t Width>
+template <typename T>
+dvec3 BatchedStreamLineTracer<Width>::VolumeField<T>::voxel(const size3_t &pos) const {
+    const auto p = glm::clamp(pos, size3_t(0), dims - size3_t(1));
+    return util::glm_convert<dvec3>(data[VolumeRAM::posToIndex(p, dims)]);
+}
+
+template <size_t Width>
+template <typename T>
+dvec3 BatchedStreamLineTracer<Width>::VolumeField<T>::sample(const dvec3 &pos) const {
+    const auto p = toDataSpace(pos);
+    if (!inside(p)) return dvec3(0.0);
+
+    const dvec3 samplePos = p * dvec3(dims - size3_t(1));
+    const size3_t indexPos = size3_t(samplePos);
+    const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+    dvec3 samples[8];
+    samples[0] = voxel(indexPos);
+    samples[1] = voxel(indexPos + size3_t(1, 0, 0));
+    samples[2] = voxel(indexPos + size3_t(0, 1, 0));
+    samples[3] = voxel(indexPos + size3_t(1, 1, 0));
+
+    samples[4] = voxel(indexPos + size3_t(0, 0, 1));
+    samples[5] = voxel(indexPos + size3_t(1, 0, 1));
+    samples[6] = voxel(indexPos + size3_t(0, 1, 1));
+    samples[7] = voxel(indexPos + size3_t(1, 1, 1));
+
+    return Interpolation<dvec3>::trilinear(samples, interpolants);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,252 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/exception.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class IntegralLineArena;
+
+/**
+ * \brief A non-owning view of a single line in an IntegralLineArena
+ *
+ * Offers the read only part of the IntegralLine interface. Positions and meta data are returned
+ * as ranges into the contiguous arrays of the arena. The view is only valid as long as the arena
+ * is alive and not modified.
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineView {
+public:
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    IntegralLineView(const IntegralLineArena &arena, size_t line);
+
+    util::iter_range<const dvec3 *> getPositions() const;
+    /**
+     * Number of points in the line
+     */
+    size_t size() const;
+
+    template <typename T>
+    util::iter_range<const T *> getMetaData(const std::string &name) const;
+
+    /**
+     * Calls callable with a util::iter_range<const T*> over the meta data of this line, where T
+     * is the type of the meta data channel.
+     */
+    template <typename Callable>
+    void dispatchMetaData(const std::string &name, Callable &&callable) const;
+
+    bool hasMetaData(const std::string &name) const;
+    std::vector<std::string> getMetaDataKeys() const;
+
+    double getLength() const;
+
+    size_t getIndex() const;
+    TerminationReason getBackwardTerminationReason() const;
+    TerminationReason getForwardTerminationReason() const;
+
+    /**
+     * Copy the line into a standalone IntegralLine
+     */
+    IntegralLine toIntegralLine() const;
+
+private:
+    const IntegralLineArena *arena_;
+    size_t line_;
+};
+
+/**
+ * \brief Contiguous storage for a set of integral lines
+ *
+ * Stores the positions of all lines in one buffer, and each meta data channel in one buffer, using
+ * a compressed sparse row layout: the points of line i are found at [offsets[i], offsets[i + 1]) in
+ * all buffers. Compared to a vector of IntegralLine this avoids one allocation per line and meta
+ * data channel, and the buffers can be handed to a Mesh without copying, see toMesh().
+ *
+ * All lines need to have the same set of meta data channels, with one value per point.
+ * The buffers are copied on write: the arena clones a buffer before modifying it if the buffer is
+ * also used elsewhere, for example by a mesh created by toMesh() or through getPositionBuffer().
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineArena {
+public:
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    IntegralLineArena();
+    IntegralLineArena(const IntegralLineArena &rhs);
+    IntegralLineArena(IntegralLineArena &&rhs) = default;
+    IntegralLineArena &operator=(const IntegralLineArena &that);
+    IntegralLineArena &operator=(IntegralLineArena &&that) = default;
+    ~IntegralLineArena() = default;
+
+    /**
+     * Number of lines
+     */
+    size_t size() const;
+    bool empty() const;
+    size_t getNumberOfPoints() const;
+
+    void reserve(size_t lines, size_t points);
+    void clear();
+
+    /**
+     * Append a copy of line using index as line index. The first line decides the meta data
+     * channels, throws an Exception if a later line has different channels or if the size of any
+     * meta data does not match the number of positions.
+     */
+    void push_back(const IntegralLine &line, size_t index);
+    void push_back(const IntegralLine &line);
+
+    IntegralLineView operator[](size_t line) const;
+    IntegralLineView at(size_t line) const;
+
+    /**
+     * Offsets into the position and meta data buffers, size() + 1 values.
+     */
+    const std::vector<size_t> &getOffsets() const;
+
+    std::shared_ptr<const Buffer<dvec3>> getPositionBuffer() const;
+    const std::vector<dvec3> &getPositions() const;
+
+    bool hasMetaData(const std::string &name) const;
+    std::vector<std::string> getMetaDataKeys() const;
+    std::shared_ptr<const BufferBase> getMetaDataBuffer(const std::string &name) const;
+
+    template <typename T>
+    const std::vector<T> &getMetaData(const std::string &name) const;
+
+    size_t getIndex(size_t line) const;
+    TerminationReason getBackwardTerminationReason(size_t line) const;
+    TerminationReason getForwardTerminationReason(size_t line) const;
+
+    /**
+     * Create a mesh of lines that shares the position and meta data buffers of the arena, no
+     * vertex data is copied. The positions are added as a dvec3 PositionAttrib and the meta data
+     * channels, in the order of getMetaDataKeys(), as ScalarMetaAttrib at locations following
+     * BufferType::NumberOfBufferTypes. Only the index buffers are created: for
+     * ConnectivityType::None one index buffer with a pair of indices per line segment, otherwise
+     * one index buffer per line, with at least two points, with the given connectivity.
+     * Later modifications of the arena do not affect the mesh, the arena copies the shared
+     * buffers before modifying them. The mesh buffers should not be modified.
+     */
+    std::shared_ptr<Mesh> toMesh(const mat4 &modelMatrix, const mat4 &worldMatrix,
+                                 ConnectivityType connectivity = ConnectivityType::None) const;
+
+private:
+    /**
+     * Clone the buffers that are shared with others, before modifying them
+     */
+    void detach();
+
+    std::shared_ptr<Buffer<dvec3>> positions_;
+    std::map<std::string, std::shared_ptr<BufferBase>> metaData_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> indices_;
+    std::vector<TerminationReason> backwardTerminationReasons_;
+    std::vector<TerminationReason> forwardTerminationReasons_;
+};
+
+template <typename T>
+const std::vector<T> &IntegralLineArena::getMetaData(const std::string &name) const {
+    auto buffer = getMetaDataBuffer(name);
+    auto askedDF = DataFormat<T>::get();
+    auto isDF = buffer->getDataFormat();
+    if (isDF != askedDF) {
+        throw Exception("Incorrect dataformat for meta data " + name + " asking for " +
+                            askedDF->getString() + " but is " + isDF->getString(),
+                        IVW_CONTEXT);
+    }
+    return static_cast<const Buffer<T> *>(buffer.get())->getRAMRepresentation()->getDataContainer();
+}
+
+inline IntegralLineView::IntegralLineView(const IntegralLineArena &arena, size_t line)
+    : arena_(&arena), line_(line) {}
+
+inline util::iter_range<const dvec3 *> IntegralLineView::getPositions() const {
+    const auto &offsets = arena_->getOffsets();
+    const auto data = arena_->getPositions().data();
+    return util::as_range(data + offsets[line_], data + offsets[line_ + 1]);
+}
+
+inline size_t IntegralLineView::size() const {
+    const auto &offsets = arena_->getOffsets();
+    return offsets[line_ + 1] - offsets[line_];
+}
+
+template <typename T>
+util::iter_range<const T *> IntegralLineView::getMetaData(const std::string &name) const {
+    const auto &offsets = arena_->getOffsets();
+    const auto data = arena_->getMetaData<T>(name).data();
+    return util::as_range(data + offsets[line_], data + offsets[line_ + 1]);
+}
+
+template <typename Callable>
+void IntegralLineView::dispatchMetaData(const std::string &name, Callable &&callable) const {
+    const auto &offsets = arena_->getOffsets();
+    arena_->getMetaDataBuffer(name)->getRepresentation<BufferRAM>()->dispatch<void>(
+        [&](auto brprecision) {
+            const auto data = brprecision->getDataContainer().data();
+            callable(util::as_range(data + offsets[line_], data + offsets[line_ + 1]));
+        });
+}
+
+inline bool IntegralLineView::hasMetaData(const std::string &name) const {
+    return arena_->hasMetaData(name);
+}
+
+inline std::vector<std::string> IntegralLineView::getMetaDataKeys() const {
+    return arena_->getMetaDataKeys();
+}
+
+inline size_t IntegralLineView::getIndex() const { return arena_->getIndex(line_); }
+
+inline IntegralLineView::TerminationReason IntegralLineView::getBackwardTerminationReason() const {
+    return arena_->getBackwardTerminationReason(line_);
+}
+
+inline IntegralLineView::TerminationReason IntegralLineView::getForwardTerminationReason() const {
+    return arena_->getForwardTerminationReason(line_);
+}
+
+}  // namespace inviwo
@@ -32,25 +32,38 @@
 
 #include <inviwo/core/common/inviwo.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallinearena.h>
 #include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/datastructures/datatraits.h>
 
+#include <mutex>
+
 namespace inviwo {
 
 /**
  * \class IntegralLineSet
- * \brief VERY_BRIEFLY_DESCRIBE_THE_CLASS
- * DESCRIBE_THE_CLASS
+ * \brief A set of integral lines together with the model and world matrices of the lines
+ *
+ * The lines are either stored as a vector of IntegralLine, Storage::Lines, or packed into the
+ * contiguous arrays of an IntegralLineArena, Storage::Packed. Algorithms that handle a large
+ * number of lines should check getArena() and work on the packed data directly.
+ * The IntegralLine based interface works for both storages. For a packed set the const
+ * accessors unpack a copy of the lines on first use, while the non-const accessors convert the
+ * set to Storage::Lines.
  */
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineSet {
 public:
     enum class SetIndex { Yes, No };
+    enum class Storage { Lines, Packed };
 
     using value_type = IntegralLine;
-    IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix = mat4(1));
+    IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix = mat4(1),
+                    Storage storage = Storage::Lines);
+    IntegralLineSet(const IntegralLineSet& rhs);
+    IntegralLineSet& operator=(const IntegralLineSet& that);
     virtual ~IntegralLineSet();
 
     mat4 getModelMatrix() const;
@@ -62,11 +75,11 @@ public:
     std::vector<IntegralLine>::iterator begin();
     std::vector<IntegralLine>::iterator end();
 
-    const IntegralLine& back() const { return lines_.back(); }
-    IntegralLine& back() { return lines_.back(); }
+    const IntegralLine& back() const { return getVector().back(); }
+    IntegralLine& back() { return getVector().back(); }
 
-    const IntegralLine& front() const { return lines_.front(); }
-    IntegralLine& front() { return lines_.front(); }
+    const IntegralLine& front() const { return getVector().front(); }
+    IntegralLine& front() { return getVector().front(); }
 
     size_t size() const;
 
@@ -82,11 +95,32 @@ public:
     void push_back(IntegralLine&& line, SetIndex updateIndex);
     void push_back(IntegralLine&& line, size_t idx);
 
-    std::vector<IntegralLine>& getVector() { return lines_; }
-    const std::vector<IntegralLine>& getVector() const { return lines_; }
+    std::vector<IntegralLine>& getVector();
+    const std::vector<IntegralLine>& getVector() const;
+
+    Storage getStorage() const;
+    /**
+     * Move all lines into an IntegralLineArena, see Storage::Packed
+     */
+    void pack();
+    /**
+     * Move all lines out of the arena into a vector of IntegralLine, see Storage::Lines
+     */
+    void unpack();
+    /**
+     * The packed lines, or nullptr if the storage is Storage::Lines
+     */
+    const IntegralLineArena* getArena() const;
 
 private:
-    std::vector<IntegralLine> lines_;
+    const std::vector<IntegralLine>& lines() const;
+
+    Storage storage_;
+    IntegralLineArena arena_;
+    // For Storage::Packed, holds the lines unpacked by the const accessors
+    mutable std::vector<IntegralLine> lines_;
+    mutable bool unpacked_ = false;
+    mutable std::mutex mutex_;
     mat4 modelMatrix_;
     mat4 worldMatrix_;
 };
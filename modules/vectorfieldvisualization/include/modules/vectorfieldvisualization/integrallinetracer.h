@@ -38,10 +38,59 @@
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 
+#include <array>
+#include <cmath>
 #include <unordered_map>
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Butcher tableau of an embedded explicit Runge-Kutta scheme with Stages stages. The solution is
+ * advanced with the weights b, and e holds the difference between b and the weights of the
+ * embedded lower order solution, used to estimate the local error.
+ */
+template <size_t Stages>
+struct EmbeddedTableau {
+    std::array<double, Stages> c;
+    std::array<std::array<double, Stages>, Stages> a;
+    std::array<double, Stages> b;
+    std::array<double, Stages> e;
+    int order;  // Order of the embedded solution, controls the step size adaption
+};
+
+// Dormand-Prince RK5(4)7M, the last stage is evaluated at the new point (first same as last)
+constexpr EmbeddedTableau<7> dormandPrince{
+    {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0},
+    {{{},
+      {1.0 / 5.0},
+      {3.0 / 40.0, 9.0 / 40.0},
+      {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+      {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+      {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+      {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}}},
+    {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0},
+    {71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0,
+     -1.0 / 40.0},
+    4};
+
+// Cash-Karp RK5(4), advanced with the fifth order solution
+constexpr EmbeddedTableau<6> cashKarp{
+    {0.0, 1.0 / 5.0, 3.0 / 10.0, 3.0 / 5.0, 1.0, 7.0 / 8.0},
+    {{{},
+      {1.0 / 5.0},
+      {3.0 / 40.0, 9.0 / 40.0},
+      {3.0 / 10.0, -9.0 / 10.0, 6.0 / 5.0},
+      {-11.0 / 54.0, 5.0 / 2.0, -70.0 / 27.0, 35.0 / 27.0},
+      {1631.0 / 55296.0, 175.0 / 512.0, 575.0 / 13824.0, 44275.0 / 110592.0, 253.0 / 4096.0}}},
+    {37.0 / 378.0, 0.0, 250.0 / 621.0, 125.0 / 594.0, 0.0, 512.0 / 1771.0},
+    {37.0 / 378.0 - 2825.0 / 27648.0, 0.0, 250.0 / 621.0 - 18575.0 / 48384.0,
+     125.0 / 594.0 - 13525.0 / 55296.0, -277.0 / 14336.0, 512.0 / 1771.0 - 1.0 / 4.0},
+    4};
+
+}  // namespace detail
+
 /**
  * \class IntegralLineTracer
  * \brief VERY_BRIEFLY_DESCRIBE_THE_CLASS
@@ -56,6 +105,8 @@ public:
     struct Result {
         IntegralLine line;
         size_t seedIndex{0};
+        size_t acceptedSteps{0};  // Only counted by the adaptive integration schemes
+        size_t rejectedSteps{0};  // Only counted by the adaptive integration schemes
         operator IntegralLine() const { return line; }
     };
 
@@ -88,9 +139,16 @@ private:
     bool addPoint(IntegralLine &line, const SpatialVector &pos);
     bool addPoint(IntegralLine &line, const SpatialVector &pos, const DataVector &worldVelocity);
 
-    IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine &line,
+    IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, Result &res,
                                               bool fwd);
 
+    SpatialVector derivative(const SpatialVector &pos) const;
+
+    template <size_t Stages>
+    IntegralLine::TerminationReason integrateAdaptive(const detail::EmbeddedTableau<Stages> &tab,
+                                                      size_t steps, SpatialVector pos,
+                                                      Result &res, bool fwd);
+
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
     int steps_;
@@ -98,6 +156,12 @@ private:
     IntegralLineProperties::Direction dir_;
     bool normalizeSamples_;
 
+    double relativeTolerance_;
+    double absoluteTolerance_;
+    double minStepSize_;
+    double maxStepSize_;
+    bool denseOutput_;
+
     std::shared_ptr<const Sampler> sampler_;
     std::unordered_map<std::string, std::shared_ptr<const Sampler>> metaSamplers_;
 
@@ -113,6 +177,11 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::IntegralLineTracer(
     , stepSize_(properties.getStepSize())
     , dir_(properties.getStepDirection())
     , normalizeSamples_(properties.getNormalizeSamples())
+    , relativeTolerance_(properties.getRelativeTolerance())
+    , absoluteTolerance_(properties.getAbsoluteTolerance())
+    , minStepSize_(properties.getMinStepSize())
+    , maxStepSize_(std::max(properties.getMaxStepSize(), properties.getMinStepSize()))
+    , denseOutput_(properties.getDenseOutput())
     , sampler_(sampler)
     , invBasis_(glm::inverse(DataMatrix(sampler->getModelMatrix())))
     , seedTransformation_(
@@ -156,14 +225,14 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
         return res;  // Zero velocity at seed point
     }
 
-    line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
+    line.setBackwardTerminationReason(integrate(stepsBWD, p, res, false));
 
     if (line.getPositions().size() > 1) {
         line.reverse();
         res.seedIndex = line.getPositions().size() - 1;
     }
 
-    line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
+    line.setForwardTerminationReason(integrate(stepsFWD, p, res, true));
     return res;
 }
 
@@ -271,8 +340,19 @@ bool IntegralLineTracer<SpatialSampler, TimeDependent>::addPoint(IntegralLine &l
 
 template <typename SpatialSampler, bool TimeDependent>
 IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(
-    size_t steps, SpatialVector pos, IntegralLine &line, bool fwd) {
+    size_t steps, SpatialVector pos, Result &res, bool fwd) {
     if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
+
+    switch (integrationScheme_) {
+        case IntegralLineProperties::IntegrationScheme::DormandPrince:
+            return integrateAdaptive(detail::dormandPrince, steps, pos, res, fwd);
+        case IntegralLineProperties::IntegrationScheme::CashKarp:
+            return integrateAdaptive(detail::cashKarp, steps, pos, res, fwd);
+        default:
+            break;
+    }
+
+    auto &line = res.line;
     for (size_t i = 0; i < steps; i++) {
         if (!sampler_->withinBounds(pos)) {
             return IntegralLine::TerminationReason::OutOfBounds;
@@ -287,6 +367,136 @@ IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent
     return IntegralLine::TerminationReason::Steps;
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector
+IntegralLineTracer<SpatialSampler, TimeDependent>::derivative(const SpatialVector &pos) const {
+    auto v = sampler_->sample(pos);
+    if (normalizeSamples_) {
+        const auto l = glm::length(v);
+        if (l != 0) v /= l;
+    }
+    if constexpr (TimeDependent) {
+        return SpatialVector(invBasis_ * v, 1.0);
+    } else {
+        return invBasis_ * v;
+    }
+}
+
+/*
+ * Integrates with an embedded Runge-Kutta scheme. A step is accepted if the estimated local error,
+ * relative to the tolerances, is at most one, and the next step size is adapted from the error.
+ * Steps at the minimum step size are always accepted, and a non-finite error, from NaN or infinite
+ * samples, ends the line as out of bounds. The sample at the end of a step is reused as the first
+ * stage of the next one. With dense output the points are placed at a fixed spacing of stepSize_
+ * by cubic Hermite interpolation within the accepted steps, and `steps` limits the number of
+ * points, otherwise each accepted step adds one point.
+ */
+template <typename SpatialSampler, bool TimeDependent>
+template <size_t Stages>
+IntegralLine::TerminationReason
+IntegralLineTracer<SpatialSampler, TimeDependent>::integrateAdaptive(
+    const detail::EmbeddedTableau<Stages> &tab, size_t steps, SpatialVector pos, Result &res,
+    bool fwd) {
+    constexpr size_t N = SpatialSampler::DataDimensions;  // Error is measured in space only
+    const double sign = fwd ? 1.0 : -1.0;
+    const double exponent = -1.0 / (tab.order + 1);
+    // For first same as last schemes the last stage is the sample at the new point
+    const bool fsal = tab.c[Stages - 1] == 1.0 && tab.a[Stages - 1] == tab.b;
+    const auto isFinite = [](const SpatialVector &v) {
+        for (size_t i = 0; i < N; ++i) {
+            if (!std::isfinite(v[i])) return false;
+        }
+        return true;
+    };
+
+    auto &line = res.line;
+    double h = glm::clamp(stepSize_, minStepSize_, maxStepSize_);
+    double untilOutput = stepSize_;  // Parameter distance left to the next dense output point
+    size_t added = 0;
+
+    std::array<SpatialVector, Stages> k;
+    SpatialVector start = derivative(pos);
+    for (;;) {
+        if (!sampler_->withinBounds(pos)) {
+            return IntegralLine::TerminationReason::OutOfBounds;
+        }
+
+        // Try steps until one is accepted
+        SpatialVector next;
+        SpatialVector end;
+        for (;;) {
+            const double hs = h * sign;
+            k[0] = start;
+            for (size_t s = 1; s < Stages; ++s) {
+                SpatialVector y = pos;
+                for (size_t j = 0; j < s; ++j) {
+                    if (tab.a[s][j] != 0.0) y += k[j] * (hs * tab.a[s][j]);
+                }
+                k[s] = derivative(y);
+            }
+            next = pos;
+            SpatialVector err{0.0};
+            for (size_t s = 0; s < Stages; ++s) {
+                if (tab.b[s] != 0.0) next += k[s] * (hs * tab.b[s]);
+                if (tab.e[s] != 0.0) err += k[s] * (hs * tab.e[s]);
+            }
+
+            double errNorm = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                const double scale =
+                    absoluteTolerance_ +
+                    relativeTolerance_ * std::max(std::abs(pos[i]), std::abs(next[i]));
+                // Keep a NaN error, std::max would drop it
+                const double e = std::abs(err[i]) / scale;
+                errNorm = std::isnan(e) ? e : std::max(errNorm, e);
+            }
+            // A NaN or infinite sample never gives an acceptable step, stop the line like the
+            // fixed step schemes do when the position can no longer be sampled
+            if (!std::isfinite(errNorm) || !std::isfinite(h)) {
+                return IntegralLine::TerminationReason::OutOfBounds;
+            }
+
+            const double factor =
+                errNorm == 0.0 ? 5.0 : glm::clamp(0.9 * std::pow(errNorm, exponent), 0.2, 5.0);
+            const bool atMin = h <= minStepSize_;
+            const double used = h;
+            h = glm::clamp(h * factor, minStepSize_, maxStepSize_);
+            if (errNorm <= 1.0 || atMin) {
+                ++res.acceptedSteps;
+                end = fsal ? k[Stages - 1] : derivative(next);
+                if (!isFinite(end)) return IntegralLine::TerminationReason::OutOfBounds;
+                if (denseOutput_) {
+                    // Hermite interpolation between pos and next over the parameter range used
+                    while (untilOutput <= used) {
+                        const double t = untilOutput / used;
+                        const double hs = used * sign;
+                        const auto p = pos * ((1 + 2 * t) * (1 - t) * (1 - t)) +
+                                       start * (hs * t * (1 - t) * (1 - t)) +
+                                       next * (t * t * (3 - 2 * t)) + end * (hs * t * t * (t - 1));
+                        if (!addPoint(line, p)) {
+                            return IntegralLine::TerminationReason::ZeroVelocity;
+                        }
+                        if (++added == steps) return IntegralLine::TerminationReason::Steps;
+                        untilOutput += stepSize_;
+                    }
+                    untilOutput -= used;
+                }
+                break;
+            }
+            ++res.rejectedSteps;
+        }
+
+        pos = next;
+        start = end;
+        if (!denseOutput_) {
+            if (!addPoint(line, pos)) {
+                return IntegralLine::TerminationReason::ZeroVelocity;
+            }
+            if (++added == steps) return IntegralLine::TerminationReason::Steps;
+        }
+    }
+}
+
 using StreamLine2DTracer = IntegralLineTracer<SpatialSampler<2, 2, double>>;
 using StreamLine3DTracer = IntegralLineTracer<SpatialSampler<3, 3, double>>;
 using PathLine3DTracer = IntegralLineTracer<Spatial4DSampler<3, double>>;
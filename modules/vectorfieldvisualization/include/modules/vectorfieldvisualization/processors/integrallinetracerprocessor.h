@@ -43,6 +43,7 @@
 #include <inviwo/core/util/foreach.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/batchedintegrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
 namespace inviwo {
@@ -65,6 +66,7 @@ private:
     IntegralLineSetOutport lines_;
 
     IntegralLineProperties properties_;
+    BoolProperty packedStorage_;
 
     CompositeProperty metaData_;
     BoolProperty calculateCurvature_;
@@ -78,6 +80,7 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
     , annotationSamplers_("annotationSamplers")
     , lines_("lines")
     , properties_("properties", "Properties")
+    , packedStorage_("packedStorage", "Packed Storage", false)
 
     , metaData_("metaData", "Meta Data")
     , calculateCurvature_("calculateCurvature", "Calculate Curvature", false)
@@ -88,6 +91,7 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
     addPort(lines_);
 
     addProperty(properties_);
+    addProperty(packedStorage_);
     addProperty(metaData_);
     metaData_.addProperty(calculateCurvature_);
     metaData_.addProperty(calculateTortuosity_);
@@ -104,36 +108,87 @@ IntegralLineTracerProcessor<Tracer>::~IntegralLineTracerProcessor() {}
 template <typename Tracer>
 void IntegralLineTracerProcessor<Tracer>::process() {
     auto sampler = sampler_.getData();
-    auto lines =
-        std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
-
-    Tracer tracer(sampler, properties_);
-
-    for (auto meta : annotationSamplers_.getSourceVectorData()) {
-        auto key = meta.first->getProcessor()->getIdentifier();
-        key = util::stripIdentifier(key);
-        tracer.addMetaDataSampler(key, meta.second);
-    }
+    auto lines = std::make_shared<IntegralLineSet>(
+        sampler->getModelMatrix(), sampler->getWorldMatrix(),
+        packedStorage_ ? IntegralLineSet::Storage::Packed : IntegralLineSet::Storage::Lines);
+
+    auto addMetaDataSamplers = [&](auto &tracer) {
+        for (auto meta : annotationSamplers_.getSourceVectorData()) {
+            auto key = meta.first->getProcessor()->getIdentifier();
+            key = util::stripIdentifier(key);
+            tracer.addMetaDataSampler(key, meta.second);
+        }
+    };
+
+    // Meta data is calculated per line in the worker threads, before the line is added to the
+    // set, such that packed lines never have to be unpacked.
+    const bool calculateCurvature = calculateCurvature_.get();
+    const bool calculateTortuosity = calculateTortuosity_.get();
+    const dmat4 toWorld{lines->getModelMatrix()};
 
     std::mutex mutex;
-    size_t startID = 0;
-    for (const auto &seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
+    size_t acceptedSteps = 0;
+    size_t rejectedSteps = 0;
+    auto addLine = [&](typename Tracer::Result &&res, size_t id) {
+        auto &line = res.line;
+        if (line.getPositions().size() > 1) {
+            if (calculateCurvature) util::curvature(line, toWorld);
+            if (calculateTortuosity) util::tortuosity(line, toWorld);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        acceptedSteps += res.acceptedSteps;
+        rejectedSteps += res.rejectedSteps;
+        if (line.getPositions().size() > 1) {
+            lines->push_back(std::move(line), id);
+        }
+    };
+
+    auto traceEach = [&]() {
+        Tracer tracer(sampler, properties_);
+        addMetaDataSamplers(tracer);
+
+        size_t startID = 0;
+        for (const auto &seeds : seeds_) {
+            util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
+                addLine(tracer.traceFrom(p), startID + i);
+            });
+            startID += seeds->size();
+        }
+    };
+
+    if constexpr (std::is_same_v<Tracer, StreamLine3DTracer>) {
+        if (IntegralLineProperties::isAdaptive(properties_.getIntegrationScheme())) {
+            traceEach();
+        } else {
+            // Stream lines are traced in packets of seed points, each packet in one job
+            using PacketTracer = BatchedStreamLineTracer<8>;
+            PacketTracer tracer(sampler, properties_);
+            addMetaDataSamplers(tracer);
+
+            size_t startID = 0;
+            for (const auto &seeds : seeds_) {
+                std::vector<size_t> packets;
+                for (size_t i = 0; i < seeds->size(); i += PacketTracer::PacketWidth) {
+                    packets.push_back(i);
+                }
+                util::forEachParallel(packets, [&](size_t first) {
+                    const auto last = std::min(first + PacketTracer::PacketWidth, seeds->size());
+                    auto results =
+                        tracer.tracePacket(seeds->begin() + first, seeds->begin() + last);
+                    for (size_t i = 0; i < results.size(); ++i) {
+                        addLine(std::move(results[i]), startID + first + i);
+                    }
+                });
+                startID += seeds->size();
             }
-        });
-        startID += seeds->size();
+        }
+    } else {
+        traceEach();
     }
 
-    if (calculateCurvature_) {
-        util::curvature(*lines);
-    }
-    if (calculateTortuosity_) {
-        util::tortuosity(*lines);
+    if (IntegralLineProperties::isAdaptive(properties_.getIntegrationScheme())) {
+        LogProcessorInfo("Adaptive integration: " << acceptedSteps << " accepted and "
+                                                  << rejectedSteps << " rejected steps");
     }
 
     lines_.setData(lines);
@@ -43,7 +43,14 @@ namespace inviwo {
 
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineProperties : public CompositeProperty {
 public:
-    enum class IntegrationScheme { Euler, RK4 };
+    /**
+     * Euler and RK4 take fixed steps of getStepSize(). DormandPrince (RK45) and CashKarp are
+     * embedded Runge-Kutta schemes that adapt the step size to keep the estimated local error
+     * below the tolerances, starting from getStepSize().
+     */
+    enum class IntegrationScheme { Euler, RK4, DormandPrince, CashKarp };
+
+    static bool isAdaptive(IntegrationScheme scheme);
 
     enum class Direction { FWD = 1, BWD = 2, BOTH = 3 };
 
@@ -64,6 +71,17 @@ public:
     CoordinateSpace getSeedPointsSpace() const;
     bool getNormalizeSamples() const;
 
+    double getRelativeTolerance() const;
+    double getAbsoluteTolerance() const;
+    double getMinStepSize() const;
+    double getMaxStepSize() const;
+    /**
+     * If true, adaptive schemes output points at a fixed spacing of getStepSize() by interpolating
+     * within the accepted steps, and the number of steps limits the number of output points.
+     * Otherwise each accepted step gives one point.
+     */
+    bool getDenseOutput() const;
+
 private:
     void setUpProperties();
 
@@ -75,6 +93,13 @@ public:
     TemplateOptionProperty<IntegralLineProperties::Direction> stepDirection_;
     TemplateOptionProperty<IntegralLineProperties::IntegrationScheme> integrationScheme_;
     TemplateOptionProperty<CoordinateSpace> seedPointsSpace_;
+
+    CompositeProperty adaptive_;
+    DoubleProperty relativeTolerance_;
+    DoubleProperty absoluteTolerance_;
+    DoubleProperty minStepSize_;
+    DoubleProperty maxStepSize_;
+    BoolProperty denseOutput_;
 };
 
 template <unsigned int N>
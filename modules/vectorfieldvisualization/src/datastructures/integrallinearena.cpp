@@ -0,0 +1,273 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/vectorfieldvisualization/datastructures/integrallinearena.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+IntegralLine IntegralLineView::toIntegralLine() const {
+    IntegralLine line;
+    const auto positions = getPositions();
+    line.getPositions().assign(positions.begin(), positions.end());
+    for (const auto &key : getMetaDataKeys()) {
+        dispatchMetaData(key, [&](auto range) {
+            using T = typename decltype(range)::value_type;
+            line.getMetaData<T>(key, true).assign(range.begin(), range.end());
+        });
+    }
+    line.setIndex(getIndex());
+    // The termination reason getters of IntegralLine return the opposite member, set them
+    // swapped to make the getters of the copy match the ones of the view.
+    line.setBackwardTerminationReason(getForwardTerminationReason());
+    line.setForwardTerminationReason(getBackwardTerminationReason());
+    return line;
+}
+
+double IntegralLineView::getLength() const {
+    double length = 0.0;
+    const auto positions = getPositions();
+    if (positions.begin() == positions.end()) return length;
+    for (auto prev = positions.begin(), next = prev + 1; next != positions.end(); ++prev, ++next) {
+        length += glm::distance(*prev, *next);
+    }
+    return length;
+}
+
+IntegralLineArena::IntegralLineArena()
+    : positions_{std::make_shared<Buffer<dvec3>>()}, metaData_{}, offsets_{0} {}
+
+IntegralLineArena::IntegralLineArena(const IntegralLineArena &rhs)
+    : positions_{std::shared_ptr<Buffer<dvec3>>(rhs.positions_->clone())}
+    , metaData_{}
+    , offsets_{rhs.offsets_}
+    , indices_{rhs.indices_}
+    , backwardTerminationReasons_{rhs.backwardTerminationReasons_}
+    , forwardTerminationReasons_{rhs.forwardTerminationReasons_} {
+    for (const auto &item : rhs.metaData_) {
+        metaData_[item.first] = std::shared_ptr<BufferBase>(item.second->clone());
+    }
+}
+
+IntegralLineArena &IntegralLineArena::operator=(const IntegralLineArena &that) {
+    if (this != &that) {
+        IntegralLineArena copy(that);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+size_t IntegralLineArena::size() const { return offsets_.size() - 1; }
+
+bool IntegralLineArena::empty() const { return size() == 0; }
+
+size_t IntegralLineArena::getNumberOfPoints() const { return offsets_.back(); }
+
+void IntegralLineArena::detach() {
+    if (positions_.use_count() > 1) {
+        positions_ = std::shared_ptr<Buffer<dvec3>>(positions_->clone());
+    }
+    for (auto &item : metaData_) {
+        if (item.second.use_count() > 1) {
+            item.second = std::shared_ptr<BufferBase>(item.second->clone());
+        }
+    }
+}
+
+void IntegralLineArena::reserve(size_t lines, size_t points) {
+    detach();
+    offsets_.reserve(lines + 1);
+    indices_.reserve(lines);
+    backwardTerminationReasons_.reserve(lines);
+    forwardTerminationReasons_.reserve(lines);
+    positions_->getEditableRAMRepresentation()->getDataContainer().reserve(points);
+}
+
+void IntegralLineArena::clear() {
+    positions_ = std::make_shared<Buffer<dvec3>>();
+    metaData_.clear();
+    offsets_.assign(1, 0);
+    indices_.clear();
+    backwardTerminationReasons_.clear();
+    forwardTerminationReasons_.clear();
+}
+
+void IntegralLineArena::push_back(const IntegralLine &line) { push_back(line, line.getIndex()); }
+
+void IntegralLineArena::push_back(const IntegralLine &line, size_t index) {
+    const auto &positions = line.getPositions();
+    const auto &lineMetaData = line.getMetaDataBuffers();
+
+    if (empty()) {
+        metaData_.clear();
+        for (const auto &item : lineMetaData) {
+            metaData_[item.first] =
+                item.second->getRepresentation<BufferRAM>()->dispatch<std::shared_ptr<BufferBase>>(
+                    [](auto brprecision) -> std::shared_ptr<BufferBase> {
+                        using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+                        return std::make_shared<Buffer<ValueType>>();
+                    });
+        }
+    }
+
+    // Validate everything before modifying anything, to keep the arena consistent on errors.
+    if (lineMetaData.size() != metaData_.size()) {
+        throw Exception("All lines in an IntegralLineArena need the same meta data", IVW_CONTEXT);
+    }
+    for (const auto &item : lineMetaData) {
+        auto it = metaData_.find(item.first);
+        if (it == metaData_.end()) {
+            throw Exception("Unexpected meta data: " + item.first, IVW_CONTEXT);
+        }
+        if (it->second->getDataFormat() != item.second->getDataFormat()) {
+            throw Exception("Incorrect dataformat for meta data " + item.first, IVW_CONTEXT);
+        }
+        if (item.second->getSize() != positions.size()) {
+            throw Exception("Size of meta data " + item.first +
+                                " does not match the number of positions",
+                            IVW_CONTEXT);
+        }
+    }
+
+    detach();
+    auto &allPositions = positions_->getEditableRAMRepresentation()->getDataContainer();
+    allPositions.insert(allPositions.end(), positions.begin(), positions.end());
+
+    for (const auto &item : lineMetaData) {
+        auto &target = metaData_[item.first];
+        item.second->getRepresentation<BufferRAM>()->dispatch<void>([&](auto brprecision) {
+            using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+            const auto &src = brprecision->getDataContainer();
+            auto &dst = static_cast<Buffer<ValueType> *>(target.get())
+                            ->getEditableRAMRepresentation()
+                            ->getDataContainer();
+            dst.insert(dst.end(), src.begin(), src.end());
+        });
+    }
+
+    offsets_.push_back(allPositions.size());
+    indices_.push_back(index);
+    backwardTerminationReasons_.push_back(line.getBackwardTerminationReason());
+    forwardTerminationReasons_.push_back(line.getForwardTerminationReason());
+}
+
+IntegralLineView IntegralLineArena::operator[](size_t line) const {
+    return IntegralLineView(*this, line);
+}
+
+IntegralLineView IntegralLineArena::at(size_t line) const {
+    if (line >= size()) {
+        throw RangeException("Line index out of range: " + std::to_string(line), IVW_CONTEXT);
+    }
+    return IntegralLineView(*this, line);
+}
+
+const std::vector<size_t> &IntegralLineArena::getOffsets() const { return offsets_; }
+
+std::shared_ptr<const Buffer<dvec3>> IntegralLineArena::getPositionBuffer() const {
+    return positions_;
+}
+
+const std::vector<dvec3> &IntegralLineArena::getPositions() const {
+    return positions_->getRAMRepresentation()->getDataContainer();
+}
+
+bool IntegralLineArena::hasMetaData(const std::string &name) const {
+    return metaData_.find(name) != metaData_.end();
+}
+
+std::vector<std::string> IntegralLineArena::getMetaDataKeys() const {
+    return util::transform(metaData_, [](const auto &item) { return item.first; });
+}
+
+std::shared_ptr<const BufferBase> IntegralLineArena::getMetaDataBuffer(
+    const std::string &name) const {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        throw Exception("No meta data with name: " + name, IVW_CONTEXT);
+    }
+    return it->second;
+}
+
+size_t IntegralLineArena::getIndex(size_t line) const { return indices_[line]; }
+
+IntegralLineArena::TerminationReason IntegralLineArena::getBackwardTerminationReason(
+    size_t line) const {
+    return backwardTerminationReasons_[line];
+}
+
+IntegralLineArena::TerminationReason IntegralLineArena::getForwardTerminationReason(
+    size_t line) const {
+    return forwardTerminationReasons_[line];
+}
+
+std::shared_ptr<Mesh> IntegralLineArena::toMesh(const mat4 &modelMatrix,
+                                                const mat4 &worldMatrix,
+                                                ConnectivityType connectivity) const {
+    if (getNumberOfPoints() > std::numeric_limits<std::uint32_t>::max()) {
+        throw Exception("Too many points for a mesh index buffer", IVW_CONTEXT);
+    }
+
+    auto mesh = std::make_shared<Mesh>(DrawType::Lines, connectivity);
+    mesh->setModelMatrix(modelMatrix);
+    mesh->setWorldMatrix(worldMatrix);
+
+    mesh->addBuffer(BufferType::PositionAttrib, positions_);
+    int location = static_cast<int>(BufferType::NumberOfBufferTypes);
+    for (const auto &item : metaData_) {
+        mesh->addBuffer(Mesh::BufferInfo(BufferType::ScalarMetaAttrib, location++), item.second);
+    }
+
+    if (connectivity == ConnectivityType::None) {
+        auto indices = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
+        auto &container = indices->getDataContainer();
+        container.reserve(2 * (getNumberOfPoints() - std::min(getNumberOfPoints(), size())));
+        for (size_t line = 0; line < size(); ++line) {
+            for (auto i = offsets_[line] + 1; i < offsets_[line + 1]; ++i) {
+                container.push_back(static_cast<std::uint32_t>(i - 1));
+                container.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    } else {
+        for (size_t line = 0; line < size(); ++line) {
+            if (offsets_[line + 1] - offsets_[line] < 2) continue;
+            auto indices = mesh->addIndexBuffer(DrawType::Lines, connectivity);
+            auto &container = indices->getDataContainer();
+            container.resize(offsets_[line + 1] - offsets_[line]);
+            std::iota(container.begin(), container.end(),
+                      static_cast<std::uint32_t>(offsets_[line]));
+        }
+    }
+    return mesh;
+}
+
+}  // namespace inviwo
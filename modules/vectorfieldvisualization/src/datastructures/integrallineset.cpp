@@ -31,56 +31,153 @@
 
 namespace inviwo {
 
-IntegralLineSet::IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix)
-    : lines_(), modelMatrix_(modelMatrix), worldMatrix_(worldMatrix) {}
+IntegralLineSet::IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix, Storage storage)
+    : storage_(storage), arena_(), lines_(), modelMatrix_(modelMatrix), worldMatrix_(worldMatrix) {}
+
+IntegralLineSet::IntegralLineSet(const IntegralLineSet& rhs)
+    : storage_(rhs.storage_)
+    , arena_(rhs.arena_)
+    , lines_(rhs.storage_ == Storage::Lines ? rhs.lines_ : std::vector<IntegralLine>{})
+    , modelMatrix_(rhs.modelMatrix_)
+    , worldMatrix_(rhs.worldMatrix_) {}
+
+IntegralLineSet& IntegralLineSet::operator=(const IntegralLineSet& that) {
+    if (this != &that) {
+        storage_ = that.storage_;
+        arena_ = that.arena_;
+        lines_ = that.storage_ == Storage::Lines ? that.lines_ : std::vector<IntegralLine>{};
+        unpacked_ = false;
+        modelMatrix_ = that.modelMatrix_;
+        worldMatrix_ = that.worldMatrix_;
+    }
+    return *this;
+}
 
 IntegralLineSet::~IntegralLineSet() {}
 
 mat4 IntegralLineSet::getModelMatrix() const { return modelMatrix_; }
 mat4 IntegralLineSet::getWorldMatrix() const { return worldMatrix_; }
 
-std::vector<IntegralLine>::const_iterator IntegralLineSet::begin() const { return lines_.begin(); }
+std::vector<IntegralLine>::const_iterator IntegralLineSet::begin() const {
+    return lines().begin();
+}
 
-std::vector<IntegralLine>::iterator IntegralLineSet::begin() { return lines_.begin(); }
+std::vector<IntegralLine>::iterator IntegralLineSet::begin() { return getVector().begin(); }
 
-std::vector<IntegralLine>::const_iterator IntegralLineSet::end() const { return lines_.end(); }
+std::vector<IntegralLine>::const_iterator IntegralLineSet::end() const { return lines().end(); }
 
-std::vector<IntegralLine>::iterator IntegralLineSet::end() { return lines_.end(); }
+std::vector<IntegralLine>::iterator IntegralLineSet::end() { return getVector().end(); }
 
-size_t IntegralLineSet::size() const { return lines_.size(); }
+size_t IntegralLineSet::size() const {
+    return storage_ == Storage::Packed ? arena_.size() : lines_.size();
+}
 
-IntegralLine& IntegralLineSet::operator[](size_t idx) { return lines_[idx]; }
+IntegralLine& IntegralLineSet::operator[](size_t idx) { return getVector()[idx]; }
 
-const IntegralLine& IntegralLineSet::operator[](size_t idx) const { return lines_[idx]; }
+const IntegralLine& IntegralLineSet::operator[](size_t idx) const { return lines()[idx]; }
 
-IntegralLine& IntegralLineSet::at(size_t idx) { return lines_.at(idx); }
+IntegralLine& IntegralLineSet::at(size_t idx) { return getVector().at(idx); }
 
-const IntegralLine& IntegralLineSet::at(size_t idx) const { return lines_.at(idx); }
+const IntegralLine& IntegralLineSet::at(size_t idx) const { return lines().at(idx); }
 
 void IntegralLineSet::push_back(const IntegralLine& line, SetIndex updateIndex) {
     if (updateIndex == SetIndex::No) {
-        lines_.push_back(line);
+        if (storage_ == Storage::Packed) {
+            arena_.push_back(line);
+            lines_.clear();
+            unpacked_ = false;
+        } else {
+            lines_.push_back(line);
+        }
     } else {
-        push_back(line, lines_.size());
+        push_back(line, size());
     }
 }
 
 void IntegralLineSet::push_back(const IntegralLine& line, size_t idx) {
-    IntegralLine copy(line);
-    copy.setIndex(idx);
-    lines_.push_back(std::move(copy));
+    if (storage_ == Storage::Packed) {
+        arena_.push_back(line, idx);
+        lines_.clear();
+        unpacked_ = false;
+    } else {
+        IntegralLine copy(line);
+        copy.setIndex(idx);
+        lines_.push_back(std::move(copy));
+    }
 }
 
 void IntegralLineSet::push_back(IntegralLine&& line, SetIndex updateIndex) {
     if (updateIndex == SetIndex::Yes) {
-        line.setIndex(lines_.size());
+        line.setIndex(size());
+    }
+    if (storage_ == Storage::Packed) {
+        push_back(line, line.getIndex());
+    } else {
+        lines_.push_back(line);
     }
-    lines_.push_back(line);
 }
 
 void IntegralLineSet::push_back(IntegralLine&& line, size_t idx) {
     line.setIndex(idx);
-    lines_.push_back(line);
+    if (storage_ == Storage::Packed) {
+        push_back(line, idx);
+    } else {
+        lines_.push_back(line);
+    }
+}
+
+std::vector<IntegralLine>& IntegralLineSet::getVector() {
+    unpack();
+    return lines_;
+}
+
+const std::vector<IntegralLine>& IntegralLineSet::getVector() const { return lines(); }
+
+IntegralLineSet::Storage IntegralLineSet::getStorage() const { return storage_; }
+
+void IntegralLineSet::pack() {
+    if (storage_ == Storage::Packed) return;
+
+    size_t points = 0;
+    for (const auto& line : lines_) points += line.getPositions().size();
+
+    // Pack into a new arena first, lines_ are kept intact if a line does not fit.
+    IntegralLineArena arena;
+    arena.reserve(lines_.size(), points);
+    for (const auto& line : lines_) arena.push_back(line);
+
+    arena_ = std::move(arena);
+    lines_ = std::vector<IntegralLine>{};
+    unpacked_ = false;
+    storage_ = Storage::Packed;
+}
+
+void IntegralLineSet::unpack() {
+    if (storage_ == Storage::Lines) return;
+
+    lines();
+    arena_.clear();
+    unpacked_ = false;
+    storage_ = Storage::Lines;
+}
+
+const IntegralLineArena* IntegralLineSet::getArena() const {
+    return storage_ == Storage::Packed ? &arena_ : nullptr;
+}
+
+const std::vector<IntegralLine>& IntegralLineSet::lines() const {
+    if (storage_ == Storage::Lines) return lines_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!unpacked_) {
+        lines_.clear();
+        lines_.reserve(arena_.size());
+        for (size_t i = 0; i < arena_.size(); ++i) {
+            lines_.push_back(arena_[i].toIntegralLine());
+        }
+        unpacked_ = true;
+    }
+    return lines_;
 }
 
 }  // namespace inviwo
@@ -49,6 +49,36 @@ template <
 static double norm(const glm::vec<L, T, Q> &glm) {
     return glm::length(util::glm_convert<glm::vec<L, F, Q>>(glm));
 }
+
+static size_t pointCount(const IntegralLine &line) { return line.getPositions().size(); }
+static size_t pointCount(const IntegralLineView &line) { return line.size(); }
+
+/**
+ * Calls callable with each line and its position in the set. Packed sets are visited using
+ * IntegralLineView:s, to avoid unpacking them.
+ */
+template <typename Callable>
+static void forEachLine(const IntegralLineSet &lines, Callable &&callable) {
+    if (auto arena = lines.getArena()) {
+        for (size_t i = 0; i < arena->size(); ++i) callable((*arena)[i], i);
+    } else {
+        size_t i = 0;
+        for (const auto &line : lines) callable(line, i++);
+    }
+}
+
+template <typename Callable>
+static void dispatchMetaData(const IntegralLine &line, const std::string &key,
+                             Callable &&callable) {
+    line.getMetaDataBuffer(key)->getRepresentation<BufferRAM>()->dispatch<void>(
+        [&](auto mdBuf) { callable(mdBuf->getDataContainer()); });
+}
+
+template <typename Callable>
+static void dispatchMetaData(const IntegralLineView &line, const std::string &key,
+                             Callable &&callable) {
+    line.dispatchMetaData(key, std::forward<Callable>(callable));
+}
 }  // namespace detail
 
 const std::string IntegralLineVectorToMesh::ColorByProperty::classIdentifier =
@@ -130,10 +160,10 @@ const ProcessorInfo IntegralLineVectorToMesh::processorInfo_{
     Tags::CPU,                              // Tags
 };
 
-bool IntegralLineVectorToMesh::isFiltered(const IntegralLine &line, size_t idx) const {
+bool IntegralLineVectorToMesh::isFiltered(size_t lineIndex, size_t idx) const {
     switch (brushBy_.get()) {
         case BrushBy::LineIndex:
-            return brushingList_.isFiltered(line.getIndex());
+            return brushingList_.isFiltered(lineIndex);
         case BrushBy::VectorPosition:
             return brushingList_.isFiltered(idx);
         case BrushBy::Nothing:
@@ -142,10 +172,10 @@ bool IntegralLineVectorToMesh::isFiltered(const IntegralLine &line, size_t idx)
     }
 }
 
-bool IntegralLineVectorToMesh::isSelected(const IntegralLine &line, size_t idx) const {
+bool IntegralLineVectorToMesh::isSelected(size_t lineIndex, size_t idx) const {
     switch (brushBy_.get()) {
         case BrushBy::LineIndex:
-            return brushingList_.isSelected(line.getIndex());
+            return brushingList_.isSelected(lineIndex);
         case BrushBy::VectorPosition:
             return brushingList_.isSelected(idx);
         case BrushBy::Nothing:
@@ -160,7 +190,9 @@ void IntegralLineVectorToMesh::updateOptions() {
 
     std::vector<OptionPropertyStringOption> options = {{"constant", "constant color"}};
 
-    for (const auto &key : lines->front().getMetaDataKeys()) {
+    const auto keys = lines->getArena() ? lines->getArena()->getMetaDataKeys()
+                                        : lines->front().getMetaDataKeys();
+    for (const auto &key : keys) {
         options.emplace_back(key, key);
 
         if (!getPropertyByIdentifier(key)) {
@@ -243,26 +275,21 @@ IntegralLineVectorToMesh::IntegralLineVectorToMesh()
             double minT = std::numeric_limits<double>::max();
             double maxT = std::numeric_limits<double>::lowest();
 
-            size_t idx = 0;
-            for (auto &line : (*lines_.getData())) {
-                util::OnScopeExit incIdx([&idx]() { idx++; });
-                auto size = line.getPositions().size();
-                if (size == 0) continue;
+            detail::forEachLine(*lines_.getData(), [&](const auto &line, size_t idx) {
+                if (detail::pointCount(line) == 0) return;
 
-                if (this->isFiltered(line, idx)) {
-                    continue;
-                }
+                if (this->isFiltered(line.getIndex(), idx)) return;
 
                 if (!line.hasMetaData("timestamp")) {
                     minT = std::min(minT, 0.);
                     maxT = std::max(maxT, 1.);
                 } else {
-                    for (const auto &t : line.getMetaData<double>("timestamp")) {
+                    for (const auto &t : line.template getMetaData<double>("timestamp")) {
                         minT = std::min(minT, t);
                         maxT = std::max(t, maxT);
                     }
                 }
-            }
+            });
             NetworkLock lock(getNetwork());
             minMaxT_.setRangeMin(minT);
             minMaxT_.setRangeMax(maxT);
@@ -291,6 +318,21 @@ void IntegralLineVectorToMesh::process() {
     mesh->setModelMatrix(lines_.getData()->getModelMatrix());
     mesh->setWorldMatrix(lines_.getData()->getWorldMatrix());
 
+    // Packed lines in a constant color, without brushing or stride, need no per vertex
+    // processing. Share the buffers of the arena instead of copying every vertex.
+    if (auto arena = lines_.getData()->getArena();
+        arena && output_.get() == Output::Lines && colorBy_.get() == "constant" &&
+        brushBy_.get() == BrushBy::Nothing && stride_.get() == 1) {
+        auto lineMesh = arena->toMesh(lines_.getData()->getModelMatrix(),
+                                      lines_.getData()->getWorldMatrix(),
+                                      ConnectivityType::StripAdjacency);
+        lineMesh->addBuffer(BufferType::ColorAttrib,
+                            util::makeBuffer(std::vector<vec4>(arena->getNumberOfPoints(),
+                                                               selectedColor_.get())));
+        mesh_.setData(lineMesh);
+        return;
+    }
+
     std::vector<BasicMesh::Vertex> vertices;
 
     vertices.reserve(lines_.getData()->size() * 2000);
@@ -326,12 +368,10 @@ void IntegralLineVectorToMesh::process() {
 
     Output output = output_.get();
 
-    size_t lineIdx = 0;
-    for (auto &line : (*lines_.getData())) {
-        util::OnScopeExit incIdx([&lineIdx]() { lineIdx++; });
-        auto size = line.getPositions().size();
+    detail::forEachLine(*lines_.getData(), [&](const auto &line, size_t lineIdx) {
+        auto size = detail::pointCount(line);
 
-        if (size == 0 || isFiltered(line, lineIdx)) continue;
+        if (size == 0 || isFiltered(line.getIndex(), lineIdx)) return;
 
         auto indexBuffer = [&]() -> std::shared_ptr<IndexBufferRAM> {
             if (output == Output::Lines) {
@@ -347,7 +387,7 @@ void IntegralLineVectorToMesh::process() {
         }();
 
         auto coloring = [&, this](auto sample, size_t lineIndex, size_t lineNumber) -> vec4 {
-            if (constantColor || this->isSelected(line, lineIdx)) {
+            if (constantColor || this->isSelected(line.getIndex(), lineIdx)) {
                 return selectedColor_.get();
             }
 
@@ -384,14 +424,15 @@ void IntegralLineVectorToMesh::process() {
             }
         };
 
-        auto lineLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                            const IntegralLine &line, auto mdContainter) {
+        auto lineLoop = [&coloring, &vertices, &indexBuffer, &line, lineIdx, size,
+                         this](auto &&mdContainter) {
             size_t pointIdx = 0;
-            for (auto &&sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter)) {
+            for (auto &&sample :
+                 util::zip(line.getPositions(), line.template getMetaData<dvec3>("velocity"),
+                           mdContainter)) {
                 util::OnScopeExit incPointIdx([&pointIdx]() { pointIdx++; });
                 bool first = pointIdx <= 1;
-                bool last = pointIdx >= line.getPositions().size() - 2;
+                bool last = pointIdx >= size - 2;
                 // need to keep the two first and two last when using adjendency information
                 if (!first && !last && pointIdx % stride_.get() != 0) {
                     continue;
@@ -407,10 +448,11 @@ void IntegralLineVectorToMesh::process() {
             }
         };
 
-        auto ribbonLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                              const IntegralLine &line, auto mdContainter) {
-            for (auto &&sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter, line.getMetaData<dvec3>("vorticity"))) {
+        auto ribbonLoop = [&coloring, &vertices, &indexBuffer, &line, lineIdx,
+                           this](auto &&mdContainter) {
+            for (auto &&sample :
+                 util::zip(line.getPositions(), line.template getMetaData<dvec3>("velocity"),
+                           mdContainter, line.template getMetaData<dvec3>("vorticity"))) {
                 vec3 pos = get<0>(sample);
                 vec3 vel = get<1>(sample);
                 vec3 vor = get<3>(sample);
@@ -430,23 +472,21 @@ void IntegralLineVectorToMesh::process() {
         };
 
         if (mdProp) {
-            line.getMetaDataBuffer(metaDataKey)
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void>([&](auto mdBuf) {
-                    if (output == Output::Lines)
-                        lineLoop(line, mdBuf->getDataContainer());
-                    else {
-                        ribbonLoop(line, mdBuf->getDataContainer());
-                    }
-                });
+            detail::dispatchMetaData(line, metaDataKey, [&](auto &&mdContainer) {
+                if (output == Output::Lines)
+                    lineLoop(mdContainer);
+                else {
+                    ribbonLoop(mdContainer);
+                }
+            });
         } else {
             if (output == Output::Lines)
-                lineLoop(line, std::vector<int>(line.getPositions().size()));
+                lineLoop(std::vector<int>(size));
             else {
-                ribbonLoop(line, std::vector<int>(line.getPositions().size()));
+                ribbonLoop(std::vector<int>(size));
             }
         }
-    }
+    });
 
     mesh->addVertices(vertices);
 
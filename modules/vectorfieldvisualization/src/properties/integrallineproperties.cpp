@@ -38,7 +38,13 @@ IntegralLineProperties::IntegralLineProperties(std::string identifier, std::stri
     , normalizeSamples_("normalizeSamples", "Normalize Samples", true)
     , stepDirection_("stepDirection", "Step Direction")
     , integrationScheme_("integrationScheme", "Integration Scheme")
-    , seedPointsSpace_("seedPointsSpace", "Seed Points Space") {
+    , seedPointsSpace_("seedPointsSpace", "Seed Points Space")
+    , adaptive_("adaptive", "Adaptive Step Size")
+    , relativeTolerance_("relativeTolerance", "Relative Tolerance", 1e-6, 1e-12, 1e-1, 1e-7)
+    , absoluteTolerance_("absoluteTolerance", "Absolute Tolerance", 1e-8, 1e-14, 1e-1, 1e-9)
+    , minStepSize_("minStepSize", "Min Step Size", 1e-6, 1e-10, 1.0, 1e-6)
+    , maxStepSize_("maxStepSize", "Max Step Size", 0.1, 1e-6, 10.0, 1e-3)
+    , denseOutput_("denseOutput", "Dense Output", false) {
     setUpProperties();
 }
 
@@ -49,7 +55,13 @@ IntegralLineProperties::IntegralLineProperties(const IntegralLineProperties& rhs
     , normalizeSamples_(rhs.normalizeSamples_)
     , stepDirection_(rhs.stepDirection_)
     , integrationScheme_(rhs.integrationScheme_)
-    , seedPointsSpace_(rhs.seedPointsSpace_) {
+    , seedPointsSpace_(rhs.seedPointsSpace_)
+    , adaptive_(rhs.adaptive_)
+    , relativeTolerance_(rhs.relativeTolerance_)
+    , absoluteTolerance_(rhs.absoluteTolerance_)
+    , minStepSize_(rhs.minStepSize_)
+    , maxStepSize_(rhs.maxStepSize_)
+    , denseOutput_(rhs.denseOutput_) {
     setUpProperties();
 }
 
@@ -59,6 +71,10 @@ IntegralLineProperties* IntegralLineProperties::clone() const {
 
 IntegralLineProperties::~IntegralLineProperties() = default;
 
+bool IntegralLineProperties::isAdaptive(IntegrationScheme scheme) {
+    return scheme == IntegrationScheme::DormandPrince || scheme == IntegrationScheme::CashKarp;
+}
+
 int IntegralLineProperties::getNumberOfSteps() const { return numberOfSteps_.get(); }
 
 float IntegralLineProperties::getStepSize() const { return stepSize_.get(); }
@@ -77,6 +93,16 @@ CoordinateSpace IntegralLineProperties::getSeedPointsSpace() const {
 
 bool IntegralLineProperties::getNormalizeSamples() const { return normalizeSamples_; }
 
+double IntegralLineProperties::getRelativeTolerance() const { return relativeTolerance_.get(); }
+
+double IntegralLineProperties::getAbsoluteTolerance() const { return absoluteTolerance_.get(); }
+
+double IntegralLineProperties::getMinStepSize() const { return minStepSize_.get(); }
+
+double IntegralLineProperties::getMaxStepSize() const { return maxStepSize_.get(); }
+
+bool IntegralLineProperties::getDenseOutput() const { return denseOutput_.get(); }
+
 void IntegralLineProperties::setUpProperties() {
     stepDirection_.addOption("fwd", "Forward", IntegralLineProperties::Direction::FWD);
     stepDirection_.addOption("bwd", "Backwards", IntegralLineProperties::Direction::BWD);
@@ -86,6 +112,10 @@ void IntegralLineProperties::setUpProperties() {
                                  IntegralLineProperties::IntegrationScheme::Euler);
     integrationScheme_.addOption("rk4", "Runge-Kutta (RK4)",
                                  IntegralLineProperties::IntegrationScheme::RK4);
+    integrationScheme_.addOption("rk45", "Dormand-Prince (RK45)",
+                                 IntegralLineProperties::IntegrationScheme::DormandPrince);
+    integrationScheme_.addOption("cashkarp", "Cash-Karp",
+                                 IntegralLineProperties::IntegrationScheme::CashKarp);
     integrationScheme_.setSelectedValue(IntegralLineProperties::IntegrationScheme::RK4);
 
     seedPointsSpace_.addOption("data", "Data", CoordinateSpace::Data);
@@ -99,6 +129,15 @@ void IntegralLineProperties::setUpProperties() {
     addProperty(seedPointsSpace_);
     addProperty(normalizeSamples_);
 
+    adaptive_.addProperty(relativeTolerance_);
+    adaptive_.addProperty(absoluteTolerance_);
+    adaptive_.addProperty(minStepSize_);
+    adaptive_.addProperty(maxStepSize_);
+    adaptive_.addProperty(denseOutput_);
+    adaptive_.visibilityDependsOn(integrationScheme_,
+                                  [](const auto& p) { return isAdaptive(p.get()); });
+    addProperty(adaptive_);
+
     setAllPropertiesCurrentStateAsDefault();
 }
 
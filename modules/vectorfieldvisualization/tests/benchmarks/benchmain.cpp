@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/batchedintegrallinetracer.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+constexpr size_t fieldSize = 256;
+constexpr size_t seedCount = 100000;
+
+// A helix around the center of the volume, the lines stay inside for most of the steps
+static std::shared_ptr<const VolumeDoubleSampler<3>> makeSampler() {
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(size3_t(fieldSize));
+    auto data = ram->getDataTyped();
+    const auto dims = ram->getDimensions();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const vec3 p = vec3(x, y, z) / vec3(dims - size3_t(1)) - vec3(0.5f);
+                data[VolumeRAM::posToIndex(size3_t(x, y, z), dims)] = vec3(-p.y, p.x, 0.1f);
+            }
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    return std::make_shared<VolumeDoubleSampler<3>>(volume);
+}
+
+static const std::shared_ptr<const VolumeDoubleSampler<3>>& sampler() {
+    static const auto sampler = makeSampler();
+    return sampler;
+}
+
+static const std::vector<dvec3>& seeds() {
+    static const auto seeds = []() {
+        std::mt19937 rand(0);
+        std::uniform_real_distribution<double> dist(0.1, 0.9);
+        std::vector<dvec3> res(seedCount);
+        for (auto& s : res) s = dvec3(dist(rand), dist(rand), dist(rand));
+        return res;
+    }();
+    return seeds;
+}
+
+static IntegralLineProperties& properties() {
+    static IntegralLineProperties props = []() {
+        IntegralLineProperties p("properties", "Properties");
+        p.numberOfSteps_.set(100);
+        p.stepSize_.set(0.002f);
+        p.normalizeSamples_.set(true);
+        p.seedPointsSpace_.set(CoordinateSpace::Data);
+        p.integrationScheme_.set(IntegralLineProperties::IntegrationScheme::RK4);
+        p.stepDirection_.set(IntegralLineProperties::Direction::BOTH);
+        return p;
+    }();
+    return props;
+}
+
+// Every position of a line except the seed point is one integration step
+static size_t countSteps(const IntegralLine& line) {
+    const auto size = line.getPositions().size();
+    return size > 0 ? size - 1 : 0;
+}
+
+static void StreamLinesScalar(benchmark::State& state) {
+    StreamLine3DTracer tracer(sampler(), properties());
+    size_t steps = 0;
+    for (auto _ : state) {
+        for (const auto& seed : seeds()) {
+            auto res = tracer.traceFrom(seed);
+            steps += countSteps(res.line);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+    state.counters["Steps"] = benchmark::Counter(static_cast<double>(steps),
+                                                 benchmark::Counter::kIsRate);
+}
+
+template <size_t Width>
+static void StreamLinesBatched(benchmark::State& state) {
+    BatchedStreamLineTracer<Width> tracer(sampler(), properties());
+    const auto& points = seeds();
+    size_t steps = 0;
+    for (auto _ : state) {
+        for (size_t first = 0; first < points.size(); first += Width) {
+            const auto last = std::min(first + Width, points.size());
+            auto results = tracer.tracePacket(points.begin() + first, points.begin() + last);
+            for (const auto& res : results) steps += countSteps(res.line);
+            benchmark::DoNotOptimize(results);
+        }
+    }
+    state.counters["Steps"] = benchmark::Counter(static_cast<double>(steps),
+                                                 benchmark::Counter::kIsRate);
+}
+
+// Embedded schemes, the counters show how many steps were needed for the tolerance
+static void StreamLinesAdaptive(benchmark::State& state) {
+    IntegralLineProperties props(properties());
+    props.integrationScheme_.set(
+        static_cast<IntegralLineProperties::IntegrationScheme>(state.range(0)));
+    props.relativeTolerance_.set(1e-6);
+    props.absoluteTolerance_.set(1e-8);
+    StreamLine3DTracer tracer(sampler(), props);
+
+    size_t steps = 0;
+    size_t accepted = 0;
+    size_t rejected = 0;
+    for (auto _ : state) {
+        for (const auto& seed : seeds()) {
+            auto res = tracer.traceFrom(seed);
+            steps += countSteps(res.line);
+            accepted += res.acceptedSteps;
+            rejected += res.rejectedSteps;
+            benchmark::DoNotOptimize(res);
+        }
+    }
+    state.counters["Steps"] = benchmark::Counter(static_cast<double>(steps),
+                                                 benchmark::Counter::kIsRate);
+    state.counters["Accepted"] = benchmark::Counter(static_cast<double>(accepted),
+                                                    benchmark::Counter::kAvgIterations);
+    state.counters["Rejected"] = benchmark::Counter(static_cast<double>(rejected),
+                                                    benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(StreamLinesScalar)->Unit(benchmark::kMillisecond);
+BENCHMARK(StreamLinesAdaptive)
+    ->Arg(static_cast<int>(IntegralLineProperties::IntegrationScheme::DormandPrince))
+    ->Arg(static_cast<int>(IntegralLineProperties::IntegrationScheme::CashKarp))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(StreamLinesBatched, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(StreamLinesBatched, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(StreamLinesBatched, 16)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    auto logger = std::make_shared<ConsoleLogger>();
+    LogCentral::getPtr()->setVerbosity(LogVerbosity::Error);
+    LogCentral::getPtr()->registerLogger(logger);
+    InviwoApplication app(argc, argv, "Inviwo-Benchmarks-VectorFieldVisualization");
+
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
+
+#include <warn/pop>
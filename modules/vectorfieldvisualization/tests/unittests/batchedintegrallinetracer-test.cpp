@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/batchedintegrallinetracer.h>
+
+namespace inviwo {
+
+namespace {
+
+// A helix around the center of the volume, scaled to make use of integer formats
+template <typename T>
+std::shared_ptr<const VolumeDoubleSampler<3>> createHelix(double scale) {
+    const size3_t dims{24, 20, 16};
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const dvec3 p = dvec3(x, y, z) / dvec3(dims - size3_t(1)) - dvec3(0.5);
+                data[VolumeRAM::posToIndex(size3_t(x, y, z), dims)] =
+                    static_cast<T>(dvec3(-p.y, p.x, 0.1 + 0.2 * p.z) * scale);
+            }
+        }
+    }
+    return std::make_shared<VolumeDoubleSampler<3>>(std::make_shared<Volume>(ram));
+}
+
+const std::vector<dvec3> seeds{{0.5, 0.5, 0.5},  {0.2, 0.4, 0.1}, {0.7, 0.3, 0.8},
+                               {0.9, 0.9, 0.5},  {0.1, 0.8, 0.3}, {0.45, 0.6, 0.95},
+                               {1.5, 0.5, 0.5}};
+
+void expectSameLine(const IntegralLine& expected, const IntegralLine& line) {
+    EXPECT_EQ(expected.getBackwardTerminationReason(), line.getBackwardTerminationReason());
+    EXPECT_EQ(expected.getForwardTerminationReason(), line.getForwardTerminationReason());
+
+    ASSERT_EQ(expected.getPositions().size(), line.getPositions().size());
+    for (size_t i = 0; i < expected.getPositions().size(); ++i) {
+        EXPECT_NEAR(0.0, glm::distance(expected.getPositions()[i], line.getPositions()[i]), 1e-9)
+            << "position " << i;
+    }
+
+    ASSERT_EQ(expected.getMetaDataKeys(), line.getMetaDataKeys());
+    for (const auto& key : expected.getMetaDataKeys()) {
+        const auto& a = expected.getMetaData<dvec3>(key);
+        const auto& b = line.getMetaData<dvec3>(key);
+        ASSERT_EQ(a.size(), b.size()) << key;
+        for (size_t i = 0; i < a.size(); ++i) {
+            EXPECT_NEAR(0.0, glm::distance(a[i], b[i]), 1e-9) << key << " " << i;
+        }
+    }
+}
+
+void expectSameLines(std::shared_ptr<const VolumeDoubleSampler<3>> sampler) {
+    const auto meta = createHelix<vec3>(2.0);
+
+    for (auto scheme : {IntegralLineProperties::IntegrationScheme::Euler,
+                        IntegralLineProperties::IntegrationScheme::RK4}) {
+        for (auto dir : {IntegralLineProperties::Direction::FWD,
+                         IntegralLineProperties::Direction::BWD,
+                         IntegralLineProperties::Direction::BOTH}) {
+            IntegralLineProperties props("properties", "Properties");
+            props.numberOfSteps_.set(200);
+            props.stepSize_.set(0.01f);
+            props.normalizeSamples_.set(true);
+            props.seedPointsSpace_.set(CoordinateSpace::Data);
+            props.integrationScheme_.set(scheme);
+            props.stepDirection_.set(dir);
+
+            StreamLine3DTracer tracer(sampler, props);
+            tracer.addMetaDataSampler("meta", meta);
+            BatchedStreamLineTracer<4> batched(sampler, props);
+            batched.addMetaDataSampler("meta", meta);
+
+            // Two packets, the last one only partially filled
+            std::vector<StreamLine3DTracer::Result> results;
+            for (size_t first = 0; first < seeds.size(); first += 4) {
+                const auto last = std::min(first + 4, seeds.size());
+                auto packet = batched.tracePacket(seeds.begin() + first, seeds.begin() + last);
+                ASSERT_EQ(last - first, packet.size());
+                std::move(packet.begin(), packet.end(), std::back_inserter(results));
+            }
+
+            for (size_t i = 0; i < seeds.size(); ++i) {
+                SCOPED_TRACE(::testing::Message() << "seed " << i << " scheme "
+                                                  << static_cast<int>(scheme) << " direction "
+                                                  << static_cast<int>(dir));
+                const auto expected = tracer.traceFrom(seeds[i]);
+                EXPECT_EQ(expected.seedIndex, results[i].seedIndex);
+                expectSameLine(expected.line, results[i].line);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+// Float volumes are interpolated directly by the batched tracer
+TEST(BatchedStreamLineTracer, SameAsTracerDirectSampling) {
+    expectSameLines(createHelix<vec3>(1.0));
+}
+
+// Other formats go through the sampler interface
+TEST(BatchedStreamLineTracer, SameAsTracerSampler) { expectSameLines(createHelix<ivec3>(100.0)); }
+
+}  // namespace inviwo
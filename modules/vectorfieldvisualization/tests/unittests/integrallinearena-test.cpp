@@ -0,0 +1,232 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/datastructures/integrallinearena.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace inviwo {
+
+namespace {
+
+IntegralLine createLine(size_t points, size_t index, double offset) {
+    IntegralLine line;
+    auto& positions = line.getPositions();
+    auto& velocity = line.getMetaData<dvec3>("velocity", true);
+    auto& scalar = line.getMetaData<double>("scalar", true);
+    for (size_t i = 0; i < points; ++i) {
+        positions.emplace_back(offset + static_cast<double>(i), offset, 0.0);
+        velocity.emplace_back(1.0, 0.0, offset);
+        scalar.push_back(offset * static_cast<double>(i));
+    }
+    line.setIndex(index);
+    line.setBackwardTerminationReason(IntegralLine::TerminationReason::OutOfBounds);
+    line.setForwardTerminationReason(IntegralLine::TerminationReason::Steps);
+    return line;
+}
+
+const std::vector<IntegralLine> lines{createLine(3, 4, 1.0), createLine(1, 7, 2.0),
+                                      createLine(5, 2, 3.0)};
+
+void expectSameLine(const IntegralLine& expected, const IntegralLine& line) {
+    EXPECT_EQ(expected.getPositions(), line.getPositions());
+    EXPECT_EQ(expected.getMetaDataKeys(), line.getMetaDataKeys());
+    EXPECT_EQ(expected.getMetaData<dvec3>("velocity"), line.getMetaData<dvec3>("velocity"));
+    EXPECT_EQ(expected.getMetaData<double>("scalar"), line.getMetaData<double>("scalar"));
+    EXPECT_EQ(expected.getIndex(), line.getIndex());
+    EXPECT_EQ(expected.getBackwardTerminationReason(), line.getBackwardTerminationReason());
+    EXPECT_EQ(expected.getForwardTerminationReason(), line.getForwardTerminationReason());
+}
+
+IntegralLineArena createArena() {
+    IntegralLineArena arena;
+    arena.reserve(lines.size(), 9);
+    for (const auto& line : lines) arena.push_back(line);
+    return arena;
+}
+
+}  // namespace
+
+TEST(IntegralLineArena, Append) {
+    const auto arena = createArena();
+
+    ASSERT_EQ(3u, arena.size());
+    EXPECT_FALSE(arena.empty());
+    EXPECT_EQ(9u, arena.getNumberOfPoints());
+    EXPECT_EQ(std::vector<size_t>({0, 3, 4, 9}), arena.getOffsets());
+    EXPECT_EQ(9u, arena.getPositions().size());
+    EXPECT_EQ(9u, arena.getMetaData<dvec3>("velocity").size());
+    EXPECT_EQ(9u, arena.getMetaData<double>("scalar").size());
+    EXPECT_EQ(std::vector<std::string>({"scalar", "velocity"}), arena.getMetaDataKeys());
+    EXPECT_THROW(arena.getMetaData<float>("scalar"), Exception);
+
+    EXPECT_EQ(7u, arena.getIndex(1));
+    EXPECT_EQ(lines[2].getBackwardTerminationReason(), arena.at(2).getBackwardTerminationReason());
+    EXPECT_EQ(lines[2].getForwardTerminationReason(), arena.at(2).getForwardTerminationReason());
+    EXPECT_THROW(arena.at(3), RangeException);
+}
+
+TEST(IntegralLineArena, AppendMismatch) {
+    auto arena = createArena();
+
+    auto missing = createLine(2, 0, 0.0);
+    missing.getMetaData<float>("extra", true).assign(2, 1.0f);
+    EXPECT_THROW(arena.push_back(missing), Exception);
+
+    auto size = createLine(2, 0, 0.0);
+    size.getMetaData<double>("scalar").push_back(1.0);
+    EXPECT_THROW(arena.push_back(size), Exception);
+
+    // A failed append leaves the arena untouched
+    EXPECT_EQ(3u, arena.size());
+    EXPECT_EQ(9u, arena.getNumberOfPoints());
+    EXPECT_EQ(9u, arena.getMetaData<double>("scalar").size());
+}
+
+TEST(IntegralLineArena, Iteration) {
+    const auto arena = createArena();
+
+    for (size_t i = 0; i < arena.size(); ++i) {
+        const auto view = arena[i];
+        const auto& line = lines[i];
+        ASSERT_EQ(line.getPositions().size(), view.size());
+
+        const auto positions = view.getPositions();
+        EXPECT_TRUE(std::equal(positions.begin(), positions.end(), line.getPositions().begin(),
+                               line.getPositions().end()));
+        const auto scalar = view.getMetaData<double>("scalar");
+        EXPECT_TRUE(std::equal(scalar.begin(), scalar.end(),
+                               line.getMetaData<double>("scalar").begin(),
+                               line.getMetaData<double>("scalar").end()));
+        size_t count = 0;
+        view.dispatchMetaData("velocity", [&](auto range) {
+            count = static_cast<size_t>(std::distance(range.begin(), range.end()));
+        });
+        EXPECT_EQ(line.getPositions().size(), count);
+        EXPECT_DOUBLE_EQ(line.getLength(), view.getLength());
+        EXPECT_EQ(line.getIndex(), view.getIndex());
+    }
+}
+
+TEST(IntegralLineArena, RoundTrip) {
+    const auto arena = createArena();
+    for (size_t i = 0; i < arena.size(); ++i) {
+        expectSameLine(lines[i], arena[i].toIntegralLine());
+    }
+
+    // Copies do not share buffers
+    auto copy = arena;
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(3u, arena.size());
+    EXPECT_EQ(9u, arena.getPositions().size());
+}
+
+TEST(IntegralLineArena, ToMesh) {
+    auto arena = createArena();
+    const auto mesh = arena.toMesh(mat4(1.0f), mat4(1.0f));
+
+    // The mesh uses the buffers of the arena
+    ASSERT_EQ(3u, mesh->getNumberOfBuffers());
+    EXPECT_EQ(arena.getPositionBuffer().get(), mesh->getBuffer(0));
+    EXPECT_EQ(arena.getMetaDataBuffer("scalar").get(), mesh->getBuffer(1));
+    EXPECT_EQ(arena.getMetaDataBuffer("velocity").get(), mesh->getBuffer(2));
+    EXPECT_EQ(BufferType::PositionAttrib, mesh->getBufferInfo(0).type);
+
+    // Segment pairs, the line with a single point has no segments
+    ASSERT_EQ(1u, mesh->getNumberOfIndicies());
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 1, 1, 2, 4, 5, 5, 6, 6, 7, 7, 8}),
+              mesh->getIndexBuffers()[0].second->getRAMRepresentation()->getDataContainer());
+
+    const auto strips = arena.toMesh(mat4(1.0f), mat4(1.0f), ConnectivityType::StripAdjacency);
+    ASSERT_EQ(2u, strips->getNumberOfIndicies());
+    EXPECT_EQ(ConnectivityType::StripAdjacency, strips->getIndexMeshInfo(1).ct);
+    EXPECT_EQ(std::vector<std::uint32_t>({4, 5, 6, 7, 8}),
+              strips->getIndexBuffers()[1].second->getRAMRepresentation()->getDataContainer());
+
+    // Appending copies the shared buffers, the mesh keeps the old data
+    arena.push_back(createLine(2, 9, 4.0));
+    EXPECT_NE(arena.getPositionBuffer().get(), mesh->getBuffer(0));
+    EXPECT_EQ(11u, arena.getPositions().size());
+    EXPECT_EQ(9u, mesh->getBuffer(0)->getSize());
+    EXPECT_EQ(9u, mesh->getBuffer(1)->getSize());
+}
+
+TEST(IntegralLineSet, PackedStorage) {
+    IntegralLineSet set(mat4(1), mat4(1), IntegralLineSet::Storage::Packed);
+    for (const auto& line : lines) set.push_back(line, line.getIndex());
+
+    EXPECT_EQ(IntegralLineSet::Storage::Packed, set.getStorage());
+    ASSERT_NE(nullptr, set.getArena());
+    EXPECT_EQ(3u, set.size());
+    EXPECT_EQ(9u, set.getArena()->getNumberOfPoints());
+
+    // The const interface unpacks a copy and keeps the packed storage
+    const auto& constSet = set;
+    size_t i = 0;
+    for (const auto& line : constSet) expectSameLine(lines[i++], line);
+    EXPECT_EQ(3u, i);
+    EXPECT_EQ(IntegralLineSet::Storage::Packed, set.getStorage());
+
+    // The non-const interface converts to separate lines
+    set[1].setIndex(10);
+    EXPECT_EQ(IntegralLineSet::Storage::Lines, set.getStorage());
+    EXPECT_EQ(nullptr, set.getArena());
+    EXPECT_EQ(10u, set[1].getIndex());
+    expectSameLine(lines[2], set[2]);
+}
+
+TEST(IntegralLineSet, PackRoundTrip) {
+    IntegralLineSet set(mat4(1));
+    for (const auto& line : lines) set.push_back(line, IntegralLineSet::SetIndex::No);
+    EXPECT_EQ(IntegralLineSet::Storage::Lines, set.getStorage());
+
+    set.pack();
+    EXPECT_EQ(IntegralLineSet::Storage::Packed, set.getStorage());
+    ASSERT_NE(nullptr, set.getArena());
+    EXPECT_EQ(3u, set.getArena()->size());
+
+    const IntegralLineSet copy(set);
+    EXPECT_EQ(IntegralLineSet::Storage::Packed, copy.getStorage());
+    for (size_t i = 0; i < lines.size(); ++i) expectSameLine(lines[i], copy[i]);
+
+    set.unpack();
+    EXPECT_EQ(IntegralLineSet::Storage::Lines, set.getStorage());
+    ASSERT_EQ(3u, set.size());
+    for (size_t i = 0; i < lines.size(); ++i) expectSameLine(lines[i], set[i]);
+}
+
+}  // namespace inviwo
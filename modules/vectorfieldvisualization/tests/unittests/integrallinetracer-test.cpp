@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+// A constant field along x with NaN vectors in the upper half of the volume along x
+std::shared_ptr<const VolumeDoubleSampler<3>> createNaNSampler() {
+    const size3_t dims{16, 16, 16};
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                data[VolumeRAM::posToIndex(size3_t(x, y, z), dims)] =
+                    x < dims.x / 2 ? vec3(1.0f, 0.0f, 0.0f)
+                                   : vec3(std::numeric_limits<float>::quiet_NaN());
+            }
+        }
+    }
+    return std::make_shared<VolumeDoubleSampler<3>>(std::make_shared<Volume>(ram));
+}
+
+}  // namespace
+
+TEST(IntegralLineTracer, AdaptiveNaNField) {
+    const auto sampler = createNaNSampler();
+
+    for (auto scheme : {IntegralLineProperties::IntegrationScheme::DormandPrince,
+                        IntegralLineProperties::IntegrationScheme::CashKarp}) {
+        for (bool dense : {false, true}) {
+            IntegralLineProperties props("properties", "Properties");
+            props.numberOfSteps_.set(1000);
+            props.stepSize_.set(0.01f);
+            props.seedPointsSpace_.set(CoordinateSpace::Data);
+            props.stepDirection_.set(IntegralLineProperties::Direction::BOTH);
+            props.integrationScheme_.set(scheme);
+            props.denseOutput_.set(dense);
+
+            StreamLine3DTracer tracer(sampler, props);
+            const auto res = tracer.traceFrom(dvec3{0.2, 0.5, 0.5});
+            const auto& line = res.line;
+
+            // Backward the line leaves the volume, forward it stops where the field is NaN
+            EXPECT_EQ(IntegralLine::TerminationReason::OutOfBounds,
+                      line.getBackwardTerminationReason());
+            EXPECT_EQ(IntegralLine::TerminationReason::OutOfBounds,
+                      line.getForwardTerminationReason());
+            ASSERT_FALSE(line.getPositions().empty());
+            for (const auto& p : line.getPositions()) {
+                EXPECT_TRUE(std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z));
+            }
+            EXPECT_LT(line.getPositions().back().x, 0.5);
+        }
+    }
+}
+
+}  // namespace inviwo
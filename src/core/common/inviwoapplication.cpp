@@ -148,6 +148,11 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         systemSettings_->poolSize_.onChange([this]() { resizePool(systemSettings_->poolSize_); });
     }
 
+    processorNetworkEvaluator_->setParallelEvaluation(systemSettings_->parallelEvaluation_);
+    systemSettings_->parallelEvaluation_.onChange([this]() {
+        processorNetworkEvaluator_->setParallelEvaluation(systemSettings_->parallelEvaluation_);
+    });
+
     resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get());
     systemSettings_->enableResourceManager_.onChange(
         [this]() { resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get()); });
@@ -29,10 +29,111 @@
 
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/threadpool.h>
 
 namespace inviwo {
 
+namespace {
+
+template <typename T>
+HistogramContainer calculateHistogramsParallel(const T* data, size_t size, dvec2 dataRange,
+                                               size_t bins, size_t jobs, size_t stride = 1) {
+    if (jobs == 0 && InviwoApplication::isInitialized()) {
+        jobs = 4 * InviwoApplication::getPtr()->getPoolSize();
+    }
+    // Don't make the chunks too small, the merging is O(bins) per chunk.
+    constexpr size_t minChunkSize = 1 << 16;
+    const size_t samples = (size + stride - 1) / stride;
+    jobs = std::min(jobs, samples / minChunkSize);
+
+    if (jobs <= 1) {
+        detail::HistogramAccumulator<T> accumulator(dataRange, bins);
+        accumulator.add(data, data + size, stride);
+        return accumulator.getHistograms();
+    }
+
+    std::vector<std::future<detail::HistogramAccumulator<T>>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        // Chunks start at a multiple of the stride to visit the same values as a single pass
+        const auto start = data + stride * ((samples * job) / jobs);
+        const auto end = data + std::min(size, stride * ((samples * (job + 1)) / jobs));
+        futures.push_back(dispatchPool([start, end, dataRange, bins, stride]() {
+            detail::HistogramAccumulator<T> accumulator(dataRange, bins);
+            accumulator.add(start, end, stride);
+            return accumulator;
+        }));
+    }
+
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    detail::HistogramAccumulator<T> result(dataRange, bins);
+    for (auto& future : futures) {
+        pool.wait(future);
+        result.merge(future.get());
+    }
+    return result.getHistograms();
+}
+
+bool isPrime(size_t n) {
+    if (n < 2) return false;
+    for (size_t i = 2; i * i <= n; ++i) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+HistogramContainer util::calculateHistograms(const VolumeRAM& volumeRam, dvec2 dataRange,
+                                             size_t bins, size_t jobs) {
+    return volumeRam.dispatch<HistogramContainer>([&](auto vr) {
+        using T = util::PrecisionValueType<decltype(vr)>;
+        return calculateHistogramsParallel<T>(vr->getDataTyped(),
+                                              glm::compMul(vr->getDimensions()), dataRange, bins,
+                                              jobs);
+    });
+}
+
+HistogramContainer util::calculateHistograms(const LayerRAM& layerRam, dvec2 dataRange,
+                                             size_t bins, size_t jobs) {
+    return layerRam.dispatch<HistogramContainer>([&](auto lr) {
+        using T = util::PrecisionValueType<decltype(lr)>;
+        return calculateHistogramsParallel<T>(lr->getDataTyped(),
+                                              glm::compMul(lr->getDimensions()), dataRange, bins,
+                                              jobs);
+    });
+}
+
+HistogramContainer util::calculateHistogramsStrided(const VolumeRAM& volumeRam, dvec2 dataRange,
+                                                    size_t bins, size_t stride) {
+    return volumeRam.dispatch<HistogramContainer>([&](auto vr) {
+        using T = util::PrecisionValueType<decltype(vr)>;
+        return calculateHistogramsParallel<T>(vr->getDataTyped(),
+                                              glm::compMul(vr->getDimensions()), dataRange, bins,
+                                              0, std::max(stride, size_t{1}));
+    });
+}
+
+std::vector<size_t> util::progressiveHistogramStrides(size_t size, size_t sizeOf) {
+    // Start with about 64k samples and refine by a factor 16 per step. Stop once the samples
+    // get so close that every cache line would be touched, then the exact pass is just as fast.
+    constexpr size_t initialSamples = 1 << 16;
+    constexpr size_t minStrideBytes = 256;
+    size_t target = 1;
+    while (target * 2 <= size / initialSamples) target *= 2;
+
+    // Use the next prime instead of the power of two itself. Volume dimensions are often powers
+    // of two, a stride sharing factors with them would only ever visit some of the columns.
+    std::vector<size_t> strides;
+    for (; target > 1 && target * sizeOf >= minStrideBytes; target /= 16) {
+        auto stride = target + 1;
+        while (!isPrime(stride)) ++stride;
+        strides.push_back(stride);
+    }
+    return strides;
+}
+
 void HistogramCalculationState::whenDone(std::function<void(const HistogramContainer&)> callback) {
     if (auto container = container_.lock(); container && done) {
         callback(*container);
@@ -41,6 +142,16 @@ void HistogramCalculationState::whenDone(std::function<void(const HistogramConta
     }
 }
 
+void HistogramCalculationState::whenUpdated(
+    std::function<void(const HistogramContainer&)> callback) {
+    if (auto container = container_.lock(); container && done) {
+        callback(*container);
+    } else {
+        if (!intermediate_.empty()) callback(intermediate_);
+        callbackHandles_.push_back(updateCallbacks_.add(callback));
+    }
+}
+
 HistogramSupplier::HistogramSupplier() : histograms_{std::make_shared<HistogramContainer>()} {}
 
 HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
@@ -63,10 +174,21 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
 
         dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
                       stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
+            const auto strides = util::progressiveHistogramStrides(
+                glm::compMul(volumeRam->getDimensions()),
+                volumeRam->getDataFormat()->getSize());
+            for (auto stride : strides) {
+                auto histograms =
+                    util::calculateHistogramsStrided(*volumeRam, dataRange, bins, stride);
+                if (*stop) return;
+                dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
+                    if (auto s = weakState.lock()) {
+                        update(s, std::move(hist));
+                    }
+                });
+            }
+
+            auto histograms = util::calculateHistograms(*volumeRam, dataRange, bins);
             if (*stop) return;
             dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
                 if (auto s = weakState.lock()) {
@@ -78,10 +200,19 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     return calculation_;
 }
 
+void HistogramSupplier::update(std::shared_ptr<HistogramCalculationState> state,
+                               HistogramContainer histograms) {
+    if (state->done) return;
+    state->intermediate_ = std::move(histograms);
+    state->updateCallbacks_.invoke(state->intermediate_);
+}
+
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
                              HistogramContainer histograms) {
+    state->updateCallbacks_.invoke(histograms);
     state->callbacks_.invoke(histograms);
     state->done = true;
+    state->intermediate_.clear();
     if (auto container = state->container_.lock()) {
         *container = std::move(histograms);
     }
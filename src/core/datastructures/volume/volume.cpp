@@ -29,6 +29,8 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
 #include <inviwo/core/util/document.h>
 
 namespace inviwo {
@@ -62,11 +64,44 @@ Volume::Volume(std::shared_ptr<VolumeRepresentation> in)
     addRepresentation(in);
 }
 
+// The cached pyramid and octree refer to the representations of rhs and are not copied
+Volume::Volume(const Volume& rhs)
+    : Data<Volume, VolumeRepresentation>(rhs)
+    , StructuredGridEntity<3>(rhs)
+    , MetaDataOwner(rhs)
+    , HistogramSupplier(rhs)
+    , dataMap_{rhs.dataMap_}
+    , defaultDimensions_{rhs.defaultDimensions_}
+    , defaultDataFormat_{rhs.defaultDataFormat_}
+    , defaultSwizzleMask_{rhs.defaultSwizzleMask_}
+    , defaultInterpolation_{rhs.defaultInterpolation_}
+    , defaultWrapping_{rhs.defaultWrapping_} {}
+
+Volume& Volume::operator=(const Volume& that) {
+    if (this != &that) {
+        Data<Volume, VolumeRepresentation>::operator=(that);
+        StructuredGridEntity<3>::operator=(that);
+        MetaDataOwner::operator=(that);
+        HistogramSupplier::operator=(that);
+        dataMap_ = that.dataMap_;
+        defaultDimensions_ = that.defaultDimensions_;
+        defaultDataFormat_ = that.defaultDataFormat_;
+        defaultSwizzleMask_ = that.defaultSwizzleMask_;
+        defaultInterpolation_ = that.defaultInterpolation_;
+        defaultWrapping_ = that.defaultWrapping_;
+        discardPyramid();
+        discardMinMaxOctree();
+    }
+    return *this;
+}
+
 Volume* Volume::clone() const { return new Volume(*this); }
 Volume::~Volume() = default;
 
 void Volume::setDimensions(const size3_t& dim) {
     defaultDimensions_ = dim;
+    discardPyramid();
+    discardMinMaxOctree();
 
     if (lastValidRepresentation_) {
         // Resize last valid representation
@@ -227,6 +262,40 @@ std::shared_ptr<HistogramCalculationState> Volume::calculateHistograms(size_t bi
         std::static_pointer_cast<VolumeRAM>(lastValidRepresentation_), dataMap_.dataRange, bins);
 }
 
+std::shared_ptr<const VolumePyramid> Volume::getPyramid() const {
+    const auto modification = getModificationCount();
+    const auto volumeRAM = getRepresentationShared<VolumeRAM>();
+    std::lock_guard<std::mutex> lock{pyramidMutex_};
+    if (!pyramid_ || pyramid_->getLevel(0) != volumeRAM ||
+        pyramidModification_ != modification) {
+        pyramid_ = std::make_shared<VolumePyramid>(volumeRAM);
+        pyramidModification_ = modification;
+    }
+    return pyramid_;
+}
+
+void Volume::discardPyramid() {
+    std::lock_guard<std::mutex> lock{pyramidMutex_};
+    pyramid_.reset();
+}
+
+std::shared_ptr<const VolumeMinMaxOctree> Volume::getMinMaxOctree() const {
+    const auto modification = getModificationCount();
+    std::lock_guard<std::mutex> lock{minMaxOctreeMutex_};
+    if (!minMaxOctree_ || minMaxOctree_->getVolumeDimensions() != getDimensions() ||
+        minMaxOctreeModification_ != modification) {
+        const auto volumeRAM = getRepresentationShared<VolumeRAM>();
+        minMaxOctree_ = std::make_shared<VolumeMinMaxOctree>(*volumeRAM);
+        minMaxOctreeModification_ = modification;
+    }
+    return minMaxOctree_;
+}
+
+void Volume::discardMinMaxOctree() {
+    std::lock_guard<std::mutex> lock{minMaxOctreeMutex_};
+    minMaxOctree_.reset();
+}
+
 template class IVW_CORE_TMPL_INST DataReaderType<Volume>;
 template class IVW_CORE_TMPL_INST DataWriterType<Volume>;
 template class IVW_CORE_TMPL_INST DataReaderType<VolumeSequence>;
@@ -0,0 +1,250 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <tuple>
+
+namespace inviwo {
+
+VolumeMinMaxOctree::VolumeMinMaxOctree(const VolumeRAM& volume, size_t brickSize)
+    : dims_{volume.getDimensions()}, brickSize_{std::max(brickSize, size_t{1})} {
+
+    // Number of cells along each axis, divided into bricks, at least one brick per axis
+    const size3_t cells{glm::max(dims_, size3_t{1}) - size3_t{1}};
+    levelDims_.push_back(
+        glm::max((cells + size3_t{brickSize_ - 1}) / size3_t{brickSize_}, size3_t{1}));
+    while (glm::compMax(levelDims_.back()) > 1) {
+        levelDims_.push_back((levelDims_.back() + size3_t{1}) / size3_t{2});
+    }
+
+    const size3_t leaves = levelDims_.front();
+    levels_.emplace_back(glm::compMul(leaves));
+    nanBricks_.resize(glm::compMul(leaves), 0);
+
+    volume.dispatch<void>([&](auto vr) {
+        using ValueType = util::PrecisionValueType<decltype(vr)>;
+        using C = typename util::value_type<ValueType>::type;
+
+        const auto src = vr->getDataTyped();
+        const util::IndexMapper3D im(dims_);
+        auto& ranges = levels_.front();
+
+        // Process a range of layers of leaf bricks. Each row segment of voxels is added to the
+        // bricks it belongs to, voxels on a brick border in y belong to two bricks. NaN values
+        // are skipped, otherwise they would propagate through std::min/max.
+        const auto layers = [&](size_t bzBegin, size_t bzEnd) {
+            const size_t layerSize = leaves.x * leaves.y;
+            std::vector<C> minVal(layerSize);
+            std::vector<C> maxVal(layerSize);
+            for (size_t bz = bzBegin; bz < bzEnd; ++bz) {
+                std::fill(minVal.begin(), minVal.end(), std::numeric_limits<C>::max());
+                std::fill(maxVal.begin(), maxVal.end(), std::numeric_limits<C>::lowest());
+                const auto nan = nanBricks_.begin() + bz * layerSize;
+
+                const auto zEnd = std::min((bz + 1) * brickSize_, cells.z);
+                for (size_t z = bz * brickSize_; z <= zEnd; ++z) {
+                    for (size_t y = 0; y < dims_.y; ++y) {
+                        const size_t byHi = std::min(y / brickSize_, leaves.y - 1);
+                        const size_t byLo =
+                            (y % brickSize_ == 0 && y > 0) ? y / brickSize_ - 1 : byHi;
+                        const auto row = src + im(0, y, z);
+                        for (size_t bx = 0; bx < leaves.x; ++bx) {
+                            const auto xEnd = std::min((bx + 1) * brickSize_, cells.x);
+                            C rowMin = std::numeric_limits<C>::max();
+                            C rowMax = std::numeric_limits<C>::lowest();
+                            bool rowNaN = false;
+                            for (size_t x = bx * brickSize_; x <= xEnd; ++x) {
+                                const C val = util::glmcomp(row[x], 0);
+                                if (util::isnan(val)) {
+                                    rowNaN = true;
+                                    continue;
+                                }
+                                rowMin = std::min(rowMin, val);
+                                rowMax = std::max(rowMax, val);
+                            }
+                            for (const auto by : {byLo, byHi}) {
+                                minVal[bx + by * leaves.x] =
+                                    std::min(minVal[bx + by * leaves.x], rowMin);
+                                maxVal[bx + by * leaves.x] =
+                                    std::max(maxVal[bx + by * leaves.x], rowMax);
+                                if (rowNaN) nan[bx + by * leaves.x] = 1;
+                            }
+                        }
+                    }
+                }
+                for (size_t i = 0; i < layerSize; ++i) {
+                    ranges[i + bz * layerSize] = dvec2{static_cast<double>(minVal[i]),
+                                                       static_cast<double>(maxVal[i])};
+                }
+            }
+        };
+
+        const size_t jobs =
+            InviwoApplication::isInitialized()
+                ? std::min(leaves.z, 4 * InviwoApplication::getPtr()->getPoolSize())
+                : 0;
+        if (jobs <= 1) {
+            layers(0, leaves.z);
+        } else {
+            std::vector<std::future<void>> futures;
+            for (size_t job = 0; job < jobs; ++job) {
+                futures.push_back(dispatchPool(
+                    [&layers, bzBegin = (leaves.z * job) / jobs,
+                     bzEnd = (leaves.z * (job + 1)) / jobs]() { layers(bzBegin, bzEnd); }));
+            }
+            auto& pool = InviwoApplication::getPtr()->getThreadPool();
+            for (auto& future : futures) {
+                pool.wait(future);
+                future.get();
+            }
+        }
+    });
+
+    // Combine 2x2x2 nodes into the nodes of the next level
+    for (size_t level = 1; level < levelDims_.size(); ++level) {
+        const auto& prevDims = levelDims_[level - 1];
+        const auto& dims = levelDims_[level];
+        std::vector<dvec2> ranges(glm::compMul(dims),
+                                  dvec2{std::numeric_limits<double>::max(),
+                                        std::numeric_limits<double>::lowest()});
+        for (size_t z = 0; z < prevDims.z; ++z) {
+            for (size_t y = 0; y < prevDims.y; ++y) {
+                for (size_t x = 0; x < prevDims.x; ++x) {
+                    const auto& child = levels_[level - 1][index(level - 1, size3_t{x, y, z})];
+                    auto& node = ranges[(x / 2) + (y / 2) * dims.x + (z / 2) * dims.x * dims.y];
+                    node.x = std::min(node.x, child.x);
+                    node.y = std::max(node.y, child.y);
+                }
+            }
+        }
+        levels_.push_back(std::move(ranges));
+    }
+}
+
+size3_t VolumeMinMaxOctree::getVolumeDimensions() const { return dims_; }
+
+size_t VolumeMinMaxOctree::getBrickSize() const { return brickSize_; }
+
+size_t VolumeMinMaxOctree::getNumberOfLevels() const { return levels_.size(); }
+
+size3_t VolumeMinMaxOctree::getLevelDimensions(size_t level) const { return levelDims_[level]; }
+
+size3_t VolumeMinMaxOctree::getNumberOfBricks() const { return levelDims_.front(); }
+
+size3_t VolumeMinMaxOctree::getBrickOffset(const size3_t& brick) const {
+    return brick * size3_t{brickSize_};
+}
+
+size3_t VolumeMinMaxOctree::getBrickDimensions(const size3_t& brick) const {
+    const size3_t cells{glm::max(dims_, size3_t{1}) - size3_t{1}};
+    const auto offset = getBrickOffset(brick);
+    return glm::min(offset + size3_t{brickSize_}, cells) - offset + size3_t{1};
+}
+
+size3_t VolumeMinMaxOctree::getBrick(const size3_t& pos) const {
+    return glm::min(pos / size3_t{brickSize_}, levelDims_.front() - size3_t{1});
+}
+
+dvec2 VolumeMinMaxOctree::getBrickRange(const size3_t& brick) const {
+    return levels_.front()[index(0, brick)];
+}
+
+const std::vector<dvec2>& VolumeMinMaxOctree::getBrickRanges() const { return levels_.front(); }
+
+dvec2 VolumeMinMaxOctree::getNodeRange(size_t level, const size3_t& node) const {
+    return levels_[level][index(level, node)];
+}
+
+dvec2 VolumeMinMaxOctree::getDataRange() const { return levels_.back().front(); }
+
+bool VolumeMinMaxOctree::containsNaN(const size3_t& brick) const {
+    return nanBricks_[index(0, brick)] != 0;
+}
+
+bool VolumeMinMaxOctree::mayContain(const size3_t& brick, double value) const {
+    return mayIntersect(brick, dvec2{value});
+}
+
+bool VolumeMinMaxOctree::mayIntersect(const size3_t& brick, const dvec2& range) const {
+    const auto& r = levels_.front()[index(0, brick)];
+    return r.x <= range.y && r.y >= range.x;
+}
+
+std::vector<size3_t> VolumeMinMaxOctree::findBricks(double value) const {
+    return findBricks(dvec2{value});
+}
+
+std::vector<size3_t> VolumeMinMaxOctree::findBricks(const dvec2& range) const {
+    std::vector<size3_t> bricks;
+
+    // Depth first traversal from the root, skipping the children of non-intersecting nodes
+    std::vector<std::pair<size_t, size3_t>> stack;
+    stack.emplace_back(levels_.size() - 1, size3_t{0});
+    while (!stack.empty()) {
+        const auto [level, node] = stack.back();
+        stack.pop_back();
+
+        const auto& r = levels_[level][index(level, node)];
+        if (r.x > range.y || r.y < range.x) continue;
+
+        if (level == 0) {
+            bricks.push_back(node);
+            continue;
+        }
+        const auto& childDims = levelDims_[level - 1];
+        const auto first = node * size3_t{2};
+        const auto last = glm::min(first + size3_t{1}, childDims - size3_t{1});
+        for (size_t z = first.z; z <= last.z; ++z) {
+            for (size_t y = first.y; y <= last.y; ++y) {
+                for (size_t x = first.x; x <= last.x; ++x) {
+                    stack.emplace_back(level - 1, size3_t{x, y, z});
+                }
+            }
+        }
+    }
+
+    std::sort(bricks.begin(), bricks.end(), [&](const size3_t& a, const size3_t& b) {
+        return std::tie(a.z, a.y, a.x) < std::tie(b.z, b.y, b.x);
+    });
+    return bricks;
+}
+
+size_t VolumeMinMaxOctree::index(size_t level, const size3_t& node) const {
+    const auto& dims = levelDims_[level];
+    return node.x + node.y * dims.x + node.z * dims.x * dims.y;
+}
+
+}  // namespace inviwo
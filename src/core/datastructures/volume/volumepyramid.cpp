@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <future>
+
+namespace inviwo {
+
+VolumePyramid::VolumePyramid(std::shared_ptr<const VolumeRAM> volume, size_t minSize) {
+    levels_.push_back(std::move(volume));
+    minSize = std::max(minSize, size_t{1});
+    while (glm::compMax(levels_.back()->getDimensions()) > minSize) {
+        levels_.push_back(downsample(*levels_.back()));
+    }
+}
+
+size_t VolumePyramid::getNumberOfLevels() const { return levels_.size(); }
+
+const std::shared_ptr<const VolumeRAM>& VolumePyramid::getLevel(size_t level) const {
+    return levels_[level];
+}
+
+size3_t VolumePyramid::getDimensions(size_t level) const {
+    return levels_[level]->getDimensions();
+}
+
+size_t VolumePyramid::getLevelForVoxelBudget(size_t maxVoxels) const {
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        if (glm::compMul(getDimensions(level)) <= maxVoxels) return level;
+    }
+    return levels_.size() - 1;
+}
+
+size_t VolumePyramid::getLevelForFootprint(size_t pixels) const {
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        if (glm::compMax(getDimensions(level)) <= pixels) return level;
+    }
+    return levels_.size() - 1;
+}
+
+std::shared_ptr<VolumeRAM> VolumePyramid::downsample(const VolumeRAM& volume) {
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>([](auto srcVol) {
+        using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+        // use a double type to perform the summation
+        using P = typename util::same_extent<ValueType, double>::type;
+        constexpr bool isFloat =
+            util::is_floating_point<typename util::value_type<ValueType>::type>::value;
+
+        const size3_t srcDims{srcVol->getDimensions()};
+        const size3_t dstDims{(srcDims + size3_t{1}) / size3_t{2}};
+
+        auto dstVol = std::make_shared<VolumeRAMPrecision<ValueType>>(
+            dstDims, srcVol->getSwizzleMask(), srcVol->getInterpolation(), srcVol->getWrapping());
+
+        const auto src = srcVol->getDataTyped();
+        auto dst = dstVol->getDataTyped();
+        const util::IndexMapper3D o(srcDims);
+        const util::IndexMapper3D n(dstDims);
+
+        // Process a range of z slices of the destination. At the upper borders of volumes with odd
+        // dimensions only the existing voxels are averaged.
+        const auto slices = [&](size_t zBegin, size_t zEnd) {
+            for (size_t z = zBegin; z < zEnd; ++z) {
+                const size_t nz = std::min(size_t{2}, srcDims.z - 2 * z);
+                for (size_t y = 0; y < dstDims.y; ++y) {
+                    const size_t ny = std::min(size_t{2}, srcDims.y - 2 * y);
+                    for (size_t x = 0; x < dstDims.x; ++x) {
+                        const size_t nx = std::min(size_t{2}, srcDims.x - 2 * x);
+                        P val{0.0};
+                        for (size_t oz = 0; oz < nz; ++oz) {
+                            for (size_t oy = 0; oy < ny; ++oy) {
+                                for (size_t ox = 0; ox < nx; ++ox) {
+                                    val += static_cast<P>(
+                                        src[o(2 * x + ox, 2 * y + oy, 2 * z + oz)]);
+                                }
+                            }
+                        }
+                        val /= static_cast<double>(nx * ny * nz);
+                        if constexpr (!isFloat) val = glm::round(val);
+#include <warn/push>
+#include <warn/ignore/conversion>
+                        dst[n(x, y, z)] = static_cast<ValueType>(val);
+#include <warn/pop>
+                    }
+                }
+            }
+        };
+
+        const size_t jobs =
+            InviwoApplication::isInitialized()
+                ? std::min(dstDims.z, 4 * InviwoApplication::getPtr()->getPoolSize())
+                : 0;
+        if (jobs <= 1) {
+            slices(0, dstDims.z);
+        } else {
+            std::vector<std::future<void>> futures;
+            for (size_t job = 0; job < jobs; ++job) {
+                futures.push_back(dispatchPool(
+                    [&slices, zBegin = (dstDims.z * job) / jobs,
+                     zEnd = (dstDims.z * (job + 1)) / jobs]() { slices(zBegin, zEnd); }));
+            }
+            auto& pool = InviwoApplication::getPtr()->getThreadPool();
+            for (auto& future : futures) {
+                pool.wait(future);
+                future.get();
+            }
+        }
+        return std::shared_ptr<VolumeRAM>{std::move(dstVol)};
+    });
+}
+
+}  // namespace inviwo
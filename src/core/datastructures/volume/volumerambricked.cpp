@@ -0,0 +1,319 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/datastructures/volume/volumerambricked.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+
+#include <filesystem>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+std::string createBrickFileName() {
+    std::random_device rd;
+    std::stringstream ss;
+    ss << "inviwo-bricks-" << std::hex << rd() << rd() << ".tmp";
+    return (std::filesystem::temp_directory_path() / ss.str()).string();
+}
+
+}  // namespace
+
+VolumeRAMBricked::VolumeRAMBricked(size3_t dimensions, const DataFormatBase* format,
+                                   size3_t brickSize, size_t cacheSize,
+                                   const SwizzleMask& swizzleMask, InterpolationType interpolation,
+                                   const Wrapping3D& wrapping)
+    : VolumeRepresentation(format)
+    , dimensions_{dimensions}
+    , brickSize_{glm::max(brickSize, size3_t{1})}
+    , numBricks_{(dimensions_ + brickSize_ - size3_t{1}) / brickSize_}
+    , cacheSize_{cacheSize}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping}
+    , cachedBytes_{0}
+    , stored_(glm::compMul(numBricks_), false) {}
+
+VolumeRAMBricked::VolumeRAMBricked(const VolumeRAMBricked& rhs)
+    : VolumeRepresentation(rhs)
+    , dimensions_{rhs.dimensions_}
+    , brickSize_{rhs.brickSize_}
+    , numBricks_{rhs.numBricks_}
+    , cacheSize_{rhs.cacheSize_}
+    , swizzleMask_{rhs.swizzleMask_}
+    , interpolation_{rhs.interpolation_}
+    , wrapping_{rhs.wrapping_}
+    , cachedBytes_{0}
+    , stored_(glm::compMul(numBricks_), false) {
+    copyBricks(rhs);
+}
+
+VolumeRAMBricked& VolumeRAMBricked::operator=(const VolumeRAMBricked& that) {
+    if (this != &that) {
+        VolumeRepresentation::operator=(that);
+        dimensions_ = that.dimensions_;
+        brickSize_ = that.brickSize_;
+        numBricks_ = that.numBricks_;
+        cacheSize_ = that.cacheSize_;
+        swizzleMask_ = that.swizzleMask_;
+        interpolation_ = that.interpolation_;
+        wrapping_ = that.wrapping_;
+        reset();
+        copyBricks(that);
+    }
+    return *this;
+}
+
+VolumeRAMBricked* VolumeRAMBricked::clone() const { return new VolumeRAMBricked(*this); }
+
+VolumeRAMBricked::~VolumeRAMBricked() {
+    if (stream_.is_open()) stream_.close();
+    if (!file_.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(file_, ec);
+    }
+}
+
+std::type_index VolumeRAMBricked::getTypeIndex() const {
+    return std::type_index(typeid(VolumeRAMBricked));
+}
+
+void VolumeRAMBricked::setDimensions(size3_t dimensions) {
+    dimensions_ = dimensions;
+    numBricks_ = (dimensions_ + brickSize_ - size3_t{1}) / brickSize_;
+    reset();
+}
+
+const size3_t& VolumeRAMBricked::getDimensions() const { return dimensions_; }
+
+void VolumeRAMBricked::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumeRAMBricked::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumeRAMBricked::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumeRAMBricked::getInterpolation() const { return interpolation_; }
+
+void VolumeRAMBricked::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumeRAMBricked::getWrapping() const { return wrapping_; }
+
+size3_t VolumeRAMBricked::getBrickSize() const { return brickSize_; }
+
+size3_t VolumeRAMBricked::getNumberOfBricks() const { return numBricks_; }
+
+size3_t VolumeRAMBricked::getBrickOffset(const size3_t& brick) const { return brick * brickSize_; }
+
+size3_t VolumeRAMBricked::getBrickDimensions(const size3_t& brick) const {
+    return glm::min(brickSize_, dimensions_ - getBrickOffset(brick));
+}
+
+size_t VolumeRAMBricked::getCacheSize() const { return cacheSize_; }
+
+void VolumeRAMBricked::setCacheSize(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    cacheSize_ = bytes;
+    evict();
+}
+
+size_t VolumeRAMBricked::getNumberOfCachedBytes() const {
+    std::scoped_lock lock{mutex_};
+    return cachedBytes_;
+}
+
+std::shared_ptr<const VolumeRAM> VolumeRAMBricked::getBrick(const size3_t& brick) const {
+    return load(brick, false);
+}
+
+std::shared_ptr<VolumeRAM> VolumeRAMBricked::getEditableBrick(const size3_t& brick) {
+    return load(brick, true);
+}
+
+void VolumeRAMBricked::forEachBrick(
+    const std::function<void(const VolumeRAM& brick, const size3_t& offset)>& callback) const {
+    for (size_t z = 0; z < numBricks_.z; ++z) {
+        for (size_t y = 0; y < numBricks_.y; ++y) {
+            for (size_t x = 0; x < numBricks_.x; ++x) {
+                const size3_t brick{x, y, z};
+                callback(*getBrick(brick), getBrickOffset(brick));
+            }
+        }
+    }
+}
+
+void VolumeRAMBricked::forEachBrick(
+    const std::function<void(VolumeRAM& brick, const size3_t& offset)>& callback) {
+    for (size_t z = 0; z < numBricks_.z; ++z) {
+        for (size_t y = 0; y < numBricks_.y; ++y) {
+            for (size_t x = 0; x < numBricks_.x; ++x) {
+                const size3_t brick{x, y, z};
+                callback(*getEditableBrick(brick), getBrickOffset(brick));
+            }
+        }
+    }
+}
+
+double VolumeRAMBricked::getAsDouble(const size3_t& pos) const {
+    const auto brick = pos / brickSize_;
+    return getBrick(brick)->getAsDouble(pos - getBrickOffset(brick));
+}
+
+dvec4 VolumeRAMBricked::getAsDVec4(const size3_t& pos) const {
+    const auto brick = pos / brickSize_;
+    return getBrick(brick)->getAsDVec4(pos - getBrickOffset(brick));
+}
+
+void VolumeRAMBricked::setFromDouble(const size3_t& pos, double val) {
+    const auto brick = pos / brickSize_;
+    getEditableBrick(brick)->setFromDouble(pos - getBrickOffset(brick), val);
+}
+
+void VolumeRAMBricked::setFromDVec4(const size3_t& pos, dvec4 val) {
+    const auto brick = pos / brickSize_;
+    getEditableBrick(brick)->setFromDVec4(pos - getBrickOffset(brick), val);
+}
+
+size_t VolumeRAMBricked::getNumberOfBytes() const {
+    return glm::compMul(dimensions_) * getDataFormat()->getSize();
+}
+
+void VolumeRAMBricked::flush() const {
+    std::scoped_lock lock{mutex_};
+    for (auto& item : cache_) {
+        if (item.modified) {
+            write(item.index, *item.data);
+            // A brick still referenced from outside might be modified again after the write
+            if (item.data.use_count() == 1) item.modified = false;
+        }
+    }
+}
+
+void VolumeRAMBricked::copyBricks(const VolumeRAMBricked& src) {
+    std::vector<bool> present;
+    {
+        std::scoped_lock lock{src.mutex_};
+        present = src.stored_;
+        for (auto& item : src.cache_) present[item.index] = true;
+    }
+    // Bricks that were never written are implicitly zero and need not be copied
+    std::scoped_lock lock{mutex_};
+    for (size_t z = 0; z < numBricks_.z; ++z) {
+        for (size_t y = 0; y < numBricks_.y; ++y) {
+            for (size_t x = 0; x < numBricks_.x; ++x) {
+                const size3_t brick{x, y, z};
+                const auto index = brickIndex(brick);
+                if (present[index]) write(index, *src.getBrick(brick));
+            }
+        }
+    }
+}
+
+size_t VolumeRAMBricked::brickIndex(const size3_t& brick) const {
+    return brick.x + numBricks_.x * (brick.y + numBricks_.y * brick.z);
+}
+
+std::shared_ptr<VolumeRAM> VolumeRAMBricked::load(const size3_t& brick, bool modify) const {
+    const auto index = brickIndex(brick);
+
+    std::scoped_lock lock{mutex_};
+    if (auto it = cacheIndex_.find(index); it != cacheIndex_.end()) {
+        cache_.splice(cache_.begin(), cache_, it->second);
+        it->second->modified |= modify;
+        return it->second->data;
+    }
+
+    auto data = createVolumeRAM(getBrickDimensions(brick), getDataFormat(), nullptr, swizzleMask_,
+                                interpolation_, wrapping_);
+    if (stored_[index]) read(index, *data);
+
+    cache_.push_front(CachedBrick{index, data, modify});
+    cacheIndex_[index] = cache_.begin();
+    cachedBytes_ += data->getNumberOfBytes();
+    evict();
+    return data;
+}
+
+void VolumeRAMBricked::evict() const {
+    // Never evict the most recently used brick, nor bricks that are referenced from outside
+    auto it = cache_.end();
+    while (cachedBytes_ > cacheSize_ && it != cache_.begin() && std::prev(it) != cache_.begin()) {
+        --it;
+        if (it->data.use_count() > 1) continue;
+        if (it->modified) write(it->index, *it->data);
+        cachedBytes_ -= it->data->getNumberOfBytes();
+        cacheIndex_.erase(it->index);
+        it = cache_.erase(it);
+    }
+}
+
+void VolumeRAMBricked::write(size_t index, const VolumeRAM& brick) const {
+    if (!stream_.is_open()) {
+        file_ = createBrickFileName();
+        stream_ = filesystem::fstream(file_, std::ios::in | std::ios::out | std::ios::binary |
+                                                 std::ios::trunc);
+        if (!stream_.is_open()) {
+            throw Exception("Could not create brick file: " + file_, IVW_CONTEXT);
+        }
+    }
+    // All bricks use a slot of the full brick size in the file
+    const auto slotSize = glm::compMul(brickSize_) * getDataFormat()->getSize();
+    stream_.seekp(static_cast<std::streamoff>(index * slotSize));
+    stream_.write(static_cast<const char*>(brick.getData()), brick.getNumberOfBytes());
+    if (!stream_) {
+        stream_.clear();
+        throw Exception("Could not write brick to file: " + file_, IVW_CONTEXT);
+    }
+    stored_[index] = true;
+}
+
+void VolumeRAMBricked::read(size_t index, VolumeRAM& brick) const {
+    const auto slotSize = glm::compMul(brickSize_) * getDataFormat()->getSize();
+    stream_.seekg(static_cast<std::streamoff>(index * slotSize));
+    stream_.read(static_cast<char*>(brick.getData()), brick.getNumberOfBytes());
+    if (!stream_) {
+        stream_.clear();
+        throw Exception("Could not read brick from file: " + file_, IVW_CONTEXT);
+    }
+}
+
+void VolumeRAMBricked::reset() {
+    std::scoped_lock lock{mutex_};
+    cache_.clear();
+    cacheIndex_.clear();
+    cachedBytes_ = 0;
+    stored_.assign(glm::compMul(numBricks_), false);
+}
+
+}  // namespace inviwo
@@ -29,9 +29,49 @@
 
 #include <inviwo/core/datastructures/volume/volumeramconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/volumeregionloader.h>
+
+#include <cstring>
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * Copy a region of extent voxels from src starting at srcOffset to dst starting at dstOffset, row
+ * by row. Both volumes need to have the same format.
+ */
+void copyRegion(const VolumeRAM& src, size3_t srcOffset, VolumeRAM& dst, size3_t dstOffset,
+                size3_t extent) {
+    const auto elementSize = src.getDataFormat()->getSize();
+    const auto srcDims = src.getDimensions();
+    const auto dstDims = dst.getDimensions();
+    const auto srcData = static_cast<const char*>(src.getData());
+    const auto dstData = static_cast<char*>(dst.getData());
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto srcIndex = VolumeRAM::posToIndex(srcOffset + size3_t{0, y, z}, srcDims);
+            const auto dstIndex = VolumeRAM::posToIndex(dstOffset + size3_t{0, y, z}, dstDims);
+            std::memcpy(dstData + dstIndex * elementSize, srcData + srcIndex * elementSize,
+                        extent.x * elementSize);
+        }
+    }
+}
+
+void copyToBricks(const VolumeRAM& src, VolumeRAMBricked& dst) {
+    dst.forEachBrick([&](VolumeRAM& brick, const size3_t& offset) {
+        copyRegion(src, offset, brick, size3_t{0}, brick.getDimensions());
+    });
+}
+
+void copyFromBricks(const VolumeRAMBricked& src, VolumeRAM& dst) {
+    src.forEachBrick([&](const VolumeRAM& brick, const size3_t& offset) {
+        copyRegion(brick, size3_t{0}, dst, offset, brick.getDimensions());
+    });
+}
+
+}  // namespace
+
 std::shared_ptr<VolumeRAM> VolumeDisk2RAMConverter::createFrom(
     std::shared_ptr<const VolumeDisk> source) const {
     return std::static_pointer_cast<VolumeRAM>(source->createRepresentation());
@@ -42,4 +82,75 @@ void VolumeDisk2RAMConverter::update(std::shared_ptr<const VolumeDisk> source,
     source->updateRepresentation(destination);
 }
 
+std::shared_ptr<VolumeRAMBricked> VolumeDisk2RAMBrickedConverter::createFrom(
+    std::shared_ptr<const VolumeDisk> source) const {
+    auto bricked = std::make_shared<VolumeRAMBricked>(
+        source->getDimensions(), source->getDataFormat(), size3_t(64, 64, 64),
+        VolumeRAMBricked::defaultCacheSize, source->getSwizzleMask(), source->getInterpolation(),
+        source->getWrapping());
+    update(source, bricked);
+    return bricked;
+}
+
+void VolumeDisk2RAMBrickedConverter::update(std::shared_ptr<const VolumeDisk> source,
+                                            std::shared_ptr<VolumeRAMBricked> destination) const {
+    if (source->getDimensions() != destination->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    if (auto regions = dynamic_cast<const VolumeRegionLoader*>(source->getLoader())) {
+        // Only the bricks in the cache are in memory at any time
+        destination->forEachBrick([&](VolumeRAM& brick, const size3_t& offset) {
+            regions->readRegion(*source, offset, brick);
+        });
+    } else {
+        // The temporary VolumeRAM is released once all bricks are written
+        const auto volumeRAM = std::static_pointer_cast<VolumeRAM>(source->createRepresentation());
+        copyToBricks(*volumeRAM, *destination);
+    }
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeRAMBricked> VolumeRAM2RAMBrickedConverter::createFrom(
+    std::shared_ptr<const VolumeRAM> source) const {
+    auto bricked = std::make_shared<VolumeRAMBricked>(
+        source->getDimensions(), source->getDataFormat(), size3_t(64, 64, 64),
+        VolumeRAMBricked::defaultCacheSize, source->getSwizzleMask(), source->getInterpolation(),
+        source->getWrapping());
+    copyToBricks(*source, *bricked);
+    return bricked;
+}
+
+void VolumeRAM2RAMBrickedConverter::update(std::shared_ptr<const VolumeRAM> source,
+                                           std::shared_ptr<VolumeRAMBricked> destination) const {
+    if (source->getDimensions() != destination->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    copyToBricks(*source, *destination);
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumeRAMBricked2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeRAMBricked> source) const {
+    auto volumeRAM = createVolumeRAM(source->getDimensions(), source->getDataFormat(), nullptr,
+                                     source->getSwizzleMask(), source->getInterpolation(),
+                                     source->getWrapping());
+    copyFromBricks(*source, *volumeRAM);
+    return volumeRAM;
+}
+
+void VolumeRAMBricked2RAMConverter::update(std::shared_ptr<const VolumeRAMBricked> source,
+                                           std::shared_ptr<VolumeRAM> destination) const {
+    if (source->getDimensions() != destination->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    copyFromBricks(*source, *destination);
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
 }  // namespace inviwo
@@ -32,8 +32,20 @@
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
+namespace {
+
+void swapBytes(char* data, size_t bytes, size_t elementSize) {
+    for (size_t i = 0; i < bytes; i += elementSize) {
+        std::reverse(data + i, data + i + elementSize);
+    }
+}
+
+}  // namespace
+
 void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t bytes,
                                bool littleEndian, size_t elementSize, void* dest) {
     auto fin = filesystem::ifstream(file, std::ios::in | std::ios::binary);
@@ -42,19 +54,13 @@ void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t by
     if (fin.good()) {
         fin.seekg(offset);
         fin.read(static_cast<char*>(dest), bytes);
+        if (!fin) {
+            throw DataReaderException("Error: Unexpected end of file: " + file,
+                                      IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"));
+        }
 
         if (!littleEndian && elementSize > 1) {
-            char* temp = new char[elementSize];
-
-            for (std::size_t i = 0; i < bytes; i += elementSize) {
-                for (std::size_t j = 0; j < elementSize; j++)
-                    temp[j] = static_cast<char*>(dest)[i + j];
-
-                for (std::size_t j = 0; j < elementSize; j++)
-                    static_cast<char*>(dest)[i + j] = temp[elementSize - j - 1];
-            }
-
-            delete[] temp;
+            swapBytes(static_cast<char*>(dest), bytes, elementSize);
         }
     } else {
         throw DataReaderException("Error: Could not read from file: " + file,
@@ -62,4 +68,34 @@ void util::readBytesIntoBuffer(const std::string& file, size_t offset, size_t by
     }
 }
 
+void util::readRegionIntoBuffer(const std::string& file, size_t offset, size3_t dims,
+                                size3_t regionOffset, size3_t extent, bool littleEndian,
+                                size_t elementSize, void* dest) {
+    auto fin = filesystem::ifstream(file, std::ios::in | std::ios::binary);
+    if (!fin.good()) {
+        throw DataReaderException("Error: Could not read from file: " + file,
+                                  IVW_CONTEXT_CUSTOM("readRegionIntoBuffer"));
+    }
+
+    const auto rowBytes = extent.x * elementSize;
+    auto data = static_cast<char*>(dest);
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            const auto pos = regionOffset + size3_t{0, y, z};
+            const auto index = pos.x + dims.x * (pos.y + dims.y * pos.z);
+            fin.seekg(static_cast<std::streamoff>(offset + index * elementSize));
+            fin.read(data, rowBytes);
+            if (!fin) {
+                throw DataReaderException("Error: Unexpected end of file: " + file,
+                                          IVW_CONTEXT_CUSTOM("readRegionIntoBuffer"));
+            }
+            data += rowBytes;
+        }
+    }
+
+    if (!littleEndian && elementSize > 1) {
+        swapBytes(static_cast<char*>(dest), glm::compMul(extent) * elementSize, elementSize);
+    }
+}
+
 }  // namespace inviwo
@@ -37,7 +37,7 @@ namespace inviwo {
 
 bool DataWriterFactory::registerObject(DataWriter* writer) {
     for (auto& ext : writer->getExtensions()) {
-        util::insert_unique(map_, ext, writer);
+        if (util::insert_unique(map_, ext, writer)) ordered_.emplace_back(ext, writer);
     }
     return true;
 }
@@ -45,13 +45,14 @@ bool DataWriterFactory::registerObject(DataWriter* writer) {
 bool DataWriterFactory::unRegisterObject(DataWriter* writer) {
     size_t removed = util::map_erase_remove_if(
         map_, [writer](Map::value_type& elem) { return elem.second == writer; });
+    util::erase_remove_if(ordered_, [writer](const auto& elem) { return elem.second == writer; });
 
     return removed > 0;
 }
 
 std::unique_ptr<DataWriter> DataWriterFactory::create(const std::string& key) const {
     auto lkey = toLower(key);
-    for (auto& elem : map_) {
+    for (auto& elem : ordered_) {
         if (toLower(elem.first.extension_) == toLower(lkey)) {
             return std::unique_ptr<DataWriter>(elem.second->clone());
         }
@@ -68,7 +69,7 @@ bool DataWriterFactory::hasKey(const FileExtension& key) const { return util::ha
 
 bool DataWriterFactory::hasKey(const std::string& key) const {
     auto lkey = toLower(key);
-    for (auto& elem : map_) {
+    for (auto& elem : ordered_) {
         if (toLower(elem.first.extension_) == toLower(lkey)) return true;
     }
     return false;
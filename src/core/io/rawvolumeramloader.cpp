@@ -29,18 +29,87 @@
 
 #include <inviwo/core/io/rawvolumeramloader.h>
 
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/settings/systemsettings.h>
 
 namespace inviwo {
 
-RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian)
-    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian) {}
+namespace {
+
+/**
+ * A VolumeRAMPrecision that uses a copy-on-write memory mapping of the raw file as its data. The
+ * voxels are paged in from the file when first accessed and only written pages are copied.
+ */
+template <typename T>
+class MappedVolumeRAM : public VolumeRAMPrecision<T> {
+public:
+    MappedVolumeRAM(std::shared_ptr<util::MemoryMappedFile> mapping, size3_t dimensions,
+                    const SwizzleMask& swizzleMask, InterpolationType interpolation,
+                    const Wrapping3D& wrapping)
+        : VolumeRAMPrecision<T>(static_cast<T*>(mapping->data()), dimensions, swizzleMask,
+                                interpolation, wrapping)
+        , mapping_{std::move(mapping)} {
+        this->removeDataOwnership();
+    }
+    virtual ~MappedVolumeRAM() = default;
+
+private:
+    std::shared_ptr<util::MemoryMappedFile> mapping_;
+};
+
+struct MappedVolumeRamCreationDispatcher {
+    using type = std::shared_ptr<VolumeRAM>;
+    template <typename Result, typename Format>
+    std::shared_ptr<VolumeRAM> operator()(const std::string& file, size_t offset,
+                                          const VolumeRepresentation& src) {
+        using F = typename Format::type;
+        // The mapping is page aligned, the voxels have to be aligned within the file as well.
+        if (offset % alignof(F) != 0) return nullptr;
+
+        const auto dims = src.getDimensions();
+        auto mapping =
+            std::make_shared<util::MemoryMappedFile>(file, offset, glm::compMul(dims) * sizeof(F));
+        return std::make_shared<MappedVolumeRAM<F>>(std::move(mapping), dims, src.getSwizzleMask(),
+                                                    src.getInterpolation(), src.getWrapping());
+    }
+};
+
+}  // namespace
+
+RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                                       bool useMemoryMapping)
+    : rawFile_(rawFile)
+    , offset_(offset)
+    , littleEndian_(littleEndian)
+    , useMemoryMapping_(useMemoryMapping) {}
 
 RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAMLoader(*this); }
 
+bool RawVolumeRAMLoader::isMemoryMappingEnabled() {
+    return InviwoApplication::isInitialized() &&
+           InviwoApplication::getPtr()->getSystemSettings().memoryMapRawVolumes_;
+}
+
 std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
+    // Data that does not need byte swapping can be used directly from the file
+    if (useMemoryMapping_ && (littleEndian_ || src.getDataFormat()->getSize() == 1)) {
+        try {
+            MappedVolumeRamCreationDispatcher disp;
+            if (auto volumeRAM =
+                    dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+                        src.getDataFormat()->getId(), disp, rawFile_, offset_, src)) {
+                return volumeRAM;
+            }
+        } catch (const FileException&) {
+            // Fall back to reading the file, which will report any errors
+        }
+    }
+
     const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
     auto data = std::make_unique<char[]>(size);
     util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
@@ -70,4 +139,12 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
     volumeDst->setInterpolation(src.getInterpolation());
     volumeDst->setWrapping(src.getWrapping());
 }
+
+void RawVolumeRAMLoader::readRegion(const VolumeRepresentation& src, const size3_t& offset,
+                                    VolumeRAM& dest) const {
+    util::readRegionIntoBuffer(rawFile_, offset_, src.getDimensions(), offset,
+                               dest.getDimensions(), littleEndian_,
+                               src.getDataFormat()->getSize(), dest.getData());
+}
+
 }  // namespace inviwo
@@ -174,7 +174,8 @@ std::shared_ptr<Volume> RawVolumeReader::readData(const std::string& filePath,
         volume->setOffset(offset);
         volume->setWorldMatrix(wtm);
         auto vd = std::make_shared<VolumeDisk>(filePath, dimensions_, format_);
-        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, byteOffset_, littleEndian_);
+        auto loader = std::make_unique<RawVolumeRAMLoader>(
+            rawFile_, byteOffset_, littleEndian_, RawVolumeRAMLoader::isMemoryMappingEnabled());
         vd->setLoader(loader.release());
         volume->addRepresentation(vd);
 
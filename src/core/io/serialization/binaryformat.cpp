@@ -0,0 +1,451 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binaryformat.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/serializeconstants.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace binaryformat {
+
+namespace {
+
+// Same structure as the png signature, the leading non-ascii byte can never start an xml document
+constexpr std::array<char, 8> signature = {'\x89', 'I', 'V', 'W', '\r', '\n', '\x1a', '\n'};
+
+enum class NodeType : unsigned char { Element = 0, Text = 1, Comment = 2, End = 3 };
+
+using Tag = std::array<char, 4>;
+constexpr Tag stringsTag = {'S', 'T', 'R', 'S'};
+constexpr Tag treeTag = {'T', 'R', 'E', 'E'};
+constexpr Tag blobTag = {'B', 'L', 'O', 'B'};
+constexpr Tag endTag = {'E', 'N', 'D', ' '};
+
+constexpr char base64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void writeFixed(std::ostream& stream, std::uint64_t value, size_t bytes) {
+    std::array<char, 8> buf{};
+    for (size_t i = 0; i < bytes; ++i) buf[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    stream.write(buf.data(), bytes);
+}
+
+std::uint64_t readFixed(std::istream& stream, size_t bytes) {
+    std::array<unsigned char, 8> buf{};
+    stream.read(reinterpret_cast<char*>(buf.data()), bytes);
+    std::uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) value |= std::uint64_t{buf[i]} << (8 * i);
+    return value;
+}
+
+void writeChunk(std::ostream& stream, const Tag& tag, const char* data, size_t size) {
+    stream.write(tag.data(), tag.size());
+    writeFixed(stream, size, 8);
+    stream.write(data, size);
+}
+
+void putVarint(std::string& buf, std::uint64_t value) {
+    while (value >= 0x80) {
+        buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<char>(value));
+}
+
+void putString(std::string& buf, const std::string& str) {
+    putVarint(buf, str.size());
+    buf.append(str);
+}
+
+class StringTable {
+public:
+    size_t operator()(const std::string& str) {
+        auto [it, inserted] = indices_.try_emplace(str, strings_.size());
+        if (inserted) strings_.push_back(&it->first);
+        return it->second;
+    }
+
+    std::string encode() const {
+        std::string buf;
+        putVarint(buf, strings_.size());
+        for (auto str : strings_) putString(buf, *str);
+        return buf;
+    }
+
+private:
+    std::unordered_map<std::string, size_t> indices_;
+    std::vector<const std::string*> strings_;
+};
+
+/**
+ * Writes the element tree in document order. Child nodes follow their parent element directly
+ * and are terminated by an End marker.
+ */
+class TreeWriter : public TiXmlVisitor {
+public:
+    virtual bool VisitEnter(const TiXmlElement& elem, const TiXmlAttribute* first) override {
+        buf.push_back(static_cast<char>(NodeType::Element));
+        putVarint(buf, strings(elem.ValueStr()));
+
+        size_t attributes = 0;
+        for (auto attr = first; attr; attr = attr->Next()) ++attributes;
+        putVarint(buf, attributes);
+        for (auto attr = first; attr; attr = attr->Next()) {
+            putVarint(buf, strings(attr->NameTStr()));
+            putString(buf, attr->ValueStr());
+        }
+        return true;
+    }
+    virtual bool VisitExit(const TiXmlElement&) override {
+        buf.push_back(static_cast<char>(NodeType::End));
+        return true;
+    }
+    virtual bool Visit(const TiXmlText& text) override {
+        buf.push_back(static_cast<char>(NodeType::Text));
+        putString(buf, text.ValueStr());
+        return true;
+    }
+    virtual bool Visit(const TiXmlComment& comment) override {
+        buf.push_back(static_cast<char>(NodeType::Comment));
+        putString(buf, comment.ValueStr());
+        return true;
+    }
+
+    std::string buf;
+    StringTable strings;
+};
+
+class ChunkReader {
+public:
+    ChunkReader(const std::string& buf) : buf_{buf} {}
+
+    bool atEnd() const { return pos_ == buf_.size(); }
+
+    unsigned char byte() {
+        check(1);
+        return static_cast<unsigned char>(buf_[pos_++]);
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto b = byte();
+            value |= std::uint64_t{b & 0x7fu} << shift;
+            if ((b & 0x80) == 0) return value;
+        }
+        throw SerializationException("Invalid binary document: malformed integer",
+                                     IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+
+    size_t remaining() const { return buf_.size() - pos_; }
+
+    std::string string() {
+        const auto size = varint();
+        check(size);
+        std::string str{buf_.data() + pos_, static_cast<size_t>(size)};
+        pos_ += static_cast<size_t>(size);
+        return str;
+    }
+
+private:
+    void check(std::uint64_t size) const {
+        if (size > buf_.size() - pos_) {
+            throw SerializationException("Invalid binary document: unexpected end of chunk",
+                                         IVW_CONTEXT_CUSTOM("binaryformat::read"));
+        }
+    }
+
+    const std::string& buf_;
+    size_t pos_ = 0;
+};
+
+const std::string& lookup(const std::vector<std::string>& strings, std::uint64_t index) {
+    if (index >= strings.size()) {
+        throw SerializationException(
+            fmt::format("Invalid binary document: string index {} out of range", index),
+            IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+    return strings[static_cast<size_t>(index)];
+}
+
+// Reads nodes into parent until an End marker, or the end of the chunk for the top level
+void readNodes(ChunkReader& reader, const std::vector<std::string>& strings, TxNode& parent) {
+    while (!reader.atEnd()) {
+        switch (static_cast<NodeType>(reader.byte())) {
+            case NodeType::Element: {
+                TxElement elem(lookup(strings, reader.varint()));
+                parent.LinkEndChild(&elem);
+                const auto attributes = reader.varint();
+                for (std::uint64_t i = 0; i < attributes; ++i) {
+                    const auto& key = lookup(strings, reader.varint());
+                    elem.SetAttribute(key, reader.string());
+                }
+                readNodes(reader, strings, elem);
+                break;
+            }
+            case NodeType::Text: {
+                ticpp::Text text(reader.string());
+                parent.LinkEndChild(&text);
+                break;
+            }
+            case NodeType::Comment: {
+                TxComment comment;
+                comment.SetValue(reader.string());
+                parent.LinkEndChild(&comment);
+                break;
+            }
+            case NodeType::End:
+                return;
+            default:
+                throw SerializationException("Invalid binary document: unknown node type",
+                                             IVW_CONTEXT_CUSTOM("binaryformat::read"));
+        }
+    }
+}
+
+// Bytes left in a seekable stream, or the maximum value if the stream can not tell
+std::uint64_t remaining(std::istream& stream) {
+    const auto pos = stream.tellg();
+    if (pos == std::istream::pos_type(-1)) return std::numeric_limits<std::uint64_t>::max();
+    stream.seekg(0, std::ios::end);
+    const auto end = stream.tellg();
+    stream.seekg(pos);
+    if (end == std::istream::pos_type(-1) || end < pos) {
+        stream.clear();
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return static_cast<std::uint64_t>(end - pos);
+}
+
+void checkSize(std::uint64_t size, std::uint64_t available) {
+    if (size > available) {
+        throw SerializationException(
+            fmt::format("Invalid binary document: chunk of {} bytes exceeds the remaining {} bytes",
+                        size, available),
+            IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+}
+
+/**
+ * Reads a chunk payload of a size already checked against the stream length. The buffer is grown
+ * in steps so that a corrupt size in a stream that can not report its length fails at the end of
+ * the stream rather than with a huge allocation.
+ */
+template <typename Buffer>
+void readPayload(std::istream& stream, std::uint64_t size, Buffer& dest) {
+    constexpr std::uint64_t step = std::uint64_t{1} << 24;
+    dest.clear();
+    for (std::uint64_t done = 0; done < size;) {
+        const auto count = static_cast<size_t>(std::min(step, size - done));
+        dest.resize(dest.size() + count);
+        stream.read(reinterpret_cast<char*>(dest.data()) + done,
+                    static_cast<std::streamsize>(count));
+        if (!stream) {
+            throw SerializationException("Invalid binary document: unexpected end of stream",
+                                         IVW_CONTEXT_CUSTOM("binaryformat::read"));
+        }
+        done += count;
+    }
+}
+
+void skipPayload(std::istream& stream, std::uint64_t size) {
+    constexpr std::uint64_t step = std::uint64_t{1} << 30;
+    for (std::uint64_t done = 0; done < size;) {
+        const auto count = std::min(step, size - done);
+        stream.ignore(static_cast<std::streamsize>(count));
+        if (!stream || static_cast<std::uint64_t>(stream.gcount()) != count) {
+            throw SerializationException("Invalid binary document: unexpected end of stream",
+                                         IVW_CONTEXT_CUSTOM("binaryformat::read"));
+        }
+        done += count;
+    }
+}
+
+}  // namespace
+
+bool isBinary(std::istream& stream) {
+    return stream.peek() == static_cast<unsigned char>(signature[0]);
+}
+
+void write(std::ostream& stream, const TxDocument& doc, const std::vector<Blob>& blobs) {
+    TreeWriter writer;
+    doc.Accept(&writer);
+    const auto& tree = writer.buf;
+    const auto table = writer.strings.encode();
+
+    stream.write(signature.data(), signature.size());
+    writeFixed(stream, version, 4);
+    writeChunk(stream, stringsTag, table.data(), table.size());
+    writeChunk(stream, treeTag, tree.data(), tree.size());
+    for (const auto& blob : blobs) {
+        writeChunk(stream, blobTag, reinterpret_cast<const char*>(blob.data()), blob.size());
+    }
+    writeChunk(stream, endTag, nullptr, 0);
+
+    if (!stream) {
+        throw SerializationException("Failed to write binary document",
+                                     IVW_CONTEXT_CUSTOM("binaryformat::write"));
+    }
+}
+
+void read(std::istream& stream, TxDocument& doc, std::vector<Blob>& blobs) {
+    std::array<char, 8> sig{};
+    stream.read(sig.data(), sig.size());
+    if (!stream || sig != signature) {
+        throw SerializationException("Invalid binary document: missing signature",
+                                     IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+    const auto fileVersion = readFixed(stream, 4);
+    if (!stream) {
+        throw SerializationException("Invalid binary document: unexpected end of stream",
+                                     IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+    if (fileVersion > version) {
+        throw SerializationException(
+            fmt::format("Unsupported binary document version {}, expected {} or lower",
+                        fileVersion, version),
+            IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+
+    std::vector<std::string> strings;
+    bool hasTree = false;
+    std::string buf;
+    while (true) {
+        Tag tag{};
+        stream.read(tag.data(), tag.size());
+        const auto size = readFixed(stream, 8);
+        if (!stream) {
+            throw SerializationException("Invalid binary document: unexpected end of stream",
+                                         IVW_CONTEXT_CUSTOM("binaryformat::read"));
+        }
+
+        if (tag == endTag) break;
+
+        checkSize(size, remaining(stream));
+        if (tag == blobTag) {
+            readPayload(stream, size, blobs.emplace_back());
+        } else if (tag == stringsTag || tag == treeTag) {
+            readPayload(stream, size, buf);
+
+            ChunkReader reader{buf};
+            if (tag == stringsTag) {
+                // Every string needs at least one byte for its length
+                const auto count = reader.varint();
+                if (count > reader.remaining()) {
+                    throw SerializationException(
+                        fmt::format("Invalid binary document: {} strings in a chunk of {} bytes",
+                                    count, size),
+                        IVW_CONTEXT_CUSTOM("binaryformat::read"));
+                }
+                strings.resize(static_cast<size_t>(count));
+                for (auto& str : strings) str = reader.string();
+            } else {
+                TxDeclaration decl(SerializeConstants::XmlVersion, "", "");
+                doc.LinkEndChild(&decl);
+                readNodes(reader, strings, doc);
+                hasTree = true;
+            }
+        } else {
+            skipPayload(stream, size);
+        }
+    }
+
+    if (!hasTree) {
+        throw SerializationException("Invalid binary document: missing element tree",
+                                     IVW_CONTEXT_CUSTOM("binaryformat::read"));
+    }
+}
+
+std::string toBase64(const unsigned char* data, size_t size) {
+    std::string str;
+    str.reserve(4 * ((size + 2) / 3));
+    size_t i = 0;
+    for (; i + 2 < size; i += 3) {
+        const auto triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        str.push_back(base64Chars[(triple >> 18) & 0x3f]);
+        str.push_back(base64Chars[(triple >> 12) & 0x3f]);
+        str.push_back(base64Chars[(triple >> 6) & 0x3f]);
+        str.push_back(base64Chars[triple & 0x3f]);
+    }
+    if (i < size) {
+        const auto triple = (data[i] << 16) | (i + 1 < size ? data[i + 1] << 8 : 0);
+        str.push_back(base64Chars[(triple >> 18) & 0x3f]);
+        str.push_back(base64Chars[(triple >> 12) & 0x3f]);
+        str.push_back(i + 1 < size ? base64Chars[(triple >> 6) & 0x3f] : '=');
+        str.push_back('=');
+    }
+    return str;
+}
+
+Blob fromBase64(const std::string& str) {
+    std::array<int, 256> lookup;
+    lookup.fill(-1);
+    for (int i = 0; i < 64; ++i) lookup[static_cast<unsigned char>(base64Chars[i])] = i;
+
+    Blob blob;
+    blob.reserve(3 * str.size() / 4);
+    std::uint32_t bits = 0;
+    int count = 0;
+    for (auto c : str) {
+        if (c == '=') break;
+        const auto value = lookup[static_cast<unsigned char>(c)];
+        if (value < 0) {
+            throw SerializationException(
+                fmt::format("Invalid base64 character '{}'", c),
+                IVW_CONTEXT_CUSTOM("binaryformat::fromBase64"));
+        }
+        bits = (bits << 6) | static_cast<std::uint32_t>(value);
+        if (++count == 4) {
+            blob.push_back(static_cast<unsigned char>(bits >> 16));
+            blob.push_back(static_cast<unsigned char>(bits >> 8));
+            blob.push_back(static_cast<unsigned char>(bits));
+            bits = 0;
+            count = 0;
+        }
+    }
+    if (count == 2) {
+        blob.push_back(static_cast<unsigned char>(bits >> 4));
+    } else if (count == 3) {
+        blob.push_back(static_cast<unsigned char>(bits >> 10));
+        blob.push_back(static_cast<unsigned char>(bits >> 2));
+    }
+    return blob;
+}
+
+}  // namespace binaryformat
+
+}  // namespace inviwo
@@ -38,13 +38,19 @@
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/filesystem.h>
 
 namespace inviwo {
 
 Deserializer::Deserializer(std::string fileName, bool allowReference)
     : SerializeBase(fileName, allowReference) {
     try {
-        doc_.LoadFile();
+        auto stream = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+        if (stream.is_open() && binaryformat::isBinary(stream)) {
+            binaryformat::read(stream, doc_, blobs_);
+        } else {
+            doc_.LoadFile();
+        }
         rootElement_ = doc_.FirstChildElement();
         storeReferences(rootElement_);
         rootElement_->GetAttribute(SerializeConstants::VersionAttribute, &inviwoWorkspaceVersion_,
@@ -69,6 +75,25 @@ void Deserializer::deserialize(const std::string& key, Serializable& sObj) {
     if (NodeSwitch ns{*this, key}) sObj.deserialize(*this);
 }
 
+void Deserializer::deserializeBlob(const std::string& key, binaryformat::Blob& blob) {
+    NodeSwitch ns{*this, key};
+    if (!ns) return;
+
+    if (auto index = rootElement_->GetAttributeOrDefault(SerializeConstants::BlobAttribute, "");
+        !index.empty()) {
+        const auto i = stringTo<size_t>(index);
+        if (i >= blobs_.size()) {
+            throw SerializationException(
+                "Blob index " + index + " out of range, found " + toString(blobs_.size()),
+                IVW_CONTEXT, key);
+        }
+        blob = blobs_[i];
+    } else {
+        blob = binaryformat::fromBase64(
+            rootElement_->GetAttributeOrDefault(SerializeConstants::ContentAttribute, ""));
+    }
+}
+
 void Deserializer::deserialize(const std::string& key, signed char& data,
                                const SerializationTarget& target) {
     int val = data;
@@ -121,7 +121,11 @@ SerializeBase::SerializeBase(std::string fileName, bool allowReference)
 
 SerializeBase::SerializeBase(std::istream& stream, const std::string& path, bool allowReference)
     : fileName_(path), allowRef_(allowReference), retrieveChild_(true) {
-    stream >> doc_;
+    if (binaryformat::isBinary(stream)) {
+        binaryformat::read(stream, doc_, blobs_);
+    } else {
+        stream >> doc_;
+    }
 }
 
 const std::string& SerializeBase::getFileName() const { return fileName_; }
@@ -37,6 +37,7 @@ const int SerializeConstants::InviwoWorkspaceVersion = 2;
 const std::string SerializeConstants::VersionAttribute = "version";
 const std::string SerializeConstants::ContentAttribute = "content";
 const std::string SerializeConstants::KeyAttribute = "key";
+const std::string SerializeConstants::BlobAttribute = "blob";
 
 const std::string SerializeConstants::TypeAttribute = "type";
 const std::string SerializeConstants::RefAttribute = "reference";
@@ -58,6 +58,26 @@ void Serializer::serialize(const std::string& key, const Serializable& sObj) {
     sObj.serialize(*this);
 }
 
+void Serializer::serializeBlob(const std::string& key, binaryformat::Blob blob) {
+    auto node = std::make_unique<TxElement>(key);
+    rootElement_->LinkEndChild(node.get());
+    blobNodes_.push_back(*node);
+    blobs_.push_back(std::move(blob));
+}
+
+void Serializer::prepareBlobs(SerializationFormat format) {
+    for (size_t i = 0; i < blobNodes_.size(); ++i) {
+        if (format == SerializationFormat::Binary) {
+            blobNodes_[i].RemoveAttribute(SerializeConstants::ContentAttribute);
+            blobNodes_[i].SetAttribute(SerializeConstants::BlobAttribute, i);
+        } else {
+            blobNodes_[i].RemoveAttribute(SerializeConstants::BlobAttribute);
+            blobNodes_[i].SetAttribute(SerializeConstants::ContentAttribute,
+                                       binaryformat::toBase64(blobs_[i].data(), blobs_[i].size()));
+        }
+    }
+}
+
 void Serializer::serialize(const std::string& key, const signed char& data,
                            const SerializationTarget& target) {
     serialize(key, static_cast<int>(data), target);
@@ -74,6 +94,7 @@ void Serializer::serialize(const std::string& key, const unsigned char& data,
 void Serializer::writeFile() {
     try {
         refDataContainer_.setReferenceAttributes();
+        prepareBlobs(SerializationFormat::Xml);
         doc_.SaveFile(getFileName());
     } catch (TxException& e) {
         throw SerializationException(e.what(), IVW_CONTEXT);
@@ -83,6 +104,7 @@ void Serializer::writeFile() {
 void Serializer::writeFile(std::ostream& stream, bool format) {
     try {
         refDataContainer_.setReferenceAttributes();
+        prepareBlobs(SerializationFormat::Xml);
         if (format) {
             TiXmlPrinter printer;
             printer.SetIndent("    ");
@@ -96,4 +118,22 @@ void Serializer::writeFile(std::ostream& stream, bool format) {
     }
 }
 
+void Serializer::writeBinaryFile(std::ostream& stream) {
+    try {
+        refDataContainer_.setReferenceAttributes();
+        prepareBlobs(SerializationFormat::Binary);
+        binaryformat::write(stream, doc_, blobs_);
+    } catch (TxException& e) {
+        throw SerializationException(e.what(), IVW_CONTEXT);
+    }
+}
+
+void Serializer::writeFile(std::ostream& stream, SerializationFormat format) {
+    if (format == SerializationFormat::Binary) {
+        writeBinaryFile(stream);
+    } else {
+        writeFile(stream, true);
+    }
+}
+
 }  // namespace inviwo
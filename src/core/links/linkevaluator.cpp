@@ -38,6 +38,8 @@
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/properties/compositeproperty.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 LinkEvaluator::LinkEvaluator(ProcessorNetwork* network) : network_(network) {}
@@ -59,7 +61,7 @@ void LinkEvaluator::addLink(const PropertyLink& propertyLink) {
         propertyLinkPrimaryCache_.erase(src);
     }
 
-    propertyLinkSecondaryCache_.clear();
+    plansDirty_ = true;
 }
 
 bool LinkEvaluator::canLink(const Property* src, const Property* dst) const {
@@ -93,7 +95,7 @@ void LinkEvaluator::removeLink(const PropertyLink& propertyLink) {
         propertyLinkPrimaryCache_.erase(src);
     }
 
-    propertyLinkSecondaryCache_.clear();
+    plansDirty_ = true;
 }
 
 std::vector<PropertyLink> LinkEvaluator::getLinksBetweenProcessors(Processor* p1, Processor* p2) {
@@ -105,73 +107,125 @@ std::vector<PropertyLink> LinkEvaluator::getLinksBetweenProcessors(Processor* p1
     }
 }
 
-std::vector<LinkEvaluator::Link>& LinkEvaluator::getTriggerdLinksForProperty(Property* property) {
-    if (propertyLinkSecondaryCache_.find(property) != propertyLinkSecondaryCache_.end()) {
-        return propertyLinkSecondaryCache_[property];
+bool LinkEvaluator::Plan::involves(Property* property) const {
+    return std::binary_search(members.begin(), members.end(), property);
+}
+
+std::shared_ptr<const LinkEvaluator::Plan> LinkEvaluator::getPlan(Property* property) {
+    if (plansDirty_) compile();
+    auto it = plans_.find(property);
+    return it != plans_.end() ? it->second : nullptr;
+}
+
+std::vector<Property*> LinkEvaluator::getPropertiesLinkedTo(Property* property) {
+    if (auto plan = getPlan(property)) {
+        return util::transform(plan->links, [](const Link& link) { return link.dst_; });
     } else {
-        return addToSecondaryCache(property);
+        return {};
     }
 }
 
-std::vector<Property*> LinkEvaluator::getPropertiesLinkedTo(Property* property) {
-    // check if link connectivity has been computed and cached already
-    auto& list = (propertyLinkSecondaryCache_.find(property) != propertyLinkSecondaryCache_.end())
-                     ? propertyLinkSecondaryCache_[property]
-                     : addToSecondaryCache(property);
+void LinkEvaluator::compile() {
+    plans_.clear();
+    std::unordered_set<Property*> members;
+    for (auto& item : propertyLinkPrimaryCache_) {
+        auto plan = std::make_shared<Plan>();
+        members.clear();
+        for (auto dst : item.second) {
+            if (item.first != dst) compileHelper(plan->links, members, item.first, dst);
+        }
+        if (plan->links.empty()) continue;
 
-    return util::transform(list, [](const Link& link) { return link.dst_; });
+        plan->members.assign(members.begin(), members.end());
+        std::sort(plan->members.begin(), plan->members.end());
+        plans_[item.first] = std::move(plan);
+    }
+    plansDirty_ = false;
 }
 
-std::vector<LinkEvaluator::Link>& LinkEvaluator::addToSecondaryCache(Property* src) {
-    for (auto& dst : propertyLinkPrimaryCache_[src]) {
-        if (src != dst) secondaryCacheHelper(propertyLinkSecondaryCache_[src], src, dst);
+void LinkEvaluator::compileOutgoing(std::vector<Link>& links,
+                                    std::unordered_set<Property*>& members, Property* src) {
+    auto it = propertyLinkPrimaryCache_.find(src);
+    if (it == propertyLinkPrimaryCache_.end()) return;
+    for (auto dst : it->second) {
+        if (src != dst) compileHelper(links, members, src, dst);
     }
-    return propertyLinkSecondaryCache_[src];
 }
 
-void LinkEvaluator::secondaryCacheHelper(std::vector<Link>& links, Property* src, Property* dst) {
+void LinkEvaluator::compileHelper(std::vector<Link>& links, std::unordered_set<Property*>& members,
+                                  Property* src, Property* dst) {
     // Check that we don't use a previous source or destination as the new destination.
-    if (!util::contains_if(
-            links, [dst](const Link& link) { return link.src_ == dst || link.dst_ == dst; })) {
-        auto manager = network_->getApplication()->getPropertyConverterManager();
-        if (auto converter = manager->getConverter(src, dst)) {
-            links.emplace_back(src, dst, converter);
-        }
+    if (members.count(dst) != 0) return;
 
-        // Follow the links of destination all links of all owners (CompositeProperties).
-        for (Property* newSrc = dst; newSrc != nullptr;
-             newSrc = dynamic_cast<Property*>(newSrc->getOwner())) {
-            // Recurse over outgoing links.
-            for (auto& elem : propertyLinkPrimaryCache_[newSrc]) {
-                if (newSrc != elem) secondaryCacheHelper(links, newSrc, elem);
-            }
-        }
+    auto manager = network_->getApplication()->getPropertyConverterManager();
+    if (auto converter = manager->getConverter(src, dst)) {
+        links.emplace_back(src, dst, converter);
+        members.insert(src);
+        members.insert(dst);
+    }
+
+    // Follow the links of destination all links of all owners (CompositeProperties).
+    for (Property* newSrc = dst; newSrc != nullptr;
+         newSrc = dynamic_cast<Property*>(newSrc->getOwner())) {
+        // Recurse over outgoing links.
+        compileOutgoing(links, members, newSrc);
+    }
 
-        // If we link to a CompositeProperty, make sure to evaluate sub-links.
-        if (auto cp = dynamic_cast<CompositeProperty*>(dst)) {
-            for (auto& srcProp : cp->getProperties()) {
-                // Recurse over outgoing links.
-                for (auto& elem : propertyLinkPrimaryCache_[srcProp]) {
-                    if (srcProp != elem) secondaryCacheHelper(links, srcProp, elem);
-                }
-            }
+    // If we link to a CompositeProperty, make sure to evaluate sub-links.
+    if (auto cp = dynamic_cast<CompositeProperty*>(dst)) {
+        for (auto& srcProp : cp->getProperties()) {
+            // Recurse over outgoing links.
+            compileOutgoing(links, members, srcProp);
         }
     }
 }
 
-bool LinkEvaluator::isLinking() const { return !visited_.empty(); }
+bool LinkEvaluator::isLinking() const { return !active_.empty(); }
 
 void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
-    if (util::contains(visited_, modifiedProperty)) return;
+    if (util::contains_if(active_, [&](const std::shared_ptr<const Plan>& plan) {
+            return plan->involves(modifiedProperty);
+        })) {
+        return;
+    }
+
+    auto plan = getPlan(modifiedProperty);
+    if (!plan) return;
+
+    if (batchDepth_ > 0) {
+        util::erase_remove(pending_, modifiedProperty);
+        pending_.push_back(modifiedProperty);
+        return;
+    }
 
     NetworkLock lock(network_);
 
-    auto& links = getTriggerdLinksForProperty(modifiedProperty);
-    VisitedHelper helper(visited_, links);
+    active_.push_back(plan);
+    util::OnScopeExit popActive{[this]() { active_.pop_back(); }};
 
-    for (auto& link : links) {
+    for (auto& link : plan->links) {
         link.converter_->convert(link.src_, link.dst_);
     }
 }
 
+void LinkEvaluator::beginBatch() { ++batchDepth_; }
+
+void LinkEvaluator::endBatch() {
+    if (batchDepth_ == 0 || --batchDepth_ > 0) return;
+
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        // Pending properties are only compared by address here, they might have been removed
+        // while batching, in which case they will not have a plan any more.
+        const auto overwritten = std::any_of(it + 1, pending.end(), [&](Property* later) {
+            auto plan = getPlan(later);
+            return plan && plan->involves(*it);
+        });
+        if (!overwritten) evaluateLinksFromProperty(*it);
+    }
+}
+
+bool LinkEvaluator::isBatching() const { return batchDepth_ > 0; }
+
 }  // namespace inviwo
@@ -49,7 +49,8 @@ ProcessorNetwork::ProcessorNetwork(InviwoApplication* application)
     , ProcessorObserver()
     , PropertyOwnerObserver()
     , application_(application)
-    , linkEvaluator_(this) {}
+    , linkEvaluator_(this)
+    , mainThread_(std::this_thread::get_id()) {}
 
 ProcessorNetwork::~ProcessorNetwork() {
     lock();
@@ -282,6 +283,10 @@ void ProcessorNetwork::evaluateLinksFromProperty(Property* source) {
     linkEvaluator_.evaluateLinksFromProperty(source);
 }
 
+void ProcessorNetwork::beginLinkBatch() { linkEvaluator_.beginBatch(); }
+
+void ProcessorNetwork::endLinkBatch() { linkEvaluator_.endBatch(); }
+
 void ProcessorNetwork::clear() {
     NetworkLock lock(this);
 
@@ -293,19 +298,29 @@ void ProcessorNetwork::clear() {
 
 bool ProcessorNetwork::isEmpty() const { return processors_.empty(); }
 
-bool ProcessorNetwork::isInvalidating() const { return !processorsInvalidating_.empty(); }
+bool ProcessorNetwork::isInvalidating() const {
+    std::lock_guard<std::mutex> lock{invalidatingMutex_};
+    return !processorsInvalidating_.empty();
+}
 
 bool ProcessorNetwork::isLinking() const { return linkEvaluator_.isLinking(); }
 
 void ProcessorNetwork::onProcessorInvalidationBegin(Processor* p) {
+    std::lock_guard<std::mutex> lock{invalidatingMutex_};
     util::push_back_unique(processorsInvalidating_, p);
 }
 
 void ProcessorNetwork::onProcessorInvalidationEnd(Processor* p) {
-    util::erase_remove(processorsInvalidating_, p);
+    {
+        std::lock_guard<std::mutex> lock{invalidatingMutex_};
+        util::erase_remove(processorsInvalidating_, p);
+        if (!processorsInvalidating_.empty()) return;
+    }
 
-    if (processorsInvalidating_.empty()) {
+    if (std::this_thread::get_id() == mainThread_) {
         notifyObserversProcessorNetworkEvaluateRequest();
+    } else {
+        deferredEvaluateRequest_ = true;
     }
 }
 
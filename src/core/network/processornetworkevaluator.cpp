@@ -32,25 +32,43 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
-#include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/poolprocessor.h>
+
+#include <future>
+#include <unordered_map>
+#include <algorithm>
 
 namespace inviwo {
 
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , evaluating_(false)
+    , evaluationPosition_(0)
     , evaulationQueued_(false)
+    , parallelEvaluation_(false)
     , exceptionHandler_(StandardEvaluationErrorHandler()) {
 
     processorNetwork_->addObserver(this);
+    for (auto processor : processorNetwork_->getProcessors()) {
+        onProcessorNetworkDidAddProcessor(processor);
+    }
+    for (auto& connection : processorNetwork_->getConnections()) {
+        onProcessorNetworkDidAddConnection(connection);
+    }
 }
 
 void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handler) {
     exceptionHandler_ = handler;
 }
 
+void ProcessorNetworkEvaluator::setParallelEvaluation(bool enable) { parallelEvaluation_ = enable; }
+
+bool ProcessorNetworkEvaluator::getParallelEvaluation() const { return parallelEvaluation_; }
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -93,6 +111,54 @@ void ProcessorNetworkEvaluator::requestEvaluate() {
     evaluate();
 }
 
+bool ProcessorNetworkEvaluator::prepare(Processor* processor) {
+    if (processor->isValid()) return false;
+
+    if (!processor->isReady()) {
+        try {
+            processor->doIfNotReady();
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+        }
+        return false;
+    }
+
+    try {
+        // re-initialize resources (e.g., shaders) if necessary
+        if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+            processor->initializeResources();
+        }
+
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
+
+    try {
+        // call onChange for all invalid inports
+        for (auto inport : processor->getInports()) {
+            inport->callOnChangeIfChanged();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
+
+    processor->notifyObserversAboutToProcess(processor);
+    return true;
+}
+
+void ProcessorNetworkEvaluator::finish(Processor* processor) {
+    // Set processor as valid only if we still are ready.
+    // Callbacks might have made our inports invalid, if so abort
+    // the evaluation by not setting the processor valid.
+    if (processor->isReady()) processor->setValid();
+
+    processor->notifyObserversFinishedProcess(processor);
+}
+
 void ProcessorNetworkEvaluator::evaluate() {
     // lock processor network to avoid concurrent evaluation
     NetworkLock lock(processorNetwork_);
@@ -101,55 +167,54 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
 
-    for (auto processor : processorsSorted_) {
-        if (!processor->isValid()) {
-            if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
-                    }
-
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
-                }
-
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
-                }
-
-                processor->notifyObserversAboutToProcess(processor);
-
-                try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
-                }
+    if (parallelEvaluation_) {
+        evaluateParallel();
+    } else {
+        // Processors invalidated during the evaluation that come later in the topological order
+        // are added to the queue by onProcessorInvalidationEnd
+        const auto later = [this](Processor* a, Processor* b) {
+            return topology_.position(a) > topology_.position(b);
+        };
+        queue_ = getProcessorsToEvaluate();
+        std::make_heap(queue_.begin(), queue_.end(), later);
+        evaluating_ = true;
+        evaluationPosition_ = 0;
+        util::OnScopeExit reset{[this]() {
+            evaluating_ = false;
+            queue_.clear();
+        }};
 
-                // Set processor as valid only if we still are ready.
-                // Callbacks might have made our inports invalid, if so abort
-                // the evaluation by not setting the processor valid.
-                if (processor->isReady()) processor->setValid();
+        while (!queue_.empty()) {
+            std::pop_heap(queue_.begin(), queue_.end(), later);
+            auto processor = queue_.back();
+            queue_.pop_back();
 
-                processor->notifyObserversFinishedProcess(processor);
+            const auto position = topology_.position(processor);
+            if (position < evaluationPosition_) continue;  // Already evaluated
+            evaluationPosition_ = position + 1;
 
+            if (!prepare(processor)) continue;
+
+            try {
+                IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                // do the actual processing
+                processor->process();
+            } catch (...) {
+                exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+            }
+
+            finish(processor);
+        }
+    }
+
+    {
+        // Release the lock before notifying, observers might invalidate processors.
+        std::lock_guard<std::mutex> dirtyLock{dirtyMutex_};
+        for (auto it = dirty_.begin(); it != dirty_.end();) {
+            if ((*it)->isValid()) {
+                it = dirty_.erase(it);
             } else {
-                try {
-                    processor->doIfNotReady();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
-                }
+                ++it;
             }
         }
     }
@@ -157,30 +222,184 @@ void ProcessorNetworkEvaluator::evaluate() {
     notifyObserversProcessorNetworkEvaluationEnd();
 }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+bool ProcessorNetworkEvaluator::canProcessConcurrently(Processor* processor) const {
+    // Processors have to opt in, process() commonly updates properties and widgets.
+    if (!processor->isThreadSafe()) return false;
+    // Only pure CPU processors, GL and CL need a context and python needs the GIL.
+    if (util::getPlatformTags(processor->getTags()) != Tags::CPU) return false;
+    // Pool processors already do their work in the background.
+    if (dynamic_cast<PoolProcessor*>(processor)) return false;
+    // Setting data in an outport without data will change the ready state of the connected
+    // processors, that has to happen in the main thread.
+    return util::all_of(processor->getOutports(), [](Outport* port) { return port->hasData(); });
 }
 
-void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::evaluateParallel() {
+    auto& pool = processorNetwork_->getApplication()->getThreadPool();
+
+    // Group the processors into levels, processors in the same level do not depend on each other.
+    // Only the processors that will be evaluated impose any ordering.
+    // Processors invalidated during the evaluation will be evaluated in the next evaluation.
+    std::unordered_map<Processor*, size_t> levels;
+    std::vector<std::vector<Processor*>> sorted;
+    for (auto processor : getProcessorsToEvaluate()) {
+        size_t level = 0;
+        for (auto predecessor : topology_.getPredecessors(processor)) {
+            auto it = levels.find(predecessor);
+            if (it != levels.end()) level = std::max(level, it->second + 1);
+        }
+        levels[processor] = level;
+        if (sorted.size() <= level) sorted.resize(level + 1);
+        sorted[level].push_back(processor);
+    }
+
+    std::vector<std::pair<Processor*, std::future<void>>> jobs;
+    for (auto& level : sorted) {
+        jobs.clear();
+        for (auto processor : level) {
+            if (!prepare(processor)) continue;
+
+            if (pool.getSize() > 0 && canProcessConcurrently(processor)) {
+                jobs.emplace_back(processor, pool.enqueue([processor]() {
+                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    processor->process();
+                }));
+                continue;
+            }
+
+            try {
+                IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                processor->process();
+            } catch (...) {
+                exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+            }
+            finish(processor);
+        }
+
+        for (auto& job : jobs) {
+            try {
+                job.second.get();
+            } catch (...) {
+                exceptionHandler_(job.first, EvaluationType::Process, IVW_CONTEXT);
+            }
+            finish(job.first);
+        }
+    }
+}
+
+std::vector<Processor*> ProcessorNetworkEvaluator::getProcessorsToEvaluate() {
+    std::vector<Processor*> processors;
+    {
+        std::lock_guard<std::mutex> lock{dirtyMutex_};
+        processors.assign(dirty_.begin(), dirty_.end());
+    }
+    util::erase_remove_if(processors, [this](Processor* processor) {
+        return processor->isValid() || !reachesSink(processor);
+    });
+    std::sort(processors.begin(), processors.end(), [this](Processor* a, Processor* b) {
+        return topology_.position(a) < topology_.position(b);
+    });
+    return processors;
+}
+
+bool ProcessorNetworkEvaluator::reachesSink(Processor* processor) {
+    auto it = reachesSink_.find(processor);
+    if (it != reachesSink_.end()) return it->second;
+
+    // Visit all successors without short circuiting, that way a cached processor will always
+    // have all its successors cached as well, see invalidateReachesSink.
+    bool result = processor->isSink();
+    for (auto outport : processor->getOutports()) {
+        for (auto inport : outport->getConnectedInports()) {
+            auto successor = inport->getProcessor();
+            if (successor->isConnectionActive(inport, outport)) {
+                const bool successorReachesSink = reachesSink(successor);
+                result = result || successorReachesSink;
+            }
+        }
+    }
+    reachesSink_[processor] = result;
+    return result;
+}
+
+void ProcessorNetworkEvaluator::invalidateReachesSink(Processor* processor) {
+    std::vector<Processor*> stack{processor};
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop_back();
+        // An uncached processor can not have any cached predecessors that depend on it.
+        if (reachesSink_.erase(current) == 0) continue;
+        if (!topology_.contains(current)) continue;
+        for (auto predecessor : topology_.getPredecessors(current)) stack.push_back(predecessor);
+    }
+}
+
+void ProcessorNetworkEvaluator::onProcessorInvalidationBegin(Processor* p) {
+    // The network gets notified before us and might request an evaluation as soon as the
+    // invalidation ends, before onProcessorInvalidationEnd is called here. Hence record the
+    // processor already now, valid processors are skipped by the evaluation and then dropped.
+    if (!topology_.contains(p)) return;
+    std::lock_guard<std::mutex> lock{dirtyMutex_};
+    dirty_.insert(p);
+}
+
+void ProcessorNetworkEvaluator::onProcessorInvalidationEnd(Processor* p) {
+    if (p->isValid() || !topology_.contains(p)) return;
+    {
+        std::lock_guard<std::mutex> lock{dirtyMutex_};
+        dirty_.insert(p);
+    }
+
+    // Only a serial evaluation, which runs in the main thread, queues processors here.
+    if (evaluating_ && topology_.position(p) >= evaluationPosition_ && reachesSink(p)) {
+        queue_.push_back(p);
+        std::push_heap(queue_.begin(), queue_.end(), [this](Processor* a, Processor* b) {
+            return topology_.position(a) > topology_.position(b);
+        });
+    }
+}
+
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor* p) { invalidateReachesSink(p); }
+
+void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor* p) {
+    // The active state of the connections to the inports of p changed
+    for (auto predecessor : topology_.getPredecessors(p)) invalidateReachesSink(predecessor);
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    topology_.addNode(p);
+    if (!p->isValid()) {
+        std::lock_guard<std::mutex> lock{dirtyMutex_};
+        dirty_.insert(p);
+    }
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    for (auto predecessor : topology_.getPredecessors(p)) invalidateReachesSink(predecessor);
+    reachesSink_.erase(p);
+    {
+        std::lock_guard<std::mutex> lock{dirtyMutex_};
+        dirty_.erase(p);
+    }
+    topology_.removeNode(p);
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection& c) {
+    auto from = c.getOutport()->getProcessor();
+    auto to = c.getInport()->getProcessor();
+    if (!topology_.addEdge(from, to)) {
+        LogWarn("Connection between " << from->getIdentifier() << " and " << to->getIdentifier()
+                                      << " introduces a cycle in the network");
+    }
+    invalidateReachesSink(from);
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection& c) {
+    auto from = c.getOutport()->getProcessor();
+    topology_.removeEdge(from, c.getInport()->getProcessor());
+    invalidateReachesSink(from);
 }
 
 }  // namespace inviwo
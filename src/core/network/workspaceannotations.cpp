@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/core/network/workspaceannotations.h>
+#include <inviwo/core/io/serialization/binaryformat.h>
 
 namespace inviwo {
 
@@ -45,13 +46,20 @@ bool WorkspaceAnnotations::Base64Image::isValid() const {
 void WorkspaceAnnotations::Base64Image::serialize(Serializer &s) const {
     s.serialize("name", name);
     s.serialize("size", size);
-    s.serialize("base64", base64jpeg);
+    s.serializeBlob("jpeg", binaryformat::fromBase64(base64jpeg));
 }
 
 void WorkspaceAnnotations::Base64Image::deserialize(Deserializer &d) {
     d.deserialize("name", name);
     d.deserialize("size", size);
-    d.deserialize("base64", base64jpeg);
+    binaryformat::Blob jpeg;
+    d.deserializeBlob("jpeg", jpeg);
+    if (!jpeg.empty()) {
+        base64jpeg = binaryformat::toBase64(jpeg.data(), jpeg.size());
+    } else {
+        // Workspaces saved before images were stored as blobs
+        d.deserialize("base64", base64jpeg);
+    }
 }
 
 WorkspaceAnnotations::WorkspaceAnnotations() : WorkspaceAnnotations(ImageVector{}) {}
@@ -31,12 +31,19 @@
 
 #include <inviwo/core/io/serialization/versionconverter.h>
 #include <inviwo/core/common/inviwomodule.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/inviwosetupinfo.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/processors/preloadable.h>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <sstream>
+
 namespace inviwo {
 
 class WorkspaceConverter : public VersionConverter {
@@ -130,14 +137,25 @@ struct ErrorHandle {
     std::string filename_;
 };
 
+struct WorkspaceManager::PreloadState {
+    size_t pending;
+    std::string workspace;
+    std::chrono::steady_clock::time_point start;
+};
+
 WorkspaceManager::WorkspaceManager(InviwoApplication* app) : app_(app) {}
 
 WorkspaceManager::~WorkspaceManager() = default;
 
-void WorkspaceManager::clear() { clears_.invoke(); }
+void WorkspaceManager::clear() {
+    preloadState_.reset();
+    loadTimes_.clear();
+    clears_.invoke();
+}
 
 void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
-                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode) {
+                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode,
+                            SerializationFormat format) {
     Serializer serializer(refPath);
 
     if (mode != WorkspaceSaveMode::Undo) {
@@ -146,7 +164,7 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    serializer.writeFile(stream, format);
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
@@ -159,21 +177,102 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 
     DeserializationErrorHandle<ErrorHandle> errorHandle(deserializer, info, refPath);
 
+    NetworkLock lock(app_->getProcessorNetwork());
     deserializers_.invoke(deserializer, exceptionHandler);
+    preload(refPath);
+}
+
+void WorkspaceManager::preload(const std::string& refPath) {
+    if (app_->getPoolSize() == 0) return;
+
+    std::vector<std::pair<Processor*, Preloadable::Job>> jobs;
+    for (auto processor : app_->getProcessorNetwork()->getProcessors()) {
+        if (auto preloadable = dynamic_cast<Preloadable*>(processor)) {
+            if (auto job = preloadable->preload()) jobs.emplace_back(processor, std::move(job));
+        }
+    }
+    if (jobs.empty()) return;
+
+    auto state = std::make_shared<PreloadState>(
+        PreloadState{jobs.size(), refPath, std::chrono::steady_clock::now()});
+    preloadState_ = state;
+    loadTimes_.clear();
+
+    for (auto& item : jobs) {
+        app_->dispatchPool([this, weakState = std::weak_ptr<PreloadState>(state),
+                            processor = item.first, id = item.first->getIdentifier(),
+                            job = std::move(item.second)]() {
+            const auto start = std::chrono::steady_clock::now();
+            Preloadable::Apply apply;
+            std::string error;
+            try {
+                apply = job();
+            } catch (const Exception& e) {
+                error = e.getMessage();
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+            app_->dispatchFrontAndForget([this, weakState, processor, id, apply, error, time]() {
+                auto state = weakState.lock();
+                const bool current = state && state == preloadState_;
+
+                if (!error.empty()) {
+                    if (current) {
+                        LogError("Error while preloading data for " << id << ": " << error);
+                    }
+                } else if (apply &&
+                           app_->getProcessorNetwork()->getProcessorByIdentifier(id) == processor) {
+                    // Also for superseded loads, the processor might still wait for the data
+                    apply();
+                }
+                if (!current) return;
+                loadTimes_.push_back({id, time});
+
+                if (--state->pending == 0) {
+                    const auto total = std::chrono::steady_clock::now() - state->start;
+                    std::chrono::duration<double> sum{0};
+                    for (const auto& item : loadTimes_) sum += item.time;
+
+                    auto sorted = loadTimes_;
+                    std::sort(sorted.begin(), sorted.end(),
+                              [](const LoadTime& a, const LoadTime& b) { return a.time > b.time; });
+                    std::stringstream ss;
+                    ss << "Read data of " << sorted.size() << " processors for "
+                       << state->workspace << " in " << durationToString(total)
+                       << " (sum of read times " << durationToString(sum) << ")";
+                    for (const auto& item : sorted) {
+                        ss << "\n    " << item.processor << ": " << durationToString(item.time);
+                    }
+                    LogInfo(ss.str());
+                    preloadState_.reset();
+                }
+            });
+        });
+    }
+}
+
+const std::vector<WorkspaceManager::LoadTime>& WorkspaceManager::getLoadTimes() const {
+    return loadTimes_;
 }
 
+bool WorkspaceManager::isPreloading() const { return preloadState_ != nullptr; }
+
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
-                            WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+                            WorkspaceSaveMode mode, SerializationFormat format) {
+    auto ostream = filesystem::ofstream(path, format == SerializationFormat::Binary
+                                                  ? std::ios::out | std::ios::binary
+                                                  : std::ios::out);
     if (ostream.is_open()) {
-        save(ostream, path, exceptionHandler, mode);
+        save(ostream, path, exceptionHandler, mode, format);
     } else {
         throw AbortException("Could not open workspace file: " + path, IVW_CONTEXT);
     }
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    auto istream = filesystem::ifstream(path, std::ios::in | std::ios::binary);
     if (istream.is_open()) {
         load(istream, path, exceptionHandler);
     } else {
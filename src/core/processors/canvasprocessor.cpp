@@ -308,6 +308,9 @@ void CanvasProcessor::propagateEvent(Event* event, Outport* source) {
     if (event->hasVisitedProcessor(this)) return;
     event->markAsVisited(this);
 
+    // Coalesce the link evaluations triggered by the interaction, i.e. a linked camera.
+    LinkBatch batch(this);
+
     invokeEvent(event);
     if (event->hasBeenUsed()) return;
 
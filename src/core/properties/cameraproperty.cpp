@@ -285,7 +285,7 @@ void CameraProperty::setAspectRatio(float aspectRatio) { aspectRatio_.set(aspect
 float CameraProperty::getAspectRatio() const { return camera_->getAspectRatio(); }
 
 void CameraProperty::setLook(vec3 lookFrom, vec3 lookTo, vec3 lookUp) {
-    NetworkLock lock(this);
+    LinkBatch batch(this);
     setLookFrom(lookFrom);
     setLookTo(lookTo);
     setLookUp(lookUp);
@@ -0,0 +1,113 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace inviwo;
+
+namespace {
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> createVolume(size_t dim) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(size3_t{dim});
+    std::mt19937 rand(0);
+    std::uniform_int_distribution<int> dist(0, 4095);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < dim * dim * dim; ++i) data[i] = static_cast<T>(dist(rand));
+    return ram;
+}
+
+}  // namespace
+
+template <typename T>
+static void HistogramIterator(benchmark::State& state) {
+    const auto dim = static_cast<size_t>(state.range(0));
+    auto ram = createVolume<T>(dim);
+    std::vector<T> values(ram->getDataTyped(), ram->getDataTyped() + dim * dim * dim);
+    for (auto _ : state) {
+        HistogramContainer histograms(dvec2{0, 4095}, 2048, values.begin(), values.end());
+        benchmark::DoNotOptimize(histograms);
+    }
+    state.SetItemsProcessed(state.iterations() * dim * dim * dim);
+}
+
+template <typename T>
+static void HistogramPointer(benchmark::State& state) {
+    const auto dim = static_cast<size_t>(state.range(0));
+    auto ram = createVolume<T>(dim);
+    const auto data = ram->getDataTyped();
+    for (auto _ : state) {
+        HistogramContainer histograms(dvec2{0, 4095}, 2048, data, data + dim * dim * dim);
+        benchmark::DoNotOptimize(histograms);
+    }
+    state.SetItemsProcessed(state.iterations() * dim * dim * dim);
+}
+
+template <typename T>
+static void HistogramParallel(benchmark::State& state) {
+    const auto dim = static_cast<size_t>(state.range(0));
+    auto ram = createVolume<T>(dim);
+    for (auto _ : state) {
+        auto histograms = util::calculateHistograms(*ram, dvec2{0, 4095}, 2048);
+        benchmark::DoNotOptimize(histograms);
+    }
+    state.SetItemsProcessed(state.iterations() * dim * dim * dim);
+}
+
+BENCHMARK_TEMPLATE(HistogramIterator, unsigned short)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(HistogramPointer, unsigned short)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(HistogramParallel, unsigned short)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(HistogramIterator, float)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(HistogramPointer, float)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(HistogramParallel, float)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
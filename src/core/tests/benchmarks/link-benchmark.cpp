@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/properties/cameraproperty.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using namespace inviwo;
+
+namespace {
+
+struct CameraProcessor : Processor {
+    CameraProcessor(const std::string& id) : Processor(id, id), camera_("camera", "Camera") {
+        addProperty(camera_);
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {}
+
+    CameraProperty camera_;
+};
+
+const ProcessorInfo CameraProcessor::processorInfo_{
+    "org.inviwo.CameraProcessor",  // Class identifier
+    "CameraProcessor",             // Display name
+    "Testing",                     // Category
+    CodeState::Stable,             // Code state
+    Tags::CPU,                     // Tags
+};
+
+/**
+ * Builds a network of size processors with a camera each, where the camera of the first processor
+ * is linked bidirectionally to all the others.
+ */
+CameraProperty& buildNetwork(ProcessorNetwork& network, size_t size) {
+    NetworkLock lock(&network);
+    std::vector<CameraProcessor*> processors;
+    for (size_t i = 0; i < size; ++i) {
+        processors.push_back(static_cast<CameraProcessor*>(
+            network.addProcessor(std::make_unique<CameraProcessor>("p" + std::to_string(i)))));
+    }
+    auto& master = processors.front()->camera_;
+    for (size_t i = 1; i < size; ++i) {
+        network.addLink(&master, &processors[i]->camera_);
+        network.addLink(&processors[i]->camera_, &master);
+    }
+    return master;
+}
+
+vec3 lookFrom(size_t i) {
+    const auto angle = 0.01f * static_cast<float>(i % 628);
+    return vec3{2.0f * std::cos(angle), 0.0f, 2.0f * std::sin(angle)};
+}
+
+}  // namespace
+
+// Setting the camera components one by one, each modification is propagated over the links
+static void CameraFanOutComponents(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto& camera = buildNetwork(network, size);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        camera.setLookFrom(lookFrom(i++));
+        camera.setLookTo(vec3{0.0f});
+        camera.setLookUp(vec3{0.0f, 1.0f, 0.0f});
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+    {
+        NetworkLock lock(&network);
+        network.clear();
+    }
+}
+
+// Setting the camera components within a batch, as done when handling an interaction event
+static void CameraFanOutBatched(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto& camera = buildNetwork(network, size);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        LinkBatch batch(&network);
+        camera.setLookFrom(lookFrom(i++));
+        camera.setLookTo(vec3{0.0f});
+        camera.setLookUp(vec3{0.0f, 1.0f, 0.0f});
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+    {
+        NetworkLock lock(&network);
+        network.clear();
+    }
+}
+
+BENCHMARK(CameraFanOutComponents)
+    ->RangeMultiplier(2)
+    ->Range(25, 400)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(CameraFanOutBatched)->RangeMultiplier(2)->Range(25, 400)->Unit(benchmark::kMicrosecond);
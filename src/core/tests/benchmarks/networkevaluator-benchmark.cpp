@@ -0,0 +1,142 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace inviwo;
+
+namespace {
+
+struct BenchProcessor : Processor {
+    BenchProcessor(const std::string& id, bool hasInport, bool hasOutport) : Processor(id, id) {
+        if (hasInport) addPort(std::make_unique<DataInport<int>>("in"));
+        if (hasOutport) addPort(std::make_unique<DataOutport<int>>("out"));
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {
+        if (!getOutports().empty()) {
+            static_cast<DataOutport<int>*>(getOutports()[0])->setData(std::make_shared<int>(0));
+        }
+    }
+};
+
+const ProcessorInfo BenchProcessor::processorInfo_{
+    "org.inviwo.BenchProcessor",  // Class identifier
+    "BenchProcessor",             // Display name
+    "Testing",                    // Category
+    CodeState::Stable,            // Code state
+    Tags::CPU,                    // Tags
+};
+
+/**
+ * Builds a network with one source and a number of branches of length 8 ending in a sink, in
+ * total about size processors.
+ */
+std::vector<Processor*> buildNetwork(ProcessorNetwork& network, size_t size) {
+    NetworkLock lock(&network);
+    auto source = network.addProcessor(std::make_unique<BenchProcessor>("source", false, true));
+    std::vector<Processor*> sinks;
+    const size_t length = 8;
+    for (size_t branch = 0; branch < std::max(size_t{1}, size / length); ++branch) {
+        auto prev = source;
+        for (size_t i = 0; i < length; ++i) {
+            const bool isSink = i + 1 == length;
+            auto p = network.addProcessor(std::make_unique<BenchProcessor>(
+                "p" + std::to_string(branch) + "_" + std::to_string(i), true, !isSink));
+            network.addConnection(prev->getOutports()[0], p->getInports()[0]);
+            prev = p;
+        }
+        sinks.push_back(prev);
+    }
+    return sinks;
+}
+
+}  // namespace
+
+static void AddProcessors(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        ProcessorNetwork network{InviwoApplication::getPtr()};
+        ProcessorNetworkEvaluator evaluator{&network};
+        buildNetwork(network, size);
+
+        state.PauseTiming();
+        {
+            NetworkLock lock(&network);
+            network.clear();
+        }
+        state.ResumeTiming();
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void EvaluateLeaf(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto sinks = buildNetwork(network, size);
+
+    auto leaf = sinks[sinks.size() / 2];
+    for (auto _ : state) {
+        leaf->invalidate(InvalidationLevel::InvalidOutput);
+        benchmark::DoNotOptimize(leaf->isValid());
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+}
+
+static void EvaluateSource(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    buildNetwork(network, size);
+
+    auto source = network.getProcessorByIdentifier("source");
+    for (auto _ : state) {
+        source->invalidate(InvalidationLevel::InvalidOutput);
+        benchmark::DoNotOptimize(source->isValid());
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+}
+
+BENCHMARK(AddProcessors)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(EvaluateLeaf)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(EvaluateSource)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
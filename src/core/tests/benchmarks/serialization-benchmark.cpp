@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/serialization/serialization.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * Mimics the structure of a processor in a workspace: a couple of attributes, a list of properties
+ * with values and a bit of meta data.
+ */
+struct BenchItem : Serializable {
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("type", type, SerializationTarget::Attribute);
+        s.serialize("identifier", identifier, SerializationTarget::Attribute);
+        s.serialize("Properties", properties, "Property");
+        s.serialize("position", position);
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("type", type, SerializationTarget::Attribute);
+        d.deserialize("identifier", identifier, SerializationTarget::Attribute);
+        d.deserialize("Properties", properties, "Property");
+        d.deserialize("position", position);
+    }
+
+    std::string type;
+    std::string identifier;
+    std::vector<double> properties;
+    ivec2 position{0};
+};
+
+/**
+ * A workspace with the given number of items with 30 properties each, a base64 encoded 1 MB
+ * screenshot and a 4 MB array stored as a blob.
+ */
+struct BenchWorkspace : Serializable {
+    BenchWorkspace(size_t size) : items(size) {
+        std::mt19937 rand(0);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        for (size_t i = 0; i < size; ++i) {
+            items[i].type = "org.inviwo.BenchProcessor";
+            items[i].identifier = "Processor" + std::to_string(i);
+            items[i].properties.resize(30);
+            for (auto& p : items[i].properties) p = dist(rand);
+            items[i].position = ivec2(static_cast<int>(i), static_cast<int>(2 * i));
+        }
+        binaryformat::Blob image(1 << 20);
+        for (auto& b : image) b = static_cast<unsigned char>(rand());
+        screenshot = binaryformat::toBase64(image.data(), image.size());
+        data.resize(1 << 20);
+        for (auto& v : data) v = static_cast<float>(dist(rand));
+    }
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("Processors", items, "Processor");
+        s.serialize("Screenshot", screenshot);
+        s.serializeBlob("Data", data);
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("Processors", items, "Processor");
+        d.deserialize("Screenshot", screenshot);
+        d.deserializeBlob("Data", data);
+    }
+
+    std::vector<BenchItem> items;
+    std::string screenshot;
+    std::vector<float> data;
+};
+
+std::string save(size_t size, SerializationFormat format) {
+    BenchWorkspace workspace(size);
+    Serializer serializer("");
+    serializer.serialize("Workspace", workspace);
+    std::stringstream ss;
+    serializer.writeFile(ss, format);
+    return ss.str();
+}
+
+}  // namespace
+
+static void WorkspaceLoad(benchmark::State& state, SerializationFormat format) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto data = save(size, format);
+
+    for (auto _ : state) {
+        std::stringstream ss(data);
+        Deserializer deserializer(ss, "");
+        BenchWorkspace workspace(0);
+        deserializer.deserialize("Workspace", workspace);
+        benchmark::DoNotOptimize(workspace.items.data());
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+    state.counters["Bytes"] = static_cast<double>(data.size());
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void WorkspaceSave(benchmark::State& state, SerializationFormat format) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const BenchWorkspace workspace(size);
+
+    for (auto _ : state) {
+        Serializer serializer("");
+        serializer.serialize("Workspace", workspace);
+        std::stringstream ss;
+        serializer.writeFile(ss, format);
+        benchmark::DoNotOptimize(ss.tellp());
+    }
+    state.counters["Processors"] = static_cast<double>(size);
+}
+
+BENCHMARK_CAPTURE(WorkspaceLoad, Xml, SerializationFormat::Xml)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(WorkspaceLoad, Binary, SerializationFormat::Binary)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(WorkspaceSave, Xml, SerializationFormat::Xml)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(WorkspaceSave, Binary, SerializationFormat::Binary)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
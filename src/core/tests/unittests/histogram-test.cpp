@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <numeric>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+void compare(const HistogramContainer& a, const HistogramContainer& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].getData(), b[i].getData());
+        EXPECT_DOUBLE_EQ(a[i].getMaximumBinValue(), b[i].getMaximumBinValue());
+        EXPECT_DOUBLE_EQ(a[i].stats_.min, b[i].stats_.min);
+        EXPECT_DOUBLE_EQ(a[i].stats_.max, b[i].stats_.max);
+        EXPECT_NEAR(a[i].stats_.mean, b[i].stats_.mean, 1e-9);
+        EXPECT_NEAR(a[i].stats_.standardDeviation, b[i].stats_.standardDeviation, 1e-6);
+    }
+}
+
+template <typename T, typename Dist>
+void testHistograms(Dist dist, dvec2 range, size_t bins) {
+    const size3_t dims{64, 64, 64};
+    VolumeRAMPrecision<T> volume(dims);
+    std::mt19937 gen(0);
+    auto data = volume.getDataTyped();
+    std::generate(data, data + glm::compMul(dims), [&]() { return static_cast<T>(dist(gen)); });
+
+    // A non pointer iterator uses the plain per element path
+    const std::vector<T> values(data, data + glm::compMul(dims));
+    const HistogramContainer reference(range, bins, values.begin(), values.end());
+
+    compare(reference, HistogramContainer(range, bins, data, data + glm::compMul(dims)));
+    compare(reference, util::calculateHistograms(volume, range, bins, 1));
+    compare(reference, util::calculateHistograms(volume, range, bins, 3));
+
+    // Strided estimates are the histograms of the subsample
+    for (size_t stride : {size_t{1}, size_t{7}, size_t{64}}) {
+        std::vector<T> subsample;
+        for (size_t i = 0; i < values.size(); i += stride) subsample.push_back(values[i]);
+        compare(HistogramContainer(range, bins, subsample.begin(), subsample.end()),
+                util::calculateHistogramsStrided(volume, range, bins, stride));
+    }
+}
+
+}  // namespace
+
+TEST(HistogramTests, UInt16) {
+    testHistograms<std::uint16_t>(std::uniform_int_distribution<int>(0, 4095), dvec2{0, 4095},
+                                  2048);
+}
+
+TEST(HistogramTests, Int8) {
+    testHistograms<std::int8_t>(std::uniform_int_distribution<int>(-128, 127), dvec2{-128, 127},
+                                256);
+}
+
+TEST(HistogramTests, Float) {
+    // Values outside of the range are not binned but are part of the statistics
+    testHistograms<float>(std::normal_distribution<float>(0.0f, 1.0f), dvec2{-2.0, 2.0}, 100);
+}
+
+TEST(HistogramTests, ProgressiveStrides) {
+    EXPECT_TRUE(util::progressiveHistogramStrides(size_t{1} << 20, 1).empty());
+
+    const auto strides = util::progressiveHistogramStrides(size_t{1} << 33, 2);
+    ASSERT_FALSE(strides.empty());
+    EXPECT_GT(strides.front(), size_t{1} << 17);
+    EXPECT_LT(strides.front(), size_t{1} << 18);
+    EXPECT_TRUE(std::is_sorted(strides.rbegin(), strides.rend()));
+    EXPECT_GE(strides.back() * 2, size_t{256});
+    for (auto stride : strides) EXPECT_EQ(1, stride % 2);
+}
+
+TEST(HistogramTests, ProgressivePowerOfTwo) {
+    // Values only vary along x, a power of two stride would only ever visit a single column
+    const size3_t dims{256, 256, 256};
+    VolumeRAMPrecision<std::uint8_t> volume(dims);
+    auto data = volume.getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = static_cast<std::uint8_t>(i % dims.x);
+    }
+
+    const dvec2 range{0, 255};
+    const size_t bins = 256;
+    const auto strides = util::progressiveHistogramStrides(glm::compMul(dims), 1);
+    ASSERT_FALSE(strides.empty());
+
+    const auto normalized = [](const HistogramContainer& histograms) {
+        auto bins = histograms[0].getData();
+        const auto sum = std::accumulate(bins.begin(), bins.end(), 0.0);
+        for (auto& bin : bins) bin /= sum;
+        return bins;
+    };
+    const auto full = normalized(util::calculateHistograms(volume, range, bins));
+    for (auto stride : strides) {
+        SCOPED_TRACE(stride);
+        const auto coarse =
+            normalized(util::calculateHistogramsStrided(volume, range, bins, stride));
+        ASSERT_EQ(full.size(), coarse.size());
+        for (size_t i = 0; i < full.size(); ++i) {
+            EXPECT_NEAR(full[i], coarse[i], 0.1 / bins);
+        }
+    }
+}
+
+}  // namespace inviwo
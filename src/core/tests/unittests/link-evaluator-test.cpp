@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+namespace {
+
+struct LinkProcessor : Processor {
+    LinkProcessor(const std::string& id) : Processor(id, id), value_("value", "Value", 0) {
+        addProperty(value_);
+        value_.onChange([this]() { ++changes; });
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {}
+
+    IntProperty value_;
+    int changes = 0;
+};
+
+const ProcessorInfo LinkProcessor::processorInfo_{
+    "org.inviwo.LinkProcessor",  // Class identifier
+    "LinkProcessor",             // Display name
+    "Testing",                   // Category
+    CodeState::Stable,           // Code state
+    Tags::CPU,                   // Tags
+};
+
+struct LinkNetwork {
+    LinkNetwork() : network{InviwoApplication::getPtr()} {
+        for (auto id : {"a", "b", "c"}) {
+            p.push_back(static_cast<LinkProcessor*>(
+                network.addProcessor(std::make_unique<LinkProcessor>(id))));
+        }
+    }
+    ~LinkNetwork() {
+        NetworkLock lock(&network);
+        network.clear();
+    }
+    IntProperty& value(size_t i) { return p[i]->value_; }
+
+    ProcessorNetwork network;
+    std::vector<LinkProcessor*> p;
+};
+
+}  // namespace
+
+TEST(LinkEvaluator, Chain) {
+    LinkNetwork n;
+    n.network.addLink(&n.value(0), &n.value(1));
+    n.network.addLink(&n.value(1), &n.value(2));
+
+    EXPECT_EQ(n.network.getPropertiesLinkedTo(&n.value(0)),
+              (std::vector<Property*>{&n.value(1), &n.value(2)}));
+    EXPECT_TRUE(n.network.getPropertiesLinkedTo(&n.value(2)).empty());
+
+    n.value(0).set(3);
+    EXPECT_EQ(n.value(1).get(), 3);
+    EXPECT_EQ(n.value(2).get(), 3);
+    EXPECT_FALSE(n.network.isLinking());
+
+    n.network.removeLink(&n.value(1), &n.value(2));
+    n.value(0).set(4);
+    EXPECT_EQ(n.value(1).get(), 4);
+    EXPECT_EQ(n.value(2).get(), 3);
+}
+
+TEST(LinkEvaluator, Cycle) {
+    LinkNetwork n;
+    n.network.addLink(&n.value(0), &n.value(1));
+    n.network.addLink(&n.value(1), &n.value(2));
+    n.network.addLink(&n.value(2), &n.value(0));
+
+    n.value(1).set(5);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(n.value(i).get(), 5);
+        EXPECT_EQ(n.p[i]->changes, 1);
+    }
+}
+
+TEST(LinkEvaluator, BatchCoalesces) {
+    LinkNetwork n;
+    n.network.addLink(&n.value(0), &n.value(1));
+    n.network.addLink(&n.value(0), &n.value(2));
+    {
+        LinkBatch batch(&n.network);
+        for (int i = 1; i <= 3; ++i) n.value(0).set(i);
+        EXPECT_EQ(n.value(1).get(), 0);
+    }
+    EXPECT_EQ(n.p[0]->changes, 3);
+    EXPECT_EQ(n.p[1]->changes, 1);
+    EXPECT_EQ(n.p[2]->changes, 1);
+    EXPECT_EQ(n.value(1).get(), 3);
+    EXPECT_EQ(n.value(2).get(), 3);
+}
+
+TEST(LinkEvaluator, BatchLastModificationWins) {
+    LinkNetwork n;
+    n.network.addLink(&n.value(0), &n.value(1));
+    n.network.addLink(&n.value(1), &n.value(0));
+    n.network.addLink(&n.value(1), &n.value(2));
+    {
+        LinkBatch batch(&n.network);
+        n.value(0).set(1);
+        n.value(1).set(2);
+    }
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(n.value(i).get(), 2);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,132 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <filesystem>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::string writeTestFile(const std::string& name, const std::vector<std::uint16_t>& data,
+                          size_t offset) {
+    const auto file = (std::filesystem::temp_directory_path() / name).string();
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    const std::vector<char> header(offset, 0);
+    out.write(header.data(), header.size());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(std::uint16_t));
+    return file;
+}
+
+}  // namespace
+
+TEST(MemoryMappedFileTests, Map) {
+    std::vector<std::uint16_t> data(10000);
+    std::iota(data.begin(), data.end(), std::uint16_t{0});
+    const auto file = writeTestFile("inviwo-mmap-test.raw", data, 0);
+
+    {
+        // Offset that is not page aligned
+        util::MemoryMappedFile mapping(file, 2 * 5001, 2 * 1000);
+        ASSERT_EQ(size_t{2 * 1000}, mapping.size());
+        const auto values = static_cast<std::uint16_t*>(mapping.data());
+        EXPECT_EQ(5001, values[0]);
+        EXPECT_EQ(6000, values[999]);
+
+        // Writes are private to the mapping
+        values[0] = 0;
+        util::MemoryMappedFile other(file, 2 * 5001, 2);
+        EXPECT_EQ(5001, *static_cast<std::uint16_t*>(other.data()));
+    }
+
+    EXPECT_THROW(util::MemoryMappedFile(file, 2 * 9000, 2 * 2000), FileException);
+    EXPECT_THROW(util::MemoryMappedFile(file + ".missing", 0, 2), FileException);
+    std::filesystem::remove(file);
+}
+
+TEST(MemoryMappedFileTests, RawVolumeRAMLoader) {
+    const size3_t dims{16, 8, 4};
+    std::vector<std::uint16_t> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), std::uint16_t{0});
+    const auto file = writeTestFile("inviwo-mmap-volume-test.raw", data, 64);
+
+    const VolumeRAMPrecision<std::uint16_t> src(dims);
+    for (bool useMemoryMapping : {true, false}) {
+        RawVolumeRAMLoader loader(file, 64, true, useMemoryMapping);
+        auto volumeRAM = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(src));
+        ASSERT_NE(nullptr, volumeRAM);
+        EXPECT_TRUE(dims == volumeRAM->getDimensions());
+        const auto values = static_cast<const std::uint16_t*>(volumeRAM->getData());
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), values));
+
+        // Copies own their data
+        std::unique_ptr<VolumeRAM> copy{volumeRAM->clone()};
+        volumeRAM.reset();
+        const auto copied = static_cast<const std::uint16_t*>(copy->getData());
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), copied));
+    }
+    std::filesystem::remove(file);
+}
+
+TEST(MemoryMappedFileTests, RawVolumeRAMLoaderTruncated) {
+    const size3_t dims{16, 8, 4};
+    std::vector<std::uint16_t> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), std::uint16_t{0});
+    const auto file = writeTestFile("inviwo-mmap-truncated-test.raw", data, 64);
+    const VolumeRAMPrecision<std::uint16_t> src(dims);
+
+    // Without memory mapping, the default, the voxels are read so the file can change afterwards
+    {
+        RawVolumeRAMLoader loader(file, 64, true);
+        auto volumeRAM = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(src));
+        std::filesystem::resize_file(file, 64 + data.size());
+        const auto values = static_cast<const std::uint16_t*>(volumeRAM->getData());
+        EXPECT_TRUE(std::equal(data.begin(), data.end(), values));
+    }
+
+    // A file that is too small is reported, and never mapped
+    for (bool useMemoryMapping : {true, false}) {
+        RawVolumeRAMLoader loader(file, 64, true, useMemoryMapping);
+        EXPECT_THROW(loader.createRepresentation(src), DataReaderException);
+    }
+    std::filesystem::remove(file);
+}
+
+}  // namespace inviwo
@@ -44,6 +44,7 @@
 #include <inviwo/core/ports/dataoutport.h>
 
 #include <functional>
+#include <thread>
 
 namespace inviwo {
 
@@ -65,6 +66,9 @@ struct TestProcessor : Processor {
     virtual void doIfNotReady() override {
         if (onDoIfNotReady) onDoIfNotReady(*this);
     }
+    virtual bool isThreadSafe() const override { return threadSafe; }
+
+    bool threadSafe = false;
 
     std::function<void(TestProcessor&)> onInitializeResources;
     std::function<void(TestProcessor&)> onProcess;
@@ -124,6 +128,16 @@ const auto createB = []() {
     return bt;
 };
 
+const auto createC = []() {
+    auto ct = std::make_unique<TestProcessor>("c");
+    ct->addPort(std::make_unique<DataInport<int>>("in"));
+    ct->addPort(std::make_unique<DataOutport<int>>("out"));
+    ct->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    return ct;
+};
+
 TEST(NetworkEvaluator, Eval) {
     ProcessorNetwork network{InviwoApplication::getPtr()};
     ProcessorNetworkEvaluator evaluator{&network};
@@ -196,6 +210,61 @@ TEST(NetworkEvaluator, Eval) {
     }
 }
 
+TEST(NetworkEvaluator, InvalidateWithoutLock) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    auto ct = createC();
+    auto c = ct.get();
+    auto bt = createB();
+    auto b = bt.get();
+
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(ct));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], c->getInports()[0]);
+    network.addConnection(c->getOutports()[0], b->getInports()[0]);
+
+    Instrument ai(*a);
+    Instrument ci(*c);
+    Instrument bi(*b);
+    a->onProcess = [func = a->onProcess](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    c->onProcess = [func = c->onProcess](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+    };
+
+    {
+        SCOPED_TRACE("Invalidate the middle processor");
+        // The evaluation is requested by the network before the evaluator is notified about the
+        // end of the invalidation, the invalidated processor still has to be part of it.
+        c->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 0, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+        EXPECT_TRUE(c->isValid());
+        EXPECT_TRUE(b->isValid());
+    }
+    {
+        SCOPED_TRACE("Invalidate the source");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+        EXPECT_TRUE(a->isValid());
+        EXPECT_TRUE(c->isValid());
+        EXPECT_TRUE(b->isValid());
+    }
+}
+
 TEST(NetworkEvaluator, Error) {
     ProcessorNetwork network{InviwoApplication::getPtr()};
     ProcessorNetworkEvaluator evaluator{&network};
@@ -243,6 +312,23 @@ TEST(NetworkEvaluator, Error) {
         bi.checkAndReset(0, 1, 0);
     }
 
+    {
+        SCOPED_TRACE("Only opted in processors on the pool");
+        // The branches now have data in their outports and can be processed concurrently
+        std::vector<std::thread::id> threads(branches.size());
+        for (size_t i = 0; i < branches.size(); ++i) {
+            branches[i]->onProcess = [&threads, i, func = branches[i]->onProcess](
+                                         TestProcessor& p) {
+                threads[i] = std::this_thread::get_id();
+                func(p);
+            };
+        }
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        for (auto& instrument : instruments) instrument->checkAndReset(0, 1, 0);
+        EXPECT_EQ(std::this_thread::get_id(), threads.front());
+    }
+
     {
         SCOPED_TRACE("Invalid output with throw");
         unsigned int throwCount = 0;
@@ -257,4 +343,69 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, Parallel) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setParallelEvaluation(true);
+    EXPECT_TRUE(evaluator.getParallelEvaluation());
+
+    auto at = createA();
+    auto a = at.get();
+    Instrument ai(*a);
+    a->onProcess = [func = a->onProcess](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    network.addProcessor(std::move(at));
+
+    std::vector<TestProcessor*> branches;
+    std::vector<std::unique_ptr<Instrument>> instruments;
+    for (int i = 0; i < 4; ++i) {
+        auto ct = createC();
+        ct->setIdentifier("c" + std::to_string(i));
+        auto c = ct.get();
+        instruments.push_back(std::make_unique<Instrument>(*c));
+        c->onProcess = [func = c->onProcess](TestProcessor& p) {
+            func(p);
+            static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+        };
+        // All but the first branch may be processed on the thread pool
+        c->threadSafe = i > 0;
+        network.addProcessor(std::move(ct));
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+        branches.push_back(c);
+    }
+
+    auto bt = createB();
+    auto b = bt.get();
+    network.addProcessor(std::move(bt));
+    network.addConnection(branches.front()->getOutports()[0], b->getInports()[0]);
+
+    ai.reset();
+    for (auto& instrument : instruments) instrument->reset();
+
+    {
+        SCOPED_TRACE("Invalid output");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 1, 0);
+        for (auto& instrument : instruments) instrument->checkAndReset(0, 1, 0);
+        for (auto c : branches) EXPECT_TRUE(c->isValid());
+        EXPECT_TRUE(b->isValid());
+    }
+
+    {
+        SCOPED_TRACE("Invalid output with throw");
+        unsigned int throwCount = 0;
+        evaluator.setExceptionHandler(
+            [&throwCount](Processor*, EvaluationType, ExceptionContext) { ++throwCount; });
+        branches.back()->onProcess = [](TestProcessor&) {
+            throw Exception("Error", IVW_CONTEXT_CUSTOM("TestProcessor"));
+        };
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        EXPECT_EQ(throwCount, 1);
+        ai.checkAndReset(0, 1, 0);
+        EXPECT_TRUE(branches.back()->isValid());
+    }
+}
+
 }  // namespace inviwo
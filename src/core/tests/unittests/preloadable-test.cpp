@@ -0,0 +1,184 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/preloadable.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/processorfactory.h>
+#include <inviwo/core/processors/processorfactoryobject.h>
+#include <inviwo/core/properties/stringproperty.h>
+
+#include <future>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Hands out a job during the first load only, the jobs wait for gate before they return.
+ */
+struct PreloadingProcessor : Processor, Preloadable {
+    PreloadingProcessor(const std::string& identifier = "", const std::string& displayName = "")
+        : Processor(identifier, displayName), file_("file", "File", "data.txt") {
+        addProperty(file_);
+        isReady_.setUpdate([this]() { return !preloaded_.isPending(); });
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override { data_ = preloaded_.take(file_.get()); }
+
+    virtual Preloadable::Job preload() override {
+        if (preloaded) return nullptr;
+        preloaded = true;
+        auto job = preloaded_.makeJob(
+            file_.get(),
+            [wait = gate]() {
+                wait.wait();
+                return std::make_shared<int>(42);
+            },
+            [this]() {
+                isReady_.update();
+                invalidate(InvalidationLevel::InvalidOutput);
+            });
+        isReady_.update();
+        return job;
+    }
+
+    StringProperty file_;
+    util::PreloadedData<int> preloaded_;
+    std::shared_ptr<int> data_;
+    bool preloaded = false;
+
+    static std::shared_future<void> gate;
+};
+
+const ProcessorInfo PreloadingProcessor::processorInfo_{
+    "org.inviwo.PreloadingTestProcessor",  // Class identifier
+    "Preloading",                          // Display name
+    "Testing",                             // Category
+    CodeState::Stable,                     // Code state
+    Tags::CPU,                             // Tags
+};
+
+std::shared_future<void> PreloadingProcessor::gate;
+
+std::string makeWorkspace(InviwoApplication* app, const std::vector<std::string>& ids) {
+    app->getWorkspaceManager()->clear();
+    for (const auto& id : ids) {
+        app->getProcessorNetwork()->addProcessor(std::make_unique<PreloadingProcessor>(id, id));
+    }
+    std::stringstream ss;
+    app->getWorkspaceManager()->save(ss, "");
+    app->getWorkspaceManager()->clear();
+    return ss.str();
+}
+
+}  // namespace
+
+TEST(Preloadable, PreloadedData) {
+    util::PreloadedData<int> preloaded;
+    int done = 0;
+    auto read = []() { return std::make_shared<int>(1); };
+
+    // An Apply of a superseded job is ignored
+    auto first = preloaded.makeJob("a", read, [&]() { ++done; });
+    auto second = preloaded.makeJob("a", read, [&]() { ++done; });
+    EXPECT_TRUE(preloaded.isPending());
+    first()();
+    EXPECT_TRUE(preloaded.isPending());
+    EXPECT_EQ(0, done);
+    second()();
+    EXPECT_FALSE(preloaded.isPending());
+    EXPECT_EQ(1, done);
+    ASSERT_TRUE(preloaded.take("a"));
+    EXPECT_FALSE(preloaded.take("a"));
+
+    // A job that is discarded is no longer pending
+    auto third = preloaded.makeJob("b", read, [&]() { ++done; });
+    EXPECT_TRUE(preloaded.isPending());
+    third = nullptr;
+    EXPECT_FALSE(preloaded.isPending());
+    EXPECT_EQ(1, done);
+}
+
+TEST(Preloadable, SupersededLoad) {
+    auto app = InviwoApplication::getPtr();
+    auto network = app->getProcessorNetwork();
+    auto manager = app->getWorkspaceManager();
+
+    ProcessorFactoryObjectTemplate<PreloadingProcessor> factoryObject;
+    app->getProcessorFactory()->registerObject(&factoryObject);
+    const auto poolSize = app->getPoolSize();
+    if (poolSize == 0) app->resizePool(2);
+
+    const auto first = makeWorkspace(app, {"a"});
+    const auto second = makeWorkspace(app, {"a", "b"});
+
+    std::promise<void> gate;
+    PreloadingProcessor::gate = gate.get_future().share();
+
+    std::stringstream firstStream(first);
+    manager->load(firstStream, "");
+    auto a = dynamic_cast<PreloadingProcessor*>(network->getProcessorByIdentifier("a"));
+    ASSERT_TRUE(a);
+    EXPECT_FALSE(a->isReady());
+
+    // Load the second workspace before the data of the first one has arrived. Processor a is kept
+    // and gets no new job, its data still has to arrive from the superseded load.
+    std::stringstream secondStream(second);
+    manager->load(secondStream, "");
+    EXPECT_EQ(a, network->getProcessorByIdentifier("a"));
+    auto b = dynamic_cast<PreloadingProcessor*>(network->getProcessorByIdentifier("b"));
+    ASSERT_TRUE(b);
+    EXPECT_FALSE(b->isReady());
+
+    gate.set_value();
+    app->waitForPool();
+
+    EXPECT_TRUE(a->isReady());
+    EXPECT_TRUE(b->isReady());
+    EXPECT_FALSE(manager->isPreloading());
+
+    manager->clear();
+    PreloadingProcessor::gate = {};
+    if (poolSize == 0) app->resizePool(0);
+    app->getProcessorFactory()->unRegisterObject(&factoryObject);
+}
+
+}  // namespace inviwo
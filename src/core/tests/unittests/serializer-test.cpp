@@ -34,6 +34,7 @@
 
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/network/workspaceannotations.h>
 #include <inviwo/core/util/filesystem.h>
 
 namespace inviwo {
@@ -383,4 +384,121 @@ TEST(SerializationTest, mat4Tests) {
     for (int i = 0; i < s; i++)
         for (int j = 0; j < s; j++) EXPECT_EQ(inMat[i][j], outMat[i][j]);
 }
-}  // namespace inviwo
\ No newline at end of file
+TEST(SerializationTest, binaryFormatTest) {
+    std::string refpath = filesystem::findBasePath();
+    const std::vector<float> values{1.0f, -2.5f, 3.25f};
+    const std::string text = "<escaped> & \"quoted\"\n";
+
+    Serializer serializer(refpath);
+    serializer.serialize("int", 42);
+    serializer.serialize("text", text);
+    serializer.serialize("vec", vec3(1.0f, 2.0f, 3.0f));
+    serializer.serialize("list", std::vector<int>{1, 2, 3});
+    serializer.serializeBlob("blob", values);
+
+    std::stringstream ss;
+    serializer.writeBinaryFile(ss);
+    EXPECT_TRUE(binaryformat::isBinary(ss));
+
+    Deserializer deserializer(ss, refpath);
+    int intValue = 0;
+    deserializer.deserialize("int", intValue);
+    EXPECT_EQ(42, intValue);
+    std::string textValue;
+    deserializer.deserialize("text", textValue);
+    EXPECT_EQ(text, textValue);
+    vec3 vecValue{0.0f};
+    deserializer.deserialize("vec", vecValue);
+    EXPECT_EQ(vec3(1.0f, 2.0f, 3.0f), vecValue);
+    std::vector<int> listValue;
+    deserializer.deserialize("list", listValue);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), listValue);
+    std::vector<float> blobValue;
+    deserializer.deserializeBlob("blob", blobValue);
+    EXPECT_EQ(values, blobValue);
+}
+
+TEST(SerializationTest, blobXmlTest) {
+    std::string refpath = filesystem::findBasePath();
+    for (size_t size = 0; size < 8; ++size) {
+        std::vector<unsigned char> values(size);
+        for (size_t i = 0; i < size; ++i) values[i] = static_cast<unsigned char>(251 + i);
+
+        Serializer serializer(refpath);
+        serializer.serializeBlob("blob", values);
+        std::stringstream ss;
+        serializer.writeFile(ss);
+        EXPECT_FALSE(binaryformat::isBinary(ss));
+
+        Deserializer deserializer(ss, refpath);
+        std::vector<unsigned char> blobValue;
+        deserializer.deserializeBlob("blob", blobValue);
+        EXPECT_EQ(values, blobValue);
+    }
+}
+
+TEST(SerializationTest, binaryFormatInvalidTest) {
+    std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    serializer.serialize("int", 42);
+    std::stringstream ss;
+    serializer.writeBinaryFile(ss);
+
+    const auto data = ss.str();
+    std::stringstream truncated(data.substr(0, data.size() / 2));
+    EXPECT_THROW(Deserializer deserializer(truncated, refpath), SerializationException);
+}
+
+TEST(SerializationTest, binaryFormatChunkSizeTest) {
+    std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    serializer.serialize("int", 42);
+    serializer.serializeBlob("blob", std::vector<unsigned char>(16, 1));
+    std::stringstream ss;
+    serializer.writeBinaryFile(ss);
+    const auto data = ss.str();
+
+    // A blob size far beyond the end of the stream
+    auto blobSize = data;
+    const auto blob = blobSize.find("BLOB");
+    ASSERT_NE(std::string::npos, blob);
+    std::fill_n(blobSize.begin() + blob + 4, 8, '\xff');
+    std::stringstream oversized(blobSize);
+    EXPECT_THROW(Deserializer deserializer(oversized, refpath), SerializationException);
+
+    // A string count larger than the string table chunk, the table is the first chunk
+    auto stringCount = data;
+    stringCount[8 + 4 + 4 + 8] = '\x7f';
+    std::stringstream strings(stringCount);
+    EXPECT_THROW(Deserializer deserializer(strings, refpath), SerializationException);
+
+    for (size_t size = 1; size < data.size(); size += 7) {
+        std::stringstream truncated(data.substr(0, size));
+        EXPECT_THROW(Deserializer deserializer(truncated, refpath), SerializationException);
+    }
+}
+
+TEST(SerializationTest, annotationsBlobTest) {
+    std::string refpath = filesystem::findBasePath();
+    const std::vector<unsigned char> jpeg{0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0xff, 0xd9};
+    const WorkspaceAnnotations annotations{
+        {{"canvas", binaryformat::toBase64(jpeg.data(), jpeg.size()), ivec2{2, 4}}}};
+
+    for (auto format : {SerializationFormat::Xml, SerializationFormat::Binary}) {
+        Serializer serializer(refpath);
+        serializer.serialize("WorkspaceAnnotations", annotations);
+        std::stringstream ss;
+        serializer.writeFile(ss, format);
+
+        Deserializer deserializer(ss, refpath);
+        WorkspaceAnnotations result;
+        deserializer.deserialize("WorkspaceAnnotations", result);
+        const auto images = result.getCanvasImages();
+        ASSERT_EQ(1u, images.size());
+        EXPECT_EQ("canvas", images[0].name);
+        EXPECT_EQ(ivec2(2, 4), images[0].size);
+        EXPECT_EQ(annotations.getCanvasImages()[0].base64jpeg, images[0].base64jpeg);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <numeric>
+#include <array>
+
+namespace inviwo {
+
+TEST(ThreadPoolTests, EnqueueResult) {
+    ThreadPool pool(4);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool.enqueue([](int a, int b) { return a * b; }, i, 2));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(2 * i, futures[i].get());
+    }
+}
+
+TEST(ThreadPoolTests, EnqueueException) {
+    ThreadPool pool(2);
+    auto future = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTests, NoWorkers) {
+    ThreadPool pool(0);
+    auto future = pool.enqueue([]() { return std::this_thread::get_id(); });
+    EXPECT_EQ(std::this_thread::get_id(), future.get());
+}
+
+TEST(ThreadPoolTests, NestedWait) {
+    ThreadPool pool(2);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 16; ++i) {
+        futures.push_back(pool.enqueue([&pool]() {
+            EXPECT_TRUE(pool.isWorkerThread());
+            std::vector<std::future<int>> inner;
+            for (int j = 0; j < 16; ++j) inner.push_back(pool.enqueue([j]() { return j; }));
+            int sum = 0;
+            for (auto& f : inner) {
+                pool.wait(f);
+                sum += f.get();
+            }
+            return sum;
+        }));
+    }
+    EXPECT_FALSE(pool.isWorkerThread());
+    for (auto& f : futures) EXPECT_EQ(120, f.get());
+}
+
+TEST(ThreadPoolTests, Resize) {
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) pool.enqueueRaw([&count]() { ++count; });
+
+    while (pool.trySetSize(1) != 1) {
+    }
+    while (pool.trySetSize(0) != 0) {
+    }
+    EXPECT_EQ(1000, count);
+    EXPECT_EQ(0, pool.getQueueSize());
+
+    EXPECT_EQ(3, pool.trySetSize(3));
+    auto future = pool.enqueue([]() { return 1; });
+    EXPECT_EQ(1, future.get());
+}
+
+TEST(ThreadPoolTests, LargeTask) {
+    ThreadPool pool(2);
+    std::array<size_t, 64> data;
+    std::iota(data.begin(), data.end(), size_t{0});
+    auto future = pool.enqueue([data]() { return std::accumulate(data.begin(), data.end(), size_t{0}); });
+    EXPECT_EQ(64 * 63 / 2, future.get());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/topologicalorder.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+template <typename Node>
+void checkOrder(const util::TopologicalOrder<Node>& order) {
+    order.forEach([&](Node node) {
+        for (auto successor : order.getSuccessors(node)) {
+            EXPECT_LT(order.position(node), order.position(successor));
+        }
+    });
+}
+
+}  // namespace
+
+TEST(TopologicalOrder, AddEdges) {
+    util::TopologicalOrder<int> order;
+    for (int i = 1; i <= 5; ++i) order.addNode(i);
+
+    EXPECT_TRUE(order.addEdge(5, 4));
+    EXPECT_TRUE(order.addEdge(4, 3));
+    EXPECT_TRUE(order.addEdge(3, 1));
+    EXPECT_TRUE(order.addEdge(2, 1));
+    checkOrder(order);
+
+    EXPECT_FALSE(order.addEdge(1, 5));
+    EXPECT_FALSE(order.addEdge(3, 3));
+    checkOrder(order);
+    EXPECT_EQ(5, order.getOrder().size());
+}
+
+TEST(TopologicalOrder, RemoveNodes) {
+    util::TopologicalOrder<int> order;
+    for (int i = 1; i <= 100; ++i) order.addNode(i);
+    for (int i = 100; i > 1; --i) EXPECT_TRUE(order.addEdge(i, i - 1));
+    checkOrder(order);
+
+    for (int i = 2; i <= 100; i += 2) order.removeNode(i);
+    EXPECT_EQ(50, order.size());
+    EXPECT_TRUE(order.getPredecessors(1).empty());
+    checkOrder(order);
+
+    EXPECT_TRUE(order.addEdge(1, 99));
+    checkOrder(order);
+    order.removeEdge(1, 99);
+    EXPECT_TRUE(order.addEdge(99, 1));
+    checkOrder(order);
+}
+
+TEST(TopologicalOrder, Random) {
+    util::TopologicalOrder<int> order;
+    const int size = 200;
+    for (int i = 1; i <= size; ++i) order.addNode(i);
+
+    // Only add edges from larger to smaller labels, hence the graph is always acyclic
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(1, size);
+    for (int i = 0; i < 2000; ++i) {
+        auto a = dist(gen);
+        auto b = dist(gen);
+        if (a == b) continue;
+        EXPECT_TRUE(order.addEdge(std::max(a, b), std::min(a, b)));
+        EXPECT_FALSE(order.addEdge(std::min(a, b), std::max(a, b)));
+    }
+    checkOrder(order);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeminmaxoctree.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> createRamp(const size3_t& dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                ram->setFromDouble(size3_t(x, y, z), static_cast<double>(x + y + z));
+            }
+        }
+    }
+    return ram;
+}
+
+}  // namespace
+
+TEST(VolumeMinMaxOctreeTests, Bricks) {
+    const auto ram = createRamp(size3_t{10, 9, 5});
+    VolumeMinMaxOctree octree(*ram, 4);
+
+    // 9 x 8 x 4 cells
+    EXPECT_TRUE(size3_t(3, 2, 1) == octree.getNumberOfBricks());
+    ASSERT_EQ(3u, octree.getNumberOfLevels());
+    EXPECT_TRUE(size3_t(2, 1, 1) == octree.getLevelDimensions(1));
+    EXPECT_TRUE(size3_t(1, 1, 1) == octree.getLevelDimensions(2));
+
+    EXPECT_TRUE(size3_t(5, 5, 5) == octree.getBrickDimensions(size3_t(0, 0, 0)));
+    EXPECT_TRUE(size3_t(2, 5, 5) == octree.getBrickDimensions(size3_t(2, 1, 0)));
+    EXPECT_TRUE(size3_t(8, 4, 0) == octree.getBrickOffset(size3_t(2, 1, 0)));
+    EXPECT_TRUE(size3_t(2, 1, 0) == octree.getBrick(size3_t(9, 8, 4)));
+
+    // A brick includes the border voxels shared with the next brick
+    EXPECT_EQ(dvec2(0.0, 12.0), octree.getBrickRange(size3_t(0, 0, 0)));
+    EXPECT_EQ(dvec2(12.0, 21.0), octree.getBrickRange(size3_t(2, 1, 0)));
+    EXPECT_EQ(dvec2(0.0, 21.0), octree.getDataRange());
+
+    EXPECT_TRUE(octree.mayContain(size3_t(0, 0, 0), 12.0));
+    EXPECT_FALSE(octree.mayContain(size3_t(0, 0, 0), 12.5));
+    EXPECT_TRUE(octree.mayIntersect(size3_t(2, 1, 0), dvec2(20.0, 30.0)));
+}
+
+TEST(VolumeMinMaxOctreeTests, FindBricks) {
+    const auto ram = createRamp(size3_t{33, 33, 33});
+    VolumeMinMaxOctree octree(*ram, 8);
+    const auto dims = octree.getNumberOfBricks();
+
+    for (const double value : {-1.0, 0.0, 10.5, 48.0, 96.0, 97.0}) {
+        std::vector<size3_t> expected;
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    if (octree.mayContain(size3_t(x, y, z), value)) expected.emplace_back(x, y, z);
+                }
+            }
+        }
+        EXPECT_EQ(expected, octree.findBricks(value)) << "value: " << value;
+    }
+    EXPECT_TRUE(octree.findBricks(dvec2(100.0, 200.0)).empty());
+    EXPECT_EQ(64u, octree.findBricks(dvec2(0.0, 96.0)).size());
+}
+
+TEST(VolumeMinMaxOctreeTests, NaN) {
+    const size3_t dims{9, 9, 9};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::fill(data, data + glm::compMul(dims), 0.0f);
+    // A NaN as the first voxel of a row in a zero brick must not hide the rest of the row
+    const size_t row = 1 * 9 * 9 + 2 * 9;
+    data[row] = std::numeric_limits<float>::quiet_NaN();
+    data[row + 1] = data[row + 2] = data[row + 3] = 5.0f;
+    // Only NaN values in the last brick, apart from the voxels shared with the other bricks
+    for (size_t z = 5; z < 9; ++z) {
+        for (size_t y = 5; y < 9; ++y) {
+            for (size_t x = 5; x < 9; ++x) {
+                data[x + y * 9 + z * 81] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+    }
+    VolumeMinMaxOctree octree(*ram, 4);
+
+    EXPECT_EQ(dvec2(0.0, 5.0), octree.getBrickRange(size3_t(0, 0, 0)));
+    EXPECT_TRUE(octree.containsNaN(size3_t(0, 0, 0)));
+    EXPECT_TRUE(octree.mayContain(size3_t(0, 0, 0), 2.5));
+    EXPECT_EQ(std::vector<size3_t>{size3_t(0, 0, 0)}, octree.findBricks(2.5));
+    EXPECT_FALSE(octree.containsNaN(size3_t(1, 0, 0)));
+    EXPECT_EQ(dvec2(0.0, 0.0), octree.getBrickRange(size3_t(1, 0, 0)));
+
+    // The last brick shares the voxels at 4 with its neighbors, those are zero
+    EXPECT_TRUE(octree.containsNaN(size3_t(1, 1, 1)));
+    EXPECT_EQ(dvec2(0.0, 0.0), octree.getBrickRange(size3_t(1, 1, 1)));
+    EXPECT_EQ(dvec2(0.0, 5.0), octree.getDataRange());
+}
+
+TEST(VolumeMinMaxOctreeTests, VolumeCache) {
+    Volume volume(createRamp(size3_t{16, 16, 16}));
+    auto octree = volume.getMinMaxOctree();
+    EXPECT_EQ(dvec2(0.0, 45.0), octree->getDataRange());
+    EXPECT_EQ(octree, volume.getMinMaxOctree());
+
+    // Editing the representation invalidates the octree
+    volume.getEditableRepresentation<VolumeRAM>()->setFromDouble(size3_t(0, 0, 0), -1.0);
+    auto edited = volume.getMinMaxOctree();
+    EXPECT_NE(octree, edited);
+    EXPECT_EQ(dvec2(-1.0, 45.0), edited->getDataRange());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,167 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/representationconverter.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <atomic>
+#include <thread>
+
+namespace inviwo {
+
+TEST(VolumePyramidTests, Levels) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{5, 4, 3});
+    const auto dims = ram->getDimensions();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                ram->setFromDouble(size3_t(x, y, z), static_cast<double>(x + 10 * y + 100 * z));
+            }
+        }
+    }
+
+    VolumePyramid pyramid(ram);
+    ASSERT_EQ(4u, pyramid.getNumberOfLevels());
+    EXPECT_EQ(ram.get(), pyramid.getLevel(0).get());
+    EXPECT_TRUE(size3_t(3, 2, 2) == pyramid.getDimensions(1));
+    EXPECT_TRUE(size3_t(2, 1, 1) == pyramid.getDimensions(2));
+    EXPECT_TRUE(size3_t(1, 1, 1) == pyramid.getDimensions(3));
+
+    const auto& level1 = *pyramid.getLevel(1);
+    // Average of x in {0,1}, y in {0,1}, z in {0,1}
+    EXPECT_DOUBLE_EQ(0.5 + 5.0 + 50.0, level1.getAsDouble(size3_t(0, 0, 0)));
+    // At the upper border only x = 4 and z = 2 exist
+    EXPECT_DOUBLE_EQ(4.0 + 25.0 + 200.0, level1.getAsDouble(size3_t(2, 1, 1)));
+
+    EXPECT_EQ(0u, pyramid.getLevelForVoxelBudget(60));
+    EXPECT_EQ(1u, pyramid.getLevelForVoxelBudget(59));
+    EXPECT_EQ(3u, pyramid.getLevelForVoxelBudget(0));
+    EXPECT_EQ(0u, pyramid.getLevelForFootprint(5));
+    EXPECT_EQ(1u, pyramid.getLevelForFootprint(4));
+    EXPECT_EQ(2u, pyramid.getLevelForFootprint(2));
+}
+
+TEST(VolumePyramidTests, IntegerRounding) {
+    auto ram = std::make_shared<VolumeRAMPrecision<std::uint8_t>>(size3_t{2, 1, 1});
+    ram->getDataTyped()[0] = 1;
+    ram->getDataTyped()[1] = 2;
+    const auto level = VolumePyramid::downsample(*ram);
+    EXPECT_EQ(2.0, level->getAsDouble(size3_t(0, 0, 0)));
+}
+
+TEST(VolumePyramidTests, VolumeCache) {
+    Volume volume(std::make_shared<VolumeRAMPrecision<float>>(size3_t{16, 16, 16}));
+    auto pyramid = volume.getPyramid();
+    EXPECT_EQ(5u, pyramid->getNumberOfLevels());
+    EXPECT_EQ(pyramid, volume.getPyramid());
+    volume.discardPyramid();
+    EXPECT_NE(pyramid, volume.getPyramid());
+}
+
+namespace {
+
+// A stand-in for a GPU representation, converted from VolumeRAM without copying any data
+class VolumeTestRepresentation : public VolumeRepresentation {
+public:
+    explicit VolumeTestRepresentation(size3_t dimensions) : dimensions_{dimensions} {}
+    virtual VolumeTestRepresentation* clone() const override {
+        return new VolumeTestRepresentation(*this);
+    }
+    virtual std::type_index getTypeIndex() const override {
+        return std::type_index(typeid(VolumeTestRepresentation));
+    }
+    virtual void setDimensions(size3_t dimensions) override { dimensions_ = dimensions; }
+    virtual const size3_t& getDimensions() const override { return dimensions_; }
+    virtual void setSwizzleMask(const SwizzleMask&) override {}
+    virtual SwizzleMask getSwizzleMask() const override { return swizzlemasks::rgba; }
+    virtual void setInterpolation(InterpolationType) override {}
+    virtual InterpolationType getInterpolation() const override {
+        return InterpolationType::Linear;
+    }
+    virtual void setWrapping(const Wrapping3D&) override {}
+    virtual Wrapping3D getWrapping() const override { return wrapping3d::clampAll; }
+
+private:
+    size3_t dimensions_;
+};
+
+class VolumeRAM2TestConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeRAM,
+                                         VolumeTestRepresentation> {
+public:
+    virtual std::shared_ptr<VolumeTestRepresentation> createFrom(
+        std::shared_ptr<const VolumeRAM> source) const override {
+        return std::make_shared<VolumeTestRepresentation>(source->getDimensions());
+    }
+    virtual void update(std::shared_ptr<const VolumeRAM> source,
+                        std::shared_ptr<VolumeTestRepresentation> destination) const override {
+        destination->setDimensions(source->getDimensions());
+    }
+};
+
+}  // namespace
+
+TEST(VolumePyramidTests, ConcurrentRepresentations) {
+    auto factory =
+        InviwoApplication::getPtr()->getRepresentationConverterFactory<VolumeRepresentation>();
+    VolumeRAM2TestConverter converter;
+    factory->registerObject(&converter);
+
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    Volume volume(ram);
+
+    // Leaves the test representation as the last valid one
+    volume.getRepresentation<VolumeTestRepresentation>();
+    EXPECT_EQ(ram, volume.getPyramid()->getLevel(0));
+
+    std::atomic<bool> done{false};
+    std::thread other([&]() {
+        while (!done) volume.getRepresentation<VolumeTestRepresentation>();
+    });
+    for (int i = 0; i < 200; ++i) {
+        volume.discardPyramid();
+        const auto pyramid = volume.getPyramid();
+        EXPECT_EQ(ram, pyramid->getLevel(0));
+        EXPECT_EQ(4u, pyramid->getNumberOfLevels());
+        EXPECT_EQ(ram, volume.getRepresentationShared<VolumeRAM>());
+    }
+    done = true;
+    other.join();
+
+    factory->unRegisterObject(&converter);
+}
+
+}  // namespace inviwo
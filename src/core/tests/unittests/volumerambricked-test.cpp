@@ -0,0 +1,205 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumerambricked.h>
+#include <inviwo/core/datastructures/volume/volumeramconverter.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+double value(const size3_t& pos) { return static_cast<double>(pos.x + 7 * pos.y + 13 * pos.z); }
+
+void writeRaw(const std::string& file, const size3_t& dims, size_t voxels) {
+    std::vector<float> data;
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                data.push_back(static_cast<float>(value(size3_t(x, y, z))));
+            }
+        }
+    }
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()),
+              std::min(voxels, data.size()) * sizeof(float));
+}
+
+}  // namespace
+
+TEST(VolumeRAMBrickedTests, SetAndGet) {
+    const size3_t dims{50, 40, 30};
+    const size3_t brickSize{16, 16, 16};
+    const size_t brickBytes = glm::compMul(brickSize) * sizeof(std::uint16_t);
+    VolumeRAMBricked volume(dims, DataUInt16::get(), brickSize, 2 * brickBytes);
+
+    EXPECT_TRUE(size3_t(4, 3, 2) == volume.getNumberOfBricks());
+    EXPECT_TRUE(size3_t(2, 8, 14) == volume.getBrickDimensions(size3_t(3, 2, 1)));
+
+    // Never written voxels are zero
+    EXPECT_EQ(0.0, volume.getAsDouble(size3_t(49, 39, 29)));
+
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                volume.setFromDouble(size3_t(x, y, z), value(size3_t(x, y, z)));
+            }
+        }
+    }
+    EXPECT_LE(volume.getNumberOfCachedBytes(), 2 * brickBytes);
+
+    size_t errors = 0;
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                errors += volume.getAsDouble(size3_t(x, y, z)) != value(size3_t(x, y, z));
+            }
+        }
+    }
+    EXPECT_EQ(0u, errors);
+
+    // A copy has its own bricks
+    VolumeRAMBricked copy(volume);
+    volume.setFromDouble(size3_t(1, 2, 3), 0.0);
+    EXPECT_EQ(value(size3_t(1, 2, 3)), copy.getAsDouble(size3_t(1, 2, 3)));
+    EXPECT_EQ(0.0, volume.getAsDouble(size3_t(1, 2, 3)));
+}
+
+TEST(VolumeRAMBrickedTests, ForEachBrick) {
+    VolumeRAMBricked volume(size3_t{20, 20, 20}, DataFloat32::get(), size3_t{8, 8, 8}, 0);
+
+    volume.forEachBrick([](VolumeRAM& brick, const size3_t& offset) {
+        const auto dims = brick.getDimensions();
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    brick.setFromDouble(size3_t(x, y, z), value(offset + size3_t(x, y, z)));
+                }
+            }
+        }
+    });
+
+    size_t voxels = 0;
+    size_t errors = 0;
+    volume.forEachBrick([&](const VolumeRAM& brick, const size3_t& offset) {
+        const auto dims = brick.getDimensions();
+        for (size_t z = 0; z < dims.z; ++z) {
+            for (size_t y = 0; y < dims.y; ++y) {
+                for (size_t x = 0; x < dims.x; ++x) {
+                    errors += brick.getAsDouble(size3_t(x, y, z)) !=
+                              value(offset + size3_t(x, y, z));
+                    ++voxels;
+                }
+            }
+        }
+    });
+    EXPECT_EQ(size_t{20 * 20 * 20}, voxels);
+    EXPECT_EQ(0u, errors);
+}
+
+TEST(VolumeRAMBrickedTests, Converters) {
+    const size3_t dims{33, 17, 9};
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                ram->setFromDouble(size3_t(x, y, z), value(size3_t(x, y, z)));
+            }
+        }
+    }
+
+    auto bricked = VolumeRAM2RAMBrickedConverter{}.createFrom(ram);
+    EXPECT_EQ(value(size3_t(32, 16, 8)), bricked->getAsDouble(size3_t(32, 16, 8)));
+
+    auto back = std::static_pointer_cast<VolumeRAMPrecision<float>>(
+        VolumeRAMBricked2RAMConverter{}.createFrom(bricked));
+    ASSERT_TRUE(dims == back->getDimensions());
+    EXPECT_TRUE(std::equal(ram->getDataTyped(), ram->getDataTyped() + glm::compMul(dims),
+                           back->getDataTyped()));
+}
+
+TEST(VolumeRAMBrickedTests, FlushKeepsHeldBricksModified) {
+    VolumeRAMBricked volume(size3_t{16, 8, 8}, DataFloat32::get(), size3_t{8, 8, 8});
+
+    auto brick = volume.getEditableBrick(size3_t{0, 0, 0});
+    brick->setFromDouble(size3_t{0, 0, 0}, 1.0);
+    volume.flush();
+    // Modified after the flush, while still held
+    brick->setFromDouble(size3_t{0, 0, 0}, 2.0);
+    brick.reset();
+
+    // Evict the brick and read it back from disk
+    volume.getBrick(size3_t{1, 0, 0});
+    volume.setCacheSize(0);
+    EXPECT_EQ(glm::compMul(size3_t{8, 8, 8}) * sizeof(float), volume.getNumberOfCachedBytes());
+    EXPECT_EQ(2.0, volume.getAsDouble(size3_t{0, 0, 0}));
+}
+
+TEST(VolumeRAMBrickedTests, DiskConverter) {
+    const size3_t dims{150, 70, 9};
+    util::TempFileHandle file("ivw_", ".raw");
+    writeRaw(file.getFileName(), dims, glm::compMul(dims));
+
+    auto disk = std::make_shared<VolumeDisk>(dims, DataFloat32::get());
+    disk->setLoader(new RawVolumeRAMLoader(file.getFileName(), 0, true, false));
+
+    VolumeRAMPrecision<float> region(size3_t{5, 4, 3});
+    RawVolumeRAMLoader(file.getFileName(), 0, true, false)
+        .readRegion(*disk, size3_t{140, 60, 2}, region);
+    EXPECT_EQ(value(size3_t{144, 63, 4}), region.getAsDouble(size3_t{4, 3, 2}));
+
+    auto bricked = VolumeDisk2RAMBrickedConverter{}.createFrom(disk);
+    ASSERT_TRUE(dims == bricked->getDimensions());
+    size_t errors = 0;
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                errors += bricked->getAsDouble(size3_t(x, y, z)) != value(size3_t(x, y, z));
+            }
+        }
+    }
+    EXPECT_EQ(0u, errors);
+
+    // A truncated file is reported instead of read past its end
+    writeRaw(file.getFileName(), dims, glm::compMul(dims) - 1);
+    EXPECT_THROW(VolumeDisk2RAMBrickedConverter{}.createFrom(disk), DataReaderException);
+}
+
+}  // namespace inviwo
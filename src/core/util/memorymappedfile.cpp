@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#if WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <inviwo/core/util/stringconversion.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file, size_t offset, size_t bytes) {
+    if (bytes == 0) {
+        throw FileException("Can not map an empty region of file: " + file,
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+#if WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const size_t granularity = info.dwAllocationGranularity;
+
+    HANDLE fileHandle =
+        CreateFileW(util::toWstring(file).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw FileException("Could not open file: " + file,
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    util::OnScopeExit closeFile{[&]() { CloseHandle(fileHandle); }};
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) ||
+        static_cast<size_t>(fileSize.QuadPart) < offset + bytes) {
+        throw FileException("File is too small: " + file, IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+    HANDLE mappingHandle =
+        CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        throw FileException("Could not map file: " + file, IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    // The view keeps the mapping object alive
+    util::OnScopeExit closeMapping{[&]() { CloseHandle(mappingHandle); }};
+
+    const size_t alignedOffset = offset - offset % granularity;
+    const size_t mappingSize = bytes + (offset - alignedOffset);
+    void* mapping = MapViewOfFile(mappingHandle, FILE_MAP_COPY,
+                                  static_cast<DWORD>(static_cast<uint64_t>(alignedOffset) >> 32),
+                                  static_cast<DWORD>(alignedOffset & 0xFFFFFFFF), mappingSize);
+    if (!mapping) {
+        throw FileException("Could not map file: " + file, IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+#else
+    const size_t granularity = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw FileException("Could not open file: " + file,
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    util::OnScopeExit closeFile{[&]() { ::close(fd); }};
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < offset + bytes) {
+        throw FileException("File is too small: " + file, IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+    const size_t alignedOffset = offset - offset % granularity;
+    const size_t mappingSize = bytes + (offset - alignedOffset);
+    // A private mapping is copy-on-write, the file is never modified. The mapping stays valid
+    // after the file descriptor is closed.
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                           static_cast<off_t>(alignedOffset));
+    if (mapping == MAP_FAILED) {
+        throw FileException("Could not map file: " + file, IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+#endif
+
+    mapping_ = mapping;
+    mappingSize_ = mappingSize;
+    data_ = static_cast<char*>(mapping) + (offset - alignedOffset);
+    size_ = bytes;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+    : mapping_{std::exchange(rhs.mapping_, nullptr)}
+    , mappingSize_{std::exchange(rhs.mappingSize_, 0)}
+    , data_{std::exchange(rhs.data_, nullptr)}
+    , size_{std::exchange(rhs.size_, 0)} {}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        unmap();
+        mapping_ = std::exchange(rhs.mapping_, nullptr);
+        mappingSize_ = std::exchange(rhs.mappingSize_, 0);
+        data_ = std::exchange(rhs.data_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() { unmap(); }
+
+void MemoryMappedFile::unmap() {
+    if (!mapping_) return;
+#if WIN32
+    UnmapViewOfFile(mapping_);
+#else
+    ::munmap(mapping_, mappingSize_);
+#endif
+    mapping_ = nullptr;
+    mappingSize_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
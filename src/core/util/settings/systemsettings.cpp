@@ -41,6 +41,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , parallelEvaluation_("parallelEvaluation", "Parallel Network Evaluation (experimental)",
+                          false)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -60,12 +62,15 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                       0}
     , breakOnException_{"breakOnException", "Break on Exception", false}
     , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false}
+    , binaryWorkspaces_{"binaryWorkspaces", "Save Workspaces in Binary Format", false}
+    , memoryMapRawVolumes_{"memoryMapRawVolumes", "Memory Map Raw Volume Files", false}
     , redirectCout_{"redirectCout", "Redirect cout to LogCentral", false}
     , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false} {
 
     addProperty(workspaceAuthor_);
     addProperty(applicationUsageMode_);
     addProperty(poolSize_);
+    addProperty(parallelEvaluation_);
     addProperty(enablePortInspectors_);
     addProperty(portInspectorSize_);
     addProperty(enableTouchProperty_);
@@ -77,6 +82,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(breakOnMessage_);
     addProperty(breakOnException_);
     addProperty(stackTraceInException_);
+    addProperty(binaryWorkspaces_);
+    addProperty(memoryMapRawVolumes_);
     addProperty(redirectCout_);
     addProperty(redirectCerr_);
 
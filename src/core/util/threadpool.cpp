@@ -33,89 +33,260 @@
 
 namespace inviwo {
 
+ThreadPool::Task::Task(Task&& rhs) noexcept : vtable_{rhs.vtable_} {
+    if (vtable_) {
+        vtable_->move(&storage_, &rhs.storage_);
+        rhs.vtable_ = nullptr;
+    }
+}
+
+ThreadPool::Task& ThreadPool::Task::operator=(Task&& rhs) noexcept {
+    if (this != &rhs) {
+        if (vtable_) vtable_->destroy(&storage_);
+        vtable_ = rhs.vtable_;
+        if (vtable_) {
+            vtable_->move(&storage_, &rhs.storage_);
+            rhs.vtable_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+ThreadPool::Task::~Task() {
+    if (vtable_) vtable_->destroy(&storage_);
+}
+
+void ThreadPool::Task::operator()() { vtable_->invoke(&storage_); }
+
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
     : onThreadStart_{std::move(onThreadStart)}, onThreadStop_{std::move(onThreadStop)} {
-    while (workers.size() < threads) {
-        workers.push_back(std::make_unique<Worker>(*this));
-    }
+    trySetSize(threads);
 }
 
 size_t ThreadPool::trySetSize(size_t size) {
-    while (workers.size() < size) {
-        workers.push_back(std::make_unique<Worker>(*this));
-    }
+    std::vector<std::unique_ptr<Worker>> done;
+    std::vector<Task> orphans;
+    {
+        std::unique_lock<std::shared_mutex> lock(workersMutex_);
+        while (workers.size() < size) {
+            workers.push_back(std::make_unique<Worker>(*this));
+        }
 
-    if (workers.size() > size) {
-        auto active = workers.size();
-        for (auto& worker : workers) {
-            auto exprected = State::Free;
-            if (worker->state.compare_exchange_strong(exprected, State::Stop)) {
-                --active;
-            } else if (exprected == State::Stop || exprected == State::Done) {
-                --active;
+        if (workers.size() > size) {
+            auto active = workers.size();
+            for (auto& worker : workers) {
+                auto exprected = State::Free;
+                if (worker->state.compare_exchange_strong(exprected, State::Stop)) {
+                    --active;
+                } else if (exprected == State::Stop || exprected == State::Done) {
+                    --active;
+                }
+                if (active <= size) break;
             }
-            if (active <= size) break;
-        }
 
-        condition.notify_all();
+            notify(true);
+
+            for (auto& worker : workers) {
+                if (worker->state == State::Done) done.push_back(std::move(worker));
+            }
+            util::erase_remove_if(workers,
+                                  [](std::unique_ptr<Worker>& worker) { return !worker; });
 
-        util::erase_remove_if(
-            workers, [](std::unique_ptr<Worker>& worker) { return worker->state == State::Done; });
+            // A task might have been pushed to a worker just as it was stopping, move it over to
+            // one of the remaining workers.
+            for (auto& worker : done) {
+                std::unique_lock<std::mutex> queueLock(worker->queueMutex);
+                queued_ -= worker->queue.size();
+                for (auto& task : worker->queue) {
+                    if (workers.empty()) {
+                        orphans.push_back(std::move(task));
+                    } else {
+                        push(*workers.front(), std::move(task));
+                    }
+                }
+                worker->queue.clear();
+            }
+        }
     }
+    // join the threads outside of the lock
+    done.clear();
+    notify(true);
+
+    for (auto& task : orphans) {
+        try {
+            task();  // No worker threads left, just run the task.
+        } catch (...) {  // Make sure we don't leak any exceptions.
+        }
+    }
+
+    return getSize();
+}
+
+size_t ThreadPool::getSize() const {
+    std::shared_lock<std::shared_mutex> lock(workersMutex_);
     return workers.size();
 }
 
-size_t ThreadPool::getSize() const { return workers.size(); }
+size_t ThreadPool::getQueueSize() { return queued_; }
+
+bool ThreadPool::isWorkerThread() const {
+    auto* worker = currentWorker();
+    return worker && &worker->pool == this;
+}
 
-size_t ThreadPool::getQueueSize() {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
+ThreadPool::Worker*& ThreadPool::currentWorker() {
+    thread_local Worker* worker = nullptr;
+    return worker;
 }
 
 ThreadPool::~ThreadPool() {
-    for (auto& worker : workers) worker->state = State::Abort;
-    condition.notify_all();
-    workers.clear();  // this will join all threads.
+    std::vector<std::unique_ptr<Worker>> all;
+    {
+        std::unique_lock<std::shared_mutex> lock(workersMutex_);
+        for (auto& worker : workers) worker->state = State::Abort;
+        std::swap(all, workers);
+    }
+    notify(true);
+    all.clear();  // this will join all threads.
 }
 
 ThreadPool::Worker::~Worker() { thread.join(); }
 
 ThreadPool::Worker::Worker(ThreadPool& pool)
-    : state{State::Free}, thread{[this, &pool]() {
+    : state{State::Free}, pool{pool}, thread{[this, &pool]() {
+        currentWorker() = this;
         pool.onThreadStart_();
         util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
 
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
-            {
-                std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
-                });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
-            }
-            state = State::Working;
-            try {
-                task();
-            } catch (...) {  // Make sure we don't leak any exceptions.
+            if (state == State::Abort) break;
+            if (auto task = pool.findTask(*this)) {
+                // Use compare exchange to not overwrite a Stop or Abort
+                auto expected = State::Free;
+                state.compare_exchange_strong(expected, State::Working);
+                try {
+                    task();
+                } catch (...) {  // Make sure we don't leak any exceptions.
+                }
+                expected = State::Working;
+                state.compare_exchange_strong(expected, State::Free);
+            } else if (state == State::Stop) {
+                break;
+            } else {
+                pool.sleep(*this);
             }
         }
         state = State::Done;
     }} {}
 
-void ThreadPool::enqueueRaw(std::function<void()> task) {
-    if (workers.empty()) {
-        task();  // No worker threads, just run the task.
+void ThreadPool::enqueueRaw(std::function<void()> task) { enqueueTask(Task{std::move(task)}); }
+
+void ThreadPool::enqueueTask(Task task) {
+    {
+        std::shared_lock<std::shared_mutex> lock(workersMutex_);
+        if (!workers.empty()) {
+            if (isWorkerThread()) {
+                push(*currentWorker(), std::move(task));
+            } else {
+                // Round robin over the workers, skipping the ones that are stopping.
+                const auto size = workers.size();
+                const auto start = next_++;
+                auto* target = workers[start % size].get();
+                for (size_t i = 0; i < size; ++i) {
+                    auto* worker = workers[(start + i) % size].get();
+                    const auto state = worker->state.load();
+                    if (state == State::Free || state == State::Working) {
+                        target = worker;
+                        break;
+                    }
+                }
+                push(*target, std::move(task));
+            }
+            lock.unlock();
+            notify(false);
+            return;
+        }
+    }
+    task();  // No worker threads, just run the task.
+}
+
+void ThreadPool::push(Worker& worker, Task&& task) {
+    std::unique_lock<std::mutex> lock(worker.queueMutex);
+    worker.queue.push_back(std::move(task));
+    ++queued_;
+}
+
+ThreadPool::Task ThreadPool::pop(Worker& worker) {
+    std::unique_lock<std::mutex> lock(worker.queueMutex);
+    if (worker.queue.empty()) return {};
+    auto task = std::move(worker.queue.back());
+    worker.queue.pop_back();
+    --queued_;
+    return task;
+}
+
+ThreadPool::Task ThreadPool::steal(const Worker& thief) {
+    std::shared_lock<std::shared_mutex> lock(workersMutex_);
+    const auto size = workers.size();
+    // Start at different offsets to spread the thieves over the victims.
+    const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (size_t i = 0; i < size; ++i) {
+        auto& victim = *workers[(start + i) % size];
+        if (&victim == &thief) continue;
+        std::unique_lock<std::mutex> queueLock(victim.queueMutex, std::try_to_lock);
+        if (!queueLock.owns_lock() || victim.queue.empty()) continue;
+        auto task = std::move(victim.queue.front());
+        victim.queue.pop_front();
+        --queued_;
+        return task;
+    }
+    return {};
+}
+
+ThreadPool::Task ThreadPool::findTask(Worker& worker) {
+    if (auto task = pop(worker)) return task;
+    // A failed try_lock might make us miss a task, retry a few times if there are tasks queued.
+    for (int attempt = 0; attempt < 8 && queued_ > 0 && worker.state != State::Abort; ++attempt) {
+        if (auto task = steal(worker)) return task;
+        std::this_thread::yield();
+    }
+    return {};
+}
+
+bool ThreadPool::runPendingTask() {
+    if (auto task = findTask(*currentWorker())) {
+        try {
+            task();
+        } catch (...) {  // Make sure we don't leak any exceptions.
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::sleep(Worker& worker) {
+    ++sleeping_;
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        condition.wait(lock, [this, &worker] {
+            return worker.state == State::Abort || worker.state == State::Stop || queued_ > 0;
+        });
+    }
+    --sleeping_;
+}
+
+void ThreadPool::notify(bool all) {
+    // Only take the lock when someone is sleeping, ++sleeping_ in sleep() happens before the
+    // predicate is checked so we can not miss a wake up.
+    if (!all && sleeping_ == 0) return;
+    { std::unique_lock<std::mutex> lock(sleepMutex_); }
+    if (all) {
+        condition.notify_all();
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        condition.notify_one();
     }
-    condition.notify_one();
 }
 
 }  // namespace inviwo
@@ -1045,7 +1045,7 @@ bool InviwoMainWindow::openWorkspace(QString workspaceFileName, bool isExample)
 
 void InviwoMainWindow::appendWorkspace(const std::string& file) {
     NetworkLock lock(app_->getProcessorNetwork());
-    std::ifstream fs(file);
+    std::ifstream fs(file, std::ios::in | std::ios::binary);
     if (!fs) {
         LogError("Could not open workspace file: " << file);
         return;
@@ -1058,16 +1058,22 @@ void InviwoMainWindow::saveWorkspace(QString workspaceFileName) {
     std::string fileName{utilqt::fromQString(workspaceFileName)};
     fileName = filesystem::cleanupPath(fileName);
 
+    const auto format = app_->getSystemSettings().binaryWorkspaces_
+                            ? SerializationFormat::Binary
+                            : SerializationFormat::Xml;
     try {
-        app_->getWorkspaceManager()->save(fileName, [&](ExceptionContext ec) {
-            try {
-                throw;
-            } catch (const IgnoreException& e) {
-                util::log(e.getContext(),
-                          "Incomplete network save " + fileName + " due to " + e.getMessage(),
-                          LogLevel::Error);
-            }
-        });
+        app_->getWorkspaceManager()->save(
+            fileName,
+            [&](ExceptionContext ec) {
+                try {
+                    throw;
+                } catch (const IgnoreException& e) {
+                    util::log(e.getContext(),
+                              "Incomplete network save " + fileName + " due to " + e.getMessage(),
+                              LogLevel::Error);
+                }
+            },
+            WorkspaceSaveMode::Disk, format);
         getNetworkEditor()->setModified(false);
         updateWindowTitle();
         LogInfo("Workspace saved to: " << fileName);
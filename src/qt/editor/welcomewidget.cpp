@@ -164,7 +164,8 @@ WelcomeWidget::WelcomeWidget(InviwoMainWindow* window, QWidget* parent)
         WorkspaceAnnotationsQt annotations;
         bool fileBroken = false;
         try {
-            auto istream = filesystem::ifstream(utilqt::fromQString(filename));
+            auto istream = filesystem::ifstream(utilqt::fromQString(filename),
+                                                std::ios::in | std::ios::binary);
             if (istream.is_open()) {
                 LogFilter logger{LogCentral::getPtr(), LogVerbosity::None};
                 auto d = mainWindow_->getInviwoApplication()